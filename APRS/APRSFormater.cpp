@@ -18,31 +18,72 @@
  */
 
 
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cassert>
 
 #include "APRSFormater.h"
 #include "Log.h"
 #include "StringUtils.h"
 
 bool CAPRSFormater::frameToString(std::string& output, CAPRSFrame& frame)
+{
+    unsigned int length = getLength(frame);
+    if(length == 0U)
+        return false;
+
+    output.resize(length);
+    write(&output[0], frame);
+
+    return true;
+}
+
+unsigned int CAPRSFormater::frameToBuffer(char* buffer, unsigned int size, CAPRSFrame& frame)
+{
+    assert(buffer != nullptr);
+
+    unsigned int length = getLength(frame);
+    if(length == 0U || length > size)
+        return 0U;
+
+    write(buffer, frame);
+
+    return length;
+}
+
+unsigned int CAPRSFormater::getLength(CAPRSFrame& frame)
 {
     // make sur we have the minimal stuff to build a correct aprs string
     if(frame.getSource().empty()
         || frame.getDestination().empty()
         || frame.getBody().empty()) {
             LogWarning("Invalid APRS frame, missing source, destination or body");
-            return false;
+            return 0U;
     }
 
-    auto path = boost::join_if(frame.getPath(), ",", [](std::string s) { return  !string_is_blank_or_empty(s); });
-
-    CStringUtils::string_format_in_place(output, "%s>%s%s%s:%s",
-                                                    frame.getSource().c_str(),
-                                                    frame.getDestination().c_str(),
-                                                    path.empty() ? "" : ",",
-                                                    path.c_str(),
-                                                    frame.getBody().c_str());
+    unsigned int length = frame.getSource().length() + 1U + frame.getDestination().length() + 1U + frame.getBody().length();
+    for(const auto& path : frame.getPath()) {
+        if(!string_is_blank_or_empty(path))
+            length += 1U + path.length();
+    }
 
-    return true;
+    return length;
 }
 
+void CAPRSFormater::write(char* buffer, CAPRSFrame& frame)
+{
+    char* p = buffer;
+
+    p = std::copy(frame.getSource().begin(), frame.getSource().end(), p);
+    *p++ = '>';
+    p = std::copy(frame.getDestination().begin(), frame.getDestination().end(), p);
+
+    for(const auto& path : frame.getPath()) {
+        if(!string_is_blank_or_empty(path)) {
+            *p++ = ',';
+            p = std::copy(path.begin(), path.end(), p);
+        }
+    }
+
+    *p++ = ':';
+    std::copy(frame.getBody().begin(), frame.getBody().end(), p);
+}
@@ -24,4 +24,11 @@ class CAPRSFormater
 {
 public:
     static bool frameToString(std::string& output, CAPRSFrame& frame);
+
+    // Writes the frame into buffer without a terminating NUL, returns the length written or 0 if invalid or too long
+    static unsigned int frameToBuffer(char* buffer, unsigned int size, CAPRSFrame& frame);
+
+private:
+    static unsigned int getLength(CAPRSFrame& frame);
+    static void write(char* buffer, CAPRSFrame& frame);
 };
\ No newline at end of file
@@ -16,67 +16,84 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <algorithm>
+
 #include "APRSParser.h"
 #include "Log.h"
 
-bool CAPRSParser::parseFrame(const std::string& frameStr, CAPRSFrame& frame)
+bool CAPRSParser::parseFrame(std::string_view frameStr, CAPRSFrame& frame)
 {   
     frame.clear();
-    bool ret = false;
 
-    if(!frameStr.empty()) {
-        auto pos = frameStr.find_first_of(':');
-        if(pos != std::string::npos && pos != frameStr.length() - 1) {
-            auto header = frameStr.substr(0, pos); // contains source, dest and path
-            auto body = frameStr.substr(pos +1);
+    auto pos = frameStr.find_first_of(':');
+    if(pos == std::string_view::npos || pos == frameStr.length() - 1)
+        return false;
 
-            std::vector<std::string> headerSplits;
-            boost::split(headerSplits, header, [](char c) { return c == ',' || c == '>';});
+    std::string_view header = frameStr.substr(0, pos); // contains source, dest and path
+    std::string_view body = frameStr.substr(pos + 1);
 
-             //we need at least source and dest to form a valid frame, also headers shall not contain empty strings
-            if(headerSplits.size() >= 2 && std::none_of(headerSplits.begin(), headerSplits.end(), [](std::string s){ return s.empty(); })) {
-                frame.getSource().assign(headerSplits[0]);
-                frame.getDestination().assign(headerSplits[1]);
+    // we need at least source and dest to form a valid frame, also headers shall not contain empty strings
+    unsigned int count = 0U;
+    std::string_view::size_type start = 0U;
+    while(true) {
+        auto end = header.find_first_of(",>", start);
+        std::string_view field = header.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        if(field.empty()) {
+            frame.clear();
+            return false;
+        }
 
-                for(unsigned int i = 2; i < headerSplits.size(); i++) {
-                    frame.getPath().push_back(headerSplits[i]);
-                }
+        if(count == 0U)
+            frame.getSource().assign(field);
+        else if(count == 1U)
+            frame.getDestination().assign(field);
+        else
+            frame.getPath().emplace_back(field);
+        count++;
 
-                frame.getBody().assign(body);
+        if(end == std::string_view::npos)
+            break;
+        start = end + 1U;
+    }
 
-                ret = parseInt(frame);
-                if(!ret) {
-                    frame.clear();
-                }
-            }
-        }
+    if(count < 2U) {
+        frame.clear();
+        return false;
+    }
+
+    frame.getType() = parseType(body, frame.getSource());
+    if(frame.getType() == APFT_UNKNOWN) {
+        frame.clear();
+        return false;
     }
 
-    return ret;
+    frame.getBody().assign(body);
+
+    return true;
 }
 
-bool CAPRSParser::parseInt(CAPRSFrame& frame)
+APRS_FRAME_TYPE CAPRSParser::parseType(std::string_view frameBody, std::string_view source)
 {
     APRS_FRAME_TYPE type = APFT_UNKNOWN;
-    unsigned char typeChar = frame.getBody()[0];
-    std::string body(frame.getBody().substr(1));//strip the type char for processing purposes
-    
-    if(body.empty())
-        return false;
+    if(frameBody.length() < 2U)
+        return APFT_UNKNOWN;
+
+    unsigned char typeChar = frameBody[0];
+    std::string_view body = frameBody.substr(1);//strip the type char for processing purposes
 
     switch (typeChar)
     {
         case '!':
             if(body[0] == '!') {
                 // This is ultimeter 200 weather station
-                return false;
+                return APFT_UNKNOWN;
             }
             [[fallthrough]];
         case '=':
         case '/':
         case '@':
             {
-                if(body.length() < 10) return false;//enough chars to have a chance to parse it ?
+                if(body.length() < 10) return APFT_UNKNOWN;//enough chars to have a chance to parse it ?
                 /* Normal or compressed location packet, with or without
                 * timestamp, with or without messaging capability
                 *
@@ -90,7 +107,7 @@ bool CAPRSParser::parseInt(CAPRSFrame& frame)
                 if(valid_sym_table_compressed(posChar)//Compressed format
                     && body.length() >= 13){//we need at least 13 char
                     //icom unsupported, ignore for now
-                    return false;//parse_aprs_compressed(pb, body, body_end);
+                    return APFT_UNKNOWN;//parse_aprs_compressed(pb, body, body_end);
                 }
                 else if(posChar >= '0' && posChar <= '9' //Normal uncompressed format
                         && body.length() >=19){//we need at least 19 chars for it to be valid
@@ -107,16 +124,16 @@ bool CAPRSParser::parseInt(CAPRSFrame& frame)
             break;
         case ':':
             // we have either message or telemetry labels or telemetry EQNS
-            if(body[9] == ':'
+            if(body.length() >= 10 && body[9] == ':'
                 && std::all_of(body.begin(), body.begin() + 9, [](char c){ return c == ' ' || c == '-' || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'); })) {
                 type = APFT_MESSAGE;
 
                 //If reciepient is same as source and we donot have a sequence number at the end of message, Then it is telemetry
-                if(body.find(frame.getSource()) == 0U) {
+                if(body.find(source) == 0U) {
                     auto eqnsPos = body.find("EQNS.");
                     auto parmPos = body.find("PARM.");
                     auto seqNumPos = body.find_last_of('{');
-                    if((eqnsPos == 10U || parmPos == 10U) && seqNumPos == std::string::npos) {
+                    if((eqnsPos == 10U || parmPos == 10U) && seqNumPos == std::string_view::npos) {
                         type = APFT_TELEMETRY;
                     }
                 }
@@ -148,8 +165,7 @@ bool CAPRSParser::parseInt(CAPRSFrame& frame)
             break;
     }
     
-    frame.getType() = type;
-    return type != APFT_UNKNOWN;
+    return type;
 }
 
 bool CAPRSParser::valid_sym_table_compressed(unsigned char c)
@@ -19,17 +19,19 @@
 #pragma once
 
 #include <string>
-#include <boost/algorithm/string.hpp>
+#include <string_view>
 
 #include "APRSFrame.h"
 
 class CAPRSParser
 {
 public:
-    static bool parseFrame(const std::string& frameStr, CAPRSFrame& frame);
+    // Parses straight from the view, the only copies made are into the fields of frame
+    static bool parseFrame(std::string_view frameStr, CAPRSFrame& frame);
+
+    static APRS_FRAME_TYPE parseType(std::string_view body, std::string_view source);
 
 private:
-    static bool parseInt(CAPRSFrame& frame);
     static bool valid_sym_table_compressed(unsigned char c);
     static bool valid_sym_table_uncompressed(unsigned char c);
 };
\ No newline at end of file
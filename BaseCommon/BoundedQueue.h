@@ -0,0 +1,101 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+// Thread safe FIFO that refuses new entries once full, unlike CRingBuffer which overwrites
+template<class T> class CBoundedQueue {
+public:
+	CBoundedQueue(unsigned int depth) :
+	m_depth(depth),
+	m_queue(),
+	m_dropped(0U),
+	m_mutex()
+	{
+	}
+
+	bool push(const T& data)
+	{
+		std::lock_guard locker(m_mutex);
+
+		if (m_queue.size() >= m_depth) {
+			m_dropped++;
+			return false;
+		}
+
+		m_queue.push_back(data);
+
+		return true;
+	}
+
+	bool pop(T& data)
+	{
+		std::lock_guard locker(m_mutex);
+
+		if (m_queue.empty())
+			return false;
+
+		data = m_queue.front();
+		m_queue.pop_front();
+
+		return true;
+	}
+
+	bool peek(T& data)
+	{
+		std::lock_guard locker(m_mutex);
+
+		if (m_queue.empty())
+			return false;
+
+		data = m_queue.front();
+
+		return true;
+	}
+
+	bool empty()
+	{
+		std::lock_guard locker(m_mutex);
+
+		return m_queue.empty();
+	}
+
+	unsigned int size()
+	{
+		std::lock_guard locker(m_mutex);
+
+		return m_queue.size();
+	}
+
+	// Entries refused because the queue was full
+	unsigned int getDropped()
+	{
+		std::lock_guard locker(m_mutex);
+
+		return m_dropped;
+	}
+
+private:
+	unsigned int  m_depth;
+	std::deque<T> m_queue;
+	unsigned int  m_dropped;
+	std::mutex    m_mutex;
+};
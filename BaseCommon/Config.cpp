@@ -229,7 +229,8 @@ bool CConfig::getValue(const std::string &section, const std::string& key, std::
     if(getValue(section, key, valueTemp, 0U, 2048, defaultValue)) {
         for(auto s : allowedValues) {
             if(isSameNoCase(s, valueTemp)) {
-                value = CUtils::ToLower(valueTemp);
+                // Hand back the spelling callers compare against, whatever the case in the file
+                value = s;
                 return true;
             }
         }
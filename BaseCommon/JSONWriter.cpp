@@ -0,0 +1,164 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "JSONWriter.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+CJSONWriter::CJSONWriter() :
+m_buffer(),
+m_first(true),
+m_cachedSecond(0),
+m_cachedTime()
+{
+	m_buffer.reserve(256U);
+	m_cachedTime[0] = '\0';
+}
+
+void CJSONWriter::begin(const char* topLevel)
+{
+	assert(topLevel != nullptr);
+
+	m_buffer.assign("{\"");
+	m_buffer.append(topLevel);
+	m_buffer.append("\":{");
+	m_first = true;
+}
+
+void CJSONWriter::add(const char* key, const std::string& value)
+{
+	appendKey(key);
+	appendEscaped(m_buffer, value.c_str(), value.size());
+	m_buffer.push_back('"');
+}
+
+void CJSONWriter::add(const char* key, const char* value)
+{
+	assert(value != nullptr);
+
+	appendKey(key);
+	appendEscaped(m_buffer, value, ::strlen(value));
+	m_buffer.push_back('"');
+}
+
+void CJSONWriter::add(const char* key, uint64_t value)
+{
+	char number[24U];
+	::snprintf(number, sizeof(number), "%llu", (unsigned long long)value);
+
+	appendKey(key, false);
+	m_buffer.append(number);
+}
+
+void CJSONWriter::addTimestamp(const char* key)
+{
+	time_t second;
+	unsigned int ms;
+
+#if defined(_WIN32) || defined(_WIN64)
+	SYSTEMTIME st;
+	::GetSystemTime(&st);
+
+	::sprintf(m_cachedTime, "%04u-%02u-%02u %02u:%02u:%02u.", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+	second = 0;
+	ms = st.wMilliseconds;
+#else
+	struct timeval now;
+	::gettimeofday(&now, nullptr);
+
+	second = now.tv_sec;
+	ms = (unsigned int)(now.tv_usec / 1000L);
+
+	if (second != m_cachedSecond || m_cachedTime[0] == '\0') {
+		struct tm tm;
+		::gmtime_r(&second, &tm);
+
+		::snprintf(m_cachedTime, sizeof(m_cachedTime), "%04d-%02d-%02d %02d:%02d:%02d.", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+		m_cachedSecond = second;
+	}
+#endif
+
+	appendKey(key);
+	m_buffer.append(m_cachedTime);
+	m_buffer.push_back(char('0' + ms / 100U));
+	m_buffer.push_back(char('0' + (ms / 10U) % 10U));
+	m_buffer.push_back(char('0' + ms % 10U));
+	m_buffer.push_back('"');
+}
+
+const std::string& CJSONWriter::end()
+{
+	m_buffer.append("}}");
+
+	return m_buffer;
+}
+
+void CJSONWriter::appendKey(const char* key, bool quoted)
+{
+	assert(key != nullptr);
+
+	if (!m_first)
+		m_buffer.push_back(',');
+	m_first = false;
+
+	m_buffer.push_back('"');
+	m_buffer.append(key);
+	m_buffer.append(quoted ? "\":\"" : "\":");
+}
+
+void CJSONWriter::appendEscaped(std::string& out, const char* value, std::size_t length)
+{
+	assert(value != nullptr);
+
+	std::size_t start = 0U;
+	for (std::size_t i = 0U; i < length; i++) {
+		unsigned char c = (unsigned char)value[i];
+		if (c >= 0x20U && c != '"' && c != '\\')
+			continue;
+
+		// Flush the run of plain characters in one go
+		out.append(value + start, i - start);
+		start = i + 1U;
+
+		switch (c) {
+			case '"':  out.append("\\\""); break;
+			case '\\': out.append("\\\\"); break;
+			case '\b': out.append("\\b");  break;
+			case '\f': out.append("\\f");  break;
+			case '\n': out.append("\\n");  break;
+			case '\r': out.append("\\r");  break;
+			case '\t': out.append("\\t");  break;
+			default: {
+					char escaped[7U];
+					::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+					out.append(escaped);
+				}
+				break;
+		}
+	}
+
+	out.append(value + start, length - start);
+}
@@ -0,0 +1,52 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+// Streams {"<topLevel>":{"key":"value",...}} events into a reused buffer.
+// The output is byte identical to nlohmann::json::dump() provided keys are added in alphabetical order,
+// which is how nlohmann orders object members.
+class CJSONWriter {
+public:
+	CJSONWriter();
+
+	void begin(const char* topLevel);
+
+	void add(const char* key, const std::string& value);
+	void add(const char* key, const char* value);
+	void add(const char* key, uint64_t value);
+
+	// Same format as CUtils::createTimestamp(), the date and time part is only formatted once per second
+	void addTimestamp(const char* key = "timestamp");
+
+	const std::string& end();
+
+	static void appendEscaped(std::string& out, const char* value, std::size_t length);
+
+private:
+	std::string m_buffer;
+	bool        m_first;
+	time_t      m_cachedSecond;
+	char        m_cachedTime[64U];
+
+	void appendKey(const char* key, bool quoted = true);
+};
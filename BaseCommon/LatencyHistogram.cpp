@@ -0,0 +1,128 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cmath>
+
+#include "LatencyHistogram.h"
+
+CLatencySnapshot::CLatencySnapshot() :
+m_count(0U),
+m_max(0U),
+m_buckets()
+{
+}
+
+uint64_t CLatencySnapshot::getCount() const
+{
+	return m_count;
+}
+
+uint32_t CLatencySnapshot::getMax() const
+{
+	return m_max;
+}
+
+uint32_t CLatencySnapshot::getPercentile(double percentile) const
+{
+	if (m_count == 0U)
+		return 0U;
+
+	uint64_t target = uint64_t(std::ceil(double(m_count) * percentile / 100.0));
+	if (target == 0U)
+		target = 1U;
+
+	uint64_t seen = 0U;
+	for (unsigned int i = 0U; i < LATENCY_BUCKETS; i++) {
+		seen += m_buckets[i];
+		if (seen >= target) {
+			uint32_t bound = getUpperBound(i);
+			return bound < m_max ? bound : m_max;
+		}
+	}
+
+	return m_max;
+}
+
+void CLatencySnapshot::subtract(const CLatencySnapshot& earlier)
+{
+	m_count = 0U;
+
+	unsigned int highest = LATENCY_BUCKETS;
+	for (unsigned int i = 0U; i < LATENCY_BUCKETS; i++) {
+		m_buckets[i] -= earlier.m_buckets[i];
+		m_count += m_buckets[i];
+		if (m_buckets[i] > 0U)
+			highest = i;
+	}
+
+	if (highest == LATENCY_BUCKETS)
+		m_max = 0U;
+	else if (getUpperBound(highest) < m_max)
+		m_max = getUpperBound(highest);
+}
+
+unsigned int CLatencySnapshot::getBucket(uint32_t value)
+{
+	if (value < LATENCY_SUB_BUCKETS)
+		return value;
+
+#if defined(__GNUC__)
+	unsigned int exponent = 31U - (unsigned int)__builtin_clz(value);
+#else
+	unsigned int exponent = 0U;
+	while ((value >> (exponent + 1U)) != 0U)
+		exponent++;
+#endif
+	unsigned int shift = exponent - LATENCY_SUB_BITS;
+
+	return (shift + 1U) * LATENCY_SUB_BUCKETS + ((value >> shift) & (LATENCY_SUB_BUCKETS - 1U));
+}
+
+uint32_t CLatencySnapshot::getUpperBound(unsigned int bucket)
+{
+	assert(bucket < LATENCY_BUCKETS);
+
+	if (bucket < LATENCY_SUB_BUCKETS)
+		return bucket;
+
+	unsigned int shift = bucket / LATENCY_SUB_BUCKETS - 1U;
+	uint64_t lower = uint64_t(LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) << shift;
+
+	return uint32_t(lower + (uint64_t(1U) << shift) - 1U);
+}
+
+CLatencyHistogram::CLatencyHistogram() :
+m_max(0U),
+m_buckets()
+{
+	for (unsigned int i = 0U; i < LATENCY_BUCKETS; i++)
+		m_buckets[i].store(0U, std::memory_order_relaxed);
+}
+
+void CLatencyHistogram::snapshot(CLatencySnapshot& snapshot) const
+{
+	// The count comes from the buckets so that it always matches them
+	snapshot.m_count = 0U;
+	for (unsigned int i = 0U; i < LATENCY_BUCKETS; i++) {
+		snapshot.m_buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+		snapshot.m_count += snapshot.m_buckets[i];
+	}
+
+	snapshot.m_max = m_max.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,80 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Log-linear buckets: exact below 8, then 8 buckets per power of two, so a value is never more
+// than 12.5% away from the bucket it is reported as. 240 buckets cover the whole 32 bit range.
+const unsigned int LATENCY_SUB_BITS    = 3U;
+const unsigned int LATENCY_SUB_BUCKETS = 1U << LATENCY_SUB_BITS;
+const unsigned int LATENCY_BUCKETS     = (32U - LATENCY_SUB_BITS + 1U) * LATENCY_SUB_BUCKETS;
+
+// A plain copy of a histogram, taken off the hot path to be reported.
+class CLatencySnapshot {
+public:
+	CLatencySnapshot();
+
+	uint64_t getCount() const;
+	uint32_t getMax() const;
+
+	// The upper bound of the bucket holding the percentile, never more than the largest value seen
+	uint32_t getPercentile(double percentile) const;
+
+	// Leaves what was recorded since the earlier snapshot. The maximum cannot be taken apart
+	// so it becomes the top of the highest bucket still in use, capped by the overall maximum.
+	void subtract(const CLatencySnapshot& earlier);
+
+	static unsigned int getBucket(uint32_t value);
+	static uint32_t     getUpperBound(unsigned int bucket);
+
+private:
+	friend class CLatencyHistogram;
+
+	uint64_t m_count;
+	uint32_t m_max;
+	uint32_t m_buckets[LATENCY_BUCKETS];
+};
+
+// Lock free, any number of threads may record while another takes snapshots. Values are in
+// whatever unit the caller picks and are never reset, readers keep the previous snapshot
+// and subtract it to get an interval.
+class CLatencyHistogram {
+public:
+	CLatencyHistogram();
+
+	CLatencyHistogram(const CLatencyHistogram&) = delete;
+	CLatencyHistogram& operator=(const CLatencyHistogram&) = delete;
+
+	void record(uint32_t value)
+	{
+		m_buckets[CLatencySnapshot::getBucket(value)].fetch_add(1U, std::memory_order_relaxed);
+
+		uint32_t max = m_max.load(std::memory_order_relaxed);
+		while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+			;
+	}
+
+	void snapshot(CLatencySnapshot& snapshot) const;
+
+private:
+	std::atomic<uint32_t> m_max;
+	std::atomic<uint32_t> m_buckets[LATENCY_BUCKETS];
+};
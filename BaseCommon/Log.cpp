@@ -18,9 +18,7 @@
 
 #include "Log.h"
 #include "MQTTConnection.h"
-#include "Utils.h"
-
-#include <nlohmann/json.hpp>
+#include "JSONWriter.h"
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <Windows.h>
@@ -97,74 +95,102 @@ void Log(unsigned int level, const char* fmt, ...)
 		exit(1);
 }
 
-static void WriteJSON(const std::string& topLevel, nlohmann::json& json)
-{
-	if (m_mqtt != nullptr) {
-		nlohmann::json top;
-
-		top[topLevel] = json;
-
-		m_mqtt->publish("json", top.dump());
-	}
-}
+// One reused buffer per thread, events are written straight into it
+static thread_local CJSONWriter m_json;
 
 void writeJSONStatus(const std::string& status)
 {
-	nlohmann::json json;
+	if (m_mqtt == nullptr)
+		return;
 
-	json["timestamp"] = CUtils::createTimestamp();
-	json["message"]   = status;
+	m_json.begin("status");
+	m_json.add("message", status);
+	m_json.addTimestamp();
 
-	WriteJSON("status", json);
+	m_mqtt->publish("json", m_json.end());
 }
 
 void writeJSONLinking(const std::string& repeater, const std::string& reason, const std::string& protocol, const std::string& reflector)
 {
-	nlohmann::json json;
-
-	json["timestamp"] = CUtils::createTimestamp();
-	json["repeater"]  = repeater;
-	json["action"]    = "linking";
-	json["reason"]    = reason;
-	json["reflector"] = reflector;
-	json["protocol"]  = protocol;
-
-	WriteJSON("link", json);
+	if (m_mqtt == nullptr)
+		return;
+
+	m_json.begin("link");
+	m_json.add("action", "linking");
+	m_json.add("protocol", protocol);
+	m_json.add("reason", reason);
+	m_json.add("reflector", reflector);
+	m_json.add("repeater", repeater);
+	m_json.addTimestamp();
+
+	m_mqtt->publish("json", m_json.end());
 }
 
 void writeJSONUnlinked(const std::string& repeater, const std::string& reason)
 {
-	nlohmann::json json;
+	if (m_mqtt == nullptr)
+		return;
 
-	json["timestamp"] = CUtils::createTimestamp();
-	json["repeater"]  = repeater;
-	json["action"]    = "unlinked";
-	json["reason"]    = reason;
+	m_json.begin("link");
+	m_json.add("action", "unlinked");
+	m_json.add("reason", reason);
+	m_json.add("repeater", repeater);
+	m_json.addTimestamp();
 
-	WriteJSON("link", json);
+	m_mqtt->publish("json", m_json.end());
 }
 
 void writeJSONFailed(const std::string& repeater)
 {
-	nlohmann::json json;
+	if (m_mqtt == nullptr)
+		return;
 
-	json["timestamp"] = CUtils::createTimestamp();
-	json["repeater"]  = repeater;
-	json["action"]    = "failed";
+	m_json.begin("link");
+	m_json.add("action", "failed");
+	m_json.add("repeater", repeater);
+	m_json.addTimestamp();
 
-	WriteJSON("link", json);
+	m_mqtt->publish("json", m_json.end());
 }
 
 void writeJSONRelinking(const std::string& repeater, const std::string& protocol, const std::string& reflector)
 {
-	nlohmann::json json;
+	if (m_mqtt == nullptr)
+		return;
+
+	m_json.begin("link");
+	m_json.add("action", "relinking");
+	m_json.add("protocol", protocol);
+	m_json.add("reflector", reflector);
+	m_json.add("repeater", repeater);
+	m_json.addTimestamp();
 
-	json["timestamp"] = CUtils::createTimestamp();
-	json["repeater"]  = repeater;
-	json["action"]    = "relinking";
-	json["reflector"] = reflector;
-	json["protocol"]  = protocol;
+	m_mqtt->publish("json", m_json.end());
+}
 
-	WriteJSON("link", json);
+void writeJSONStream(const std::string& repeater, const std::string& protocol, const std::string& reflector, uint64_t frames, uint64_t lost, uint64_t outOfOrder, uint64_t duplicates, unsigned int jitter)
+{
+	if (m_mqtt == nullptr)
+		return;
+
+	m_json.begin("stream");
+	m_json.add("duplicates", duplicates);
+	m_json.add("frames", frames);
+	m_json.add("jitter_us", uint64_t(jitter));
+	m_json.add("lost", lost);
+	m_json.add("out_of_order", outOfOrder);
+	m_json.add("protocol", protocol);
+	m_json.add("reflector", reflector);
+	m_json.add("repeater", repeater);
+	m_json.addTimestamp();
+
+	m_mqtt->publish("json", m_json.end());
 }
 
+void writeJSON(const std::string& json)
+{
+	if (m_mqtt == nullptr)
+		return;
+
+	m_mqtt->publish("json", json);
+}
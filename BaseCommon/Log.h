@@ -19,6 +19,7 @@
 #if !defined(LOG_H)
 #define	LOG_H
 
+#include <cstdint>
 #include <string>
 
 #define	LogDebug(fmt, ...)	Log(1U, fmt, ##__VA_ARGS__)
@@ -38,5 +39,8 @@ extern void writeJSONLinking(const std::string& repeater, const std::string& rea
 extern void writeJSONUnlinked(const std::string& reason, const std::string& repeater);
 extern void writeJSONFailed(const std::string& repeater);
 extern void writeJSONRelinking(const std::string& repeater, const std::string& protocol, const std::string& reflector);
+extern void writeJSONStream(const std::string& repeater, const std::string& protocol, const std::string& reflector, uint64_t frames, uint64_t lost, uint64_t outOfOrder, uint64_t duplicates, unsigned int jitter);
+// For events built by the caller with their own CJSONWriter
+extern void writeJSON(const std::string& json);
 
 #endif
@@ -17,12 +17,17 @@
  */
 
 #include "MQTTConnection.h"
+#include "Thread.h"
 
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
 
+const unsigned int MQTT_BATCH_SIZE = 20U;
+const unsigned int MQTT_WAIT_MS    = 100U;
+
 CMQTTConnection::CMQTTConnection(const std::string& host, unsigned short port, const std::string& name, const bool authEnabled, const std::string& username, const std::string& password, const std::vector<std::pair<std::string, void (*)(const unsigned char*, unsigned int)>>& subs, unsigned int keepalive, MQTT_QOS qos) :
 m_host(host),
 m_port(port),
@@ -34,7 +39,10 @@ m_subs(subs),
 m_keepalive(keepalive),
 m_qos(qos),
 m_mosq(nullptr),
-m_connected(false)
+m_connected(false),
+m_queue(),
+m_publisher(),
+m_stopPublisher(false)
 {
 	assert(!host.empty());
 	assert(port > 0U);
@@ -46,6 +54,8 @@ m_connected(false)
 
 CMQTTConnection::~CMQTTConnection()
 {
+	stopPublisher();
+
 	::mosquitto_lib_cleanup();
 }
 
@@ -87,6 +97,8 @@ bool CMQTTConnection::open()
 		return false;
 	}
 
+	startPublisher();
+
 	return true;
 }
 
@@ -110,24 +122,97 @@ bool CMQTTConnection::publish(const char* topic, const unsigned char* data, unsi
 	assert(topic != nullptr);
 	assert(data != nullptr);
 
-	if (!m_connected)
-		return false;
+	return m_queue.push(topic, data, len);
+}
 
-	if (::strchr(topic, '/') == nullptr) {
-		char topicEx[100U];
-		::sprintf(topicEx, "%s/%s", m_name.c_str(), topic);
+void CMQTTConnection::setTopicPolicy(const std::string& topic, MQTT_QUEUE_POLICY policy, unsigned int depth)
+{
+	m_queue.setPolicy(topic, policy, depth);
+}
+
+TMQTTQueueStats CMQTTConnection::getStats()
+{
+	return m_queue.getStats();
+}
+
+TMQTTQueueStats CMQTTConnection::getStats(const std::string& topic)
+{
+	return m_queue.getStats(topic);
+}
+
+void CMQTTConnection::startPublisher()
+{
+	if (m_publisher.joinable())
+		return;
+
+	m_stopPublisher = false;
+	m_publisher = std::thread(&CMQTTConnection::publisher, this);
+}
+
+void CMQTTConnection::stopPublisher()
+{
+	if (!m_publisher.joinable())
+		return;
+
+	m_stopPublisher = true;
+	m_queue.wakeUp();
+	m_publisher.join();
 
-		int rc = ::mosquitto_publish(m_mosq, nullptr, topicEx, len, data, static_cast<int>(m_qos), false);
-		if (rc != MOSQ_ERR_SUCCESS) {
-			::fprintf(stderr, "MQTT Error publishing: %s\n", ::mosquitto_strerror(rc));
-			return false;
+	TMQTTQueueStats stats = m_queue.getStats();
+	if (stats.dropped > 0ULL || stats.failed > 0ULL)
+		::fprintf(stderr, "MQTT: %llu messages queued, %llu published, %llu dropped, %llu coalesced, %llu failed\n", stats.queued, stats.published, stats.dropped, stats.coalesced, stats.failed);
+}
+
+void CMQTTConnection::setConnected(bool connected)
+{
+	m_connected = connected;
+}
+
+void CMQTTConnection::publisher()
+{
+	CThread::configure("MQTT");
+
+	std::vector<CMQTTQueuedMessage> batch;
+	batch.reserve(MQTT_BATCH_SIZE);
+
+	for (;;) {
+		bool stop = m_stopPublisher;
+
+		// While the broker is away the backlog stays in the bounded queues
+		if (!m_connected) {
+			if (stop)
+				break;
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(MQTT_WAIT_MS));
+			continue;
 		}
-	} else {
-		int rc = ::mosquitto_publish(m_mosq, nullptr, topic, len, data, static_cast<int>(m_qos), false);
-		if (rc != MOSQ_ERR_SUCCESS) {
-			::fprintf(stderr, "MQTT Error publishing: %s\n", ::mosquitto_strerror(rc));
-			return false;
+
+		batch.clear();
+		if (m_queue.pop(batch, MQTT_BATCH_SIZE, stop ? 0U : MQTT_WAIT_MS) == 0U) {
+			if (stop)
+				break;
+
+			continue;
 		}
+
+		for (const auto& message : batch)
+			m_queue.published(message.m_topic, deliver(message.m_topic, message.m_payload));
+	}
+}
+
+bool CMQTTConnection::deliver(const std::string& topic, const std::string& payload)
+{
+	int rc;
+	if (topic.find('/') == std::string::npos) {
+		std::string topicEx = m_name + "/" + topic;
+		rc = ::mosquitto_publish(m_mosq, nullptr, topicEx.c_str(), (int)payload.size(), payload.data(), static_cast<int>(m_qos), false);
+	} else {
+		rc = ::mosquitto_publish(m_mosq, nullptr, topic.c_str(), (int)payload.size(), payload.data(), static_cast<int>(m_qos), false);
+	}
+
+	if (rc != MOSQ_ERR_SUCCESS) {
+		::fprintf(stderr, "MQTT Error publishing: %s\n", ::mosquitto_strerror(rc));
+		return false;
 	}
 
 	return true;
@@ -135,6 +220,8 @@ bool CMQTTConnection::publish(const char* topic, const unsigned char* data, unsi
 
 void CMQTTConnection::close()
 {
+	stopPublisher();
+
 	if (m_mosq != nullptr) {
 		::mosquitto_disconnect(m_mosq);
 		::mosquitto_destroy(m_mosq);
@@ -21,6 +21,10 @@
 
 #include <mosquitto.h>
 
+#include "MQTTPublishQueue.h"
+
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -33,16 +37,28 @@ enum class MQTT_QOS : int {
 class CMQTTConnection {
 public:
 	CMQTTConnection(const std::string& host, unsigned short port, const std::string& name, const bool authEnabled, const std::string& username, const std::string& password, const std::vector<std::pair<std::string, void (*)(const unsigned char*, unsigned int)>>& subs, unsigned int keepalive, MQTT_QOS qos = MQTT_QOS::EXACTLY_ONCE);
-	~CMQTTConnection();
+	virtual ~CMQTTConnection();
 
 	bool open();
 
+	// Publishing only queues the message, the publisher thread hands it to the broker
 	bool publish(const char* topic, const char* text);
 	bool publish(const char* topic, const std::string& text);
 	bool publish(const char* topic, const unsigned char* data, unsigned int len);
 
+	void setTopicPolicy(const std::string& topic, MQTT_QUEUE_POLICY policy, unsigned int depth);
+	TMQTTQueueStats getStats();
+	TMQTTQueueStats getStats(const std::string& topic);
+
 	void close();
 
+protected:
+	void startPublisher();
+	void stopPublisher();
+	void setConnected(bool connected);
+
+	virtual bool deliver(const std::string& topic, const std::string& payload);
+
 private:
 	std::string    m_host;
 	unsigned short m_port;
@@ -54,7 +70,12 @@ private:
 	unsigned int   m_keepalive;
 	MQTT_QOS       m_qos;
 	mosquitto*     m_mosq;
-	bool           m_connected;
+	std::atomic<bool> m_connected;
+	CMQTTPublishQueue m_queue;
+	std::thread    m_publisher;
+	std::atomic<bool> m_stopPublisher;
+
+	void publisher();
 
 	static void onConnect(mosquitto* mosq, void* obj, int rc);
 	static void onSubscribe(mosquitto* mosq, void* obj, int mid, int qosCount, const int* grantedQOS);
@@ -0,0 +1,178 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <chrono>
+
+#include "MQTTPublishQueue.h"
+
+CMQTTPublishQueue::CMQTTPublishQueue(unsigned int defaultDepth, MQTT_QUEUE_POLICY defaultPolicy) :
+m_defaultDepth(defaultDepth),
+m_defaultPolicy(defaultPolicy),
+m_topics(),
+m_seq(0ULL),
+m_size(0U),
+m_wakeUp(false),
+m_mutex(),
+m_available()
+{
+	assert(defaultDepth > 0U);
+}
+
+void CMQTTPublishQueue::setPolicy(const std::string& topic, MQTT_QUEUE_POLICY policy, unsigned int depth)
+{
+	assert(depth > 0U);
+
+	std::lock_guard lock(m_mutex);
+
+	CMQTTTopicQueue& queue = getTopic(topic);
+	queue.m_policy = policy;
+	queue.m_depth  = policy == MQTT_QUEUE_POLICY::COALESCE ? 1U : depth;
+
+	while (queue.m_entries.size() > queue.m_depth) {
+		queue.m_entries.pop_front();
+		queue.m_stats.dropped++;
+		m_size--;
+	}
+}
+
+bool CMQTTPublishQueue::push(const std::string& topic, const unsigned char* data, unsigned int len)
+{
+	assert(data != nullptr);
+
+	std::lock_guard lock(m_mutex);
+
+	CMQTTTopicQueue& queue = getTopic(topic);
+
+	if (queue.m_entries.size() >= queue.m_depth) {
+		switch (queue.m_policy) {
+			case MQTT_QUEUE_POLICY::COALESCE:
+				// Refresh the pending message in place, it keeps its turn
+				queue.m_entries.back().m_payload.assign((const char*)data, len);
+				queue.m_stats.coalesced++;
+				return true;
+			case MQTT_QUEUE_POLICY::DROP_NEWEST:
+				queue.m_stats.dropped++;
+				return false;
+			case MQTT_QUEUE_POLICY::DROP_OLDEST:
+			default:
+				queue.m_entries.pop_front();
+				queue.m_stats.dropped++;
+				m_size--;
+				break;
+		}
+	}
+
+	queue.m_entries.push_back({ m_seq++, std::string((const char*)data, len) });
+	queue.m_stats.queued++;
+	m_size++;
+
+	m_available.notify_one();
+
+	return true;
+}
+
+unsigned int CMQTTPublishQueue::pop(std::vector<CMQTTQueuedMessage>& batch, unsigned int max, unsigned int waitMs)
+{
+	std::unique_lock lock(m_mutex);
+
+	m_available.wait_for(lock, std::chrono::milliseconds(waitMs), [this] { return m_size > 0U || m_wakeUp; });
+	m_wakeUp = false;
+
+	unsigned int count = 0U;
+	while (count < max && m_size > 0U) {
+		// Topics are few, a linear scan for the oldest head keeps the global order
+		std::unordered_map<std::string, CMQTTTopicQueue>::iterator oldest = m_topics.end();
+		for (auto it = m_topics.begin(); it != m_topics.end(); ++it) {
+			if (!it->second.m_entries.empty() && (oldest == m_topics.end() || it->second.m_entries.front().m_seq < oldest->second.m_entries.front().m_seq))
+				oldest = it;
+		}
+
+		assert(oldest != m_topics.end());
+
+		batch.push_back({ oldest->first, std::move(oldest->second.m_entries.front().m_payload) });
+		oldest->second.m_entries.pop_front();
+		m_size--;
+		count++;
+	}
+
+	return count;
+}
+
+void CMQTTPublishQueue::published(const std::string& topic, bool success)
+{
+	std::lock_guard lock(m_mutex);
+
+	CMQTTTopicQueue& queue = getTopic(topic);
+	if (success)
+		queue.m_stats.published++;
+	else
+		queue.m_stats.failed++;
+}
+
+unsigned int CMQTTPublishQueue::size()
+{
+	std::lock_guard lock(m_mutex);
+
+	return m_size;
+}
+
+void CMQTTPublishQueue::wakeUp()
+{
+	std::lock_guard lock(m_mutex);
+
+	m_wakeUp = true;
+	m_available.notify_all();
+}
+
+TMQTTQueueStats CMQTTPublishQueue::getStats()
+{
+	std::lock_guard lock(m_mutex);
+
+	TMQTTQueueStats total = { 0ULL, 0ULL, 0ULL, 0ULL, 0ULL };
+	for (const auto& topic : m_topics) {
+		total.queued    += topic.second.m_stats.queued;
+		total.published += topic.second.m_stats.published;
+		total.dropped   += topic.second.m_stats.dropped;
+		total.coalesced += topic.second.m_stats.coalesced;
+		total.failed    += topic.second.m_stats.failed;
+	}
+
+	return total;
+}
+
+TMQTTQueueStats CMQTTPublishQueue::getStats(const std::string& topic)
+{
+	std::lock_guard lock(m_mutex);
+
+	return getTopic(topic).m_stats;
+}
+
+CMQTTPublishQueue::CMQTTTopicQueue& CMQTTPublishQueue::getTopic(const std::string& topic)
+{
+	auto it = m_topics.find(topic);
+	if (it != m_topics.end())
+		return it->second;
+
+	CMQTTTopicQueue& queue = m_topics[topic];
+	queue.m_policy = m_defaultPolicy;
+	queue.m_depth  = m_defaultPolicy == MQTT_QUEUE_POLICY::COALESCE ? 1U : m_defaultDepth;
+	queue.m_stats  = { 0ULL, 0ULL, 0ULL, 0ULL, 0ULL };
+
+	return queue;
+}
@@ -0,0 +1,92 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class MQTT_QUEUE_POLICY {
+	DROP_OLDEST,	// a full queue discards its oldest message to make room
+	DROP_NEWEST,	// a full queue refuses the new message
+	COALESCE		// only the latest pending message is kept, for status type topics
+};
+
+struct CMQTTQueuedMessage {
+	std::string m_topic;
+	std::string m_payload;
+};
+
+struct TMQTTQueueStats {
+	unsigned long long queued;
+	unsigned long long published;
+	unsigned long long dropped;
+	unsigned long long coalesced;
+	unsigned long long failed;
+};
+
+// Bounded per topic publish queues, filled by any thread and drained in batches by the MQTT publisher thread.
+// Messages of all topics are handed out in the order they were first queued.
+class CMQTTPublishQueue {
+public:
+	CMQTTPublishQueue(unsigned int defaultDepth = 100U, MQTT_QUEUE_POLICY defaultPolicy = MQTT_QUEUE_POLICY::DROP_OLDEST);
+
+	void setPolicy(const std::string& topic, MQTT_QUEUE_POLICY policy, unsigned int depth);
+
+	// Never blocks, returns false when the message had to be dropped
+	bool push(const std::string& topic, const unsigned char* data, unsigned int len);
+
+	// Waits up to waitMs for messages, then moves at most max of them into batch
+	unsigned int pop(std::vector<CMQTTQueuedMessage>& batch, unsigned int max, unsigned int waitMs);
+
+	void published(const std::string& topic, bool success);
+
+	unsigned int size();
+	void wakeUp();
+
+	TMQTTQueueStats getStats();
+	TMQTTQueueStats getStats(const std::string& topic);
+
+private:
+	struct CMQTTQueueEntry {
+		unsigned long long m_seq;
+		std::string m_payload;
+	};
+
+	struct CMQTTTopicQueue {
+		MQTT_QUEUE_POLICY m_policy;
+		unsigned int m_depth;
+		std::deque<CMQTTQueueEntry> m_entries;
+		TMQTTQueueStats m_stats;
+	};
+
+	unsigned int m_defaultDepth;
+	MQTT_QUEUE_POLICY m_defaultPolicy;
+	std::unordered_map<std::string, CMQTTTopicQueue> m_topics;
+	unsigned long long m_seq;
+	unsigned int m_size;
+	bool m_wakeUp;
+	std::mutex m_mutex;
+	std::condition_variable m_available;
+
+	CMQTTTopicQueue& getTopic(const std::string& topic);
+};
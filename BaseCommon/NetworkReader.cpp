@@ -0,0 +1,290 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "NetworkReader.h"
+#include "Log.h"
+
+// How often a socket whose queue is full is looked at again
+const int NETWORK_FULL_RETRY_MS = 1;
+
+CNetworkReader::CNetworkReader() :
+CThread("Network"),
+m_mutex(),
+m_sockets(),
+m_controlFds(),
+m_dataFds(),
+m_started(false),
+m_stopped(false)
+{
+	for (unsigned int i = 0U; i < 2U; i++) {
+		m_controlFds[i] = -1;
+		m_dataFds[i]    = -1;
+	}
+}
+
+CNetworkReader::~CNetworkReader()
+{
+	for (unsigned int i = 0U; i < 2U; i++) {
+		if (m_controlFds[i] >= 0)
+			::close(m_controlFds[i]);
+		if (m_dataFds[i] >= 0)
+			::close(m_dataFds[i]);
+	}
+}
+
+bool CNetworkReader::start()
+{
+	if (::pipe(m_controlFds) < 0 || ::pipe(m_dataFds) < 0) {
+		LogError("Cannot create the network reader pipes, err=%d", errno);
+		return false;
+	}
+
+	for (unsigned int i = 0U; i < 2U; i++) {
+		::fcntl(m_controlFds[i], F_SETFL, ::fcntl(m_controlFds[i], F_GETFL, 0) | O_NONBLOCK);
+		::fcntl(m_dataFds[i], F_SETFL, ::fcntl(m_dataFds[i], F_GETFL, 0) | O_NONBLOCK);
+	}
+
+	m_stopped = false;
+	m_started = true;
+
+	Create();
+	Run();
+
+	return true;
+}
+
+void CNetworkReader::add(int fd, CNetworkQueue* queue)
+{
+	assert(fd >= 0);
+	assert(queue != nullptr);
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_sockets.push_back(SNetworkSocket{ fd, queue });
+	}
+
+	wake();
+}
+
+void CNetworkReader::remove(int fd)
+{
+	// The thread holds the lock while it receives, once we have it the socket is no longer in use
+	std::lock_guard lock(m_mutex);
+	m_sockets.erase(std::remove_if(m_sockets.begin(), m_sockets.end(), [fd](const SNetworkSocket& socket) { return socket.fd == fd; }), m_sockets.end());
+}
+
+bool CNetworkReader::wait(unsigned int timeoutMs)
+{
+	if (m_dataFds[0] < 0)
+		return false;
+
+	pollfd fds = { m_dataFds[0], POLLIN, 0 };
+
+	int ret = ::poll(&fds, 1U, int(timeoutMs));
+	if (ret <= 0)
+		return false;
+
+	unsigned char buffer[64U];
+	while (::read(m_dataFds[0], buffer, sizeof(buffer)) > 0)
+		;
+
+	return true;
+}
+
+void CNetworkReader::wake()
+{
+	if (m_controlFds[1] < 0)
+		return;
+
+	unsigned char c = 0U;
+	ssize_t ret = ::write(m_controlFds[1], &c, 1U);
+	(void)ret;
+}
+
+void CNetworkReader::stop()
+{
+	if (!m_started)
+		return;
+
+	m_stopped = true;
+	wake();
+
+	Wait();
+
+	m_started = false;
+}
+
+void* CNetworkReader::Entry()
+{
+	LogInfo("Starting the network reader");
+
+	std::vector<pollfd> fds;
+
+	while (!m_stopped) {
+		fds.clear();
+		fds.push_back(pollfd{ m_controlFds[0], POLLIN, 0 });
+
+		bool full = false;
+		{
+			std::lock_guard lock(m_mutex);
+
+			for (const SNetworkSocket& socket : m_sockets) {
+				// Leave the data in the kernel until the consumer has made room for it
+				if (socket.queue->writable() == 0U)
+					full = true;
+				else
+					fds.push_back(pollfd{ socket.fd, POLLIN, 0 });
+			}
+		}
+
+		int ret = ::poll(fds.data(), fds.size(), full ? NETWORK_FULL_RETRY_MS : -1);
+		if (ret < 0 && errno != EINTR) {
+			LogError("Error returned from the network reader poll, err=%d", errno);
+			Sleep(NETWORK_FULL_RETRY_MS);
+			continue;
+		}
+
+		if ((fds[0U].revents & POLLIN) != 0) {
+			unsigned char buffer[16U];
+			while (::read(m_controlFds[0], buffer, sizeof(buffer)) > 0)
+				;
+		}
+
+		unsigned int count = 0U;
+		{
+			std::lock_guard lock(m_mutex);
+
+			for (unsigned int i = 1U; i < fds.size(); i++) {
+				if ((fds[i].revents & POLLIN) == 0)
+					continue;
+
+				// The socket may have gone while we were polling
+				auto it = std::find_if(m_sockets.begin(), m_sockets.end(), [&fds, i](const SNetworkSocket& socket) { return socket.fd == fds[i].fd; });
+				if (it != m_sockets.end())
+					count += receive(it->fd, it->queue);
+			}
+		}
+
+		if (count > 0U) {
+			unsigned char c = 0U;
+			ssize_t n = ::write(m_dataFds[1], &c, 1U);
+			(void)n;
+		}
+	}
+
+	LogInfo("Stopping the network reader");
+
+	return NULL;
+}
+
+unsigned int CNetworkReader::receive(int fd, CNetworkQueue* queue)
+{
+	assert(queue != nullptr);
+
+	unsigned int count = 0U;
+
+	for (;;) {
+		unsigned int n = std::min(queue->writable(), NETWORK_BATCH_LENGTH);
+		if (n == 0U)
+			return count;
+
+#if defined(__linux__)
+		struct iovec iov[NETWORK_BATCH_LENGTH];
+		struct mmsghdr msgs[NETWORK_BATCH_LENGTH];
+		::memset(msgs, 0, sizeof(msgs));
+
+		for (unsigned int i = 0U; i < n; i++) {
+			SNetworkPacket* packet = queue->writeSlot(i);
+			iov[i].iov_base = packet->data;
+			iov[i].iov_len  = NETWORK_PACKET_LENGTH;
+			msgs[i].msg_hdr.msg_name    = &packet->addr;
+			msgs[i].msg_hdr.msg_namelen = sizeof(packet->addr);
+			msgs[i].msg_hdr.msg_iov     = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1U;
+		}
+
+		int ret = ::recvmmsg(fd, msgs, n, MSG_DONTWAIT, NULL);
+		if (ret <= 0)
+			return count;
+
+		unsigned int kept = 0U;
+		for (int i = 0; i < ret; i++) {
+			if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+				LogWarning("Dropping a datagram longer than %u bytes on fd %d", NETWORK_PACKET_LENGTH, fd);
+				continue;
+			}
+
+			// Close the gap left by a dropped datagram
+			SNetworkPacket* packet = queue->writeSlot(kept);
+			if (kept != (unsigned int)i)
+				*packet = *queue->writeSlot(i);
+
+			packet->length = msgs[i].msg_len;
+			kept++;
+		}
+#else
+		int ret = 0;
+		unsigned int kept = 0U;
+		for (unsigned int i = 0U; i < n; i++) {
+			SNetworkPacket* packet = queue->writeSlot(kept);
+
+			struct iovec iov;
+			iov.iov_base = packet->data;
+			iov.iov_len  = NETWORK_PACKET_LENGTH;
+
+			struct msghdr msg;
+			::memset(&msg, 0, sizeof(msg));
+			msg.msg_name    = &packet->addr;
+			msg.msg_namelen = sizeof(packet->addr);
+			msg.msg_iov     = &iov;
+			msg.msg_iovlen  = 1U;
+
+			ssize_t len = ::recvmsg(fd, &msg, MSG_DONTWAIT);
+			if (len < 0)
+				break;
+
+			ret++;
+
+			if ((msg.msg_flags & MSG_TRUNC) != 0) {
+				LogWarning("Dropping a datagram longer than %u bytes on fd %d", NETWORK_PACKET_LENGTH, fd);
+				continue;
+			}
+
+			packet->length = len;
+			kept++;
+		}
+
+		if (ret == 0)
+			return count;
+#endif
+
+		queue->commit(kept);
+		count += kept;
+
+		if (ret < int(n))
+			return count;
+	}
+}
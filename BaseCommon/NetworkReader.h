@@ -0,0 +1,75 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <sys/socket.h>
+
+#include "SPSCQueue.h"
+#include "Thread.h"
+
+const unsigned int NETWORK_PACKET_LENGTH = 2048U;
+const unsigned int NETWORK_QUEUE_LENGTH  = 64U;
+const unsigned int NETWORK_BATCH_LENGTH  = 16U;
+
+struct SNetworkPacket {
+	struct sockaddr_storage addr;
+	unsigned int            length;
+	unsigned char           data[NETWORK_PACKET_LENGTH];
+};
+
+typedef CSPSCQueue<SNetworkPacket> CNetworkQueue;
+
+// One thread receives for every registered UDP socket. It sleeps in poll() and pulls whole
+// batches of datagrams into each socket's queue, then wakes the consumer, so the thread that
+// owns the sockets no longer has to poll them on a timer.
+class CNetworkReader : public CThread {
+public:
+	CNetworkReader();
+	virtual ~CNetworkReader();
+
+	bool start();
+
+	void add(int fd, CNetworkQueue* queue);
+	void remove(int fd);
+
+	// Block for up to timeoutMs until a datagram has been queued, true if one was
+	bool wait(unsigned int timeoutMs);
+
+	void stop();
+
+	virtual void* Entry();
+
+private:
+	struct SNetworkSocket {
+		int            fd;
+		CNetworkQueue* queue;
+	};
+
+	std::mutex                  m_mutex;
+	std::vector<SNetworkSocket> m_sockets;
+	int                         m_controlFds[2];
+	int                         m_dataFds[2];
+	bool                        m_started;
+	bool                        m_stopped;
+
+	void wake();
+	unsigned int receive(int fd, CNetworkQueue* queue);
+};
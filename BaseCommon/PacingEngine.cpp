@@ -0,0 +1,235 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <cerrno>
+#include <ctime>
+#endif
+
+#include "PacingEngine.h"
+
+CStreamPacer::CStreamPacer(unsigned int periodMs) :
+m_period(periodMs * 1000U),
+m_start(std::chrono::steady_clock::now())
+{
+	assert(periodMs > 0U);
+}
+
+void CStreamPacer::start()
+{
+	m_start = std::chrono::steady_clock::now();
+}
+
+void CStreamPacer::start(const TPacingTime& start)
+{
+	m_start = start;
+}
+
+unsigned int CStreamPacer::getDue() const
+{
+	return getDue(std::chrono::steady_clock::now());
+}
+
+unsigned int CStreamPacer::getDue(const TPacingTime& now) const
+{
+	if (now <= m_start)
+		return 0U;
+
+	return (unsigned int)((now - m_start) / m_period);
+}
+
+TPacingTime CStreamPacer::getDeadline(unsigned int frame) const
+{
+	return m_start + m_period * (frame + 1U);
+}
+
+CJitterHistogram::CJitterHistogram(unsigned int bucketUs, unsigned int buckets) :
+m_bucketUs(bucketUs),
+m_counts(buckets + 1U, 0UL),
+m_total(0UL),
+m_maxUs(0ULL)
+{
+	assert(bucketUs > 0U);
+	assert(buckets > 0U);
+}
+
+void CJitterHistogram::add(const std::chrono::microseconds& lateness)
+{
+	unsigned long long us = lateness.count() > 0 ? (unsigned long long)lateness.count() : 0ULL;
+
+	std::size_t bucket = std::min<std::size_t>(std::size_t(us / m_bucketUs), m_counts.size() - 1U);
+	m_counts[bucket]++;
+	m_total++;
+	m_maxUs = std::max(m_maxUs, us);
+}
+
+void CJitterHistogram::clear()
+{
+	std::fill(m_counts.begin(), m_counts.end(), 0UL);
+	m_total = 0UL;
+	m_maxUs = 0ULL;
+}
+
+unsigned int CJitterHistogram::getBucketWidth() const
+{
+	return m_bucketUs;
+}
+
+unsigned int CJitterHistogram::getBucketCount() const
+{
+	return (unsigned int)m_counts.size();
+}
+
+unsigned long CJitterHistogram::getCount(unsigned int bucket) const
+{
+	assert(bucket < m_counts.size());
+
+	return m_counts[bucket];
+}
+
+unsigned long CJitterHistogram::getTotal() const
+{
+	return m_total;
+}
+
+unsigned long long CJitterHistogram::getMax() const
+{
+	return m_maxUs;
+}
+
+unsigned long long CJitterHistogram::getPercentile(double fraction) const
+{
+	if (m_total == 0UL)
+		return 0ULL;
+
+	unsigned long target = (unsigned long)(fraction * double(m_total) + 0.5);
+	unsigned long count = 0UL;
+	for (std::size_t i = 0U; i < m_counts.size() - 1U; i++) {
+		count += m_counts[i];
+		if (count >= target)
+			return (unsigned long long)(i + 1U) * m_bucketUs;
+	}
+
+	return m_maxUs;
+}
+
+CPacingEngine::CPacingEngine(unsigned int periodMs) :
+m_periodMs(periodMs),
+m_streams(),
+m_nextId(1U),
+m_stopped(false),
+m_jitter()
+{
+}
+
+unsigned int CPacingEngine::add(const TCallback& callback)
+{
+	return add(callback, std::chrono::steady_clock::now());
+}
+
+unsigned int CPacingEngine::add(const TCallback& callback, const TPacingTime& start)
+{
+	TStream stream = { m_nextId++, callback, CStreamPacer(m_periodMs), 0U };
+	stream.m_pacer.start(start);
+
+	m_streams.push_back(stream);
+
+	return stream.m_id;
+}
+
+void CPacingEngine::remove(unsigned int stream)
+{
+	m_streams.erase(std::remove_if(m_streams.begin(), m_streams.end(), [stream](const TStream& s) { return s.m_id == stream; }), m_streams.end());
+}
+
+bool CPacingEngine::hasStreams() const
+{
+	return !m_streams.empty();
+}
+
+bool CPacingEngine::runOnce()
+{
+	if (m_streams.empty())
+		return false;
+
+	TPacingTime next = m_streams.front().m_pacer.getDeadline(m_streams.front().m_frame);
+	for (const auto& stream : m_streams)
+		next = std::min(next, stream.m_pacer.getDeadline(stream.m_frame));
+
+	sleepUntil(next);
+
+	TPacingTime now = std::chrono::steady_clock::now();
+
+	// A late wake up sends everything that is due, the schedule itself never slips
+	for (auto it = m_streams.begin(); it != m_streams.end() && !m_stopped;) {
+		bool active = true;
+		while (active && !m_stopped && it->m_pacer.getDeadline(it->m_frame) <= now) {
+			m_jitter.add(std::chrono::duration_cast<std::chrono::microseconds>(now - it->m_pacer.getDeadline(it->m_frame)));
+			active = it->m_callback(it->m_frame);
+			it->m_frame++;
+		}
+
+		if (active)
+			++it;
+		else
+			it = m_streams.erase(it);
+	}
+
+	return !m_streams.empty();
+}
+
+void CPacingEngine::run()
+{
+	m_stopped = false;
+
+	while (!m_stopped && runOnce())
+		;
+}
+
+void CPacingEngine::stop()
+{
+	m_stopped = true;
+}
+
+const CJitterHistogram& CPacingEngine::getJitter() const
+{
+	return m_jitter;
+}
+
+void CPacingEngine::sleepUntil(const TPacingTime& deadline)
+{
+#if defined(_WIN32) || defined(_WIN64)
+	std::this_thread::sleep_until(deadline);
+#else
+	// steady_clock is CLOCK_MONOTONIC, sleeping to an absolute time cannot accumulate drift
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+	if (ns <= 0)
+		return;
+
+	struct timespec ts;
+	ts.tv_sec  = time_t(ns / 1000000000LL);
+	ts.tv_nsec = long(ns % 1000000000LL);
+
+	while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+		;
+#endif
+}
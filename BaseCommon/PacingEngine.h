@@ -0,0 +1,110 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+typedef std::chrono::steady_clock::time_point TPacingTime;
+
+// Absolute deadlines for one stream of fixed period frames. Frame n is due one period after the
+// previous one, measured from the start, so the schedule never drifts whatever the caller's tick is.
+class CStreamPacer {
+public:
+	CStreamPacer(unsigned int periodMs = 20U);
+
+	void start();
+	void start(const TPacingTime& start);
+
+	// How many frames are due by now, frame n is due at start + (n + 1) * period
+	unsigned int getDue() const;
+	unsigned int getDue(const TPacingTime& now) const;
+
+	TPacingTime getDeadline(unsigned int frame) const;
+
+private:
+	std::chrono::microseconds m_period;
+	TPacingTime               m_start;
+};
+
+// Lateness of frames against their deadline, in fixed width buckets with an overflow bucket
+class CJitterHistogram {
+public:
+	CJitterHistogram(unsigned int bucketUs = 100U, unsigned int buckets = 50U);
+
+	void add(const std::chrono::microseconds& lateness);
+	void clear();
+
+	unsigned int       getBucketWidth() const;
+	unsigned int       getBucketCount() const;
+	unsigned long      getCount(unsigned int bucket) const;
+	unsigned long      getTotal() const;
+	unsigned long long getMax() const;
+
+	// The upper bound of the bucket holding the given fraction of the frames
+	unsigned long long getPercentile(double fraction) const;
+
+private:
+	unsigned int               m_bucketUs;
+	std::vector<unsigned long> m_counts;
+	unsigned long              m_total;
+	unsigned long long         m_maxUs;
+};
+
+// Drives any number of concurrent fixed period streams from one thread. The thread sleeps until the
+// earliest deadline with an absolute timed sleep, then calls every stream that is due. A stream's
+// callback is given the frame number and returns false once it has sent its last frame.
+class CPacingEngine {
+public:
+	typedef std::function<bool(unsigned int frame)> TCallback;
+
+	CPacingEngine(unsigned int periodMs = 20U);
+
+	unsigned int add(const TCallback& callback);
+	unsigned int add(const TCallback& callback, const TPacingTime& start);
+	void remove(unsigned int stream);
+
+	bool hasStreams() const;
+
+	// Sleep until the next deadline and service the streams that are due, false when there are none
+	bool runOnce();
+
+	// Run until all the streams have finished or stop() is called from a callback
+	void run();
+	void stop();
+
+	const CJitterHistogram& getJitter() const;
+
+	static void sleepUntil(const TPacingTime& deadline);
+
+private:
+	struct TStream {
+		unsigned int m_id;
+		TCallback    m_callback;
+		CStreamPacer m_pacer;
+		unsigned int m_frame;
+	};
+
+	unsigned int         m_periodMs;
+	std::vector<TStream> m_streams;
+	unsigned int         m_nextId;
+	bool                 m_stopped;
+	CJitterHistogram     m_jitter;
+};
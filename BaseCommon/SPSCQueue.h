@@ -0,0 +1,124 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+const unsigned int SPSC_CACHE_LINE = 64U;
+
+// Lock free FIFO for exactly one producer thread and one consumer thread. Entries are
+// written in place, the producer fills slots and then commits them, the consumer looks at the
+// front slot and pops it when done, so nothing is copied on the way through.
+template<class T> class CSPSCQueue {
+public:
+	CSPSCQueue(unsigned int capacity) :
+	m_slots(roundUp(capacity)),
+	m_mask(m_slots.size() - 1U),
+	m_head(0U),
+	m_tail(0U)
+	{
+	}
+
+	// Producer side
+	unsigned int writable() const
+	{
+		unsigned int tail = m_tail.load(std::memory_order_relaxed);
+		unsigned int head = m_head.load(std::memory_order_acquire);
+
+		return m_slots.size() - (tail - head);
+	}
+
+	// The n'th free slot, n must be less than writable()
+	T* writeSlot(unsigned int n)
+	{
+		unsigned int tail = m_tail.load(std::memory_order_relaxed);
+
+		return &m_slots[(tail + n) & m_mask];
+	}
+
+	// Make the first count free slots visible to the consumer
+	void commit(unsigned int count)
+	{
+		assert(count <= writable());
+
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+	}
+
+	bool push(const T& data)
+	{
+		if (writable() == 0U)
+			return false;
+
+		*writeSlot(0U) = data;
+		commit(1U);
+
+		return true;
+	}
+
+	// Consumer side, NULL when there is nothing to read
+	T* front()
+	{
+		unsigned int head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return NULL;
+
+		return &m_slots[head & m_mask];
+	}
+
+	void pop()
+	{
+		assert(!isEmpty());
+
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1U, std::memory_order_release);
+	}
+
+	bool isEmpty() const
+	{
+		return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+	}
+
+	unsigned int size() const
+	{
+		return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+	}
+
+	unsigned int capacity() const
+	{
+		return m_slots.size();
+	}
+
+private:
+	std::vector<T> m_slots;
+	unsigned int   m_mask;
+
+	// Each index is only written by one side, keep them apart so they do not share a cache line
+	alignas(SPSC_CACHE_LINE) std::atomic<unsigned int> m_head;
+	alignas(SPSC_CACHE_LINE) std::atomic<unsigned int> m_tail;
+
+	static unsigned int roundUp(unsigned int capacity)
+	{
+		unsigned int size = 1U;
+		while (size < capacity)
+			size <<= 1;
+
+		return size;
+	}
+};
@@ -18,11 +18,23 @@
  */
 
 #include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
 #include "Thread.h"
 #include "Log.h"
 
 using namespace std;
 
+// The kernel keeps 15 characters of a thread name
+const size_t THREAD_NAME_LENGTH = 15U;
+
+std::mutex                             CThread::m_settingsMutex;
+std::map<std::string, TThreadSettings> CThread::m_settings;
+
 CThread::CThread(const std::string& name) :
 m_name(name)
 {
@@ -57,6 +69,80 @@ void CThread::Wait()
 void CThread::EntryRunner(CThread * thread)
 {
     assert(thread != nullptr);
+    configure(thread->m_name);
     thread->Entry();
     LogInfo("Exiting %s thread", thread->m_name.c_str());
 }
+
+void CThread::setSettings(const std::string& name, const TThreadSettings& settings)
+{
+    std::lock_guard lock(m_settingsMutex);
+    m_settings[name] = settings;
+}
+
+void CThread::clearSettings()
+{
+    std::lock_guard lock(m_settingsMutex);
+    m_settings.clear();
+}
+
+void CThread::configure(const std::string& name)
+{
+#if defined(__linux__)
+    pthread_t self = ::pthread_self();
+
+    ::pthread_setname_np(self, name.substr(0U, THREAD_NAME_LENGTH).c_str());
+
+    TThreadSettings settings;
+    {
+        std::lock_guard lock(m_settingsMutex);
+
+        auto it = m_settings.find(name);
+        if (it == m_settings.end())
+            return;
+
+        settings = it->second;
+    }
+
+    if (settings.policy != TP_OTHER) {
+        sched_param param;
+        ::memset(&param, 0, sizeof(sched_param));
+        param.sched_priority = settings.priority;
+
+        int policy = settings.policy == TP_FIFO ? SCHED_FIFO : SCHED_RR;
+        int ret = ::pthread_setschedparam(self, policy, &param);
+        if (ret != 0)
+            LogWarning("Cannot set the real time priority of the %s thread, err: %s", name.c_str(), ::strerror(ret));
+        else
+            LogInfo("The %s thread runs %s at priority %u", name.c_str(), settings.policy == TP_FIFO ? "FIFO" : "round robin", settings.priority);
+    }
+
+    if (!settings.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (unsigned int cpu : settings.cpus)
+            CPU_SET(cpu, &set);
+
+        int ret = ::pthread_setaffinity_np(self, sizeof(cpu_set_t), &set);
+        if (ret != 0)
+            LogWarning("Cannot pin the %s thread to its CPUs, err: %s", name.c_str(), ::strerror(ret));
+    }
+#else
+    (void)name;
+#endif
+}
+
+bool CThread::lockMemory()
+{
+#if defined(__linux__)
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        LogWarning("Cannot lock the process in memory, err: %s", ::strerror(errno));
+        return false;
+    }
+
+    LogInfo("The process is locked in memory");
+    return true;
+#else
+    return false;
+#endif
+}
@@ -22,8 +22,24 @@
 #ifndef	Thread_H
 #define	Thread_H
 
+#include <map>
+#include <mutex>
 #include <thread>
 #include <string>
+#include <vector>
+
+enum THREAD_POLICY {
+    TP_OTHER,
+    TP_FIFO,
+    TP_RR
+};
+
+// How a thread role is scheduled, TP_OTHER with no CPUs leaves it to the kernel
+struct TThreadSettings {
+    THREAD_POLICY             policy;
+    unsigned int              priority;
+    std::vector<unsigned int> cpus;
+};
 
 class CThread {
 public:
@@ -34,6 +50,19 @@ public:
     void Wait();
     void Sleep(unsigned long milli);
 
+    // Settings for every thread that starts under name from now on
+    static void setSettings(const std::string& name, const TThreadSettings& settings);
+
+    // Forget the settings of every role, new threads run with the defaults
+    static void clearSettings();
+
+    // Give the calling thread its kernel visible name and the settings of its role,
+    // for threads that are not started through CThread
+    static void configure(const std::string& name);
+
+    // Keep the whole process in RAM so that voice never waits on a page fault
+    static bool lockMemory();
+
 protected:
     virtual void* Entry() = 0;
 
@@ -42,6 +71,9 @@ private:
 
     std::string m_name;
     std::thread m_thread;
+
+    static std::mutex                             m_settingsMutex;
+    static std::map<std::string, TThreadSettings> m_settings;
 };
 
 #endif
\ No newline at end of file
@@ -17,6 +17,7 @@
  */
 
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <string.h>
 #include "UDPReaderWriter.h"
@@ -27,7 +28,9 @@ CUDPReaderWriter::CUDPReaderWriter(const std::string& address, unsigned int port
 m_address(address),
 m_port(port),
 m_addr(),
-m_fd(-1)
+m_fd(-1),
+m_reader(NULL),
+m_queue(NULL)
 {
 }
 
@@ -35,12 +38,15 @@ CUDPReaderWriter::CUDPReaderWriter() :
 m_address(),
 m_port(0U),
 m_addr(),
-m_fd(-1)
+m_fd(-1),
+m_reader(NULL),
+m_queue(NULL)
 {
 }
 
 CUDPReaderWriter::~CUDPReaderWriter()
 {
+	delete m_queue;
 }
 
 in_addr CUDPReaderWriter::lookup(const std::string& hostname)
@@ -64,7 +70,7 @@ in_addr CUDPReaderWriter::lookup(const std::string& hostname)
 	return addr;
 }
 
-bool CUDPReaderWriter::open()
+bool CUDPReaderWriter::open(CNetworkReader* reader)
 {
 	m_fd = ::socket(PF_INET, SOCK_DGRAM, 0);
 	if (m_fd < 0) {
@@ -99,20 +105,31 @@ bool CUDPReaderWriter::open()
 		}
 	}
 
+	if (reader != NULL) {
+		if (m_queue == NULL)
+			m_queue = new CNetworkQueue(NETWORK_QUEUE_LENGTH);
+
+		m_reader = reader;
+		m_reader->add(m_fd, m_queue);
+	}
+
 	return true;
 }
 
-int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr)
+int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr, unsigned int timeoutMs)
 {
+	if (m_reader != NULL)
+		return readQueue(buffer, length, addr, timeoutMs);
+
 	// Check that the readfrom() won't block
 	fd_set readFds;
 	FD_ZERO(&readFds);
 	FD_SET(m_fd, &readFds);
 
-	// Return immediately
+	// Return immediately unless asked to wait for data
 	timeval tv;
-	tv.tv_sec  = 0L;
-	tv.tv_usec = 0L;
+	tv.tv_sec  = timeoutMs / 1000U;
+	tv.tv_usec = (timeoutMs % 1000U) * 1000U;
 
 	int ret = ::select(m_fd + 1, &readFds, NULL, NULL, &tv);
 	if (ret < 0) {
@@ -134,10 +151,44 @@ int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, struct so
 	return len;
 }
 
-int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port)
+int CUDPReaderWriter::readQueue(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr, unsigned int timeoutMs)
+{
+	SNetworkPacket* packet = m_queue->front();
+
+	// Sleep on the reader until it queues something, for this or another of its sockets
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+	while (packet == NULL) {
+		auto now = std::chrono::steady_clock::now();
+		if (now >= deadline)
+			break;
+
+		m_reader->wait((unsigned int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now + std::chrono::microseconds(999)).count());
+		packet = m_queue->front();
+	}
+
+	if (packet == NULL)
+		return 0;
+
+	if (packet->length == 0U) {
+		m_queue->pop();
+		LogError("Error returned from recvfrom (port: %u), err: empty datagram", m_port);
+		return -1;
+	}
+
+	// Truncate like recvfrom() does when the buffer is too small
+	unsigned int len = packet->length < length ? packet->length : length;
+	::memcpy(buffer, packet->data, len);
+	addr = packet->addr;
+
+	m_queue->pop();
+
+	return len;
+}
+
+int CUDPReaderWriter::read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port, unsigned int timeoutMs)
 {
 	struct sockaddr_storage addr;
-	auto res = read(buffer, length, addr);
+	auto res = read(buffer, length, addr, timeoutMs);
 	
 	if(res >= 0 && addr.ss_family == AF_INET) {
 		address = TOIPV4(addr)->sin_addr;
@@ -174,9 +225,69 @@ bool CUDPReaderWriter::write(const unsigned char* buffer, unsigned int length, c
 }
 
 
+bool CUDPReaderWriter::writeBatch(const unsigned char* buffer, unsigned int length, unsigned int count, const in_addr& address, unsigned int port)
+{
+	struct sockaddr_storage addr;
+	::memset(&addr, 0, sizeof(sockaddr_storage));
+
+	addr.ss_family = AF_INET;
+	TOIPV4(addr)->sin_addr = address;
+	TOIPV4(addr)->sin_port = htons(port);
+
+#if defined(__linux__)
+	const unsigned int MAX_BATCH = 16U;
+
+	while (count > 0U) {
+		unsigned int n = count < MAX_BATCH ? count : MAX_BATCH;
+
+		struct iovec iov[MAX_BATCH];
+		struct mmsghdr msgs[MAX_BATCH];
+		::memset(msgs, 0, sizeof(msgs));
+
+		for (unsigned int i = 0U; i < n; i++) {
+			iov[i].iov_base = (void*)(buffer + i * length);
+			iov[i].iov_len  = length;
+			msgs[i].msg_hdr.msg_name    = &addr;
+			msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			msgs[i].msg_hdr.msg_iov     = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1U;
+		}
+
+		int ret = ::sendmmsg(m_fd, msgs, n, 0);
+		if (ret < 0) {
+			LogError("Error returned from sendmmsg (port: %u), err: %s", m_port, strerror(errno));
+			return false;
+		}
+
+		if (ret == 0)
+			return false;
+
+		buffer += ret * length;
+		count  -= ret;
+	}
+
+	return true;
+#else
+	for (unsigned int i = 0U; i < count; i++) {
+		if (!write(buffer + i * length, length, addr))
+			return false;
+	}
+
+	return true;
+#endif
+}
 
 void CUDPReaderWriter::close()
 {
+	if (m_reader != NULL) {
+		m_reader->remove(m_fd);
+		m_reader = NULL;
+
+		// Drop anything left over so a reopened socket starts afresh
+		while (m_queue->front() != NULL)
+			m_queue->pop();
+	}
+
 	::close(m_fd);
 }
 
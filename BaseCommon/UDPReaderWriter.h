@@ -30,6 +30,7 @@
 #include <arpa/inet.h>
 #include <errno.h>
 
+#include "NetworkReader.h"
 
 class CUDPReaderWriter {
 public:
@@ -39,13 +40,18 @@ public:
 
 	static in_addr lookup(const std::string& hostName);
 
-	bool open();
+	// With a reader the socket is received on its thread and read() pops from a queue, which
+	// must then only be read from the thread that waits on the reader
+	bool open(CNetworkReader* reader = NULL);
 
-	int read(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr);
-	int read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port);
+	int read(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr, unsigned int timeoutMs = 0U);
+	int read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port, unsigned int timeoutMs = 0U);
 	bool write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
 	bool write(const unsigned char* buffer, unsigned int length, const struct sockaddr_storage& addr);
 
+	// Send count packets of length bytes each, stored back to back, in as few system calls as possible
+	bool writeBatch(const unsigned char* buffer, unsigned int length, unsigned int count, const in_addr& address, unsigned int port);
+
 	void close();
 
 	unsigned int getPort() const;
@@ -55,4 +61,8 @@ private:
 	unsigned short m_port;
 	in_addr        m_addr;
 	int            m_fd;
+	CNetworkReader* m_reader;
+	CNetworkQueue*  m_queue;
+
+	int readQueue(unsigned char* buffer, unsigned int length, struct sockaddr_storage& addr, unsigned int timeoutMs);
 };
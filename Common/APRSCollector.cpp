@@ -31,7 +31,8 @@
 #include "SlowDataCollectorThrottle.h"
 
 CAPRSCollector::CAPRSCollector() :
-m_collectors()
+m_collectors(),
+m_demux()
 {
 	m_collectors.push_back(new CRSMS1AMessageCollector()); // we do not throttle messages, they have highest priority !
 	m_collectors.push_back(new CSlowDataCollectorThrottle(new CGPSACollector(), 10U));
@@ -41,6 +42,11 @@ m_collectors()
 	m_collectors.push_back(new CSlowDataCollectorThrottle(new CNMEASentenceCollector("$GPRMC"), 10U));
 	m_collectors.push_back(new CSlowDataCollectorThrottle(new CNMEASentenceCollector("$GPGSA"), 10U));
 	m_collectors.push_back(new CSlowDataCollectorThrottle(new CNMEASentenceCollector("$GPGSV"), 10U));
+
+	// The slow data is descrambled once here, the collectors only get the blocks of their type
+	for(auto collector : m_collectors) {
+		m_demux.addConsumer(collector->getDataType(), [collector](const unsigned char* block) { return collector->writeBlock(block); });
+	}
 }
 
 CAPRSCollector::~CAPRSCollector()
@@ -64,17 +70,18 @@ void CAPRSCollector::writeHeader(const CHeaderData& header)
 
 bool CAPRSCollector::writeData(const unsigned char* data)
 {
-	bool ret = false;
+	return m_demux.writeData(data);
+}
 
-	for(auto collector : m_collectors) {
-		bool ret2 = collector->writeData(data);
-		ret = ret || ret2;
-	}
-	return ret;
+bool CAPRSCollector::writeBlock(const unsigned char* block)
+{
+	return m_demux.writeBlock(block);
 }
 
 void CAPRSCollector::reset()
 {
+	m_demux.reset();
+
 	for(auto collector : m_collectors) {
 		collector->reset();
 	}
@@ -82,9 +89,7 @@ void CAPRSCollector::reset()
 
 void CAPRSCollector::sync()
 {
-	for(auto collector : m_collectors) {
-		collector->sync();
-	}
+	m_demux.sync();
 }
 
 unsigned int CAPRSCollector::getData(unsigned char dataType, unsigned char* data, unsigned int length)
@@ -24,6 +24,7 @@
 #include <functional>
 
 #include "SlowDataCollector.h"
+#include "SlowDataDemux.h"
 #include "HeaderData.h"
 #include "Defs.h"
 
@@ -43,6 +44,7 @@ public:
 	void writeHeader(const CHeaderData& callsign);
 
 	bool writeData(const unsigned char* data);
+	bool writeBlock(const unsigned char* block);
 
 	void reset();
 
@@ -56,6 +58,7 @@ public:
 
 private:
 	std::vector<ISlowDataCollector *> m_collectors;
+	CSlowDataDemux                    m_demux;
 };
 
 #endif
@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "APRSFrameQueue.h"
+
+// Sources idle long enough to have a full bucket are forgotten once we track that many
+const unsigned int MAX_TRACKED_SOURCES = 1024U;
+
+CAPRSFrameQueue::CAPRSFrameQueue(unsigned int depth, unsigned int burst, unsigned int ratePerMinute) :
+m_depth(depth),
+m_burst(burst),
+m_ratePerMinute(ratePerMinute),
+m_frames(),
+m_sources(),
+m_stats({ 0ULL, 0ULL, 0ULL, 0ULL }),
+m_wakeUp(false),
+m_mutex(),
+m_available()
+{
+	assert(depth > 0U);
+	assert(burst > 0U);
+}
+
+bool CAPRSFrameQueue::push(const std::string& source, const std::string& frame)
+{
+	return push(source, frame, std::chrono::steady_clock::now());
+}
+
+bool CAPRSFrameQueue::push(const std::string& source, const std::string& frame, const std::chrono::steady_clock::time_point& now)
+{
+	std::lock_guard lock(m_mutex);
+
+	if (!consume(source, now)) {
+		m_stats.limited++;
+		return false;
+	}
+
+	bool dropped = false;
+	if (m_frames.size() >= m_depth) {
+		// Fresh positions are worth more than stale ones
+		m_frames.pop_front();
+		m_stats.dropped++;
+		dropped = true;
+	}
+
+	m_frames.push_back(frame);
+	m_stats.queued++;
+
+	m_available.notify_one();
+
+	return !dropped;
+}
+
+unsigned int CAPRSFrameQueue::pop(std::vector<std::string>& batch, unsigned int max, unsigned int waitMs)
+{
+	std::unique_lock lock(m_mutex);
+
+	m_available.wait_for(lock, std::chrono::milliseconds(waitMs), [this] { return !m_frames.empty() || m_wakeUp; });
+	m_wakeUp = false;
+
+	unsigned int count = 0U;
+	while (count < max && !m_frames.empty()) {
+		batch.push_back(std::move(m_frames.front()));
+		m_frames.pop_front();
+		count++;
+	}
+
+	return count;
+}
+
+void CAPRSFrameQueue::sent(unsigned int count)
+{
+	std::lock_guard lock(m_mutex);
+
+	m_stats.sent += count;
+}
+
+unsigned int CAPRSFrameQueue::size()
+{
+	std::lock_guard lock(m_mutex);
+
+	return m_frames.size();
+}
+
+void CAPRSFrameQueue::wakeUp()
+{
+	std::lock_guard lock(m_mutex);
+
+	m_wakeUp = true;
+	m_available.notify_all();
+}
+
+TAPRSQueueStats CAPRSFrameQueue::getStats()
+{
+	std::lock_guard lock(m_mutex);
+
+	return m_stats;
+}
+
+bool CAPRSFrameQueue::consume(const std::string& source, const std::chrono::steady_clock::time_point& now)
+{
+	if (m_ratePerMinute == 0U)
+		return true;
+
+	auto it = m_sources.find(source);
+	if (it == m_sources.end()) {
+		if (m_sources.size() >= MAX_TRACKED_SOURCES) {
+			for (auto s = m_sources.begin(); s != m_sources.end();) {
+				double elapsed = std::chrono::duration<double>(now - s->second.m_lastRefill).count();
+				if (s->second.m_tokens + elapsed * m_ratePerMinute / 60.0 >= double(m_burst))
+					s = m_sources.erase(s);
+				else
+					++s;
+			}
+		}
+
+		it = m_sources.insert({ source, { double(m_burst), now } }).first;
+	}
+
+	CAPRSSourceBucket& bucket = it->second;
+
+	double elapsed = std::chrono::duration<double>(now - bucket.m_lastRefill).count();
+	if (elapsed > 0.0) {
+		bucket.m_tokens = std::min(double(m_burst), bucket.m_tokens + elapsed * m_ratePerMinute / 60.0);
+		bucket.m_lastRefill = now;
+	}
+
+	if (bucket.m_tokens < 1.0)
+		return false;
+
+	bucket.m_tokens -= 1.0;
+
+	return true;
+}
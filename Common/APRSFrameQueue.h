@@ -0,0 +1,73 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TAPRSQueueStats {
+	unsigned long long queued;
+	unsigned long long sent;
+	unsigned long long dropped;		// pushed out of a full queue
+	unsigned long long limited;		// refused by the per source rate limit
+};
+
+// Bounded queue of formatted APRS frames, filled by the repeater threads and drained in batches by the APRS writer thread.
+// Each source callsign gets its own token bucket so that one chatty station cannot crowd the others out.
+class CAPRSFrameQueue {
+public:
+	CAPRSFrameQueue(unsigned int depth = 256U, unsigned int burst = 10U, unsigned int ratePerMinute = 60U);
+
+	// Never blocks, returns false when the frame was rate limited or pushed out an older one
+	bool push(const std::string& source, const std::string& frame);
+	bool push(const std::string& source, const std::string& frame, const std::chrono::steady_clock::time_point& now);
+
+	// Waits up to waitMs for frames, then moves at most max of them into batch
+	unsigned int pop(std::vector<std::string>& batch, unsigned int max, unsigned int waitMs);
+
+	void sent(unsigned int count);
+
+	unsigned int size();
+	void wakeUp();
+
+	TAPRSQueueStats getStats();
+
+private:
+	struct CAPRSSourceBucket {
+		double m_tokens;
+		std::chrono::steady_clock::time_point m_lastRefill;
+	};
+
+	unsigned int m_depth;
+	unsigned int m_burst;
+	unsigned int m_ratePerMinute;
+	std::deque<std::string> m_frames;
+	std::unordered_map<std::string, CAPRSSourceBucket> m_sources;
+	TAPRSQueueStats m_stats;
+	bool m_wakeUp;
+	std::mutex m_mutex;
+	std::condition_variable m_available;
+
+	bool consume(const std::string& source, const std::chrono::steady_clock::time_point& now);
+};
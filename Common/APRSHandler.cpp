@@ -21,6 +21,7 @@
 #include <cmath>
 #include <cassert>
 #include <algorithm>
+#include <boost/algorithm/string.hpp>
 
 #include "StringUtils.h"
 #include "Log.h"
@@ -80,34 +81,23 @@ void CAPRSHandler::writeHeader(const std::string& callsign, const CHeaderData& h
 	collector->writeHeader(header);
 }
 
-void CAPRSHandler::writeData(const std::string& callsign, const CAMBEData& data)
+bool CAPRSHandler::writeBlock(const std::string& callsign, const unsigned char* block)
 {
-	if (data.isEnd())
-		return;
-
 	CAPRSEntry* entry = m_array[callsign];
 	if (entry == NULL) {
 		LogError("Cannot find the callsign \"%s\" in the APRS array", callsign.c_str());
-		return;
+		return false;
 	}
 
 	CAPRSCollector* collector = entry->getCollector();
 
-	if (data.isSync()) {
-		collector->sync();
-		return;
-	}
-
-	unsigned char buffer[400U];
-	data.getData(buffer, DV_FRAME_MAX_LENGTH_BYTES);
-
-	bool complete = collector->writeData(buffer + VOICE_FRAME_LENGTH_BYTES);
+	bool complete = collector->writeBlock(block);
 	if (!complete)
-		return;
+		return false;
 
 	if (!m_backend->isConnected()) {
 		collector->reset();
-		return;
+		return true;
 	}
 
 	collector->getData([=](const std::string& rawFrame, const std::string& dstarCall)
@@ -119,21 +109,21 @@ void CAPRSHandler::writeData(const std::string& callsign, const CAMBEData& data)
 		}
 
 		// If we already have a q-construct, don't send it on
-		if(std::any_of(frame.getPath().begin(), frame.getPath().end(), [] (std::string s) { return !s.empty() && s[0] == 'q'; })) {
+		if(std::any_of(frame.getPath().begin(), frame.getPath().end(), [] (const std::string& s) { return !s.empty() && s[0] == 'q'; })) {
 			LogWarning("DPRS Frame already has q construct, not forwarding to APRS-IS: %s", rawFrame.c_str());
 			return;
 		}
 
 		frame.getPath().push_back("qAR");
 		frame.getPath().push_back(CStringUtils::string_format("%s-%s", entry->getCallsign().c_str(), entry->getBand().c_str()));
-		
-		std::string output ;
-		CAPRSFormater::frameToString(output, frame);
+
 
 		LogInfo("DPRS\t%s\t%s\t%s", dstarCall.c_str(), frame.getSource().c_str(), rawFrame.c_str());
 
 		m_backend->write(frame);
 	});
+
+	return true;
 }
 
 void CAPRSHandler::writeStatus(const std::string& callsign, const std::string status)
@@ -48,7 +48,8 @@ public:
 
 	void writeHeader(const std::string& callsign, const CHeaderData& header);
 
-	void writeData(const std::string& callsign, const CAMBEData& data);
+	// A descrambled GPS slow data block of the stream of that repeater
+	bool writeBlock(const std::string& callsign, const unsigned char* block);
 
 	void  writeStatus(const std::string& callsign, const std::string status);
 
@@ -33,6 +33,8 @@
 
 // #define	DUMP_TX
 
+const unsigned int APRS_BATCH_SIZE = 16U;
+
 
 // In Log.cpp
 extern CMQTTConnection* m_mqtt;
@@ -41,7 +43,7 @@ CAPRSISHandlerThread::CAPRSISHandlerThread(const std::string& callsign) :
 CThread("APRS"),
 m_username(callsign),
 m_ssid(callsign),
-m_queue(20U),
+m_queue(),
 m_exit(false),
 m_APRSReadCallbacks(),
 m_filter(),
@@ -60,7 +62,7 @@ CAPRSISHandlerThread::CAPRSISHandlerThread(const std::string& callsign, const st
 CThread("APRS"),
 m_username(callsign),
 m_ssid(callsign),
-m_queue(20U),
+m_queue(),
 m_exit(false),
 m_APRSReadCallbacks(),
 m_filter(filter),
@@ -102,14 +104,22 @@ void* CAPRSISHandlerThread::Entry()
 #ifndef DEBUG_DSTARGW
 	try {
 #endif
-		while (!m_exit) {
-			if(!m_queue.empty()){
-				auto frameStr = m_queue.getData();
+		std::vector<std::string> batch;
+		batch.reserve(APRS_BATCH_SIZE);
 
+		while (!m_exit) {
+			// Sleeps until a frame is queued or stop() wakes us up
+			batch.clear();
+			unsigned int count = m_queue.pop(batch, APRS_BATCH_SIZE, 1000U);
+			for (const auto& frameStr : batch) {
 				LogInfo("APRS Frame sent to IS ==> %s", frameStr.c_str());
 
 				m_mqtt->publish("aprs-gateway/aprs", frameStr);
 			}
+
+			if (count > 0U)
+				m_queue.sent(count);
+
 #ifdef notdef
 			{
 				std::string line;
@@ -139,10 +149,9 @@ void* CAPRSISHandlerThread::Entry()
 #endif
 		}
 
-		while (!m_queue.empty()) {
-			auto s = m_queue.getData();
-			s.clear();
-		}
+		TAPRSQueueStats stats = m_queue.getStats();
+		if (stats.dropped > 0ULL || stats.limited > 0ULL)
+			LogInfo("APRS Writer thread sent %llu frames, %llu dropped, %llu rate limited", stats.sent, stats.dropped, stats.limited);
 #ifndef DEBUG_DSTARGW
 	}
 	catch (std::exception& e) {
@@ -175,7 +184,8 @@ void CAPRSISHandlerThread::write(CAPRSFrame& frame)
 		LogDebug("Queued APRS Frame : %s", frameString.c_str());
 		frameString.append("\r\n");
 
-		m_queue.addData(frameString);
+		if (!m_queue.push(frame.getSource(), frameString))
+			LogDebug("APRS Frame from %s dropped or rate limited", frame.getSource().c_str());
 	}
 }
 
@@ -187,6 +197,7 @@ bool CAPRSISHandlerThread::isConnected() const
 void CAPRSISHandlerThread::stop()
 {
 	m_exit = true;
+	m_queue.wakeUp();
 
 	Wait();
 }
@@ -21,7 +21,7 @@
 
 #include <vector>
 
-#include "RingBuffer.h"
+#include "APRSFrameQueue.h"
 #include "Thread.h"
 #include "IAPRSHandlerBackend.h"
 #include "APRSFrame.h"
@@ -50,7 +50,7 @@ public:
 private:
 	std::string               m_username;
 	std::string	           m_ssid;
-	CRingBuffer<std::string>     m_queue;
+	CAPRSFrameQueue        m_queue;
 	bool                   m_exit;
 	std::vector<IReadAPRSFrameCallback *>  m_APRSReadCallbacks;
 	std::string               m_filter;
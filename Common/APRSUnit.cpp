@@ -16,15 +16,20 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
-#include <boost/algorithm/string.hpp>
+#include <cassert>
+#include <cstring>
+#include <functional>
 
 #include "APRSUnit.h"
 #include "APRSFormater.h"
 #include "StringUtils.h"
 #include "APRStoDPRS.h"
+#include "Log.h"
 
-CAPRSUnit::CAPRSUnit(IRepeaterCallback * repeaterHandler) :
-m_frameBuffer(20U),
+CAPRSUnit::CAPRSUnit(IRepeaterCallback * repeaterHandler, unsigned int airtimeBudgetMs, unsigned int airtimeWindowMs) :
+m_messages(),
+m_recent(),
+m_now(0U),
 m_status(APS_IDLE),
 m_repeaterHandler(repeaterHandler),
 m_headerData(nullptr),
@@ -33,61 +38,100 @@ m_out(0U),
 m_seq(0U),
 m_totalNeeded(0U),
 m_timer(1000U, 2U),
-m_start()
+m_sent(0U),
+m_pacer(DSTAR_FRAME_TIME_MS),
+m_airtimeBudget(airtimeBudgetMs),
+m_airtimeWindow(airtimeWindowMs),
+m_airtimeCredit((unsigned long long)airtimeBudgetMs * airtimeWindowMs),
+m_airtimeNeeded(0U),
+m_stats({ 0ULL, 0ULL, 0ULL, 0ULL, 0ULL, 0ULL })
 {
+    assert(airtimeWindowMs > 0U);
+
     m_timer.start();
 }
 
+CAPRSUnit::~CAPRSUnit()
+{
+    delete m_headerData;
+    delete m_slowData;
+}
+
 void CAPRSUnit::writeFrame(CAPRSFrame& frame)
 {
-    auto frameCopy = new CAPRSFrame(frame);
-    frameCopy->getPath().clear();//path is of no use for us, just clear it
+    m_stats.received++;
+
+    // Nothing but messages can be turned into DPRS, do not let anything else take a place in the queue
+    if(frame.getType() != APFT_MESSAGE) {
+        m_stats.unsupported++;
+        return;
+    }
+
+    std::size_t frameHash = hash(frame);
+    if(isDuplicate(frameHash)) {
+        m_stats.duplicates++;
+        LogDebug("Duplicate APRS frame from %s not sent on RF", frame.getSource().c_str());
+        return;
+    }
+
+    if(m_messages.size() >= APRS_QUEUE_DEPTH) {
+        m_messages.pop_front();
+
+        m_stats.dropped++;
+        LogInfo("APRS to RF queue full, dropped oldest message, %llu dropped so far", m_stats.dropped);
+    }
+
+    m_messages.push_back(frame);
+    m_messages.back().getPath().clear();//path is of no use for us, just clear it
+
+    m_recent[frameHash] = m_now;
 
-    m_frameBuffer.push_back(frameCopy);
     m_timer.start();
 }
 
 void CAPRSUnit::clock(unsigned int ms)
 {
+    m_now += ms;
     m_timer.clock(ms);
-    if(m_status == APS_IDLE && !m_frameBuffer.empty() && m_timer.hasExpired()) {
+    refill(ms);
+
+    if(m_status == APS_IDLE && !m_messages.empty() && m_timer.hasExpired()) {
+        if(!prepare())
+            return;
 
-        auto frame = m_frameBuffer.front();
-        m_frameBuffer.pop_front();
+        m_status = APS_WAIT;
+    }
 
-        m_headerData = new CHeaderData();
-        std::string dprs, text;
-        if(!CAPRSToDPRS::aprsToDPRS(dprs, text, *m_headerData, *frame)) {
-            delete m_headerData;
-            m_headerData = nullptr;
+    if(m_status == APS_WAIT) {
+        unsigned long long cost = (unsigned long long)m_airtimeNeeded * m_airtimeWindow;
+        if(m_airtimeCredit < cost)
             return;
-        }
 
-        m_slowData = new CSlowDataEncoder();
-        
-        m_slowData->setHeaderData(*m_headerData);
-        m_slowData->setGPSData(dprs);
-        m_slowData->setTextData(text);
+        m_airtimeCredit -= cost;
+        m_stats.transmitted++;
+        m_stats.airtimeMs += m_airtimeNeeded;
 
-        m_totalNeeded = (m_slowData->getInterleavedDataLength() / (DATA_FRAME_LENGTH_BYTES)) * 2U;
+        LogInfo("Sending APRS message from %s to %s on RF, %u ms of airtime, %u ms left in budget, %llu duplicates and %llu drops so far",
+                m_headerData->getMyCall1().c_str(), m_headerData->getYourCall().c_str(), m_airtimeNeeded, getAirtimeAvailable(), m_stats.duplicates, m_stats.dropped);
 
         m_repeaterHandler->process(*m_headerData, DIR_INCOMING, AS_INFO);
 
         m_out = 0U;
         m_seq = 0U;
 
-        m_start = std::chrono::high_resolution_clock::now();
+        m_sent = 0U;
+        m_pacer.start();
         m_status = APS_TRANSMIT;
         return;
     }
 
     if(m_status == APS_TRANSMIT) {
-        unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_start).count();
-		needed /= DSTAR_FRAME_TIME_MS;
+        // Sync frames take their 20ms slot like any other frame
+        unsigned int needed = m_pacer.getDue();
 
         unsigned char buffer[DV_FRAME_LENGTH_BYTES];
 
-        while (m_out < needed && m_out < m_totalNeeded) {
+        while (m_sent < needed && m_out < m_totalNeeded) {
             CAMBEData data;
             data.setId(m_headerData->getId());
             data.setSeq(m_seq);
@@ -107,14 +151,102 @@ void CAPRSUnit::clock(unsigned int ms)
             data.setData(buffer, DV_FRAME_LENGTH_BYTES);
             m_repeaterHandler->process(data, DIR_INCOMING, AS_INFO);
 
+            m_sent++;
             m_seq++;
             if (m_seq == 21U) m_seq = 0U;
         }
 
-        if(m_out >= m_totalNeeded) {
-            m_status = APS_IDLE;
-            delete m_headerData;
-            delete m_slowData;
-        }
+        if(m_out >= m_totalNeeded)
+            endTransmission();
+    }
+}
+
+unsigned int CAPRSUnit::getQueued() const
+{
+    return m_messages.size();
+}
+
+unsigned int CAPRSUnit::getAirtimeAvailable() const
+{
+    return (unsigned int)(m_airtimeCredit / m_airtimeWindow);
+}
+
+const TAPRSUnitStats& CAPRSUnit::getStats() const
+{
+    return m_stats;
+}
+
+std::size_t CAPRSUnit::hash(CAPRSFrame& frame)
+{
+    // The path is left out on purpose, it is what differs between copies of the same frame
+    std::hash<std::string> hasher;
+    std::size_t hash = hasher(frame.getSource());
+    hash ^= hasher(frame.getDestination()) + 0x9E3779B9U + (hash << 6) + (hash >> 2);
+    hash ^= hasher(frame.getBody()) + 0x9E3779B9U + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
+bool CAPRSUnit::isDuplicate(std::size_t hash)
+{
+    for(auto it = m_recent.begin(); it != m_recent.end();) {
+        if(m_now - it->second >= APRS_DUPLICATE_WINDOW_MS)
+            it = m_recent.erase(it);
+        else
+            ++it;
     }
-}
\ No newline at end of file
+
+    return m_recent.count(hash) > 0U;
+}
+
+bool CAPRSUnit::prepare()
+{
+    CAPRSFrame frame(std::move(m_messages.front()));
+    m_messages.pop_front();
+
+    m_headerData = new CHeaderData();
+    std::string dprs, text;
+    if(!CAPRSToDPRS::aprsToDPRS(dprs, text, *m_headerData, frame)) {
+        delete m_headerData;
+        m_headerData = nullptr;
+        return false;
+    }
+
+    m_slowData = new CSlowDataEncoder();
+    
+    m_slowData->setHeaderData(*m_headerData);
+    m_slowData->setGPSData(dprs);
+    m_slowData->setTextData(text);
+
+    m_totalNeeded = (m_slowData->getInterleavedDataLength() / (DATA_FRAME_LENGTH_BYTES)) * 2U;
+
+    // Every 21st frame is a sync frame on top of the slow data frames
+    m_airtimeNeeded = (m_totalNeeded + (m_totalNeeded + 19U) / 20U) * DSTAR_FRAME_TIME_MS;
+    if(m_airtimeNeeded > m_airtimeBudget) {
+        m_stats.dropped++;
+        LogInfo("APRS message from %s needs %u ms of airtime, more than the %u ms budget, dropped", frame.getSource().c_str(), m_airtimeNeeded, m_airtimeBudget);
+        endTransmission();
+        return false;
+    }
+
+    return true;
+}
+
+void CAPRSUnit::refill(unsigned int ms)
+{
+    unsigned long long capacity = (unsigned long long)m_airtimeBudget * m_airtimeWindow;
+
+    m_airtimeCredit += (unsigned long long)ms * m_airtimeBudget;
+    if(m_airtimeCredit > capacity)
+        m_airtimeCredit = capacity;
+}
+
+void CAPRSUnit::endTransmission()
+{
+    m_status = APS_IDLE;
+
+    delete m_headerData;
+    delete m_slowData;
+    m_headerData = nullptr;
+    m_slowData = nullptr;
+}
@@ -19,12 +19,13 @@
 #pragma once
 
 #include <string>
-#include <boost/circular_buffer.hpp>
-#include <chrono>
+#include <deque>
+#include <unordered_map>
 
 #include "APRSFrame.h"
 #include "RepeaterCallback.h"
 #include "Timer.h"
+#include "PacingEngine.h"
 #include "SlowDataEncoder.h"
 
 enum APRSUNIT_STATUS {
@@ -33,16 +34,39 @@ enum APRSUNIT_STATUS {
     APS_TRANSMIT
 };
 
+// Frames heard again within this window, via another path or igate, are not sent twice
+const unsigned int APRS_DUPLICATE_WINDOW_MS = 30000U;
+const unsigned int APRS_QUEUE_DEPTH = 20U;
+// At most one minute of DPRS on air in any ten minutes
+const unsigned int APRS_AIRTIME_BUDGET_MS = 60000U;
+const unsigned int APRS_AIRTIME_WINDOW_MS = 600000U;
+
+struct TAPRSUnitStats {
+    unsigned long long received;
+    unsigned long long duplicates;
+    unsigned long long unsupported;     // not a message, only messages can be sent as DPRS
+    unsigned long long dropped;         // pushed out of a full queue or too long for the budget
+    unsigned long long transmitted;
+    unsigned long long airtimeMs;
+};
+
 class CAPRSUnit
 {
 public:
-    CAPRSUnit(IRepeaterCallback * repeaterHandler);
+    CAPRSUnit(IRepeaterCallback * repeaterHandler, unsigned int airtimeBudgetMs = APRS_AIRTIME_BUDGET_MS, unsigned int airtimeWindowMs = APRS_AIRTIME_WINDOW_MS);
+    ~CAPRSUnit();
+
     void writeFrame(CAPRSFrame& aprsFrame);
     void clock(unsigned ms);
 
+    unsigned int getQueued() const;
+    unsigned int getAirtimeAvailable() const;
+    const TAPRSUnitStats& getStats() const;
+
 private:
-    // CRingBuffer<CAPRSFrame *> m_frameBuffer;
-    boost::circular_buffer<CAPRSFrame *> m_frameBuffer;
+    std::deque<CAPRSFrame> m_messages;
+    std::unordered_map<std::size_t, unsigned int> m_recent;
+    unsigned int m_now;
     APRSUNIT_STATUS m_status;
     IRepeaterCallback * m_repeaterHandler;
     CHeaderData * m_headerData;
@@ -51,7 +75,17 @@ private:
     unsigned int m_seq;
     unsigned int m_totalNeeded;
     CTimer m_timer;
-    std::chrono::high_resolution_clock::time_point m_start;
-};
-
+    unsigned int m_sent;
+    CStreamPacer m_pacer;
+    unsigned int m_airtimeBudget;
+    unsigned int m_airtimeWindow;
+    unsigned long long m_airtimeCredit;     // in ms of airtime times the window length
+    unsigned int m_airtimeNeeded;
+    TAPRSUnitStats m_stats;
 
+    static std::size_t hash(CAPRSFrame& frame);
+    bool isDuplicate(std::size_t hash);
+    bool prepare();
+    void refill(unsigned int ms);
+    void endTransmission();
+};
@@ -17,7 +17,7 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
-#include <boost/algorithm/string.hpp>
+#include <cctype>
 
 #include "APRStoDPRS.h"
 #include "Log.h"
@@ -42,33 +42,43 @@ bool CAPRSToDPRS::aprsToDPRS(std::string& dprs, std::string& text, CHeaderData&
 
 bool CAPRSToDPRS::messageToDPRS(std::string& dprs, std::string& text, CHeaderData& header, CAPRSFrame& frame)
 {
-    auto frameBody = frame.getBody();
+    std::string_view frameBody(frame.getBody());
     if(frameBody.length() < 11 || frameBody[0] != ':' || frameBody[10] != ':') {
-        LogDebug("Invalid APRS message body : %s", frameBody.c_str());
+        LogDebug("Invalid APRS message body : %s", frame.getBody().c_str());
         return false;
     }
 
     // extract recipient
-    auto recipient = boost::trim_copy(frameBody.substr(1, 9));
+    auto recipient = trim(frameBody.substr(1, 9));
     if(recipient.empty()) {
         LogDebug("APRS message has no recipient");
         return false;
     }
-    auto dashPos = recipient.find_first_of('-');
-    if(dashPos != std::string::npos)
-        recipient = recipient.substr(0, dashPos);
+    recipient = recipient.substr(0, recipient.find_first_of('-'));
 
     //extract message body
-    auto messageBody = boost::trim_copy(frameBody.substr(11));
+    text.assign(trim(frameBody.substr(11)));
+
+    std::string recipientCall(recipient);
 
     header.setId(header.createId());
     header.setMyCall1(frame.getSource());
     header.setMyCall2("MSG");
-    header.setYourCall(recipient);
-
-    CRSMS1AMessageBuilder::buildMessage(dprs, frame.getSource(), recipient, messageBody);
+    header.setYourCall(recipientCall);
 
-    text = messageBody;
+    CRSMS1AMessageBuilder::buildMessage(dprs, frame.getSource(), recipientCall, text);
 
     return true;
 }
+
+std::string_view CAPRSToDPRS::trim(std::string_view str)
+{
+    auto isSpace = [](char c) { return std::isspace((unsigned char)c) != 0; };
+
+    while(!str.empty() && isSpace(str.front()))
+        str.remove_prefix(1U);
+    while(!str.empty() && isSpace(str.back()))
+        str.remove_suffix(1U);
+
+    return str;
+}
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "HeaderData.h"
@@ -31,4 +32,5 @@ public:
 
 private:
     static bool messageToDPRS(std::string& dprs, std::string& text, CHeaderData& header, CAPRSFrame& frame);
+    static std::string_view trim(std::string_view str);
 };
\ No newline at end of file
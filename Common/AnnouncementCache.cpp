@@ -0,0 +1,110 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+
+#include "AnnouncementCache.h"
+
+CAnnouncementCache::CAnnouncementCache(unsigned int capacity) :
+m_capacity(capacity),
+m_entries(),
+m_index(),
+m_hits(0ULL),
+m_misses(0ULL),
+m_mutex()
+{
+	assert(capacity > 0U);
+}
+
+std::shared_ptr<const std::vector<unsigned char>> CAnnouncementCache::find(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto it = m_index.find(key);
+	if (it == m_index.end()) {
+		m_misses++;
+		return nullptr;
+	}
+
+	m_hits++;
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+	return it->second->second;
+}
+
+void CAnnouncementCache::insert(const std::string& key, const std::shared_ptr<const std::vector<unsigned char>>& frames)
+{
+	assert(frames != nullptr);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto it = m_index.find(key);
+	if (it != m_index.end()) {
+		it->second->second = frames;
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return;
+	}
+
+	m_entries.emplace_front(key, frames);
+	m_index[key] = m_entries.begin();
+
+	if (m_entries.size() > m_capacity) {
+		m_index.erase(m_entries.back().first);
+		m_entries.pop_back();
+	}
+}
+
+void CAnnouncementCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_entries.clear();
+	m_index.clear();
+}
+
+unsigned int CAnnouncementCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return (unsigned int)m_entries.size();
+}
+
+unsigned long long CAnnouncementCache::getHits() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_hits;
+}
+
+unsigned long long CAnnouncementCache::getMisses() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_misses;
+}
+
+double CAnnouncementCache::getHitRate() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	unsigned long long total = m_hits + m_misses;
+	if (total == 0ULL)
+		return 0.0;
+
+	return double(m_hits) / double(total);
+}
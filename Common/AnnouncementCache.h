@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Bounded least recently used cache of fully rendered announcements, each one a contiguous buffer of
+// DV frames (voice and slow data). Entries are handed out as shared pointers so an announcement that
+// is being transmitted stays valid even when it gets evicted.
+class CAnnouncementCache {
+public:
+	CAnnouncementCache(unsigned int capacity);
+
+	std::shared_ptr<const std::vector<unsigned char>> find(const std::string& key);
+	void insert(const std::string& key, const std::shared_ptr<const std::vector<unsigned char>>& frames);
+
+	void clear();
+
+	unsigned int size() const;
+
+	unsigned long long getHits() const;
+	unsigned long long getMisses() const;
+	double             getHitRate() const;
+
+private:
+	typedef std::pair<std::string, std::shared_ptr<const std::vector<unsigned char>>> TEntry;
+
+	unsigned int        m_capacity;
+	std::list<TEntry>   m_entries;			// Most recently used first
+	std::unordered_map<std::string, std::list<TEntry>::iterator> m_index;
+	unsigned long long  m_hits;
+	unsigned long long  m_misses;
+	mutable std::mutex  m_mutex;
+};
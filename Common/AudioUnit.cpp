@@ -33,6 +33,11 @@
 
 CAMBEFileReader * CAudioUnit::m_ambeFilereader = nullptr;
 
+// Rendered announcements are shared by all the repeaters
+const unsigned int ANNOUNCEMENT_CACHE_SIZE = 32U;
+
+CAnnouncementCache CAudioUnit::m_cache(ANNOUNCEMENT_CACHE_SIZE);
+
 TEXT_LANG CAudioUnit::m_language = TL_ENGLISH_UK;
 
 const unsigned int MAX_FRAMES = 60U * DSTAR_FRAMES_PER_SEC;
@@ -50,6 +55,8 @@ void CAudioUnit::setLanguage(const std::string & dir, TEXT_LANG language)
 		m_ambeFilereader = nullptr;
 	}
 
+	m_cache.clear();
+
 	m_language = language;
 
 	std::string ambeFileName;
@@ -112,7 +119,12 @@ void CAudioUnit::setLanguage(const std::string & dir, TEXT_LANG language)
 
 void CAudioUnit::finalise()
 {
+	LogInfo("Audio Unit announcement cache: %llu hits, %llu misses, %.1f%% hit rate", m_cache.getHits(), m_cache.getMisses(), m_cache.getHitRate() * 100.0);
+
+	m_cache.clear();
+
 	delete m_ambeFilereader;
+	m_ambeFilereader = nullptr;
 }
 
 CAudioUnit::CAudioUnit(IRepeaterCallback* handler, const std::string& callsign) :
@@ -127,19 +139,18 @@ m_reflector(),
 m_tempReflector(),
 m_hasTemporary(false),
 m_timer(1000U, REPLY_TIME),
-m_data(),
-m_out(0U)
-//m_time()
+m_frames(),
+m_frameCount(0U),
+m_id(0U),
+m_frame(),
+m_out(0U),
+m_pacer(DSTAR_FRAME_TIME_MS)
 {
 	assert(handler != NULL);
 }
 
 CAudioUnit::~CAudioUnit()
 {
-	for (auto item : m_data) {
-		delete item;
-	}
-	m_data.clear();
 }
 
 void CAudioUnit::sendStatus()
@@ -186,23 +197,26 @@ void CAudioUnit::clock(unsigned int ms)
 		m_out    = 0U;
 		m_status = AS_TRANSMIT;
 
-		m_time = std::chrono::high_resolution_clock::now();
+		m_pacer.start();
 
 		return;
 	}
 
 	if (m_status == AS_TRANSMIT) {
-		unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - m_time).count();
-		needed /= DSTAR_FRAME_TIME_MS;
-
-		while (m_out < needed && m_out < m_data.size()) {
-			CAMBEData* data = m_data[m_out];
+		unsigned int needed = m_pacer.getDue();
+
+		// One frame object is reused, each frame is a copy out of the shared announcement
+		while (m_out < needed && m_out < m_frameCount) {
+			m_frame.setData(m_frames->data() + m_out * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
+			m_frame.setId(m_id);
+			m_frame.setSeq(m_out % 21U);
+			m_frame.setEnd(m_out == m_frameCount - 1U);
 			m_out++;
-			// LogDebug("m_out %u, needed %u, m_data %u", m_out, needed, m_data.size());
-			m_handler->process(*data, DIR_INCOMING, AS_INFO);
+			// LogDebug("m_out %u, needed %u, m_frameCount %u", m_out, needed, m_frameCount);
+			m_handler->process(m_frame, DIR_INCOMING, AS_INFO);
 		}
 
-		if (m_out >= m_data.size()) {
+		if (m_out >= m_frameCount) {
 			m_out    = 0U;
 			m_status = AS_IDLE;
 			m_timer.stop();
@@ -221,7 +235,7 @@ void CAudioUnit::cancel()
 	m_timer.stop();
 }
 
-void CAudioUnit::spellReflector(const std::string &reflector)
+void CAudioUnit::spellReflector(const std::string &reflector, std::vector<CAMBEData*>& data)
 {
 	unsigned int length = reflector.size();
 
@@ -229,7 +243,7 @@ void CAudioUnit::spellReflector(const std::string &reflector)
 		std::string c = reflector.substr(i, 1);
 
 		if (c.compare(" "))
-			m_ambeFilereader->lookup(c, m_data);
+			m_ambeFilereader->lookup(c, data);
 	}
 
 	char c = reflector.at(length - 1);
@@ -240,25 +254,25 @@ void CAudioUnit::spellReflector(const std::string &reflector)
 	cstr.push_back(c);
 	if (m_linkStatus == LS_LINKING_DCS || m_linkStatus == LS_LINKED_DCS ||
 	    m_linkStatus == LS_LINKING_CCS || m_linkStatus == LS_LINKED_CCS) {
-		m_ambeFilereader->lookup(cstr, m_data);
+		m_ambeFilereader->lookup(cstr, data);
 		return;
 	}
 
 	switch (c) {
 		case 'A':
-			m_ambeFilereader->lookup("alpha", m_data);
+			m_ambeFilereader->lookup("alpha", data);
 			break;
 		case 'B':
-			m_ambeFilereader->lookup("bravo", m_data);
+			m_ambeFilereader->lookup("bravo", data);
 			break;
 		case 'C':
-			m_ambeFilereader->lookup("charlie", m_data);
+			m_ambeFilereader->lookup("charlie", data);
 			break;
 		case 'D':
-			m_ambeFilereader->lookup("delta", m_data);
+			m_ambeFilereader->lookup("delta", data);
 			break;
 		default:
-			m_ambeFilereader->lookup(cstr, m_data);
+			m_ambeFilereader->lookup(cstr, data);
 			break;
 	}
 }
@@ -267,70 +281,85 @@ void CAudioUnit::sendStatus(LINK_STATUS status, const std::string& reflector, co
 {
 	LogDebug("Audio Unit sendStatus");
 
-	// do some clean up, delete old message
-	for (auto item : m_data) {
-		delete item;
+	// The spelling of the reflector module also depends on the permanent link status
+	bool spellModule = !(m_linkStatus == LS_LINKING_DCS || m_linkStatus == LS_LINKED_DCS ||
+	                     m_linkStatus == LS_LINKING_CCS || m_linkStatus == LS_LINKED_CCS);
+
+	std::string key = std::to_string(int(m_language)) + "|" + std::to_string(int(status)) + "|" + (spellModule ? "1" : "0") + "|" + reflector + "|" + text;
+
+	m_frames = m_cache.find(key);
+	if (m_frames == nullptr) {
+		m_frames = render(status, reflector, text);
+		m_cache.insert(key, m_frames);
 	}
-	m_data.clear();
+
+	m_frameCount = (unsigned int)(m_frames->size() / DV_FRAME_LENGTH_BYTES);
+	m_id = CHeaderData::createId();
+
+	// RPT1 and RPT2 will be filled in later
+	CHeaderData header;
+	header.setMyCall1(m_callsign);
+	header.setMyCall2("INFO");
+	header.setYourCall("CQCQCQ  ");
+	header.setId(m_id);
+
+	m_handler->process(header, DIR_INCOMING, AS_INFO);
+}
+
+std::shared_ptr<const std::vector<unsigned char>> CAudioUnit::render(LINK_STATUS status, const std::string& reflector, const std::string &text)
+{
+	std::vector<CAMBEData*> data;
 
 	// Create the message
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
+	m_ambeFilereader->lookup(" ", data);
+	m_ambeFilereader->lookup(" ", data);
+	m_ambeFilereader->lookup(" ", data);
+	m_ambeFilereader->lookup(" ", data);
 
 	bool found;
 
 	switch (status) {
 		case LS_NONE:
-			m_ambeFilereader->lookup("notlinked", m_data);
+			m_ambeFilereader->lookup("notlinked", data);
 			break;
 		case LS_LINKED_CCS:
 		case LS_LINKED_DCS:
 		case LS_LINKED_DPLUS:
 		case LS_LINKED_DEXTRA:
 		case LS_LINKED_LOOPBACK:
-			found = m_ambeFilereader->lookup("linkedto", m_data);
+			found = m_ambeFilereader->lookup("linkedto", data);
 			if (!found) {
-				m_ambeFilereader->lookup("linked", m_data);
-				m_ambeFilereader->lookup("2", m_data);
+				m_ambeFilereader->lookup("linked", data);
+				m_ambeFilereader->lookup("2", data);
 			}
-			spellReflector(reflector);
+			spellReflector(reflector, data);
 			break;
 		default:
-			found = m_ambeFilereader->lookup("linkingto", m_data);
+			found = m_ambeFilereader->lookup("linkingto", data);
 			if (!found) {
-				m_ambeFilereader->lookup("linking", m_data);
-				m_ambeFilereader->lookup("2", m_data);
+				m_ambeFilereader->lookup("linking", data);
+				m_ambeFilereader->lookup("2", data);
 			}
-			spellReflector(reflector);
+			spellReflector(reflector, data);
 			break;
 	}
 
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-	m_ambeFilereader->lookup(" ", m_data);
-
-	unsigned int id = CHeaderData::createId();
-	// RPT1 and RPT2 will be filled in later
-	CHeaderData header;
-	header.setMyCall1(m_callsign);
-	header.setMyCall2("INFO");
-	header.setYourCall("CQCQCQ  ");
-	header.setId(id);
+	m_ambeFilereader->lookup(" ", data);
+	m_ambeFilereader->lookup(" ", data);
+	m_ambeFilereader->lookup(" ", data);
+	m_ambeFilereader->lookup(" ", data);
 
 	CSlowDataEncoder slowDataEncoder;
 	slowDataEncoder.setTextData(text);
 	unsigned int seqNo = 0U;
 
-	// add the slow data, id, seq num etc ...
-	for(unsigned int i = 0U; i < m_data.size(); i++) {
-		m_data[i]->setId(id);
-		m_data[i]->setSeq(seqNo);
+	// Lay the frames out back to back with the slow data already in place, the id, sequence
+	// number and end flag are filled in when transmitting
+	std::shared_ptr<std::vector<unsigned char>> frames = std::make_shared<std::vector<unsigned char>>(data.size() * DV_FRAME_LENGTH_BYTES);
 
-		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-		m_data[i]->getData(buffer, DV_FRAME_LENGTH_BYTES);
+	for(unsigned int i = 0U; i < data.size(); i++) {
+		unsigned char* buffer = frames->data() + i * DV_FRAME_LENGTH_BYTES;
+		data[i]->getData(buffer, DV_FRAME_LENGTH_BYTES);
 
 		// Insert sync bytes when the sequence number is zero, slow data otherwise
 		if (seqNo == 0U) {
@@ -340,13 +369,11 @@ void CAudioUnit::sendStatus(LINK_STATUS status, const std::string& reflector, co
 			slowDataEncoder.getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
 		}
 
-		m_data[i]->setData(buffer, DV_FRAME_LENGTH_BYTES);
-
 		seqNo++;
 		if(seqNo >= 21U) seqNo = 0U;
-	}
 
-	m_data[m_data.size() - 1]->setEnd(true);
+		delete data[i];
+	}
 
-	m_handler->process(header, DIR_INCOMING, AS_INFO);
+	return frames;
 }
@@ -22,15 +22,17 @@
 
 #include <string>
 #include <map>
-#include <chrono>
 #include <vector>
+#include <memory>
 
 #include "RepeaterCallback.h"
 #include "SlowDataEncoder.h"
 #include "AMBEData.h"
 #include "Timer.h"
+#include "PacingEngine.h"
 #include "Defs.h"
 #include "AMBEFileReader.h"
+#include "AnnouncementCache.h"
 
 enum AUDIO_STATUS {
 	AS_IDLE,
@@ -72,12 +74,17 @@ private:
 	std::string        m_tempReflector;
 	bool               m_hasTemporary;
 	CTimer             m_timer;
-	std::vector<CAMBEData*>   m_data;
+	std::shared_ptr<const std::vector<unsigned char>> m_frames;
+	unsigned int       m_frameCount;
+	unsigned int       m_id;
+	CAMBEData          m_frame;
 	static CAMBEFileReader*   m_ambeFilereader;
+	static CAnnouncementCache m_cache;
 	unsigned int       m_out;
-	std::chrono::high_resolution_clock::time_point m_time;
+	CStreamPacer       m_pacer;
 
-	void spellReflector(const std::string& reflector);
+	void spellReflector(const std::string& reflector, std::vector<CAMBEData*>& data);
 	void sendStatus(LINK_STATUS status, const std::string& reflector, const std::string& text);
+	std::shared_ptr<const std::vector<unsigned char>> render(LINK_STATUS status, const std::string& reflector, const std::string& text);
 };
 
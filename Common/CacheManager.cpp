@@ -134,3 +134,12 @@ void CCacheManager::updateGateway(const std::string& gateway, const std::string&
 	m_gatewayCache.update(gateway, address, protocol, addrLock, protoLock);
 	mux.unlock();
 }
+
+void CCacheManager::getCounts(unsigned int& users, unsigned int& repeaters, unsigned int& gateways)
+{
+	mux.lock();
+	users     = m_userCache.getCount();
+	repeaters = m_repeaterCache.getCount();
+	gateways  = m_gatewayCache.getCount();
+	mux.unlock();
+}
@@ -144,6 +144,8 @@ public:
 	void updateRepeater(const std::string& repeater, const std::string& gateway, const std::string& address, DSTAR_PROTOCOL protocol, bool addrLock, bool protoLock);
 	void updateGateway(const std::string& gateway, const std::string& address, DSTAR_PROTOCOL protocol, bool addrLock, bool protoLock);
 
+	void getCounts(unsigned int& users, unsigned int& repeaters, unsigned int& gateways);
+
 private:
 	CUserCache     m_userCache;
 	CGatewayCache  m_gatewayCache;
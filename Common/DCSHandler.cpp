@@ -57,6 +57,7 @@ m_dcsId(0x00U),
 m_dcsSeq(0x00U),
 m_seqNo(0x00U),
 m_inactivityTimer(1000U, NETWORK_TIMEOUT),
+m_quality(),
 m_yourCall(),
 m_myCall1(),
 m_myCall2(),
@@ -160,12 +161,15 @@ void CDCSHandler::getInfo(IReflectorCallback* handler, CRemoteRepeaterData& data
 		CDCSHandler* reflector = m_reflectors[i];
 		if (reflector != NULL) {
 			if (reflector->m_destination == handler) {
+				TLinkQuality quality;
+				reflector->m_quality.getLink(quality);
+
 				if (reflector->m_direction == DIR_INCOMING && reflector->m_repeater.empty()) {
 					if (reflector->m_linkState != DCS_UNLINKING)
-						data.addLink(GET_DISP_REFLECTOR(reflector), PROTO_DCS, reflector->m_linkState == DCS_LINKED, DIR_INCOMING, true);
+						data.addLink(GET_DISP_REFLECTOR(reflector), PROTO_DCS, reflector->m_linkState == DCS_LINKED, DIR_INCOMING, true, quality);
 				} else {
 					if (reflector->m_linkState != DCS_UNLINKING)
-						data.addLink(GET_DISP_REFLECTOR(reflector), PROTO_DCS, reflector->m_linkState == DCS_LINKED, reflector->m_direction, false);
+						data.addLink(GET_DISP_REFLECTOR(reflector), PROTO_DCS, reflector->m_linkState == DCS_LINKED, reflector->m_direction, false, quality);
 				}
 			}
 		}
@@ -531,6 +535,7 @@ void CDCSHandler::processInt(CAMBEData& data)
 				m_dcsId  = id;
 				m_dcsSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(temp.getTiming()));
 
 				header.setCQCQCQ();
 				header.setFlags(0x00U, 0x00U, 0x00U);
@@ -543,6 +548,7 @@ void CDCSHandler::processInt(CAMBEData& data)
 				m_inactivityTimer.start();
 
 				m_dcsSeq = seqNo;
+				m_quality.frame(m_dcsSeq, CLinkQuality::getArrival(temp.getTiming()));
 
 				if (m_dcsSeq == 0U) {
 					// Send the header every 21 frames
@@ -558,6 +564,8 @@ void CDCSHandler::processInt(CAMBEData& data)
 					m_dcsId  = 0x00U;
 					m_dcsSeq = 0x00U;
 					m_inactivityTimer.stop();
+
+					endStream();
 				}
 			}
 			break;
@@ -573,6 +581,7 @@ void CDCSHandler::processInt(CAMBEData& data)
 				m_dcsId  = id;
 				m_dcsSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(temp.getTiming()));
 
 				header.setCQCQCQ();
 				header.setFlags(0x00U, 0x00U, 0x00U);
@@ -585,6 +594,7 @@ void CDCSHandler::processInt(CAMBEData& data)
 				m_inactivityTimer.start();
 
 				m_dcsSeq = seqNo;
+				m_quality.frame(m_dcsSeq, CLinkQuality::getArrival(temp.getTiming()));
 
 				if (m_dcsSeq == 0U) {
 					// Send the header every 21 frames
@@ -600,6 +610,8 @@ void CDCSHandler::processInt(CAMBEData& data)
 					m_dcsId  = 0x00U;
 					m_dcsSeq = 0x00U;
 					m_inactivityTimer.stop();
+
+					endStream();
 				}
 			}
 			break;
@@ -688,6 +700,8 @@ bool CDCSHandler::clockInt(unsigned int ms)
 		m_dcsId  = 0x00U;
 		m_dcsSeq = 0x00U;
 
+		endStream();
+
 		switch (m_linkState) {
 			case DCS_LINKING:
 				LogInfo("DCS link to %s has failed to connect", GET_DISP_REFLECTOR(this).c_str());
@@ -721,6 +735,8 @@ bool CDCSHandler::clockInt(unsigned int ms)
 		m_dcsId  = 0x00U;
 		m_dcsSeq = 0x00U;
 		m_inactivityTimer.stop();
+
+		endStream();
 	}
 
 	if (m_pollTimer.isRunning() && m_pollTimer.hasExpired()) {
@@ -806,6 +822,12 @@ void CDCSHandler::writeAMBEInt(IReflectorCallback* handler, CAMBEData& data, DIR
 	m_handler->writeData(data);
 }
 
+void CDCSHandler::endStream()
+{
+	if (m_quality.end())
+		m_quality.report(m_repeater, "dcs", GET_DISP_REFLECTOR(this));
+}
+
 unsigned int CDCSHandler::calcBackoff()
 {
 	if (m_tryCount >= 7U) {
@@ -29,6 +29,7 @@
 #include "ReflectorCallback.h"
 #include "DStarDefines.h"
 #include "CallsignList.h"
+#include "LinkQuality.h"
 #include "ConnectData.h"
 #include "AMBEData.h"
 #include "PollData.h"
@@ -118,6 +119,7 @@ private:
 	unsigned int         m_dcsSeq;
 	unsigned int         m_seqNo;
 	CTimer               m_inactivityTimer;
+	CLinkQuality         m_quality;
 
 	// Header data
 	std::string             m_yourCall;
@@ -127,6 +129,7 @@ private:
 	std::string             m_rptCall2;
 
 	unsigned int calcBackoff();
+	void endStream();
 };
 
 #endif
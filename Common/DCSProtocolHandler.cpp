@@ -19,6 +19,7 @@
  */
 
 #include "DCSProtocolHandler.h"
+#include "VoiceStats.h"
 #include "Utils.h"
 
 // #define	DUMP_TX
@@ -32,7 +33,8 @@ m_buffer(NULL),
 m_length(0U),
 m_yourAddress(),
 m_yourPort(0U),
-m_myPort(port)
+m_myPort(port),
+m_received(0U)
 {
 	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
@@ -42,9 +44,9 @@ CDCSProtocolHandler::~CDCSProtocolHandler()
 	delete[] m_buffer;
 }
 
-bool CDCSProtocolHandler::open()
+bool CDCSProtocolHandler::open(CNetworkReader* reader)
 {
-	return m_socket.open();
+	return m_socket.open(reader);
 }
 
 unsigned int CDCSProtocolHandler::getPort() const
@@ -61,7 +63,11 @@ bool CDCSProtocolHandler::writeData(const CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 #endif
 
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+
+	CVoiceStats::written(data.getTiming(), VP_DCS);
+
+	return res;
 }
 
 bool CDCSProtocolHandler::writePoll(const CPollData& poll)
@@ -109,6 +115,7 @@ bool CDCSProtocolHandler::readPackets()
 		return false;
 
 	m_length = length;
+	m_received = CVoiceStats::stamp();
 
 	if (m_buffer[0] == '0' && m_buffer[1] == '0' && m_buffer[2] == '0' && m_buffer[3] == '1') {
 		if (m_length == 100U) {
@@ -151,10 +158,16 @@ CAMBEData* CDCSProtocolHandler::readData()
 
 	bool res = data->setDCSData(m_buffer, m_length, m_yourAddress, m_yourPort, m_myPort);
 	if (!res) {
+		CVoiceStats::dropped(VP_DCS);
 		delete data;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(data->getTiming(), VP_DCS, m_received);
+
+	// Every DCS frame carries the header, which is what gets routed at the start of a stream
+	data->getHeader().getTiming() = data->getTiming();
+
 	return data;
 }
 
@@ -41,7 +41,7 @@ public:
 	CDCSProtocolHandler(unsigned int port, const std::string& addr = std::string(""));
 	~CDCSProtocolHandler();
 
-	bool open();
+	bool open(CNetworkReader* reader = NULL);
 
 	unsigned int getPort() const;
 
@@ -64,6 +64,7 @@ private:
 	in_addr          m_yourAddress;
 	unsigned int     m_yourPort;
 	unsigned int     m_myPort;
+	uint64_t         m_received;
 
 	bool readPackets();
 };
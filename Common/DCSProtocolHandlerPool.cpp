@@ -24,9 +24,10 @@
 #include "Utils.h"
 #include "Log.h"
 
-CDCSProtocolHandlerPool::CDCSProtocolHandlerPool(const unsigned int port, const std::string &addr) :
+CDCSProtocolHandlerPool::CDCSProtocolHandlerPool(const unsigned int port, const std::string &addr, CNetworkReader* reader) :
 m_basePort(port),
-m_address(addr)
+m_address(addr),
+m_reader(reader)
 {
 	assert(port > 0U);
 	m_index = m_pool.end();
@@ -62,7 +63,7 @@ CDCSProtocolHandler *CDCSProtocolHandlerPool::getHandler(unsigned int port)
 		port++;	// find an unused port
 	CDCSProtocolHandler *proto = new CDCSProtocolHandler(port, m_address);
 	if (proto) {
-		if (proto->open()) {
+		if (proto->open(m_reader)) {
 			m_pool[port] = proto;
 			LogInfo("New DCS Protocol Handler now on port %u.\n", port);
 		} else {
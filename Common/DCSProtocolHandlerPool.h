@@ -28,7 +28,7 @@
 
 class CDCSProtocolHandlerPool {
 public:
-	CDCSProtocolHandlerPool(const unsigned int port, const std::string &addr = std::string(""));
+	CDCSProtocolHandlerPool(const unsigned int port, const std::string &addr = std::string(""), CNetworkReader* reader = NULL);
 	~CDCSProtocolHandlerPool();
 
 	CDCSProtocolHandler *getHandler();
@@ -48,5 +48,6 @@ private:
 	std::map<int,CDCSProtocolHandler *>::iterator m_index;
 	unsigned int m_basePort;
 	std::string m_address;
+	CNetworkReader* m_reader;
 };
 
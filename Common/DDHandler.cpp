@@ -16,19 +16,8 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
-#include <net/if.h>
-#include <arpa/inet.h>
-#include <sys/ioctl.h>
-#include <linux/if_tun.h>
-#include <linux/sockios.h>
-#include <netinet/in.h>
 #include <cstring>
-#include <sys/stat.h>
-#include <fcntl.h>
-#include <iostream>
-#include <fstream>
 #include <cassert>
-#include <unistd.h>
 
 #include "RepeaterHandler.h"
 #include "DDHandler.h"
@@ -36,13 +25,13 @@
 #include "Log.h"
 #include "StringUtils.h"
 
-const unsigned int ETHERNET_ADDRESS_LENGTH = 6U;
-const unsigned int ETHERNET_MTU            = 1500U;
-const unsigned int BUFFER_LENGTH           = 2000U;
-
 const unsigned int MIN_HEARD_TIME_SECS     = 120U;
 
-const int MINIMUM_DD_FRAME_LENGTH = 60;
+// Learnt routes for stations not heard for this long are dropped
+const unsigned int DD_ROUTE_MAX_AGE_SECS   = 3600U;
+const unsigned int DD_ROUTE_EXPIRY_SECS    = 60U;
+
+const unsigned int MINIMUM_DD_FRAME_LENGTH = 60U;
 
 const unsigned char ETHERNET_BROADCAST_ADDRESS[] = {0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU};
 // Multicast address '01:00:5E:00:00:01' - IP: '224.0.0.1' (send to all)
@@ -50,105 +39,40 @@ const unsigned char TOALL_MULTICAST_ADDRESS[] = {0x01U, 0x00U, 0x5EU, 0x00U, 0x0
 // Multicast address '01:00:5E:00:00:23' - IP: '224.0.0.35' (DX-Cluster)
 const unsigned char DX_MULTICAST_ADDRESS[] = {0x01U, 0x00U, 0x5EU, 0x00U, 0x00U, 0x23U};
 
-CIRCDDB*       CDDHandler::m_irc          = NULL;
-int            CDDHandler::m_fd           = -1;
-unsigned int   CDDHandler::m_maxRoutes    = 0U;
-CEthernet**    CDDHandler::m_list         = NULL;
-unsigned char* CDDHandler::m_buffer       = NULL;
-bool           CDDHandler::m_logEnabled   = false;
-std::string       CDDHandler::m_name         = "";
-CTimer         CDDHandler::m_timer        = CTimer(1000U, MIN_HEARD_TIME_SECS);
-
-CEthernet::CEthernet(const unsigned char* address, const std::string& callsign) :
-m_address(NULL),
-m_callsign(callsign)
-{
-	assert(address != NULL);
-	assert(!callsign.empty());
-
-	m_address = new unsigned char[ETHERNET_ADDRESS_LENGTH];
-	::memcpy(m_address, address, ETHERNET_ADDRESS_LENGTH);
-}
-
-CEthernet::~CEthernet()
-{
-	delete[] m_address;
-}
-
-unsigned char* CEthernet::getAddress() const
-{
-	return m_address;
-}
-
-std::string CEthernet::getCallsign() const
-{
-	return m_callsign;
-}
+CIRCDDB*             CDDHandler::m_irc          = NULL;
+CTapDevice*          CDDHandler::m_tap          = NULL;
+CEthernetRouteTable* CDDHandler::m_routes       = NULL;
+bool                 CDDHandler::m_logEnabled   = false;
+std::string          CDDHandler::m_name         = "";
+CTimer               CDDHandler::m_timer        = CTimer(1000U, MIN_HEARD_TIME_SECS);
+CTimer               CDDHandler::m_expiryTimer  = CTimer(1000U, DD_ROUTE_EXPIRY_SECS);
 
 void CDDHandler::initialise(unsigned int maxRoutes, const std::string& name)
 {
 	assert(maxRoutes > 0U);
 
-	m_maxRoutes = maxRoutes;
-	m_name      = name;
-
-	m_buffer = new unsigned char[BUFFER_LENGTH];
+	m_name = name;
 
-	m_list = new CEthernet*[maxRoutes];
-	for (unsigned int i = 0U; i < maxRoutes; i++)
-		m_list[i] = NULL;
+	m_routes = new CEthernetRouteTable(maxRoutes, DD_ROUTE_MAX_AGE_SECS);
 
 	// Add a dummy entry for broadcasts
-	m_list[0] = new CEthernet(ETHERNET_BROADCAST_ADDRESS, "        ");
+	m_routes->addStatic(ETHERNET_BROADCAST_ADDRESS, "        ");
 	// Add a dummy entry for "to all" multicast
-	m_list[1] = new CEthernet(TOALL_MULTICAST_ADDRESS, "CQCQCQ  ");
+	m_routes->addStatic(TOALL_MULTICAST_ADDRESS, "CQCQCQ  ");
 	// Add a dummy entry for "DX-Cluster" multicast
-	m_list[2] = new CEthernet(DX_MULTICAST_ADDRESS, "CQCQCQ  ");
-
-#if defined(__linux__)
-	m_fd = ::open("/dev/net/tun", O_RDWR);
-	if (m_fd < 0) {
-		LogError("Cannot open /dev/net/tun");
-		return;
-	}
+	m_routes->addStatic(DX_MULTICAST_ADDRESS, "CQCQCQ  ");
 
-	struct ifreq ifr1;
-	::memset(&ifr1, 0x00, sizeof(struct ifreq));
+	m_expiryTimer.start();
 
-	ifr1.ifr_flags = IFF_TAP | IFF_NO_PI;
-	::strcpy(ifr1.ifr_name, "tap%d");
-
-	if (::ioctl(m_fd, TUNSETIFF, (void *)&ifr1) < 0) {
-		LogError("TUNSETIFF ioctl failed, closing the tap device");
-		::close(m_fd);
-		m_fd = -1;
-		return;
-	}
-
-	std::string device = std::string(ifr1.ifr_name);
-	LogInfo("DD mode Tap interface created on %s", device.c_str());
-
-	int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
-	if (fd < 0) {
-		LogError("Unable to open the config socket, closing the tap device");
-		::close(m_fd);
-		m_fd = -1;
-		return;
-	}
-
-	struct ifreq ifr2;
-	::memset(&ifr2, 0x00, sizeof(struct ifreq));
-	::strcpy(ifr2.ifr_name, ifr1.ifr_name);
-
-	ifr2.ifr_flags = IFF_UP | IFF_BROADCAST | IFF_MULTICAST;
-	if (::ioctl(fd, SIOCSIFFLAGS, (void *)&ifr2) < 0) {
-		LogError("SIOCSIFFLAGS ioctl failed, closing the tap device");
-		::close(m_fd);
-		m_fd = -1;
+#if defined(__linux__)
+	m_tap = new CTapDevice;
+	if (!m_tap->open()) {
+		delete m_tap;
+		m_tap = NULL;
 		return;
 	}
 
-	::close(fd);
+	LogInfo("DD mode Tap interface created on %s", m_tap->getName().c_str());
 #endif
 }
 
@@ -167,7 +91,7 @@ void CDDHandler::setIRC(CIRCDDB* irc)
 void CDDHandler::process(CDDData& data)
 {
 	// If we're not initialised, return immediately
-	if (m_maxRoutes == 0U)
+	if (m_routes == NULL)
 		return;
 
 	unsigned char flag1 = data.getFlag1();
@@ -189,163 +113,91 @@ void CDDHandler::process(CDDData& data)
 	}
 
 	// Can we continue?
-	if (m_fd < 0)
+	if (m_tap == NULL)
 		return;
 
 	unsigned char* address = data.getSourceAddress();
 
-	bool found = false;
-	for (unsigned int i = 0U; i < m_maxRoutes; i++) {
-		if (m_list[i] != NULL) {
-			unsigned char* addr = m_list[i]->getAddress();
-
-			if (::memcmp(addr, address, ETHERNET_ADDRESS_LENGTH) == 0) {
-				found = true;
-				break;
-			}
-		}
-	}
-
-	if (!found) {
+	if (m_routes->learn(address, myCall1))
 		LogInfo("Adding DD user %s with ethernet address %02X:%02X:%02X:%02X:%02X:%02X", myCall1.c_str(),
 			address[0], address[1], address[2], address[3], address[4], address[5]);
 
-		CEthernet* ethernet = new CEthernet(address, myCall1);
-
-		found = false;
-		for (unsigned int i = 0U; i < m_maxRoutes; i++) {
-			if (m_list[i] == NULL) {
-				m_list[i] = ethernet;
-				found = true;
-				break;
-			}
-		}
-
-		if (!found) {
-			LogError("No space to add new DD ethernet address");
-			delete ethernet;
-			return;
-		}
-	}
+	unsigned char buffer[TAP_FRAME_LENGTH];
+	unsigned int length = data.getEthernetFrame(buffer, TAP_FRAME_LENGTH);
 
-#if defined(__linux__)
-	unsigned int length = data.getEthernetFrame(m_buffer, BUFFER_LENGTH);
+	m_tap->write(buffer, length);
+}
 
-	ssize_t len = ::write(m_fd, (char*)m_buffer, length);
-	if (len != ssize_t(length))
-		LogError("Error returned from write()");
-#endif
+void CDDHandler::flush()
+{
+	if (m_tap != NULL)
+		m_tap->flush();
 }
 
 CDDData* CDDHandler::read()
 {
 	// If we're not initialised, return immediately
-	if (m_maxRoutes == 0U)
-		return NULL;
-
-#if defined(__WINDOWS__)
-	return NULL;
-#else
-	// Check that the read() won't block
-	fd_set readFds;
-	FD_ZERO(&readFds);
-#if defined(__WINDOWS__)
-	FD_SET((unsigned int)m_fd, &readFds);
-#else
-	FD_SET(m_fd, &readFds);
-#endif
-
-	// Return immediately
-	timeval tv;
-	tv.tv_sec  = 0L;
-	tv.tv_usec = 0L;
-
-	int ret = ::select(m_fd + 1, &readFds, NULL, NULL, &tv);
-	if (ret < 0) {
-		LogError("Error returned from select()");
+	if (m_routes == NULL || m_tap == NULL)
 		return NULL;
-	}
-
-#if defined(__WINDOWS__)
-	if (!FD_ISSET((unsigned int)m_fd, &readFds))
-		return NULL;
-#else
-	if (!FD_ISSET(m_fd, &readFds))
-		return NULL;
-#endif
-
-	// Ensure that the minimum length is padded with 0x00s
-	::memset(m_buffer, 0x00U, MINIMUM_DD_FRAME_LENGTH);
-
-	ssize_t len = ::read(m_fd, (char*)m_buffer, BUFFER_LENGTH);
-	if (len <= 0) {
-		LogError("Error returned from read()");
-		return NULL;
-	}
 
-	// There seems to be a minimum size with DD mode, so pad with zeroes if it's not reached
-	if (len < MINIMUM_DD_FRAME_LENGTH)
-		len = MINIMUM_DD_FRAME_LENGTH;
-
-	// Point to the destination ethernet address
-	unsigned char* address = m_buffer + 0U;
-
-	// Do destination address to callsign lookup
-	CEthernet* ethernet = NULL;
-	for (unsigned int i = 0U; i < m_maxRoutes; i++) {
-		if (m_list[i] != NULL) {
-			unsigned char* addr = m_list[i]->getAddress();
-
-			if (::memcmp(addr, address, ETHERNET_ADDRESS_LENGTH) == 0) {
-				ethernet = m_list[i];
-				break;
-			}
+	for (;;) {
+		unsigned int length = 0U;
+		const unsigned char* frame = m_tap->read(length);
+		if (frame == NULL)
+			return NULL;
+
+		// There seems to be a minimum size with DD mode, so pad with zeroes if it's not reached
+		unsigned char padded[MINIMUM_DD_FRAME_LENGTH];
+		if (length < MINIMUM_DD_FRAME_LENGTH) {
+			::memset(padded, 0x00U, MINIMUM_DD_FRAME_LENGTH);
+			::memcpy(padded, frame, length);
+			frame  = padded;
+			length = MINIMUM_DD_FRAME_LENGTH;
 		}
-	}
 
-	if (ethernet == NULL) {
-		LogWarning("Cannot find the ethernet address of %02X:%02X:%02X:%02X:%02X:%02X in the ethernet list", address[0], address[1], address[2], address[3], address[4], address[5]);
-		return NULL;
-	}
-
-	CRepeaterHandler* handler = CRepeaterHandler::findDDRepeater();
-	if (handler == NULL) {
-		LogWarning("Incoming DD data to unknown repeater");
-		return NULL;
-	}
+		// Do destination address to callsign lookup
+		std::string callsign;
+		if (!m_routes->find(frame, callsign)) {
+			LogWarning("Cannot find the ethernet address of %02X:%02X:%02X:%02X:%02X:%02X in the ethernet list", frame[0], frame[1], frame[2], frame[3], frame[4], frame[5]);
+			continue;
+		}
 
-	// LogInfo("Mapping ethernet address %02X:%02X:%02X:%02X:%02X:%02X to user %s",
-	//				address[0], address[1], address[2], address[3], address[4], address[5],
-	//				ethernet->getCallsign().c_str());
+		CRepeaterHandler* handler = CRepeaterHandler::findDDRepeater();
+		if (handler == NULL) {
+			LogWarning("Incoming DD data to unknown repeater");
+			continue;
+		}
 
-	CDDData* data = new CDDData;
-	data->setEthernetFrame(m_buffer, len);
-	data->setYourCall(ethernet->getCallsign());
+		CDDData* data = new CDDData;
+		data->setEthernetFrame(frame, length);
+		data->setYourCall(callsign);
 
-	handler->process(*data);
+		handler->process(*data);
 
-	return data;
-#endif
+		return data;
+	}
 }
 
 void CDDHandler::clock(unsigned int ms)
 {
 	m_timer.clock(ms);
+
+	m_expiryTimer.clock(ms);
+	if (m_expiryTimer.isRunning() && m_expiryTimer.hasExpired()) {
+		if (m_routes != NULL)
+			m_routes->expire();
+		m_expiryTimer.start();
+	}
 }
 
 void CDDHandler::finalise()
 {
-#if !defined(WIN32)
-	if (m_fd >= 0) {
-		::close(m_fd);
-		m_fd = -1;
+	if (m_tap != NULL) {
+		m_tap->close();
+		delete m_tap;
+		m_tap = NULL;
 	}
-#endif
 
-	delete[] m_buffer;
-
-	for (unsigned int i = 0U; i < m_maxRoutes; i++)
-		delete m_list[i];
-	delete[] m_list;
+	delete m_routes;
+	m_routes = NULL;
 }
-
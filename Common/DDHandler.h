@@ -22,20 +22,8 @@
 #include "DDData.h"
 #include "IRCDDB.h"
 #include "Timer.h"
-
-
-class CEthernet {
-public:
-	CEthernet(const unsigned char* address, const std::string& callsign);
-	~CEthernet();
-
-	unsigned char* getAddress() const;
-	std::string       getCallsign() const;
-
-private:
-	unsigned char* m_address;
-	std::string       m_callsign;
-};
+#include "TapDevice.h"
+#include "EthernetRouteTable.h"
 
 class CDDHandler {
 public:
@@ -48,19 +36,21 @@ public:
 
 	static CDDData* read();
 
+	// Send the frames queued by process() to the tap device
+	static void flush();
+
 	static void clock(unsigned int ms);
 
 	static void finalise();
 
 private:
-	static CIRCDDB*       m_irc;
-	static int            m_fd;
-	static unsigned int   m_maxRoutes;
-	static CEthernet**    m_list;
-	static unsigned char* m_buffer;
-	static bool           m_logEnabled;
-	static std::string       m_name;
-	static CTimer         m_timer;
+	static CIRCDDB*             m_irc;
+	static CTapDevice*          m_tap;
+	static CEthernetRouteTable* m_routes;
+	static bool                 m_logEnabled;
+	static std::string          m_name;
+	static CTimer               m_timer;
+	static CTimer               m_expiryTimer;
 };
 
 #endif
@@ -18,6 +18,7 @@
 
 #include "RepeaterHandler.h"
 #include "DExtraHandler.h"
+#include "VoiceStats.h"
 #include "DStarDefines.h"
 #include "Utils.h"
 #include "Log.h"
@@ -52,7 +53,8 @@ m_tryCount(0U),
 m_dExtraId(0x00U),
 m_dExtraSeq(0x00U),
 m_inactivityTimer(1000U, NETWORK_TIMEOUT),
-m_header(NULL)
+m_header(NULL),
+m_quality()
 {
 	assert(protoHandler != NULL);
 	assert(handler != NULL);
@@ -88,7 +90,8 @@ m_tryCount(0U),
 m_dExtraId(0x00U),
 m_dExtraSeq(0x00U),
 m_inactivityTimer(1000U, NETWORK_TIMEOUT),
-m_header(NULL)
+m_header(NULL),
+m_quality()
 {
 	assert(protoHandler != NULL);
 	assert(port > 0U);
@@ -188,12 +191,15 @@ void CDExtraHandler::getInfo(IReflectorCallback* handler, CRemoteRepeaterData& d
 		CDExtraHandler* reflector = m_reflectors[i];
 		if (reflector != NULL) {
 			if (reflector->m_destination == handler) {
+				TLinkQuality quality;
+				reflector->m_quality.getLink(quality);
+
 				if (reflector->m_direction == DIR_INCOMING && reflector->m_repeater.empty()) {
 					if (reflector->m_linkState != DEXTRA_UNLINKING)
-						data.addLink(reflector->m_reflector, PROTO_DEXTRA, reflector->m_linkState == DEXTRA_LINKED, DIR_INCOMING, true);
+						data.addLink(reflector->m_reflector, PROTO_DEXTRA, reflector->m_linkState == DEXTRA_LINKED, DIR_INCOMING, true, quality);
 				} else {
 					if (reflector->m_linkState != DEXTRA_UNLINKING)
-						data.addLink(reflector->m_reflector, PROTO_DEXTRA, reflector->m_linkState == DEXTRA_LINKED, reflector->m_direction, false);
+						data.addLink(reflector->m_reflector, PROTO_DEXTRA, reflector->m_linkState == DEXTRA_LINKED, reflector->m_direction, false, quality);
 				}
 			}
 		}
@@ -595,6 +601,10 @@ void CDExtraHandler::processInt(CHeaderData& header)
 	if (m_linkState != DEXTRA_LINKED)
 		return;
 
+	// Reflectors send each header several times, count those of the stream being relayed
+	if (m_dExtraId != 0x00U && id == m_dExtraId)
+		CVoiceStats::headerRepeat(VP_DEXTRA);
+
 	switch (m_direction) {
 		case DIR_OUTGOING: {
 				// Always a repeater connection
@@ -608,6 +618,7 @@ void CDExtraHandler::processInt(CHeaderData& header)
 				m_dExtraId  = id;
 				m_dExtraSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(header.getTiming()));
 
 				delete m_header;
 
@@ -632,6 +643,7 @@ void CDExtraHandler::processInt(CHeaderData& header)
 				m_dExtraId  = id;
 				m_dExtraSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(header.getTiming()));
 
 				delete m_header;
 
@@ -657,6 +669,7 @@ void CDExtraHandler::processInt(CHeaderData& header)
 				m_dExtraId  = id;
 				m_dExtraSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(header.getTiming()));
 
 				delete m_header;
 
@@ -682,6 +695,7 @@ void CDExtraHandler::processInt(CAMBEData& data)
 	m_inactivityTimer.start();
 
 	m_dExtraSeq = data.getSeq();
+	m_quality.frame(m_dExtraSeq, CLinkQuality::getArrival(data.getTiming()));
 
 	// Send the header every 21 frames, if we have it
 	if (m_dExtraSeq == 0U && m_header != NULL)
@@ -700,6 +714,8 @@ void CDExtraHandler::processInt(CAMBEData& data)
 		m_dExtraSeq = 0x00U;
 
 		m_inactivityTimer.stop();
+
+		endStream();
 	}
 }
 
@@ -779,6 +795,8 @@ bool CDExtraHandler::clockInt(unsigned int ms)
 		m_dExtraId  = 0x00U;
 		m_dExtraSeq = 0x00U;
 
+		endStream();
+
 		switch (m_linkState) {
 			case DEXTRA_LINKING:
 				LogInfo("DExtra link to %s has failed to connect", m_reflector.c_str());
@@ -832,6 +850,8 @@ bool CDExtraHandler::clockInt(unsigned int ms)
 		m_dExtraSeq = 0x00U;
 
 		m_inactivityTimer.stop();
+
+		endStream();
 	}
 
 	if (m_linkState == DEXTRA_LINKING) {
@@ -907,6 +927,12 @@ void CDExtraHandler::writeAMBEInt(IReflectorCallback* handler, CAMBEData& data,
 	}
 }
 
+void CDExtraHandler::endStream()
+{
+	if (m_quality.end())
+		m_quality.report(m_repeater, "dextra", m_reflector);
+}
+
 unsigned int CDExtraHandler::calcBackoff()
 {
 	if (m_tryCount >= 7U) {
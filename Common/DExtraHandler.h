@@ -28,6 +28,7 @@
 #include "ReflectorCallback.h"
 #include "DStarDefines.h"
 #include "CallsignList.h"
+#include "LinkQuality.h"
 #include "ConnectData.h"
 #include "HeaderData.h"
 #include "AMBEData.h"
@@ -118,8 +119,10 @@ private:
 	unsigned int            m_dExtraSeq;
 	CTimer                  m_inactivityTimer;
 	CHeaderData*            m_header;
+	CLinkQuality            m_quality;
 
 	unsigned int calcBackoff();
+	void endStream();
 };
 
 #endif
@@ -19,6 +19,7 @@
  */
 
 #include "DExtraProtocolHandler.h"
+#include "VoiceStats.h"
 #include "Log.h"
 #include "Utils.h"
 
@@ -33,7 +34,8 @@ m_buffer(NULL),
 m_length(0U),
 m_yourAddress(),
 m_yourPort(0U),
-m_myPort(port)
+m_myPort(port),
+m_received(0U)
 {
 	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
@@ -43,9 +45,9 @@ CDExtraProtocolHandler::~CDExtraProtocolHandler()
 	delete[] m_buffer;
 }
 
-bool CDExtraProtocolHandler::open()
+bool CDExtraProtocolHandler::open(CNetworkReader* reader)
 {
-	return m_socket.open();
+	return m_socket.open(reader);
 }
 
 unsigned int CDExtraProtocolHandler::getPort() const
@@ -68,6 +70,8 @@ bool CDExtraProtocolHandler::writeHeader(const CHeaderData& header)
 			return false;
 	}
 
+	CVoiceStats::written(header.getTiming(), VP_DEXTRA);
+
 	return true;
 }
 
@@ -80,7 +84,11 @@ bool CDExtraProtocolHandler::writeAMBE(const CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 #endif
 
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+
+	CVoiceStats::written(data.getTiming(), VP_DEXTRA);
+
+	return res;
 }
 
 bool CDExtraProtocolHandler::writePoll(const CPollData& poll)
@@ -145,6 +153,7 @@ bool CDExtraProtocolHandler::readPackets()
 		return false;
 
 	m_length = length;
+	m_received = CVoiceStats::stamp();
 
 	if (m_buffer[0] != 'D' || m_buffer[1] != 'S' || m_buffer[2] != 'V' || m_buffer[3] != 'T') {
 		switch (m_length) {
@@ -179,10 +188,13 @@ CHeaderData* CDExtraProtocolHandler::readHeader()
 	// DExtra checksums are unreliable
 	bool res = header->setDExtraData(m_buffer, m_length, false, m_yourAddress, m_yourPort, m_myPort);
 	if (!res) {
+		CVoiceStats::dropped(VP_DEXTRA);
 		delete header;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(header->getTiming(), VP_DEXTRA, m_received);
+
 	return header;
 }
 
@@ -195,10 +207,13 @@ CAMBEData* CDExtraProtocolHandler::readAMBE()
 
 	bool res = data->setDExtraData(m_buffer, m_length, m_yourAddress, m_yourPort, m_myPort);
 	if (!res) {
+		CVoiceStats::dropped(VP_DEXTRA);
 		delete data;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(data->getTiming(), VP_DEXTRA, m_received);
+
 	return data;
 }
 
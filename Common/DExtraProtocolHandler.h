@@ -43,7 +43,7 @@ public:
 	CDExtraProtocolHandler(unsigned int port, const std::string& addr = std::string(""));
 	~CDExtraProtocolHandler();
 
-	bool open();
+	bool open(CNetworkReader* reader = NULL);
 
 	unsigned int getPort() const;
 
@@ -69,6 +69,7 @@ private:
 	in_addr          m_yourAddress;
 	unsigned int     m_yourPort;
 	unsigned int     m_myPort;
+	uint64_t         m_received;
 
 	bool readPackets();
 };
@@ -23,9 +23,10 @@
 #include "Utils.h"
 #include "Log.h"
 
-CDExtraProtocolHandlerPool::CDExtraProtocolHandlerPool(const unsigned int port, const std::string &addr) :
+CDExtraProtocolHandlerPool::CDExtraProtocolHandlerPool(const unsigned int port, const std::string &addr, CNetworkReader* reader) :
 m_basePort(port),
-m_address(addr)
+m_address(addr),
+m_reader(reader)
 {
 	assert(port > 0U);
 	m_index = m_pool.end();
@@ -62,7 +63,7 @@ CDExtraProtocolHandler* CDExtraProtocolHandlerPool::getHandler(unsigned int port
 
 	CDExtraProtocolHandler *proto = new CDExtraProtocolHandler(port, m_address);
 	if (proto) {
-		if (proto->open()) {
+		if (proto->open(m_reader)) {
 			m_pool[port] = proto;
 			LogInfo("New CDExtraProtocolHandler now on UDP port %u.\n", port);
 		} else {
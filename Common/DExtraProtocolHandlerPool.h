@@ -26,7 +26,7 @@
 
 class CDExtraProtocolHandlerPool {
 public:
-	CDExtraProtocolHandlerPool(const unsigned int port, const std::string &addr = std::string(""));
+	CDExtraProtocolHandlerPool(const unsigned int port, const std::string &addr = std::string(""), CNetworkReader* reader = NULL);
 	~CDExtraProtocolHandlerPool();
 
 	CDExtraProtocolHandler *getHandler();
@@ -48,5 +48,6 @@ private:
 	std::map<unsigned int, CDExtraProtocolHandler *>::iterator m_index;
 	unsigned int m_basePort;
 	std::string m_address;
+	CNetworkReader* m_reader;
 };
 
@@ -22,6 +22,7 @@
 
 #include "RepeaterHandler.h"
 #include "DPlusHandler.h"
+#include "VoiceStats.h"
 #include "DStarDefines.h"
 #include "Utils.h"
 #include "Log.h"
@@ -61,7 +62,8 @@ m_tryCount(0U),
 m_dPlusId(0x00U),
 m_dPlusSeq(0x00U),
 m_inactivityTimer(1000U, NETWORK_TIMEOUT),
-m_header(NULL)
+m_header(NULL),
+m_quality()
 {
 	assert(protoHandler != NULL);
 	assert(handler != NULL);
@@ -98,7 +100,8 @@ m_tryCount(0U),
 m_dPlusId(0x00U),
 m_dPlusSeq(0x00U),
 m_inactivityTimer(1000U, NETWORK_TIMEOUT),
-m_header(NULL)
+m_header(NULL),
+m_quality()
 {
 	assert(protoHandler != NULL);
 	assert(port > 0U);
@@ -188,8 +191,12 @@ void CDPlusHandler::getInfo(IReflectorCallback* handler, CRemoteRepeaterData& da
 	for (unsigned int i = 0U; i < m_maxReflectors; i++) {
 		CDPlusHandler* reflector = m_reflectors[i];
 		if (reflector != NULL) {
-			if (reflector->m_destination == handler && reflector->m_linkState != DPLUS_UNLINKING)
-				data.addLink(reflector->m_reflector, PROTO_DPLUS, reflector->m_linkState == DPLUS_LINKED, reflector->m_direction, true);
+			if (reflector->m_destination == handler && reflector->m_linkState != DPLUS_UNLINKING) {
+				TLinkQuality quality;
+				reflector->m_quality.getLink(quality);
+
+				data.addLink(reflector->m_reflector, PROTO_DPLUS, reflector->m_linkState == DPLUS_LINKED, reflector->m_direction, true, quality);
+			}
 		}
 	}
 }
@@ -383,9 +390,13 @@ void CDPlusHandler::relink(IReflectorCallback* handler, const std::string &gatew
 	for (unsigned int i = 0U; i < m_maxReflectors; i++) {
 		if (m_reflectors[i] != NULL && m_reflectors[i]->m_direction == DIR_OUTGOING) {
 			if (m_reflectors[i]->m_destination == handler) {
+				m_reflectors[i]->endStream();
+
 				m_reflectors[i]->m_reflector = gateway;
 				m_reflectors[i]->m_dPlusId   = 0x00U;
 				m_reflectors[i]->m_dPlusSeq  = 0x00U;
+				// A different gateway is a different network path
+				m_reflectors[i]->m_quality   = CLinkQuality();
 				return;
 			}
 		}
@@ -576,6 +587,10 @@ void CDPlusHandler::processInt(CHeaderData& header)
 	if (m_linkState != DPLUS_LINKED)
 		return;
 
+	// Reflectors send each header several times, count those of the stream being relayed
+	if (m_dPlusId != 0x00U && id == m_dPlusId)
+		CVoiceStats::headerRepeat(VP_DPLUS);
+
 	switch (m_direction) {
 		case DIR_OUTGOING:
 			if (m_reflector == rpt1 || m_reflector == rpt2) {
@@ -586,6 +601,7 @@ void CDPlusHandler::processInt(CHeaderData& header)
 				m_dPlusId  = id;
 				m_dPlusSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(header.getTiming()));
 				m_pollInactivityTimer.start();
 
 				delete m_header;
@@ -612,6 +628,7 @@ void CDPlusHandler::processInt(CHeaderData& header)
 				m_dPlusId  = id;
 				m_dPlusSeq = 0x00U;
 				m_inactivityTimer.start();
+				m_quality.start(CLinkQuality::getArrival(header.getTiming()));
 				m_pollInactivityTimer.start();
 
 				delete m_header;
@@ -634,6 +651,7 @@ void CDPlusHandler::processInt(CAMBEData& data)
 		return;
 
 	m_dPlusSeq = data.getSeq();
+	m_quality.frame(m_dPlusSeq, CLinkQuality::getArrival(data.getTiming()));
 
 	// Send the header every 21 frames, if we have it
 	if (m_dPlusSeq == 0U && m_header != NULL)
@@ -652,6 +670,8 @@ void CDPlusHandler::processInt(CAMBEData& data)
 		m_header = NULL;
 
 		m_inactivityTimer.stop();
+
+		endStream();
 	}
 }
 
@@ -744,6 +764,8 @@ bool CDPlusHandler::clockInt(unsigned int ms)
 		m_dPlusId  = 0x00U;
 		m_dPlusSeq = 0x00U;
 
+		endStream();
+
 		if (!m_reflector.empty()) {
 			switch (m_linkState) {
 				case DPLUS_LINKING:
@@ -813,6 +835,8 @@ bool CDPlusHandler::clockInt(unsigned int ms)
 		m_dPlusSeq = 0x00U;
 
 		m_inactivityTimer.stop();
+
+		endStream();
 	}
 
 	return false;
@@ -875,6 +899,12 @@ void CDPlusHandler::writeAMBEInt(IReflectorCallback* handler, CAMBEData& data, D
 	}
 }
 
+void CDPlusHandler::endStream()
+{
+	if (m_quality.end())
+		m_quality.report(m_repeater, "dplus", m_reflector);
+}
+
 unsigned int CDPlusHandler::calcBackoff()
 {
 	if (m_tryCount >= 7U) {
@@ -30,6 +30,7 @@
 #include "CacheManager.h"
 #include "DStarDefines.h"
 #include "CallsignList.h"
+#include "LinkQuality.h"
 #include "ConnectData.h"
 #include "HeaderData.h"
 #include "AMBEData.h"
@@ -129,8 +130,10 @@ private:
 	unsigned int           m_dPlusSeq;
 	CTimer                 m_inactivityTimer;
 	CHeaderData*           m_header;
+	CLinkQuality           m_quality;
 
 	unsigned int calcBackoff();
+	void endStream();
 };
 
 #endif
@@ -18,6 +18,7 @@
  */
 
 #include "DPlusProtocolHandler.h"
+#include "VoiceStats.h"
 #include "Log.h"
 #include "DStarDefines.h"
 #include "Utils.h"
@@ -33,7 +34,8 @@ m_buffer(NULL),
 m_length(0U),
 m_yourAddress(),
 m_yourPort(0U),
-m_myPort(port)
+m_myPort(port),
+m_received(0U)
 {
 	m_buffer = new unsigned char[BUFFER_LENGTH];
 }
@@ -43,9 +45,9 @@ CDPlusProtocolHandler::~CDPlusProtocolHandler()
 	delete[] m_buffer;
 }
 
-bool CDPlusProtocolHandler::open()
+bool CDPlusProtocolHandler::open(CNetworkReader* reader)
 {
-	return m_socket.open();
+	return m_socket.open(reader);
 }
 
 unsigned int CDPlusProtocolHandler::getPort() const
@@ -68,6 +70,8 @@ bool CDPlusProtocolHandler::writeHeader(const CHeaderData& header)
 			return false;
 	}
 
+	CVoiceStats::written(header.getTiming(), VP_DPLUS);
+
 	return true;
 }
 
@@ -80,7 +84,11 @@ bool CDPlusProtocolHandler::writeAMBE(const CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 #endif
 
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool res = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+
+	CVoiceStats::written(data.getTiming(), VP_DPLUS);
+
+	return res;
 }
 
 bool CDPlusProtocolHandler::writePoll(const CPollData& poll)
@@ -139,6 +147,7 @@ bool CDPlusProtocolHandler::readPackets()
 		return false;
 
 	m_length = length;
+	m_received = CVoiceStats::stamp();
 
 	if (m_buffer[2] != 'D' || m_buffer[3] != 'S' || m_buffer[4] != 'V' || m_buffer[5] != 'T') {
 		switch (m_length) {
@@ -184,10 +193,13 @@ CHeaderData* CDPlusProtocolHandler::readHeader()
 	// DPlus checksums are unreliable
 	bool res = header->setDPlusData(m_buffer, m_length, false, m_yourAddress, m_yourPort, m_myPort);
 	if (!res) {
+		CVoiceStats::dropped(VP_DPLUS);
 		delete header;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(header->getTiming(), VP_DPLUS, m_received);
+
 	return header;
 }
 
@@ -200,10 +212,13 @@ CAMBEData* CDPlusProtocolHandler::readAMBE()
 
 	bool res = data->setDPlusData(m_buffer, m_length, m_yourAddress, m_yourPort, m_myPort);
 	if (!res) {
+		CVoiceStats::dropped(VP_DPLUS);
 		delete data;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(data->getTiming(), VP_DPLUS, m_received);
+
 	return data;
 }
 
@@ -42,7 +42,7 @@ public:
 	CDPlusProtocolHandler(unsigned int port, const std::string& addr = "");
 	~CDPlusProtocolHandler();
 
-	bool open();
+	bool open(CNetworkReader* reader = NULL);
 
 	unsigned int getPort() const;
 
@@ -68,6 +68,7 @@ private:
 	in_addr          m_yourAddress;
 	unsigned int     m_yourPort;
 	unsigned int     m_myPort;
+	uint64_t         m_received;
 
 	bool readPackets();
 };
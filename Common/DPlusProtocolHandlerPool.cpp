@@ -24,9 +24,10 @@
 #include "Utils.h"
 #include "Log.h"
 
-CDPlusProtocolHandlerPool::CDPlusProtocolHandlerPool(const unsigned int port, const std::string &addr) :
+CDPlusProtocolHandlerPool::CDPlusProtocolHandlerPool(const unsigned int port, const std::string &addr, CNetworkReader* reader) :
 m_basePort(port),
-m_address(addr)
+m_address(addr),
+m_reader(reader)
 {
 	assert(port > 0U);
 	m_index = m_pool.end();
@@ -63,7 +64,7 @@ CDPlusProtocolHandler* CDPlusProtocolHandlerPool::getHandler(unsigned int port)
 
 	CDPlusProtocolHandler *proto = new CDPlusProtocolHandler(port, m_address);
 	if (proto) {
-		if (proto->open()) {
+		if (proto->open(m_reader)) {
 			m_pool[port] = proto;
 			LogInfo("New D Plus Protocol Handler now on UDP port %u.\n", port);
 		} else {
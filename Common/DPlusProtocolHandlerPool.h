@@ -26,7 +26,7 @@
 
 class CDPlusProtocolHandlerPool {
 public:
-	CDPlusProtocolHandlerPool(const unsigned int port, const std::string &addr = std::string(""));
+	CDPlusProtocolHandlerPool(const unsigned int port, const std::string &addr = std::string(""), CNetworkReader* reader = NULL);
 	~CDPlusProtocolHandlerPool();
 
 	CDPlusProtocolHandler *getHandler();
@@ -48,4 +48,5 @@ private:
 	std::map<unsigned int, CDPlusProtocolHandler *>::iterator m_index;
 	unsigned int m_basePort;
 	std::string m_address;
+	CNetworkReader* m_reader;
 };
@@ -0,0 +1,228 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include "DRATSEventLoop.h"
+#include "DRATSServer.h"
+#include "DStarDefines.h"
+#include "Log.h"
+
+CDRATSEventLoop::CDRATSEventLoop() :
+CThread("DRats"),
+m_mutex(),
+m_servers(),
+m_poolMutex(),
+m_pool(),
+m_wakeFds(),
+m_started(false),
+m_stopped(false)
+{
+	m_wakeFds[0] = -1;
+	m_wakeFds[1] = -1;
+}
+
+CDRATSEventLoop::~CDRATSEventLoop()
+{
+	for (unsigned int i = 0U; i < 2U; i++) {
+		if (m_wakeFds[i] >= 0)
+			::close(m_wakeFds[i]);
+	}
+}
+
+bool CDRATSEventLoop::start()
+{
+	if (::pipe(m_wakeFds) < 0) {
+		LogError("Cannot create the D-RATS wake up pipe, err=%d", errno);
+		return false;
+	}
+
+	for (unsigned int i = 0U; i < 2U; i++)
+		::fcntl(m_wakeFds[i], F_SETFL, ::fcntl(m_wakeFds[i], F_GETFL, 0) | O_NONBLOCK);
+
+	m_started = true;
+
+	Create();
+	Run();
+
+	return true;
+}
+
+void CDRATSEventLoop::add(CDRATSServer* server)
+{
+	assert(server != nullptr);
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_servers.push_back(server);
+	}
+
+	wake();
+}
+
+void CDRATSEventLoop::remove(CDRATSServer* server)
+{
+	// The loop holds the lock while it uses a server, once we have it the server is no longer in use
+	std::lock_guard lock(m_mutex);
+	m_servers.erase(std::remove(m_servers.begin(), m_servers.end(), server), m_servers.end());
+}
+
+void CDRATSEventLoop::acquire(std::vector<unsigned char>& buffer)
+{
+	std::lock_guard lock(m_poolMutex);
+
+	if (!m_pool.empty()) {
+		buffer.swap(m_pool.back());
+		m_pool.pop_back();
+	}
+}
+
+void CDRATSEventLoop::release(std::vector<unsigned char>& buffer)
+{
+	if (buffer.capacity() == 0U)
+		return;
+
+	buffer.clear();
+
+	std::lock_guard lock(m_poolMutex);
+
+	if (m_pool.size() < DRATS_POOL_SIZE) {
+		m_pool.emplace_back();
+		m_pool.back().swap(buffer);
+	} else {
+		buffer.shrink_to_fit();
+	}
+}
+
+void CDRATSEventLoop::wake()
+{
+	if (m_wakeFds[1] < 0)
+		return;
+
+	unsigned char c = 0U;
+	ssize_t ret = ::write(m_wakeFds[1], &c, 1U);
+	(void)ret;
+}
+
+void CDRATSEventLoop::stop()
+{
+	if (!m_started)
+		return;
+
+	m_stopped = true;
+	wake();
+
+	Wait();
+
+	m_started = false;
+}
+
+void* CDRATSEventLoop::Entry()
+{
+	LogInfo("Starting the D-RATS event loop");
+
+	std::vector<pollfd> fds;
+	std::vector<CDRATSServer*> owners;
+
+#ifndef DEBUG_DSTARGW
+	try {
+#endif
+		while (!m_stopped) {
+			fds.clear();
+			owners.clear();
+
+			fds.push_back(pollfd{ m_wakeFds[0], POLLIN, 0 });
+			owners.push_back(nullptr);
+
+			bool sending = false;
+			{
+				std::lock_guard lock(m_mutex);
+
+				for (CDRATSServer* server : m_servers) {
+					int fd = server->getListenFd();
+					if (fd >= 0) {
+						fds.push_back(pollfd{ fd, POLLIN, 0 });
+						owners.push_back(server);
+					}
+
+					fd = server->getClientFd();
+					if (fd >= 0) {
+						fds.push_back(pollfd{ fd, POLLIN, 0 });
+						owners.push_back(server);
+					}
+
+					sending = sending || server->isSending();
+				}
+			}
+
+			// Only tick while a message is going out on RF
+			int timeout = sending ? int(DSTAR_FRAME_TIME_MS) : -1;
+
+			int ret = ::poll(fds.data(), fds.size(), timeout);
+			if (ret < 0 && errno != EINTR) {
+				LogError("Error returned from D-RATS poll, err=%d", errno);
+				Sleep(DSTAR_FRAME_TIME_MS);
+				continue;
+			}
+
+			if ((fds[0U].revents & POLLIN) != 0) {
+				unsigned char buffer[16U];
+				while (::read(m_wakeFds[0], buffer, sizeof(buffer)) > 0)
+					;
+			}
+
+			std::lock_guard lock(m_mutex);
+
+			for (unsigned int i = 1U; i < fds.size(); i++) {
+				if (fds[i].revents == 0)
+					continue;
+
+				// The server may have gone while we were polling
+				CDRATSServer* server = owners[i];
+				if (std::find(m_servers.begin(), m_servers.end(), server) == m_servers.end())
+					continue;
+
+				if (fds[i].fd == server->getListenFd())
+					server->accept();
+				else if (fds[i].fd == server->getClientFd())
+					server->serviceSocket();
+			}
+
+			for (CDRATSServer* server : m_servers)
+				server->transmit();
+		}
+#ifndef DEBUG_DSTARGW
+	}
+	catch (std::exception& e) {
+		std::string message(e.what());
+		LogError("Exception raised in the D-RATS event loop - \"%s\"", message.c_str());
+	}
+	catch (...) {
+		LogError("Unknown exception raised in the D-RATS event loop");
+	}
+#endif
+
+	LogInfo("Stopping the D-RATS event loop");
+
+	return NULL;
+}
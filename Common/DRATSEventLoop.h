@@ -0,0 +1,62 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "Thread.h"
+
+class CDRATSServer;
+
+const unsigned int DRATS_POOL_SIZE = 4U;
+
+// One thread serves the D-RATS sockets of every repeater. It sleeps in poll() until a client
+// connects or sends something, and only wakes on a timer while a message is being sent on RF.
+// The servers borrow their message buffers from here, so an idle module holds none.
+class CDRATSEventLoop : public CThread {
+public:
+	CDRATSEventLoop();
+	virtual ~CDRATSEventLoop();
+
+	bool start();
+
+	void add(CDRATSServer* server);
+	void remove(CDRATSServer* server);
+
+	// Swap a pooled buffer into an empty one, and hand it back cleared when done
+	void acquire(std::vector<unsigned char>& buffer);
+	void release(std::vector<unsigned char>& buffer);
+
+	// Make poll() return so that the sockets and timeouts are looked at again
+	void wake();
+
+	void stop();
+
+	virtual void* Entry();
+
+private:
+	std::mutex                              m_mutex;
+	std::vector<CDRATSServer*>              m_servers;
+	std::mutex                              m_poolMutex;
+	std::vector<std::vector<unsigned char>> m_pool;
+	int                                     m_wakeFds[2];
+	bool                                    m_started;
+	bool                                    m_stopped;
+};
@@ -18,62 +18,102 @@
 
 #include "DStarDefines.h"
 #include "DRATSServer.h"
+#include "NetUtils.h"
 #include "Utils.h"
 #include "Log.h"
 
+#include <algorithm>
 #include <cassert>
-#include <string.h>
+#include <cerrno>
+#include <cstring>
 #include <chrono>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 // #define	LOOPBACK
 
 const unsigned int BUFFER_LENGTH = 30000U;
+const unsigned int READ_LENGTH   = 2048U;
 
-CDRATSServer::CDRATSServer(const std::string& address, unsigned int port, const std::string& callsign, IRepeaterCallback* handler) :
-CThread("DRats"),
+const char         EOB_MARKER[]  = "[EOB]";
+const unsigned int EOB_LENGTH    = 5U;
+
+CDRATSServer::CDRATSServer(const std::string& address, unsigned int port, const std::string& callsign, IRepeaterCallback* handler, CDRATSEventLoop* loop) :
 m_address(address),
 m_port(port),
 m_callsign(callsign),
 m_handler(handler),
-m_socket(NULL),
-m_stopped(false),
+m_loop(loop),
+m_listenFd(-1),
+m_clientFd(-1),
+m_mutex(),
 m_readState(SS_FIRST),
-m_readBuffer(NULL),
-m_readLength(0U),
+m_readBuffer(),
 m_readPos(0U),
 m_readEnd(false),
-m_writeText(NULL),
+m_sending(false),
+m_id(0U),
+m_seqNo(0U),
+m_sent(0U),
+m_time(),
+m_writeText(),
 m_writeState(SS_FIRST),
-m_writeBuffer(NULL),
-m_writeLength(0U)
+m_writeBuffer()
 {
 	assert(handler != NULL);
+	assert(loop != NULL);
 	assert(port > 0U);
-
-	m_readBuffer  = new unsigned char[BUFFER_LENGTH];
-	m_writeBuffer = new unsigned char[BUFFER_LENGTH];
-	m_writeText   = new unsigned char[6U];
 }
 
 CDRATSServer::~CDRATSServer()
 {
-	delete[] m_readBuffer;
-	delete[] m_writeBuffer;
-	delete[] m_writeText;
 }
 
 bool CDRATSServer::open()
 {
-	m_socket = new CTCPReaderWriterServer(m_address, m_port);
-	bool ret = m_socket->start();
-	if (!ret) {
-		delete m_socket;
-		m_socket = NULL;
+	m_listenFd = ::socket(PF_INET, SOCK_STREAM, 0);
+	if (m_listenFd < 0) {
+		LogError("Cannot create the TCP server socket, err=%d", errno);
+		return false;
+	}
+
+	struct sockaddr_in addr;
+	::memset(&addr, 0x00, sizeof(struct sockaddr_in));
+	addr.sin_family = AF_INET;
+	addr.sin_port   = htons(m_port);
+	if (m_address.empty()) {
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	} else {
+		sockaddr_storage addr4;
+		addr.sin_addr.s_addr = CNetUtils::lookupV4(m_address, addr4) ? TOIPV4(addr4)->sin_addr.s_addr : INADDR_NONE;
+	}
+
+	if (addr.sin_addr.s_addr == INADDR_NONE) {
+		LogError("The address is invalid - %s", m_address.c_str());
+		close();
+		return false;
+	}
+
+	int reuse = 1;
+	if (::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, (char *)&reuse, sizeof(reuse)) == -1) {
+		LogError("Cannot set the TCP server socket option, err=%d", errno);
+		close();
 		return false;
 	}
 
-	Create();
-	Run();
+	if (::bind(m_listenFd, (sockaddr*)&addr, sizeof(struct sockaddr_in)) == -1) {
+		LogError("Cannot bind the TCP server address, err=%d", errno);
+		close();
+		return false;
+	}
+
+	::listen(m_listenFd, 5);
+
+	LogInfo("D-RATS Server for %s listening on port %u", m_callsign.c_str(), m_port);
+
+	m_loop->add(this);
 
 	return true;
 }
@@ -82,12 +122,7 @@ void CDRATSServer::writeHeader(const CHeaderData&)
 {
 	m_writeState = SS_FIRST;
 
-	if (m_writeLength > 0U && m_socket != NULL) {
-		CUtils::dump("From RF", m_writeBuffer, m_writeLength);
-		m_socket->write(m_writeBuffer, m_writeLength);
-	}
-
-	m_writeLength = 0U;
+	sendBuffer();
 }
 
 void CDRATSServer::writeData(const CAMBEData& data)
@@ -99,12 +134,7 @@ void CDRATSServer::writeData(const CAMBEData& data)
 	}
 
 	if (data.isEnd()) {
-		if (m_writeLength > 0U && m_socket != NULL) {
-			CUtils::dump("From RF", m_writeBuffer, m_writeLength);
-			m_socket->write(m_writeBuffer, m_writeLength);
-		}
-
-		m_writeLength = 0U;
+		sendBuffer();
 		return;
 	}
 
@@ -141,244 +171,298 @@ void CDRATSServer::writeData(const CAMBEData& data)
 	if (length > 5U)
 		length = 5U;
 
-	for (unsigned int i = 0U; i < length; i++) {
-		m_writeBuffer[m_writeLength++] = m_writeText[i + 1U];
-
-		// Check for [EOB] in the buffer to signal the end of the D-RATS data.
-		// To allow strstr() to run correctly
-		m_writeBuffer[m_writeLength] = 0x00U;
+	if (m_writeBuffer.capacity() == 0U)
+		m_loop->acquire(m_writeBuffer);
 
-		if (::strstr((char*)m_writeBuffer, "[EOB]") != NULL) {
-			if (m_socket != NULL) {
-				CUtils::dump("From RF", m_writeBuffer, m_writeLength);
-				m_socket->write(m_writeBuffer, m_writeLength);
-			}
+	for (unsigned int i = 0U; i < length && m_writeBuffer.size() < BUFFER_LENGTH; i++) {
+		m_writeBuffer.push_back(m_writeText[i + 1U]);
 
-			m_writeLength = 0U;
-		}
+		// Check for [EOB] at the end of the buffer to signal the end of the D-RATS data
+		if (m_writeBuffer.size() >= EOB_LENGTH && ::memcmp(m_writeBuffer.data() + m_writeBuffer.size() - EOB_LENGTH, EOB_MARKER, EOB_LENGTH) == 0)
+			sendBuffer();
 	}
 }
 
 void CDRATSServer::writeEnd()
 {
-	if (m_writeLength > 0U && m_socket != NULL) {
-		CUtils::dump("From RF", m_writeBuffer, m_writeLength);
-		m_socket->write(m_writeBuffer, m_writeLength);
+	sendBuffer();
+}
+
+void CDRATSServer::close()
+{
+	m_loop->remove(this);
+
+	closeClient();
+
+	if (m_listenFd >= 0) {
+		::close(m_listenFd);
+		m_listenFd = -1;
 	}
 
-	m_writeLength = 0U;
+	m_loop->release(m_readBuffer);
+	m_loop->release(m_writeBuffer);
 }
 
-void* CDRATSServer::Entry()
+int CDRATSServer::getListenFd() const
 {
-	LogInfo("Starting the D-RATS Server thread for %s", m_callsign.c_str());
+	return m_listenFd;
+}
 
-	bool sending = false;
-	unsigned int id = 0U;
+int CDRATSServer::getClientFd() const
+{
+	std::lock_guard lock(m_mutex);
 
-	unsigned char seqNo = 0U;
-	unsigned int  sent = 0U;
+	return m_clientFd;
+}
 
-	std::chrono::high_resolution_clock::time_point time;
+bool CDRATSServer::isSending() const
+{
+	return m_readEnd;
+}
 
-#ifndef DEBUG_DSTARGW
-	try {
-#endif
-		while (!m_stopped) {
-			serviceSocket();
+void CDRATSServer::accept()
+{
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(struct sockaddr_in);
+
+	int fd = ::accept(m_listenFd, (sockaddr*)&addr, &len);
+	if (fd < 0) {
+		LogError("Error returned from TCP server accept, err=%d", errno);
+		return;
+	}
+
+	std::lock_guard lock(m_mutex);
+
+	// D-RATS talks to a single client at a time
+	if (m_clientFd >= 0) {
+		LogWarning("Rejecting a second TCP connection to port %u", m_port);
+		::close(fd);
+		return;
+	}
+
+	LogInfo("Incoming TCP connection to port %u", m_port);
+	m_clientFd = fd;
+}
+
+void CDRATSServer::serviceSocket()
+{
+	unsigned char buffer[READ_LENGTH];
+	ssize_t len;
+
+	{
+		std::lock_guard lock(m_mutex);
+
+		// The gateway thread may have dropped the client since it was polled
+		if (m_clientFd < 0)
+			return;
+
+		len = ::recv(m_clientFd, buffer, READ_LENGTH, MSG_DONTWAIT);
+		if (len == 0 || (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+			LogWarning("Lost TCP connection to port %u", m_port);
+			::close(m_clientFd);
+			m_clientFd = -1;
+			return;
+		}
+	}
+
+	if (len < 0)
+		return;
+
+	if (m_readBuffer.capacity() == 0U)
+		m_loop->acquire(m_readBuffer);
+
+	unsigned int start = m_readBuffer.size() >= EOB_LENGTH ? m_readBuffer.size() - EOB_LENGTH + 1U : 0U;
 
-			if (m_readEnd && !sending) {
-				id = CHeaderData::createId();
+	unsigned int space = BUFFER_LENGTH - m_readBuffer.size();
+	if (unsigned(len) > space)
+		len = space;
 
-				// Write header
-				CHeaderData header;
-				header.setMyCall1(m_callsign);
-				header.setMyCall2("DATA");
-				header.setYourCall("CQCQCQ  ");
-				header.setId(id);
+	m_readBuffer.insert(m_readBuffer.end(), buffer, buffer + len);
+
+	if (!m_readEnd) {
+		auto it = std::search(m_readBuffer.begin() + start, m_readBuffer.end(), EOB_MARKER, EOB_MARKER + EOB_LENGTH);
+		if (it != m_readBuffer.end()) {
+			CUtils::dump("To RF", m_readBuffer.data(), m_readBuffer.size());
+			m_readEnd = true;
+		}
+	}
+}
+
+void CDRATSServer::transmit()
+{
+	if (m_readEnd && !m_sending) {
+		m_id = CHeaderData::createId();
+
+		// Write header
+		CHeaderData header;
+		header.setMyCall1(m_callsign);
+		header.setMyCall2("DATA");
+		header.setYourCall("CQCQCQ  ");
+		header.setId(m_id);
 
 #if defined(LOOPBACK)
-				writeHeader(header);
+		writeHeader(header);
 #else
-				m_handler->process(header, DIR_INCOMING, AS_DRATS);
+		m_handler->process(header, DIR_INCOMING, AS_DRATS);
 #endif
 
-				m_readState = SS_FIRST;
-				m_readPos   = 0U;
-				sending     = true;
-				seqNo       = 0U;
-				sent        = 0U;
+		m_readState = SS_FIRST;
+		m_readPos   = 0U;
+		m_sending   = true;
+		m_seqNo     = 0U;
+		m_sent      = 0U;
 
-				time = std::chrono::high_resolution_clock::now();
-			}
+		m_time = std::chrono::steady_clock::now();
+	}
+
+	if (!m_readEnd || !m_sending)
+		return;
 
-			if (m_readEnd && sending) {
-				unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - time).count() / DSTAR_FRAME_TIME_MS;
+	unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_time).count() / DSTAR_FRAME_TIME_MS;
+	unsigned int readLength = m_readBuffer.size();
 
-				while (sent < needed && sending) {
-					// Write AMBE data
-					CAMBEData data;
-					data.setId(id);
+	while (m_sent < needed && m_sending) {
+		// Write AMBE data
+		CAMBEData data;
+		data.setId(m_id);
 
-					unsigned char buffer[DV_FRAME_LENGTH_BYTES];
-					::memcpy(buffer + 0U, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+		::memcpy(buffer + 0U, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
 
-					// Insert sync bytes when the sequence number is zero, slow data otherwise
-					if (seqNo == 0U) {
-						::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-						m_readState = SS_FIRST;
-					} else {
-						if (m_readState == SS_FIRST) {
-							unsigned char readText[3U];
-							::memset(readText, 'f', 3U);
+		// Insert sync bytes when the sequence number is zero, slow data otherwise
+		if (m_seqNo == 0U) {
+			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+			m_readState = SS_FIRST;
+		} else {
+			if (m_readState == SS_FIRST) {
+				unsigned char readText[3U];
+				::memset(readText, 'f', 3U);
 
-							unsigned int length = m_readLength - m_readPos;
-							unsigned char bytes = 5U;
-							if (length < 5U)
-								bytes = length;
+				unsigned int length = readLength - m_readPos;
+				unsigned char bytes = 5U;
+				if (length < 5U)
+					bytes = length;
 
-							readText[0U] = SLOW_DATA_TYPE_GPS | bytes;
+				readText[0U] = SLOW_DATA_TYPE_GPS | bytes;
 
-							for (unsigned int i = 0U; i < 2U && m_readPos < m_readLength; i++)
-								readText[i + 1U] = m_readBuffer[m_readPos++];
+				for (unsigned int i = 0U; i < 2U && m_readPos < readLength; i++)
+					readText[i + 1U] = m_readBuffer[m_readPos++];
 
-							readText[0U] ^= SCRAMBLER_BYTE1;
-							readText[1U] ^= SCRAMBLER_BYTE2;
-							readText[2U] ^= SCRAMBLER_BYTE3;
+				readText[0U] ^= SCRAMBLER_BYTE1;
+				readText[1U] ^= SCRAMBLER_BYTE2;
+				readText[2U] ^= SCRAMBLER_BYTE3;
 
-							::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, readText, DATA_FRAME_LENGTH_BYTES);
+				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, readText, DATA_FRAME_LENGTH_BYTES);
 
-							m_readState = SS_SECOND;
-						} else {
-							unsigned char readText[3U];
-							::memset(readText, 'f', 3U);
+				m_readState = SS_SECOND;
+			} else {
+				unsigned char readText[3U];
+				::memset(readText, 'f', 3U);
 
-							for (unsigned int i = 0U; i < 3U && m_readPos < m_readLength; i++)
-								readText[i] = m_readBuffer[m_readPos++];
+				for (unsigned int i = 0U; i < 3U && m_readPos < readLength; i++)
+					readText[i] = m_readBuffer[m_readPos++];
 
-							readText[0U] ^= SCRAMBLER_BYTE1;
-							readText[1U] ^= SCRAMBLER_BYTE2;
-							readText[2U] ^= SCRAMBLER_BYTE3;
+				readText[0U] ^= SCRAMBLER_BYTE1;
+				readText[1U] ^= SCRAMBLER_BYTE2;
+				readText[2U] ^= SCRAMBLER_BYTE3;
 
-							::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, readText, DATA_FRAME_LENGTH_BYTES);				
+				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, readText, DATA_FRAME_LENGTH_BYTES);
 
-							m_readState = SS_FIRST;
-						}
-					}
+				m_readState = SS_FIRST;
+			}
+		}
 
-					data.setSeq(seqNo);
-					data.setData(buffer, DV_FRAME_LENGTH_BYTES);
-					sent++;
+		data.setSeq(m_seqNo);
+		data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+		m_sent++;
 
 #if defined(LOOPBACK)
-					writeData(data);
+		writeData(data);
 #else
-					m_handler->process(data, DIR_INCOMING, AS_DRATS);
+		m_handler->process(data, DIR_INCOMING, AS_DRATS);
 #endif
-					if (m_readPos == m_readLength) {
-						if (m_readState == SS_SECOND) {
-							seqNo++;
-							if (seqNo == 21U)
-								seqNo = 0U;
-
-							unsigned char readText[3U];
-							readText[0U] = 'f' ^ SCRAMBLER_BYTE1;
-							readText[1U] = 'f' ^ SCRAMBLER_BYTE2;
-							readText[2U] = 'f' ^ SCRAMBLER_BYTE3;
-
-							::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, readText, DATA_FRAME_LENGTH_BYTES);
-
-							data.setSeq(seqNo);
-							data.setData(buffer, DV_FRAME_LENGTH_BYTES);
-							sent++;
+		if (m_readPos == readLength) {
+			if (m_readState == SS_SECOND) {
+				m_seqNo++;
+				if (m_seqNo == 21U)
+					m_seqNo = 0U;
+
+				unsigned char readText[3U];
+				readText[0U] = 'f' ^ SCRAMBLER_BYTE1;
+				readText[1U] = 'f' ^ SCRAMBLER_BYTE2;
+				readText[2U] = 'f' ^ SCRAMBLER_BYTE3;
+
+				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, readText, DATA_FRAME_LENGTH_BYTES);
+
+				data.setSeq(m_seqNo);
+				data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+				m_sent++;
 #if defined(LOOPBACK)
-							writeData(data);
+				writeData(data);
 #else
-							m_handler->process(data, DIR_INCOMING, AS_DRATS);
+				m_handler->process(data, DIR_INCOMING, AS_DRATS);
 #endif
-						}
+			}
 
-						seqNo++;
-						if (seqNo == 21U)
-							seqNo = 0U;
+			m_seqNo++;
+			if (m_seqNo == 21U)
+				m_seqNo = 0U;
 
-						if (seqNo == 0U)
-							::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-						else
-							::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
+			if (m_seqNo == 0U)
+				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+			else
+				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
 
-						data.setData(buffer, DV_FRAME_LENGTH_BYTES);
-						data.setSeq(seqNo);
-						data.setEnd(true);
-						sent++;
+			data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+			data.setSeq(m_seqNo);
+			data.setEnd(true);
+			m_sent++;
 #if defined(LOOPBACK)
-						writeData(data);
+			writeData(data);
 #else
-						m_handler->process(data, DIR_INCOMING, AS_DRATS);
+			m_handler->process(data, DIR_INCOMING, AS_DRATS);
 #endif
-						m_readLength = 0U;
-						m_readPos    = 0U;
-						m_readEnd    = false;
-						sending      = false;
-						sent         = 0U;
-					}
-
-					seqNo++;
-					if (seqNo == 21U)
-						seqNo = 0U;
-				}
-			}
-
-			// 50ms
-			Sleep(50UL);
+			// The message has gone, the buffer goes back to the pool
+			m_loop->release(m_readBuffer);
+			m_readPos = 0U;
+			m_readEnd = false;
+			m_sending = false;
+			m_sent    = 0U;
 		}
 
-		if (m_socket != NULL)
-			m_socket->stop();
-#ifndef DEBUG_DSTARGW
-	}
-	catch (std::exception& e) {
-		std::string message(e.what());
-		LogError("Exception raised in the D-RATS Server thread - \"%s\"", message.c_str());
-	}
-	catch (...) {
-		LogError("Unknown exception raised in the D-RATS Server thread");
+		m_seqNo++;
+		if (m_seqNo == 21U)
+			m_seqNo = 0U;
 	}
-#endif
-
-	LogInfo("Stopping the D-RATS Server thread for %s", m_callsign.c_str());
-
-	return NULL;
 }
 
-void CDRATSServer::close()
+void CDRATSServer::sendBuffer()
 {
-	m_stopped = true;
+	if (!m_writeBuffer.empty()) {
+		std::lock_guard lock(m_mutex);
+
+		if (m_clientFd >= 0) {
+			CUtils::dump("From RF", m_writeBuffer.data(), m_writeBuffer.size());
+
+			ssize_t len = ::send(m_clientFd, m_writeBuffer.data(), m_writeBuffer.size(), MSG_NOSIGNAL);
+			if (len != ssize_t(m_writeBuffer.size())) {
+				LogError("Lost TCP connection to port %u", m_port);
+				::close(m_clientFd);
+				m_clientFd = -1;
+				m_loop->wake();
+			}
+		}
+	}
 
-	Wait();
+	m_loop->release(m_writeBuffer);
 }
 
-void CDRATSServer::serviceSocket()
+void CDRATSServer::closeClient()
 {
-	if (m_socket == NULL) {
-		m_readLength  = 0U;
-		m_readPos     = 0U;
-		m_readEnd     = false;
-		return;
-	}
-
-	int len = m_socket->read(m_readBuffer + m_readLength, BUFFER_LENGTH - m_readLength, 0U);
-	if (len > 0) {
-		m_readLength += len;
-
-		if (!m_readEnd) {
-			// To allow strstr() to run correctly
-			m_readBuffer[m_readLength] = 0x00U;
+	std::lock_guard lock(m_mutex);
 
-			if (::strstr((char*)m_readBuffer, "[EOB]") != NULL) {
-				CUtils::dump("To RF", m_readBuffer, m_readLength);
-				m_readEnd = true;
-			}
-		}
+	if (m_clientFd >= 0) {
+		::close(m_clientFd);
+		m_clientFd = -1;
 	}
 }
@@ -19,18 +19,20 @@
 #ifndef DRATSServer_H
 #define DRATSServer_H
 
-#include "TCPReaderWriterServer.h"
+#include "DRATSEventLoop.h"
 #include "RepeaterCallback.h"
 #include "HeaderData.h"
 #include "AMBEData.h"
 #include "Defs.h"
-#include "Thread.h"
 
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <vector>
 
-class CDRATSServer : public CThread {
+class CDRATSServer {
 public:
-	CDRATSServer(const std::string& address, unsigned int port, const std::string& callsign, IRepeaterCallback* handler);
+	CDRATSServer(const std::string& address, unsigned int port, const std::string& callsign, IRepeaterCallback* handler, CDRATSEventLoop* loop);
 	virtual ~CDRATSServer();
 
 	virtual bool open();
@@ -41,26 +43,39 @@ public:
 
 	virtual void close();
 
-	virtual void* Entry();
+	// Called from the event loop thread
+	int  getListenFd() const;
+	int  getClientFd() const;
+	bool isSending() const;
+
+	void accept();
+	void serviceSocket();
+	void transmit();
 
 private:
-	std::string                   m_address;
+	std::string                m_address;
 	unsigned int               m_port;
-	std::string                   m_callsign;
+	std::string                m_callsign;
 	IRepeaterCallback*         m_handler;
-	CTCPReaderWriterServer*    m_socket;
-	bool                       m_stopped;
+	CDRATSEventLoop*           m_loop;
+	int                        m_listenFd;
+	int                        m_clientFd;
+	mutable std::mutex         m_mutex;
 	SLOWDATA_STATE             m_readState;
-	unsigned char*             m_readBuffer;
-	unsigned int               m_readLength;
+	std::vector<unsigned char> m_readBuffer;
 	unsigned int               m_readPos;
 	bool                       m_readEnd;
-	unsigned char*             m_writeText;
+	bool                       m_sending;
+	unsigned int               m_id;
+	unsigned char              m_seqNo;
+	unsigned int               m_sent;
+	std::chrono::steady_clock::time_point m_time;
+	unsigned char              m_writeText[6U];
 	SLOWDATA_STATE             m_writeState;
-	unsigned char*             m_writeBuffer;
-	unsigned int               m_writeLength;
+	std::vector<unsigned char> m_writeBuffer;
 
-	void serviceSocket();
+	void sendBuffer();
+	void closeClient();
 };
 
 #endif
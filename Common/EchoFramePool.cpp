@@ -0,0 +1,78 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+
+#include "EchoFramePool.h"
+
+CEchoFramePool::CEchoFramePool(unsigned int budget) :
+m_arena(nullptr),
+m_blockCount(budget / (ECHO_BLOCK_FRAMES * sizeof(TEchoFrame))),
+m_free(),
+m_mutex()
+{
+	if (m_blockCount == 0U)
+		m_blockCount = 1U;
+
+	m_arena = new TEchoFrame[m_blockCount * ECHO_BLOCK_FRAMES];
+
+	// Hand out the lowest blocks first
+	m_free.reserve(m_blockCount);
+	for (unsigned int i = m_blockCount; i > 0U; i--)
+		m_free.push_back(i - 1U);
+}
+
+CEchoFramePool::~CEchoFramePool()
+{
+	delete[] m_arena;
+}
+
+TEchoFrame* CEchoFramePool::allocate()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_free.empty())
+		return nullptr;
+
+	unsigned int n = m_free.back();
+	m_free.pop_back();
+
+	return m_arena + n * ECHO_BLOCK_FRAMES;
+}
+
+void CEchoFramePool::release(TEchoFrame* block)
+{
+	assert(block != nullptr);
+	assert(block >= m_arena && block < m_arena + m_blockCount * ECHO_BLOCK_FRAMES);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_free.push_back((unsigned int)((block - m_arena) / ECHO_BLOCK_FRAMES));
+}
+
+unsigned int CEchoFramePool::getBlockCount() const
+{
+	return m_blockCount;
+}
+
+unsigned int CEchoFramePool::getFreeCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return (unsigned int)m_free.size();
+}
@@ -0,0 +1,60 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "DStarDefines.h"
+
+// One recorded frame, the voice and slow data plus what is needed to play it back
+struct TEchoFrame {
+	unsigned char m_data[DV_FRAME_LENGTH_BYTES];
+	uint16_t      m_id;
+	uint8_t       m_seq;
+	uint8_t       m_reserved;
+};
+
+// Recordings grow five seconds at a time
+const unsigned int ECHO_BLOCK_FRAMES = 5U * DSTAR_FRAMES_PER_SEC;
+
+// Gateway wide store for echo recordings. The memory budget is allocated once, as one contiguous
+// arena cut into fixed size blocks of frames, so recording never touches the heap and several
+// modules can record at the same time for as long as the budget allows.
+class CEchoFramePool {
+public:
+	CEchoFramePool(unsigned int budget);
+	~CEchoFramePool();
+
+	TEchoFrame* allocate();
+	void release(TEchoFrame* block);
+
+	unsigned int getBlockCount() const;
+	unsigned int getFreeCount() const;
+
+private:
+	CEchoFramePool(const CEchoFramePool&) = delete;
+	CEchoFramePool& operator=(const CEchoFramePool&) = delete;
+
+	TEchoFrame*               m_arena;
+	unsigned int              m_blockCount;
+	std::vector<unsigned int> m_free;
+	mutable std::mutex        m_mutex;
+};
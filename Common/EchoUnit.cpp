@@ -22,34 +22,50 @@
 
 #include "DStarDefines.h"
 #include "EchoUnit.h"
+#include "VoiceStats.h"
 #include "Defs.h"
 #include "Utils.h"
 #include "Log.h"
 
 const unsigned int MAX_FRAMES = 60U * DSTAR_FRAMES_PER_SEC;
 
+CEchoFramePool* CEchoUnit::m_pool = NULL;
+
+void CEchoUnit::initialise(unsigned int memory)
+{
+	delete m_pool;
+	m_pool = new CEchoFramePool(memory);
+
+	LogInfo("Echo memory: %u kB, %.0f secs of recording", memory / 1024U, float(m_pool->getBlockCount() * ECHO_BLOCK_FRAMES) / float(DSTAR_FRAMES_PER_SEC));
+}
+
+void CEchoUnit::finalise()
+{
+	delete m_pool;
+	m_pool = NULL;
+}
+
 CEchoUnit::CEchoUnit(IRepeaterCallback* handler, const std::string& callsign) :
 m_handler(handler),
 m_callsign(callsign),
 m_status(ES_IDLE),
 m_timer(1000U, REPLY_TIME),
-m_header(NULL),
-m_data(NULL),
+m_header(),
+m_blocks(),
+m_frame(),
+m_full(false),
 m_in(0U),
 m_out(0U),
-m_time()
+m_pacer(DSTAR_FRAME_TIME_MS)
 {
 	assert(handler != NULL);
 
-	m_data = new CAMBEData*[MAX_FRAMES];
-
-	for (unsigned int i = 0U; i < MAX_FRAMES; i++)
-		m_data[i] = NULL;
+	m_blocks.reserve((MAX_FRAMES + ECHO_BLOCK_FRAMES - 1U) / ECHO_BLOCK_FRAMES);
 }
 
 CEchoUnit::~CEchoUnit()
 {
-	delete[] m_data;
+	releaseBlocks();
 }
 
 void CEchoUnit::writeHeader(const CHeaderData& header)
@@ -57,8 +73,16 @@ void CEchoUnit::writeHeader(const CHeaderData& header)
 	if (m_status != ES_IDLE)
 		return;
 
-	m_header = new CHeaderData(header);
+	if (m_pool == NULL) {
+		LogWarning("Echo memory has not been set up, cannot echo");
+		return;
+	}
+
+	m_header = header;
+	// Played back much later, the wait is not gateway latency
+	CVoiceStats::reset(m_header.getTiming());
 
+	m_full   = false;
 	m_in     = 0U;		
 	m_status = ES_RECEIVE;
 }
@@ -68,13 +92,29 @@ void CEchoUnit::writeData(const CAMBEData& data)
 	if (m_status != ES_RECEIVE)
 		return;
 
-	if (m_in < MAX_FRAMES) {
-		m_data[m_in] = new CAMBEData(data);
-		m_in++;
+	if (m_in < MAX_FRAMES && !m_full) {
+		// Take another block from the shared pool when the current one is full
+		if (m_in == m_blocks.size() * ECHO_BLOCK_FRAMES) {
+			TEchoFrame* block = m_pool->allocate();
+			if (block != NULL) {
+				m_blocks.push_back(block);
+			} else {
+				LogWarning("Echo memory is exhausted, truncating the recording from %s at %.1f secs", m_header.getMyCall1().c_str(), float(m_in) / float(DSTAR_FRAMES_PER_SEC));
+				m_full = true;
+			}
+		}
+
+		if (!m_full) {
+			TEchoFrame* frame = getFrame(m_in);
+			data.getData(frame->m_data, DV_FRAME_LENGTH_BYTES);
+			frame->m_id  = uint16_t(data.getId());
+			frame->m_seq = uint8_t(data.getSeq());
+			m_in++;
+		}
 	}
 
 	if (data.isEnd()) {
-		LogInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header->getMyCall1().c_str());
+		LogInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header.getMyCall1().c_str());
 
 		m_timer.start();
 		m_status = ES_WAIT;
@@ -86,7 +126,7 @@ void CEchoUnit::end()
 	if (m_status != ES_RECEIVE)
 		return;
 
-	LogInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header->getMyCall1().c_str());
+	LogInfo("Received %.1f secs of audio from %s for echoing\n", float(m_in) / float(DSTAR_FRAMES_PER_SEC), m_header.getMyCall1().c_str());
 
 	m_timer.start();
 	m_status = ES_WAIT;
@@ -99,41 +139,46 @@ void CEchoUnit::clock(unsigned int ms)
 	if (m_status == ES_WAIT && m_timer.hasExpired()) {
 		m_timer.stop();
 
-		// RPT1 and RPT2 will be filled in later
-		m_header->setMyCall1(m_callsign);
-		m_header->setMyCall2("ECHO");
-		m_header->setYourCall("CQCQCQ  ");
+		if (m_in == 0U) {
+			releaseBlocks();
+			m_status = ES_IDLE;
+			return;
+		}
 
-		m_handler->process(*m_header, DIR_INCOMING, AS_ECHO);
+		// RPT1 and RPT2 will be filled in later
+		m_header.setMyCall1(m_callsign);
+		m_header.setMyCall2("ECHO");
+		m_header.setYourCall("CQCQCQ  ");
 
-		delete m_header;
+		m_handler->process(m_header, DIR_INCOMING, AS_ECHO);
 
 		m_out    = 0U;
 		m_status = ES_TRANSMIT;
 
-		m_time = std::chrono::high_resolution_clock::now();
+		m_pacer.start();
 
 		return;
 	}
 
 	if (m_status == ES_TRANSMIT) {
-		auto now = std::chrono::high_resolution_clock::now();
-		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_time);
-		unsigned int needed = elapsed.count() / DSTAR_FRAME_TIME_MS;
+		unsigned int needed = m_pacer.getDue();
 
 		while (m_out < needed) {
-			CAMBEData* data = m_data[m_out];
-			m_data[m_out] = NULL;
+			const TEchoFrame* frame = getFrame(m_out);
 			m_out++;
 
-			if (m_in == m_out)
-				data->setEnd(true);
+			// One frame object is reused for the whole playback
+			m_frame.setData(frame->m_data, DV_FRAME_LENGTH_BYTES);
+			m_frame.setId(frame->m_id);
+			m_frame.setSeq(frame->m_seq);
 
-			m_handler->process(*data, DIR_INCOMING, AS_ECHO);
+			if (m_in == m_out)
+				m_frame.setEnd(true);
 
-			delete data;
+			m_handler->process(m_frame, DIR_INCOMING, AS_ECHO);
 
 			if (m_in == m_out) {
+				releaseBlocks();
 				m_in     = 0U;
 				m_out    = 0U;
 				m_status = ES_IDLE;
@@ -147,12 +192,7 @@ void CEchoUnit::clock(unsigned int ms)
 
 void CEchoUnit::cancel()
 {
-	for (unsigned int i = 0U; i < MAX_FRAMES; i++) {
-		if (m_data[i] != NULL) {
-			delete m_data[i];
-			m_data[i] = NULL;
-		}
-	}
+	releaseBlocks();
 
 	m_status = ES_IDLE;
 	m_out    = 0U;
@@ -160,3 +200,16 @@ void CEchoUnit::cancel()
 
 	m_timer.stop();
 }
+
+TEchoFrame* CEchoUnit::getFrame(unsigned int n) const
+{
+	return m_blocks[n / ECHO_BLOCK_FRAMES] + n % ECHO_BLOCK_FRAMES;
+}
+
+void CEchoUnit::releaseBlocks()
+{
+	for (auto block : m_blocks)
+		m_pool->release(block);
+
+	m_blocks.clear();
+}
@@ -21,12 +21,14 @@
 #pragma once
 
 #include <string>
-#include <chrono>
+#include <vector>
 
 #include "RepeaterCallback.h"
 #include "HeaderData.h"
 #include "AMBEData.h"
+#include "EchoFramePool.h"
 #include "Timer.h"
+#include "PacingEngine.h"
 
 enum ECHO_STATUS {
 	ES_IDLE,
@@ -50,15 +52,26 @@ public:
 
 	void clock(unsigned int ms);
 
+	static void initialise(unsigned int memory);
+
+	static void finalise();
+
 private:
+	static CEchoFramePool* m_pool;
+
 	IRepeaterCallback* m_handler;
 	std::string           m_callsign;
 	ECHO_STATUS        m_status;
 	CTimer             m_timer;
-	CHeaderData*       m_header;
-	CAMBEData**        m_data;
+	CHeaderData        m_header;
+	std::vector<TEchoFrame*> m_blocks;
+	CAMBEData          m_frame;
+	bool               m_full;
 	unsigned int       m_in;
 	unsigned int       m_out;
-	std::chrono::high_resolution_clock::time_point m_time;
+	CStreamPacer       m_pacer;
+
+	TEchoFrame* getFrame(unsigned int n) const;
+	void releaseBlocks();
 };
 
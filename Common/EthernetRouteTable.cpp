@@ -0,0 +1,154 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+
+#include "EthernetRouteTable.h"
+
+CEthernetRouteTable::CEthernetRouteTable(unsigned int capacity, unsigned int maxAgeSecs) :
+m_capacity(capacity),
+m_maxAge(maxAgeSecs),
+m_routes(),
+m_evicted(0ULL)
+{
+	assert(capacity > 0U);
+
+	m_routes.reserve(capacity);
+}
+
+void CEthernetRouteTable::addStatic(const unsigned char* address, const std::string& callsign)
+{
+	assert(address != nullptr);
+
+	TRoute& route = m_routes[getKey(address)];
+	route.m_callsign = callsign;
+	route.m_heard    = std::chrono::steady_clock::now();
+	route.m_static   = true;
+}
+
+bool CEthernetRouteTable::learn(const unsigned char* address, const std::string& callsign)
+{
+	return learn(address, callsign, std::chrono::steady_clock::now());
+}
+
+bool CEthernetRouteTable::learn(const unsigned char* address, const std::string& callsign, const TRouteTime& now)
+{
+	assert(address != nullptr);
+	assert(!callsign.empty());
+
+	uint64_t key = getKey(address);
+
+	auto it = m_routes.find(key);
+	if (it != m_routes.end()) {
+		if (!it->second.m_static) {
+			it->second.m_callsign = callsign;
+			it->second.m_heard    = now;
+		}
+
+		return false;
+	}
+
+	if (m_routes.size() >= m_capacity) {
+		expire(now);
+
+		if (m_routes.size() >= m_capacity && !evictOldest())
+			return false;
+	}
+
+	m_routes.emplace(key, TRoute{ callsign, now, false });
+
+	return true;
+}
+
+bool CEthernetRouteTable::find(const unsigned char* address, std::string& callsign) const
+{
+	assert(address != nullptr);
+
+	auto it = m_routes.find(getKey(address));
+	if (it == m_routes.end())
+		return false;
+
+	callsign = it->second.m_callsign;
+
+	return true;
+}
+
+unsigned int CEthernetRouteTable::expire()
+{
+	return expire(std::chrono::steady_clock::now());
+}
+
+unsigned int CEthernetRouteTable::expire(const TRouteTime& now)
+{
+	unsigned int count = 0U;
+
+	for (auto it = m_routes.begin(); it != m_routes.end();) {
+		if (!it->second.m_static && now - it->second.m_heard > m_maxAge) {
+			it = m_routes.erase(it);
+			count++;
+		} else {
+			++it;
+		}
+	}
+
+	return count;
+}
+
+unsigned int CEthernetRouteTable::size() const
+{
+	return (unsigned int)m_routes.size();
+}
+
+unsigned int CEthernetRouteTable::getCapacity() const
+{
+	return m_capacity;
+}
+
+unsigned long long CEthernetRouteTable::getEvicted() const
+{
+	return m_evicted;
+}
+
+uint64_t CEthernetRouteTable::getKey(const unsigned char* address)
+{
+	assert(address != nullptr);
+
+	uint64_t key = 0U;
+	for (unsigned int i = 0U; i < ETHERNET_ADDRESS_LENGTH; i++)
+		key = (key << 8) | address[i];
+
+	return key;
+}
+
+bool CEthernetRouteTable::evictOldest()
+{
+	auto oldest = m_routes.end();
+
+	for (auto it = m_routes.begin(); it != m_routes.end(); ++it) {
+		if (!it->second.m_static && (oldest == m_routes.end() || it->second.m_heard < oldest->second.m_heard))
+			oldest = it;
+	}
+
+	if (oldest == m_routes.end())
+		return false;
+
+	m_routes.erase(oldest);
+	m_evicted++;
+
+	return true;
+}
@@ -0,0 +1,68 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+const unsigned int ETHERNET_ADDRESS_LENGTH = 6U;
+
+typedef std::chrono::steady_clock::time_point TRouteTime;
+
+// DD mode routes from ethernet addresses to the callsign of the station behind them, keyed by the
+// address packed into an integer. Learnt routes age out when the station has not been heard for a
+// while, and when the table is full the one heard longest ago makes way. Static routes never go.
+class CEthernetRouteTable {
+public:
+	CEthernetRouteTable(unsigned int capacity, unsigned int maxAgeSecs);
+
+	void addStatic(const unsigned char* address, const std::string& callsign);
+
+	// Add or refresh the route to a station we have just heard, true if it is a new one
+	bool learn(const unsigned char* address, const std::string& callsign);
+	bool learn(const unsigned char* address, const std::string& callsign, const TRouteTime& now);
+
+	bool find(const unsigned char* address, std::string& callsign) const;
+
+	// Drop the routes that have aged out, returns how many went
+	unsigned int expire();
+	unsigned int expire(const TRouteTime& now);
+
+	unsigned int size() const;
+	unsigned int getCapacity() const;
+	unsigned long long getEvicted() const;
+
+	static uint64_t getKey(const unsigned char* address);
+
+private:
+	struct TRoute {
+		std::string m_callsign;
+		TRouteTime  m_heard;
+		bool        m_static;
+	};
+
+	unsigned int                         m_capacity;
+	std::chrono::seconds                 m_maxAge;
+	std::unordered_map<uint64_t, TRoute> m_routes;
+	unsigned long long                   m_evicted;
+
+	bool evictOldest();
+};
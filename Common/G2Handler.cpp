@@ -18,12 +18,14 @@
  */
 
 #include <cassert>
+#include <arpa/inet.h>
 
 #if USE_STARNET
 #include "StarNetHandler.h"
 #endif
 #include "DStarDefines.h"
 #include "G2Handler.h"
+#include "VoiceStats.h"
 #include "Utils.h"
 #include "Defs.h"
 #include "Log.h"
@@ -33,11 +35,15 @@ CG2Handler**        CG2Handler::m_routes = NULL;
 
 CG2ProtocolHandlerPool* CG2Handler::m_handler = NULL;
 
-CG2Handler::CG2Handler(CRepeaterHandler* repeater, const in_addr& address, unsigned int id) :
+TLinkQuality        CG2Handler::m_totals = TLinkQuality();
+
+CG2Handler::CG2Handler(CRepeaterHandler* repeater, const std::string& callsign, const in_addr& address, unsigned int id) :
 m_repeater(repeater),
+m_callsign(callsign),
 m_address(address),
 m_id(id),
-m_inactivityTimer(1000U, NETWORK_TIMEOUT)
+m_inactivityTimer(1000U, NETWORK_TIMEOUT),
+m_quality()
 {
 	m_inactivityTimer.start();
 }
@@ -90,7 +96,17 @@ void CG2Handler::process(CHeaderData& header)
 
 	in_addr address = header.getYourAddress();
 	unsigned int id = header.getId();
-	
+
+	// Each header is sent several times, count those of a stream that already has a route
+	if (CVoiceStats::isEnabled()) {
+		for (unsigned int i = 0U; i < m_maxRoutes; i++) {
+			if (m_routes[i] != NULL && m_routes[i]->m_id == id) {
+				CVoiceStats::headerRepeat(VP_G2);
+				break;
+			}
+		}
+	}
+
 	// Find the destination repeater
 	CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(header.getRptCall2());
 	if (repeater == NULL) {
@@ -98,7 +114,8 @@ void CG2Handler::process(CHeaderData& header)
 		return;		// Not found, ignore
 	}
 
-	CG2Handler* route = new CG2Handler(repeater, address, id);
+	CG2Handler* route = new CG2Handler(repeater, header.getRptCall2(), address, id);
+	route->m_quality.start(CLinkQuality::getArrival(header.getTiming()));
 
 	for (unsigned int i = 0U; i < m_maxRoutes; i++) {
 		if (m_routes[i] == NULL) {
@@ -136,9 +153,11 @@ void CG2Handler::process(CAMBEData& data)
 		if (route != NULL) {
 			if (route->m_id == id) {
 				route->m_inactivityTimer.start();
+				route->m_quality.frame(data.getSeq(), CLinkQuality::getArrival(data.getTiming()));
 				route->m_repeater->process(data, DIR_INCOMING, AS_G2);
 
 				if (data.isEnd()) {
+					route->endStream();
 					delete route;
 					m_routes[i] = NULL;
 				}
@@ -158,6 +177,7 @@ void CG2Handler::clock(unsigned int ms)
 		if (route != NULL) {
 			bool ret = route->clockInt(ms);
 			if (ret) {
+				route->endStream();
 				delete route;
 				m_routes[i] = NULL;
 			}
@@ -165,6 +185,17 @@ void CG2Handler::clock(unsigned int ms)
 	}
 }
 
+void CG2Handler::getQuality(TLinkQuality& quality)
+{
+	quality = m_totals;
+
+	for (unsigned int i = 0U; i < m_maxRoutes; i++) {
+		CG2Handler* route = m_routes[i];
+		if (route != NULL && route->m_quality.isActive())
+			CLinkQuality::add(quality, route->m_quality.getStream());
+	}
+}
+
 void CG2Handler::finalise()
 {
 	for (unsigned int i = 0U; i < m_maxRoutes; i++)
@@ -185,4 +216,12 @@ bool CG2Handler::clockInt(unsigned int ms)
 	return false;
 }
 
+void CG2Handler::endStream()
+{
+	if (!m_quality.end())
+		return;
 
+	m_quality.report(m_callsign, "g2", ::inet_ntoa(m_address));
+
+	CLinkQuality::add(m_totals, m_quality.getStream());
+}
@@ -26,6 +26,7 @@
 #include "RepeaterHandler.h"
 #include "DStarDefines.h"
 #include "HeaderData.h"
+#include "LinkQuality.h"
 #include "AMBEData.h"
 #include "Timer.h"
 
@@ -40,13 +41,17 @@ public:
 
 	static void clock(unsigned int ms);
 
+	// Every G2 stream received since start up, the jitter is that of the latest one
+	static void getQuality(TLinkQuality& quality);
+
 	static void finalise();
 
 protected:
-	CG2Handler(CRepeaterHandler* repeater, const in_addr& address, unsigned int id);
+	CG2Handler(CRepeaterHandler* repeater, const std::string& callsign, const in_addr& address, unsigned int id);
 	~CG2Handler();
 
 	bool clockInt(unsigned int ms);
+	void endStream();
 
 private:
 	static unsigned int        m_maxRoutes;
@@ -54,10 +59,14 @@ private:
 
 	static CG2ProtocolHandlerPool* m_handler;
 
+	static TLinkQuality        m_totals;
+
 	CRepeaterHandler* m_repeater;
+	std::string       m_callsign;
 	in_addr           m_address;
 	unsigned int      m_id;
 	CTimer            m_inactivityTimer;
+	CLinkQuality      m_quality;
 };
 
 #endif
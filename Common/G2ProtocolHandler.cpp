@@ -22,6 +22,7 @@
 #include <cassert>
 
 #include "G2ProtocolHandler.h"
+#include "VoiceStats.h"
 #include "Utils.h"
 #include "Log.h"
 
@@ -36,7 +37,8 @@ m_buffer(nullptr),
 m_length(0U),
 m_address(destination),
 m_inactivityTimer(1000U, 29U),
-m_id(0U)
+m_id(0U),
+m_received(0U)
 {
 	m_inactivityTimer.start();
 	m_buffer = new unsigned char[bufferSize];
@@ -68,6 +70,8 @@ bool CG2ProtocolHandler::writeHeader(const CHeaderData& header)
 			return false;
 	}
 
+	CVoiceStats::written(header.getTiming(), VP_G2);
+
 	return true;
 }
 
@@ -83,7 +87,11 @@ bool CG2ProtocolHandler::writeAMBE(const CAMBEData& data)
 
 	assert(CNetUtils::match(data.getDestination(), m_address, IMT_ADDRESS_ONLY));
 	//LogDebug("Write ambe to %s:%u", inet_ntoa(addr), ntohs(TOIPV4(m_address)->sin_port));
-	return m_socket->write(buffer, length, m_address);
+	bool res = m_socket->write(buffer, length, m_address);
+
+	CVoiceStats::written(data.getTiming(), VP_G2);
+
+	return res;
 }
 
 bool CG2ProtocolHandler::setBuffer(unsigned char * buffer, int length)
@@ -97,6 +105,7 @@ bool CG2ProtocolHandler::setBuffer(unsigned char * buffer, int length)
 		return false;
 
 	m_length = length;
+	m_received = CVoiceStats::stamp();
 
 	if (m_buffer[0] != 'D' || m_buffer[1] != 'S' || m_buffer[2] != 'V' || m_buffer[3] != 'T') {
 		LogDebug("DSVT");
@@ -127,10 +136,13 @@ CHeaderData* CG2ProtocolHandler::readHeader()
 	// G2 checksums are unreliable
 	bool res = header->setG2Data(m_buffer, m_length, false, TOIPV4(m_address)->sin_addr,  ntohs(GETPORT(m_address)));
 	if (!res) {
+		CVoiceStats::dropped(VP_G2);
 		delete header;
 		return nullptr;
 	}
 
+	CVoiceStats::decoded(header->getTiming(), VP_G2, m_received);
+
 	m_id = header->getId();// remember the id so we do not read it duplicate
 
 	return header;
@@ -147,10 +159,13 @@ CAMBEData* CG2ProtocolHandler::readAMBE()
 
 	bool res = data->setG2Data(m_buffer, m_length, TOIPV4(m_address)->sin_addr, ntohs(GETPORT(m_address)));
 	if (!res) {
+		CVoiceStats::dropped(VP_G2);
 		delete data;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(data->getTiming(), VP_G2, m_received);
+
 	if(data->isEnd())
 		m_id = 0U;
 
@@ -38,9 +38,9 @@ CG2ProtocolHandlerPool::~CG2ProtocolHandlerPool()
 
 }
 
-bool CG2ProtocolHandlerPool::open()
+bool CG2ProtocolHandlerPool::open(CNetworkReader* reader)
 {
-    bool res = m_socket.open();
+    bool res = m_socket.open(reader);
     return res;
 }
 
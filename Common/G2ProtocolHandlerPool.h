@@ -67,7 +67,7 @@ public:
     CG2ProtocolHandlerPool(unsigned short g2Port, const std::string& address = "");
     ~CG2ProtocolHandlerPool();
 
-    bool open();
+    bool open(CNetworkReader* reader = NULL);
     void close();
     G2_TYPE read();
     CAMBEData * readAMBE();
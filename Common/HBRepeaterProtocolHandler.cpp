@@ -22,18 +22,21 @@
 #include "HBRepeaterProtocolHandler.h"
 #include "CCITTChecksum.h"
 #include "DStarDefines.h"
+#include "VoiceStats.h"
 #include "Utils.h"
 #include "Log.h"
 
 const unsigned int BUFFER_LENGTH = 255U;
 
-CHBRepeaterProtocolHandler::CHBRepeaterProtocolHandler(const std::string& address, unsigned int port) :
+CHBRepeaterProtocolHandler::CHBRepeaterProtocolHandler(const std::string& address, unsigned int port, CNetworkReader* reader) :
 m_socket(address, port),
+m_reader(reader),
 m_type(RT_NONE),
 m_buffer(NULL),
 m_length(0U),
 m_address(),
-m_port(0U)
+m_port(0U),
+m_received(0U)
 {
 	assert(!address.empty());
 	assert(port > 0U);
@@ -48,7 +51,7 @@ CHBRepeaterProtocolHandler::~CHBRepeaterProtocolHandler()
 
 bool CHBRepeaterProtocolHandler::open()
 {
-	return m_socket.open();
+	return m_socket.open(m_reader);
 }
 
 bool CHBRepeaterProtocolHandler::writeHeader(CHeaderData& header)
@@ -60,7 +63,9 @@ bool CHBRepeaterProtocolHandler::writeHeader(CHeaderData& header)
 	CUtils::dump("Sending Header", buffer, length);
 	return true;
 #else
-	return m_socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
+	bool ret = m_socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
+	CVoiceStats::written(header.getTiming(), VP_HB);
+	return ret;
 #endif
 }
 
@@ -73,7 +78,9 @@ bool CHBRepeaterProtocolHandler::writeAMBE(CAMBEData& data)
 	CUtils::dump("Sending Data", buffer, length);
 	return true;
 #else
-	return m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool ret = m_socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	CVoiceStats::written(data.getTiming(), VP_HB);
+	return ret;
 #endif
 }
 
@@ -137,6 +144,7 @@ bool CHBRepeaterProtocolHandler::readPackets()
 		return false;
 
 	m_length = length;
+	m_received = CVoiceStats::stamp();
 
 	// Invalid packet type?
 	if (m_buffer[0] == 'D' && m_buffer[1] == 'S' && m_buffer[2] == 'R' && m_buffer[3] == 'P') {
@@ -202,10 +210,13 @@ CHeaderData* CHBRepeaterProtocolHandler::readHeader()
 	bool res = header->setHBRepeaterData(m_buffer, m_length, true, m_address, m_port);
 	if (!res) {
 		LogError("Invalid checksum from the repeater");
+		CVoiceStats::dropped(VP_HB);
 		delete header;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(header->getTiming(), VP_HB, m_received);
+
 	return header;
 }
 
@@ -219,10 +230,13 @@ CAMBEData* CHBRepeaterProtocolHandler::readAMBE()
 	bool res = data->setHBRepeaterData(m_buffer, m_length, m_address, m_port);
 	if (!res) {
 		LogError("Invalid AMBE data from the repeater");
+		CVoiceStats::dropped(VP_HB);
 		delete data;
 		return NULL;
 	}
 
+	CVoiceStats::decoded(data->getTiming(), VP_HB, m_received);
+
 	return data;
 }
 
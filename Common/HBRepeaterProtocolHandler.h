@@ -36,7 +36,7 @@
 
 class CHBRepeaterProtocolHandler : public IRepeaterProtocolHandler {
 public:
-	CHBRepeaterProtocolHandler(const std::string& address, unsigned int port);
+	CHBRepeaterProtocolHandler(const std::string& address, unsigned int port, CNetworkReader* reader = NULL);
 	virtual ~CHBRepeaterProtocolHandler();
 
 	virtual bool open();
@@ -60,11 +60,13 @@ public:
 
 private:
 	CUDPReaderWriter m_socket;
+	CNetworkReader*  m_reader;
 	REPEATER_TYPE    m_type;
 	unsigned char*   m_buffer;
 	unsigned int     m_length;
 	in_addr          m_address;
 	unsigned int     m_port;
+	uint64_t         m_received;
 
 	bool readPackets();
 };
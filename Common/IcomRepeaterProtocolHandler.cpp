@@ -17,9 +17,14 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
 #include "IcomRepeaterProtocolHandler.h"
 #include "CCITTChecksum.h"
 #include "DStarDefines.h"
+#include "VoiceStats.h"
 #include "Utils.h"
 #include "Log.h"
 
@@ -29,23 +34,19 @@ const unsigned int BUFFER_LENGTH = 2500U;
 const unsigned int QUEUE_LENGTH  = 50U;
 
 const unsigned int LOOP_DELAY    = 5UL;
-const unsigned int LOOP_TICKS    = 200U;
 
-CIcomRepeaterProtocolHandler::CIcomRepeaterProtocolHandler(const std::string& address, unsigned int port, const std::string& icomAddress, unsigned int icomPort) :
-CThread("Icom Protocol Handler"),
+CIcomRepeaterProtocolHandler::CIcomRepeaterProtocolHandler(const std::string& address, unsigned int port, const std::string& icomAddress, unsigned int icomPort, unsigned int windowSize) :
+CThread("Icom"),
 m_socket(address, port),
 m_icomAddress(),
 m_icomPort(icomPort),
 m_over1(false),
-m_seqNo(0U),
-m_tries(0U),
-m_ackQueue(NULL),
+m_window(windowSize),
 m_killed(false),
 m_type(RT_NONE),
 m_buffer(NULL),
 m_rptrQueue(QUEUE_LENGTH),
-m_gwyQueue(QUEUE_LENGTH),
-m_retryTimer(LOOP_TICKS, 0U, 200U)		// 200ms
+m_gwyQueue(QUEUE_LENGTH)
 {
 	assert(!icomAddress.empty());
 	assert(!address.empty());
@@ -62,15 +63,12 @@ m_retryTimer(LOOP_TICKS, 0U, 200U)		// 200ms
 
 CIcomRepeaterProtocolHandler::~CIcomRepeaterProtocolHandler()
 {
-	while (!m_gwyQueue.empty()) {
-		CDataQueue* dq = m_gwyQueue.getData();
+	CDataQueue dq;
+	while (m_gwyQueue.pop(dq))
 		free(dq);
-	}
 
-	while (!m_rptrQueue.empty()) {
-		CDataQueue* dq = m_rptrQueue.getData();
+	while (m_rptrQueue.pop(dq))
 		free(dq);
-	}
 
 	delete[] m_buffer;
 }
@@ -112,8 +110,8 @@ bool CIcomRepeaterProtocolHandler::open()
 		int length = m_socket.read(m_buffer, BUFFER_LENGTH, address, port);
 
 		if (length == 10 && m_buffer[0U] == 'I' && m_buffer[1U] == 'N' && m_buffer[2U] == 'I' && m_buffer[3U] == 'T' && m_buffer[6U] == 0x72 && m_buffer[7U] == 0x00) {
-			m_seqNo = m_buffer[4U] * 256U + m_buffer[5U] + 1U;
-			LogInfo("Initial sequence number from the RP2C is %u", m_seqNo);
+			m_window.setNextSeqNo(m_buffer[4U] * 256U + m_buffer[5U] + 1U);
+			LogInfo("Initial sequence number from the RP2C is %u", m_window.getNextSeqNo());
 
 			// Start the thread
 			Create();
@@ -122,7 +120,7 @@ bool CIcomRepeaterProtocolHandler::open()
 			return true;
 		}
 
-		Sleep(1);
+		Sleep(1000U);
 	}
 
 	m_socket.close();
@@ -145,8 +143,6 @@ void* CIcomRepeaterProtocolHandler::Entry()
 			Sleep(LOOP_DELAY);
 
 			readIcomPackets();
-
-			m_retryTimer.clock();
 		}
 #ifndef DEBUG_DSTARGW
 	}
@@ -161,7 +157,8 @@ void* CIcomRepeaterProtocolHandler::Entry()
 	}
 #endif
 
-	LogInfo("Stopping the Icom Controller thread");
+	const TIcomWindowStats& stats = m_window.getStats();
+	LogInfo("Stopping the Icom Controller thread, %llu packets sent to the RP2C, %llu retransmitted, %u dropped", stats.sent, stats.retransmitted, m_gwyQueue.getDropped());
 
 	m_socket.close();
 
@@ -170,29 +167,17 @@ void* CIcomRepeaterProtocolHandler::Entry()
 
 bool CIcomRepeaterProtocolHandler::writeHeader(CHeaderData& header)
 {
-	CDataQueue* dq = new CDataQueue(new CHeaderData(header));
-
-	m_gwyQueue.addData(dq);
-
-	return true;
+	return queueGateway(CDataQueue(new CHeaderData(header)));
 }
 
 bool CIcomRepeaterProtocolHandler::writeAMBE(CAMBEData& data)
 {
-	CDataQueue* dq = new CDataQueue(new CAMBEData(data));
-
-	m_gwyQueue.addData(dq);
-
-	return true;
+	return queueGateway(CDataQueue(new CAMBEData(data)));
 }
 
 bool CIcomRepeaterProtocolHandler::writeDD(CDDData& data)
 {
-	CDataQueue* dq = new CDataQueue(new CDDData(data));
-
-	m_gwyQueue.addData(dq);
-
-	return true;
+	return queueGateway(CDataQueue(new CDDData(data)));
 }
 
 bool CIcomRepeaterProtocolHandler::writeText(CTextData&)
@@ -215,6 +200,8 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 		if (length <= 0)
 			return;
 
+		uint64_t received = CVoiceStats::stamp();
+
 		if (address.s_addr != m_icomAddress.s_addr || port != m_icomPort) {
 			LogError("Incoming Icom data from an unknown source");
 			continue;
@@ -230,17 +217,7 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 		if (length == 10 && m_buffer[6] == 0x72) {
 			uint16_t seqNo = m_buffer[4] * 256U + m_buffer[5];
 
-			if (seqNo == m_seqNo)
-				m_seqNo++;
-			else
-				m_seqNo = seqNo;
-
-			// Free the ack queue
-			free(m_ackQueue);
-			m_ackQueue = NULL;
-
-			m_retryTimer.stop();
-			m_tries = 0U;
+			m_window.ack(seqNo, std::chrono::steady_clock::now());
 
 			continue;
 		}
@@ -259,13 +236,13 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 				continue;
 			}
 
-			m_rptrQueue.addData(new CDataQueue(heard));
+			queueRepeater(CDataQueue(heard));
 			continue;
 		}
 
 		// Poll data
 		if (m_buffer[6] == 0x73 && m_buffer[7] == 0x00) {
-			m_rptrQueue.addData(new CDataQueue);
+			queueRepeater(CDataQueue());
 			continue;
 		}
 
@@ -279,7 +256,7 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 				continue;
 			}
 
-			m_rptrQueue.addData(new CDataQueue(data));
+			queueRepeater(CDataQueue(data));
 			continue;
 		}
 
@@ -290,27 +267,33 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 				bool ret = header->setIcomRepeaterData(m_buffer, length, true, m_icomAddress, m_icomPort);
 				if (!ret) {
 					LogError("Invalid header data or checksum from the RP2C");
+					CVoiceStats::dropped(VP_ICOM);
 					delete header;
 					continue;
 				}
 
+				CVoiceStats::decoded(header->getTiming(), VP_ICOM, received);
+
 				if (m_over1)
 					sendMultiReply(*header);
 				else
 					sendSingleReply(*header);
 
-				m_rptrQueue.addData(new CDataQueue(header));
+				queueRepeater(CDataQueue(header));
 				continue;
 			} else {
 				CAMBEData* data = new CAMBEData;
 				bool ret = data->setIcomRepeaterData(m_buffer, length, m_icomAddress, m_icomPort);
 				if (!ret) {
 					LogError("Invalid AMBE data from the RP2C");
+					CVoiceStats::dropped(VP_ICOM);
 					delete data;
 					continue;
 				}
 
-				m_rptrQueue.addData(new CDataQueue(data));
+				CVoiceStats::decoded(data->getTiming(), VP_ICOM, received);
+
+				queueRepeater(CDataQueue(data));
 				continue;
 			}
 		}
@@ -322,74 +305,67 @@ void CIcomRepeaterProtocolHandler::readIcomPackets()
 
 void CIcomRepeaterProtocolHandler::sendGwyPackets()
 {
-	// Anything to send
-	if (m_gwyQueue.empty() && m_ackQueue == NULL)
-		return;
-
-	if (m_tries > 0U && !m_retryTimer.hasExpired())
-		return;
-
-	if (m_ackQueue == NULL) {
-		m_ackQueue = m_gwyQueue.getData();
-		if (m_ackQueue == NULL) {
-			LogError("getData of a non-empty gateway queue is NULL");
-			return;
-		}
-	}
-
-	unsigned int length = 0U;
-
-	switch (m_ackQueue->getType()) {
-		case RT_HEADER: {
-				CHeaderData* header = m_ackQueue->getHeader();
-				header->setRptSeq(m_seqNo);
-				length = header->getIcomRepeaterData(m_buffer, 60U, true);
-			}
-			break;
+	auto now = std::chrono::steady_clock::now();
+
+	// Only the packets whose ack is overdue go again, not the whole window
+	m_window.retransmit(now, [this](const unsigned char* data, unsigned int length) {
+		m_socket.write(data, length, m_icomAddress, m_icomPort);
+	});
+
+	CDataQueue dq;
+	while (!m_window.isFull() && m_gwyQueue.pop(dq)) {
+		uint16_t seqNo = m_window.getNextSeqNo();
+		unsigned int length = 0U;
+		TVoiceTiming timing = TVoiceTiming();
+
+		switch (dq.getType()) {
+			case RT_HEADER: {
+					CHeaderData* header = dq.getHeader();
+					header->setRptSeq(seqNo);
+					length = header->getIcomRepeaterData(m_buffer, 60U, true);
+					timing = header->getTiming();
+				}
+				break;
 
-		case RT_AMBE: {
-				CAMBEData* data = m_ackQueue->getAMBE();
-				data->setRptSeq(m_seqNo);
-				length = data->getIcomRepeaterData(m_buffer, 60U);
-			}
-			break;
+			case RT_AMBE: {
+					CAMBEData* data = dq.getAMBE();
+					data->setRptSeq(seqNo);
+					length = data->getIcomRepeaterData(m_buffer, 60U);
+					timing = data->getTiming();
+				}
+				break;
 
-		case RT_DD: {
-				CDDData* data = m_ackQueue->getDD();
-				data->setRptSeq(m_seqNo);
-				length = data->getIcomRepeaterData(m_buffer, BUFFER_LENGTH);
-			}
-			break;
+			case RT_DD: {
+					CDDData* data = dq.getDD();
+					data->setRptSeq(seqNo);
+					length = data->getIcomRepeaterData(m_buffer, BUFFER_LENGTH);
+				}
+				break;
 
-		default:
-			LogError("Invalid type in the gateway queue");
-			break;
-	}
+			default:
+				LogError("Invalid type in the gateway queue");
+				break;
+		}
 
-	if (length > 0U) {
-		m_socket.write(m_buffer, length, m_icomAddress, m_icomPort);
+		free(dq);
 
-		m_tries++;
-		m_retryTimer.start();
+		if (length > 0U) {
+			m_socket.write(m_buffer, length, m_icomAddress, m_icomPort);
+			m_window.add(m_buffer, length, now);
 
-		if (m_tries > 0U && (m_tries % 100U) == 0U)
-			LogInfo("No reply from the RP2C after %u retries", m_tries);
+			if (dq.getType() != RT_DD)
+				CVoiceStats::written(timing, VP_ICOM);
+		}
 	}
 }
 
 REPEATER_TYPE CIcomRepeaterProtocolHandler::read()
 {
-	if (m_rptrQueue.empty()) {
+	CDataQueue dq;
+	if (m_rptrQueue.peek(dq))
+		m_type = dq.getType();
+	else
 		m_type = RT_NONE;
-	} else {
-		CDataQueue* dq = m_rptrQueue.peek();
-		if (dq == NULL) {
-			LogError("Peek of a non-empty repeater queue is NULL");
-			m_type = RT_NONE;
-		} else {
-			m_type = dq->getType();
-		}
-	}
 
 	return m_type;
 }
@@ -399,19 +375,9 @@ CPollData* CIcomRepeaterProtocolHandler::readPoll()
 	if (m_type != RT_POLL)
 		return NULL;
 
-	CDataQueue* dq = m_rptrQueue.getData();
-	if (dq == NULL) {
-		LogError("Missing DataQueue in readPoll");
-		return NULL;
-	}
-
-	if (dq->getType() != RT_POLL) {
-		LogError("Wrong DataQueue type in readPoll");
-		delete dq;
+	CDataQueue dq;
+	if (!popRepeater(dq, RT_POLL))
 		return NULL;
-	}
-
-	delete dq;
 
 	CPollData* data = new CPollData;
 	data->setData1("icom_rp2c");
@@ -424,23 +390,11 @@ CHeaderData* CIcomRepeaterProtocolHandler::readHeader()
 	if (m_type != RT_HEADER)
 		return NULL;
 
-	CDataQueue* dq = m_rptrQueue.getData();
-	if (dq == NULL) {
-		LogError("Missing DataQueue in readHeader");
+	CDataQueue dq;
+	if (!popRepeater(dq, RT_HEADER))
 		return NULL;
-	}
 
-	if (dq->getType() != RT_HEADER) {
-		LogError("Wrong DataQueue type in readHeader");
-		delete dq;
-		return NULL;
-	}
-
-	CHeaderData* header = dq->getHeader();
-
-	delete dq;
-
-	return header;
+	return dq.getHeader();
 }
 
 CAMBEData* CIcomRepeaterProtocolHandler::readAMBE()
@@ -448,23 +402,11 @@ CAMBEData* CIcomRepeaterProtocolHandler::readAMBE()
 	if (m_type != RT_AMBE)
 		return NULL;
 
-	CDataQueue* dq = m_rptrQueue.getData();
-	if (dq == NULL) {
-		LogError("Missing DataQueue in readData");
-		return NULL;
-	}
-
-	if (dq->getType() != RT_AMBE) {
-		LogError("Wrong DataQueue type in readData");
-		delete dq;
+	CDataQueue dq;
+	if (!popRepeater(dq, RT_AMBE))
 		return NULL;
-	}
-
-	CAMBEData* data = dq->getAMBE();
 
-	delete dq;
-
-	return data;
+	return dq.getAMBE();
 }
 
 CHeardData* CIcomRepeaterProtocolHandler::readHeard()
@@ -472,23 +414,11 @@ CHeardData* CIcomRepeaterProtocolHandler::readHeard()
 	if (m_type != RT_HEARD)
 		return NULL;
 
-	CDataQueue* dq = m_rptrQueue.getData();
-	if (dq == NULL) {
-		LogError("Missing DataQueue in readHeard");
-		return NULL;
-	}
-
-	if (dq->getType() != RT_HEARD) {
-		LogError("Wrong DataQueue type in readHeard");
-		delete dq;
+	CDataQueue dq;
+	if (!popRepeater(dq, RT_HEARD))
 		return NULL;
-	}
 
-	CHeardData* heard = dq->getHeard();
-
-	delete dq;
-
-	return heard;
+	return dq.getHeard();
 }
 
 CDDData* CIcomRepeaterProtocolHandler::readDD()
@@ -496,23 +426,11 @@ CDDData* CIcomRepeaterProtocolHandler::readDD()
 	if (m_type != RT_DD)
 		return NULL;
 
-	CDataQueue* dq = m_rptrQueue.getData();
-	if (dq == NULL) {
-		LogError("Missing DataQueue in readData");
-		return NULL;
-	}
-
-	if (dq->getType() != RT_DD) {
-		LogError("Wrong DataQueue type in readData");
-		delete dq;
+	CDataQueue dq;
+	if (!popRepeater(dq, RT_DD))
 		return NULL;
-	}
 
-	CDDData* data = dq->getDD();
-
-	delete dq;
-
-	return data;
+	return dq.getDD();
 }
 
 CHeaderData* CIcomRepeaterProtocolHandler::readBusyHeader()
@@ -629,27 +547,64 @@ void CIcomRepeaterProtocolHandler::sendMultiReply(const CHeaderData& header)
 	writeAMBE(replyData);
 }
 
-void CIcomRepeaterProtocolHandler::free(CDataQueue* dataQueue)
+bool CIcomRepeaterProtocolHandler::queueGateway(const CDataQueue& dataQueue)
 {
-	if (dataQueue == NULL)
-		return;
+	if (m_gwyQueue.push(dataQueue))
+		return true;
 
-	switch (dataQueue->getType()) {
+	CDataQueue dq(dataQueue);
+	free(dq);
+
+	LogWarning("The queue to the RP2C is full, packet dropped");
+
+	return false;
+}
+
+bool CIcomRepeaterProtocolHandler::queueRepeater(const CDataQueue& dataQueue)
+{
+	if (m_rptrQueue.push(dataQueue))
+		return true;
+
+	CDataQueue dq(dataQueue);
+	free(dq);
+
+	LogWarning("The queue from the RP2C is full, packet dropped");
+
+	return false;
+}
+
+bool CIcomRepeaterProtocolHandler::popRepeater(CDataQueue& dataQueue, REPEATER_TYPE type)
+{
+	if (!m_rptrQueue.pop(dataQueue)) {
+		LogError("Missing DataQueue in the repeater queue");
+		return false;
+	}
+
+	if (dataQueue.getType() != type) {
+		LogError("Wrong DataQueue type in the repeater queue");
+		free(dataQueue);
+		return false;
+	}
+
+	return true;
+}
+
+void CIcomRepeaterProtocolHandler::free(CDataQueue& dataQueue)
+{
+	switch (dataQueue.getType()) {
 		case RT_HEADER:
-			delete dataQueue->getHeader();
+			delete dataQueue.getHeader();
 			break;
 		case RT_HEARD:
-			delete dataQueue->getHeard();
+			delete dataQueue.getHeard();
 			break;
 		case RT_AMBE:
-			delete dataQueue->getAMBE();
+			delete dataQueue.getAMBE();
 			break;
 		case RT_DD:
-			delete dataQueue->getDD();
+			delete dataQueue.getDD();
 			break;
 		default:
 			break;
 	}
-
-	delete dataQueue;
 }
@@ -26,7 +26,8 @@
 #include "RepeaterProtocolHandler.h"
 #include "UDPReaderWriter.h"
 #include "DStarDefines.h"
-#include "RingBuffer.h"
+#include "IcomSendWindow.h"
+#include "BoundedQueue.h"
 #include "HeaderData.h"
 #include "StatusData.h"
 #include "HeardData.h"
@@ -34,7 +35,6 @@
 #include "TextData.h"
 #include "PollData.h"
 #include "DDData.h"
-#include "Timer.h"
 #include "Thread.h"
 
 class CDataQueue {
@@ -119,7 +119,7 @@ private:
 
 class CIcomRepeaterProtocolHandler : public IRepeaterProtocolHandler, public CThread {
 public:
-	CIcomRepeaterProtocolHandler(const std::string& address, unsigned int port, const std::string& icomAddress, unsigned int icomPort);
+	CIcomRepeaterProtocolHandler(const std::string& address, unsigned int port, const std::string& icomAddress, unsigned int icomPort, unsigned int windowSize = ICOM_WINDOW_SIZE);
 	virtual ~CIcomRepeaterProtocolHandler();
 
 	virtual void setCount(unsigned int count);
@@ -149,16 +149,13 @@ private:
 	CUDPReaderWriter         m_socket;
 	in_addr                  m_icomAddress;
 	unsigned int             m_icomPort;
-	bool                     m_over1;
-	uint16_t                 m_seqNo;
-	unsigned int             m_tries;
-	CDataQueue*              m_ackQueue;
-	bool                     m_killed;
-	REPEATER_TYPE            m_type;
-	unsigned char*           m_buffer;
-	CRingBuffer<CDataQueue*> m_rptrQueue;
-	CRingBuffer<CDataQueue*> m_gwyQueue;
-	CTimer                   m_retryTimer;
+	bool                      m_over1;
+	CIcomSendWindow           m_window;
+	bool                      m_killed;
+	REPEATER_TYPE             m_type;
+	unsigned char*            m_buffer;
+	CBoundedQueue<CDataQueue> m_rptrQueue;
+	CBoundedQueue<CDataQueue> m_gwyQueue;
 
 	void readIcomPackets();
 	void sendGwyPackets();
@@ -167,7 +164,11 @@ private:
 	void sendSingleReply(const CHeaderData& header);
 	void sendMultiReply(const CHeaderData& header);
 
-	void free(CDataQueue* dataQueue);
+	bool queueGateway(const CDataQueue& dataQueue);
+	bool queueRepeater(const CDataQueue& dataQueue);
+	bool popRepeater(CDataQueue& dataQueue, REPEATER_TYPE type);
+
+	void free(CDataQueue& dataQueue);
 };
 
 #endif
@@ -0,0 +1,213 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "IcomSendWindow.h"
+#include "Log.h"
+
+CIcomSendWindow::CIcomSendWindow(unsigned int size) :
+m_packets(size),
+m_inFlight(0U),
+m_nextSeqNo(0U),
+m_hasRtt(false),
+m_srtt(0.0),
+m_rttVar(0.0),
+m_retryTime(ICOM_INITIAL_RETRY_MS),
+m_stats({ 0ULL, 0ULL, 0ULL, 0ULL, 0ULL })
+{
+	assert(size > 0U);
+
+	for (auto& packet : m_packets) {
+		packet.m_used  = false;
+		packet.m_seqNo = 0U;
+		packet.m_tries = 0U;
+	}
+}
+
+bool CIcomSendWindow::isFull() const
+{
+	return m_inFlight == m_packets.size();
+}
+
+bool CIcomSendWindow::isEmpty() const
+{
+	return m_inFlight == 0U;
+}
+
+unsigned int CIcomSendWindow::getInFlight() const
+{
+	return m_inFlight;
+}
+
+uint16_t CIcomSendWindow::getNextSeqNo() const
+{
+	return m_nextSeqNo;
+}
+
+void CIcomSendWindow::setNextSeqNo(uint16_t seqNo)
+{
+	m_nextSeqNo = seqNo;
+}
+
+void CIcomSendWindow::add(const unsigned char* data, unsigned int length, const TIcomTime& now)
+{
+	assert(data != nullptr);
+	assert(!isFull());
+
+	auto it = std::find_if(m_packets.begin(), m_packets.end(), [](const CIcomPacket& p) { return !p.m_used; });
+	assert(it != m_packets.end());
+
+	// The slot keeps its buffer from one packet to the next
+	it->m_used     = true;
+	it->m_seqNo    = m_nextSeqNo++;
+	it->m_data.assign(data, data + length);
+	it->m_sent     = now;
+	it->m_deadline = now + std::chrono::milliseconds(m_retryTime);
+	it->m_tries    = 1U;
+
+	m_inFlight++;
+	m_stats.sent++;
+}
+
+bool CIcomSendWindow::ack(uint16_t seqNo, const TIcomTime& now)
+{
+	auto it = std::find_if(m_packets.begin(), m_packets.end(), [seqNo](const CIcomPacket& p) { return p.m_used && p.m_seqNo == seqNo; });
+	if (it != m_packets.end()) {
+		// Karn's rule, a retransmitted packet gives no usable round trip
+		if (it->m_tries == 1U)
+			sample(std::chrono::duration<double, std::milli>(now - it->m_sent).count());
+
+		release(*it);
+		m_stats.acked++;
+		return true;
+	}
+
+	// With several packets in flight, a late ack for a packet we sent twice
+	if (m_packets.size() > 1U) {
+		uint16_t age = m_nextSeqNo - seqNo;
+		if (age > 0U && age <= 2U * m_packets.size()) {
+			m_stats.duplicateAcks++;
+			return false;
+		}
+
+		LogInfo("RP2C sequence number jumped to %u, expected at most %u", seqNo, uint16_t(m_nextSeqNo - 1U));
+	}
+
+	// The ack carries the sequence number the RP2C expects, follow it and forget what is outstanding
+	for (auto& packet : m_packets) {
+		if (packet.m_used)
+			release(packet);
+	}
+
+	m_nextSeqNo = seqNo;
+	m_stats.resyncs++;
+
+	return false;
+}
+
+unsigned int CIcomSendWindow::retransmit(const TIcomTime& now, const IcomSender& sender)
+{
+	unsigned int count = 0U;
+
+	for (auto& packet : m_packets) {
+		if (!packet.m_used || packet.m_deadline > now)
+			continue;
+
+		sender(packet.m_data.data(), packet.m_data.size());
+
+		packet.m_tries++;
+		if ((packet.m_tries % 100U) == 0U)
+			LogInfo("No reply from the RP2C after %u retries", packet.m_tries);
+
+		// Back off exponentially while the RP2C stays silent
+		unsigned int backoff = std::min(ICOM_MAX_RETRY_MS, m_retryTime << std::min(packet.m_tries - 1U, 5U));
+		packet.m_deadline = now + std::chrono::milliseconds(backoff);
+
+		m_stats.retransmitted++;
+		count++;
+	}
+
+	return count;
+}
+
+CIcomSendWindow::TIcomTime CIcomSendWindow::getNextDeadline(const TIcomTime& now) const
+{
+	TIcomTime deadline = now + std::chrono::milliseconds(m_retryTime);
+
+	for (const auto& packet : m_packets) {
+		if (packet.m_used && packet.m_deadline < deadline)
+			deadline = packet.m_deadline;
+	}
+
+	return deadline;
+}
+
+unsigned int CIcomSendWindow::getRetryTime() const
+{
+	return m_retryTime;
+}
+
+unsigned int CIcomSendWindow::getMaxTries() const
+{
+	unsigned int tries = 0U;
+	for (const auto& packet : m_packets) {
+		if (packet.m_used)
+			tries = std::max(tries, packet.m_tries);
+	}
+
+	return tries;
+}
+
+const TIcomWindowStats& CIcomSendWindow::getStats() const
+{
+	return m_stats;
+}
+
+void CIcomSendWindow::clear()
+{
+	for (auto& packet : m_packets) {
+		if (packet.m_used)
+			release(packet);
+	}
+}
+
+void CIcomSendWindow::sample(double rttMs)
+{
+	if (!m_hasRtt) {
+		m_srtt   = rttMs;
+		m_rttVar = rttMs / 2.0;
+		m_hasRtt = true;
+	} else {
+		m_rttVar = 0.75 * m_rttVar + 0.25 * std::abs(m_srtt - rttMs);
+		m_srtt   = 0.875 * m_srtt + 0.125 * rttMs;
+	}
+
+	double retryTime = m_srtt + 4.0 * m_rttVar;
+	m_retryTime = std::clamp((unsigned int)(retryTime + 0.5), ICOM_MIN_RETRY_MS, ICOM_MAX_RETRY_MS);
+}
+
+void CIcomSendWindow::release(CIcomPacket& packet)
+{
+	packet.m_used  = false;
+	packet.m_tries = 0U;
+
+	m_inFlight--;
+}
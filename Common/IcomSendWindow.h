@@ -0,0 +1,98 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Stop and wait, like the RP2C has always been driven. A larger window assumes the RP2C acks each
+// packet by its own sequence number, which has not been checked against real hardware yet.
+const unsigned int ICOM_WINDOW_SIZE      = 1U;
+const unsigned int ICOM_MAX_WINDOW_SIZE  = 16U;
+const unsigned int ICOM_MIN_RETRY_MS     = 20U;
+const unsigned int ICOM_INITIAL_RETRY_MS = 200U;
+const unsigned int ICOM_MAX_RETRY_MS     = 1000U;
+
+struct TIcomWindowStats {
+	unsigned long long sent;
+	unsigned long long retransmitted;
+	unsigned long long acked;
+	unsigned long long duplicateAcks;
+	unsigned long long resyncs;
+};
+
+// Packets sent to the RP2C that still wait for their ack, each with its own retry deadline.
+// The retry time follows the measured round trip, the way TCP does it (RFC 6298).
+class CIcomSendWindow {
+public:
+	typedef std::chrono::steady_clock::time_point TIcomTime;
+	typedef std::function<void(const unsigned char* data, unsigned int length)> IcomSender;
+
+	CIcomSendWindow(unsigned int size = ICOM_WINDOW_SIZE);
+
+	bool isFull() const;
+	bool isEmpty() const;
+	unsigned int getInFlight() const;
+
+	// The sequence number the next packet must be stamped with before calling add()
+	uint16_t getNextSeqNo() const;
+	void setNextSeqNo(uint16_t seqNo);
+
+	void add(const unsigned char* data, unsigned int length, const TIcomTime& now);
+
+	// Returns false if the ack did not match any packet in flight
+	bool ack(uint16_t seqNo, const TIcomTime& now);
+
+	// Sends again every packet whose retry deadline has passed, returns how many were sent
+	unsigned int retransmit(const TIcomTime& now, const IcomSender& sender);
+
+	// The earliest retry deadline, or now + the retry time when nothing is in flight
+	TIcomTime getNextDeadline(const TIcomTime& now) const;
+
+	unsigned int getRetryTime() const;
+	unsigned int getMaxTries() const;
+
+	const TIcomWindowStats& getStats() const;
+
+	void clear();
+
+private:
+	struct CIcomPacket {
+		bool                       m_used;
+		uint16_t                   m_seqNo;
+		std::vector<unsigned char> m_data;
+		TIcomTime                  m_sent;
+		TIcomTime                  m_deadline;
+		unsigned int               m_tries;
+	};
+
+	std::vector<CIcomPacket> m_packets;
+	unsigned int             m_inFlight;
+	uint16_t                 m_nextSeqNo;
+	bool                     m_hasRtt;
+	double                   m_srtt;
+	double                   m_rttVar;
+	unsigned int             m_retryTime;
+	TIcomWindowStats         m_stats;
+
+	void sample(double rttMs);
+	void release(CIcomPacket& packet);
+};
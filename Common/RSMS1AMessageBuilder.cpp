@@ -23,18 +23,21 @@
 
 std::vector<signed char> CRSMS1AMessageBuilder::m_charsToEscape = {-17, 0, 17, 19, -2, -25, 26, -3, -1, 36, 13, 44};
 
-void CRSMS1AMessageBuilder::buildMessage(std::string& message, const std::string& sender, const std::string& recipient, const std::string body)
+void CRSMS1AMessageBuilder::buildMessage(std::string& message, const std::string& sender, const std::string& recipient, const std::string& body)
 {
-    auto bodyCrc = calculateBodyCRC(body);
-    std::string bodyTmp;
-    escapeBody(bodyTmp, body + (char)bodyCrc);
-    
-    std::string header = CStringUtils::string_format("%s,%s,0011", sender.c_str(), recipient.c_str());
+    // Built in place, message keeps its capacity from one call to the next
+    message.assign("$$Msg,");
+    message.append(sender).append(1U, ',').append(recipient).append(",0011");
+
     signed char c1, c2;
-    calcMsgIcomCRC(header, c1, c2);
-    header.push_back(c1);
-    header.push_back(c2);
-    message = "$$Msg," + header + bodyTmp + '\r';
+    calcMsgIcomCRC(std::string_view(message).substr(6U), c1, c2);
+    message.push_back(c1);
+    message.push_back(c2);
+
+    char bodyCrc = (char)calculateBodyCRC(body);
+    escapeBody(message, body);
+    escapeBody(message, std::string_view(&bodyCrc, 1U));
+    message.push_back('\r');
 }   
 
 signed char CRSMS1AMessageBuilder::calculateBodyCRC(const std::string& body)
@@ -54,9 +57,8 @@ signed char CRSMS1AMessageBuilder::calculateBodyCRC(const std::string& body)
     return (signed char)res;
 }
 
-void CRSMS1AMessageBuilder::escapeBody(std::string& output, const std::string& body)
+void CRSMS1AMessageBuilder::escapeBody(std::string& output, std::string_view body)
 {
-    output.clear();
     for(char c : body) {
         if(std::find(m_charsToEscape.begin(), m_charsToEscape.end(), c) != m_charsToEscape.end()) {
             output.push_back('o');
@@ -65,7 +67,7 @@ void CRSMS1AMessageBuilder::escapeBody(std::string& output, const std::string& b
     }
 }
 
-void CRSMS1AMessageBuilder::calcMsgIcomCRC(const std::string& msg, signed char& c1, signed char& c2)
+void CRSMS1AMessageBuilder::calcMsgIcomCRC(std::string_view msg, signed char& c1, signed char& c2)
 {
 	int num = 0;
 	for(unsigned int i = 0U; i < msg.length(); i++) {
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 enum RSMS1A_PARSE_STATUS {
@@ -30,12 +31,12 @@ enum RSMS1A_PARSE_STATUS {
 class CRSMS1AMessageBuilder
 {
 public:
-    static void buildMessage(std::string& message, const std::string& sender, const std::string& recipient, const std::string body);
+    static void buildMessage(std::string& message, const std::string& sender, const std::string& recipient, const std::string& body);
     static RSMS1A_PARSE_STATUS parseMessage(std::string& sender, std::string& recipient, std::string& body, const std::string& message);
 
 private:
-    static void calcMsgIcomCRC(const std::string& msg, signed char& c1, signed char& c2);
-    static void escapeBody(std::string& output, const std::string& body);
+    static void calcMsgIcomCRC(std::string_view msg, signed char& c1, signed char& c2);
+    static void escapeBody(std::string& output, std::string_view body);
     static void unescapeBody(std::string& output, const std::string& body);
     static void escapeBytes(std::vector<char> output, const std::vector<char> input);
     static signed char calculateBodyCRC(const std::string& body);
@@ -29,12 +29,23 @@
 #include "DPlusHandler.h"
 #include "DStarDefines.h"
 #include "DCSHandler.h"
+#include "G2Handler.h"
+#include "VoiceStats.h"
 #include "Log.h"
 
+// Changes are gathered for this long and sent as one event per repeater
+const unsigned int REMOTE_EVENT_INTERVAL_MS = 100U;
+// Subscribers renew with another SUB before this runs out
+const unsigned int REMOTE_SUBSCRIPTION_SECS = 300U;
+
 CRemoteHandler::CRemoteHandler(const std::string& password, unsigned int port, const std::string& address) :
 m_password(password),
 m_handler(port, address),
-m_random(0U)
+m_random(0U),
+m_subscribed(),
+m_published(),
+m_repeaterState(),
+m_heardState()
 {
 	assert(port > 0U);
 	assert(!password.empty());
@@ -44,9 +55,9 @@ CRemoteHandler::~CRemoteHandler()
 {
 }
 
-bool CRemoteHandler::open()
+bool CRemoteHandler::open(CNetworkReader* reader)
 {
-	return m_handler.open();
+	return m_handler.open(reader);
 }
 
 void CRemoteHandler::process()
@@ -83,6 +94,23 @@ void CRemoteHandler::process()
 				sendRepeater(callsign);
 			}
 			break;
+		case RPHT_REPEATERS:
+			sendRepeaters();
+			break;
+		case RPHT_VOICESTATS:
+			sendVoiceStats();
+			break;
+		case RPHT_LINKQUALITY:
+			sendLinkQuality();
+			break;
+		case RPHT_SUBSCRIBE:
+			subscribe();
+			break;
+		case RPHT_UNSUBSCRIBE:
+			LogInfo("Remote control user has unsubscribed");
+			m_handler.setSubscribed(false);
+			m_handler.sendACK();
+			break;
 #ifdef USE_STARNET
 		case RPHT_STARNET: {
 				std::string callsign = m_handler.readStarNetGroup();
@@ -132,6 +160,9 @@ void CRemoteHandler::process()
 		default:
 			break;
 	}
+
+	if (m_handler.isSubscribed())
+		publishEvents();
 }
 
 void CRemoteHandler::close()
@@ -160,6 +191,155 @@ void CRemoteHandler::sendRepeater(const std::string& callsign)
 		return;
 	}
 
+	CRemoteRepeaterData* data = getInfo(repeater);
+	if (data != NULL)
+		m_handler.sendRepeater(*data);
+
+	delete data;
+}
+
+void CRemoteHandler::sendRepeaters()
+{
+	std::vector<CRemoteRepeaterData*> data;
+
+	for (const std::string& callsign : CRepeaterHandler::listDVRepeaters()) {
+		CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(callsign);
+		if (repeater == NULL)
+			continue;
+
+		CRemoteRepeaterData* info = getInfo(repeater);
+		if (info != NULL)
+			data.push_back(info);
+	}
+
+	m_handler.sendRepeaters(data);
+
+	for (CRemoteRepeaterData* info : data)
+		delete info;
+}
+
+void CRemoteHandler::sendVoiceStats()
+{
+	if (!CVoiceStats::isEnabled()) {
+		m_handler.sendNAK("Voice statistics are disabled");
+		return;
+	}
+
+	std::vector<unsigned char> stats;
+
+	for (unsigned int i = VP_HB; i < VOICE_PROTOCOLS; i++) {
+		TVoiceSnapshot snapshot;
+		CVoiceStats::snapshot(VOICE_PROTOCOL(i), snapshot);
+		CRemoteProtocolHandler::encodeVoiceStats(VOICE_PROTOCOL(i), snapshot, stats);
+	}
+
+	m_handler.sendVoiceStats(stats);
+}
+
+void CRemoteHandler::sendLinkQuality()
+{
+	std::vector<unsigned char> links;
+
+	for (const std::string& callsign : CRepeaterHandler::listDVRepeaters()) {
+		CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(callsign);
+		if (repeater == NULL)
+			continue;
+
+		CRemoteRepeaterData* info = getInfo(repeater);
+		if (info == NULL)
+			continue;
+
+		for (unsigned int i = 0U; i < info->getLinkCount(); i++) {
+			CRemoteLinkData* link = info->getLink(i);
+
+			// Only the reflector protocols carry the sequence numbers that are measured
+			VOICE_PROTOCOL protocol;
+			switch (link->getProtocol()) {
+				case PROTO_DEXTRA: protocol = VP_DEXTRA; break;
+				case PROTO_DPLUS:  protocol = VP_DPLUS;  break;
+				case PROTO_DCS:    protocol = VP_DCS;    break;
+				default:           continue;
+			}
+
+			CRemoteProtocolHandler::encodeLinkQuality(callsign, link->getCallsign(), protocol, link->getQuality(), links);
+		}
+
+		delete info;
+	}
+
+	TLinkQuality g2;
+	CG2Handler::getQuality(g2);
+	CRemoteProtocolHandler::encodeLinkQuality("", "", VP_G2, g2, links);
+
+	m_handler.sendLinkQuality(links);
+}
+
+void CRemoteHandler::subscribe()
+{
+	// A new subscriber is sent everything once, renewals only what changes
+	if (!m_handler.isFromSubscriber()) {
+		LogInfo("Remote control user has subscribed to events");
+		m_repeaterState.clear();
+		m_heardState.clear();
+	}
+
+	m_handler.setSubscribed(true);
+	m_handler.sendACK();
+
+	m_subscribed = std::chrono::steady_clock::now();
+	m_published  = m_subscribed - std::chrono::milliseconds(REMOTE_EVENT_INTERVAL_MS);
+}
+
+void CRemoteHandler::publishEvents()
+{
+	auto now = std::chrono::steady_clock::now();
+
+	if (now - m_subscribed >= std::chrono::seconds(REMOTE_SUBSCRIPTION_SECS)) {
+		LogInfo("Remote control event subscription has expired");
+		m_handler.setSubscribed(false);
+		return;
+	}
+
+	// Whatever changed since the last pass goes out as one event carrying the latest state
+	if (now - m_published < std::chrono::milliseconds(REMOTE_EVENT_INTERVAL_MS))
+		return;
+
+	m_published = now;
+
+	std::vector<unsigned char> encoded;
+
+	for (const std::string& callsign : CRepeaterHandler::listDVRepeaters()) {
+		CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(callsign);
+		if (repeater == NULL)
+			continue;
+
+		CRemoteRepeaterData* data = getInfo(repeater);
+		if (data != NULL) {
+			CRemoteProtocolHandler::encodeRepeater(*data, encoded);
+
+			auto it = m_repeaterState.find(callsign);
+			if (it == m_repeaterState.end() || it->second != encoded) {
+				m_handler.sendRepeaterEvent(encoded);
+				m_repeaterState[callsign] = encoded;
+			}
+		}
+
+		delete data;
+
+		unsigned int count = 0U;
+		std::string user = repeater->getLastHeard(count);
+
+		auto it = m_heardState.find(callsign);
+		if (it == m_heardState.end() || it->second != count) {
+			if (!user.empty())
+				m_handler.sendHeardEvent(callsign, user);
+			m_heardState[callsign] = count;
+		}
+	}
+}
+
+CRemoteRepeaterData* CRemoteHandler::getInfo(CRepeaterHandler* repeater) const
+{
 	CRemoteRepeaterData* data = repeater->getInfo();
 	if (data != NULL) {
 		CDExtraHandler::getInfo(repeater, *data);
@@ -168,11 +348,9 @@ void CRemoteHandler::sendRepeater(const std::string& callsign)
 #ifdef USE_CCS
 		CCCSHandler::getInfo(repeater, *data);
 #endif
-
-		m_handler.sendRepeater(*data);
 	}
 
-	delete data;
+	return data;
 }
 
 #ifdef USE_STARNET
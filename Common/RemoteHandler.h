@@ -20,18 +20,23 @@
 #ifndef	RemoteHandler_H
 #define	RemoteHandler_H
 
+#include <chrono>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "RemoteProtocolHandler.h"
 #include "Timer.h"
 
+class CRepeaterHandler;
+
 
 class CRemoteHandler {
 public:
 	CRemoteHandler(const std::string& password, unsigned int port, const std::string& address = "");
 	~CRemoteHandler();
 
-	bool open();
+	bool open(CNetworkReader* reader = NULL);
 
 	void process();
 
@@ -41,9 +46,19 @@ private:
 	std::string               m_password;
 	CRemoteProtocolHandler m_handler;
 	unsigned int           m_random;
+	std::chrono::steady_clock::time_point m_subscribed;
+	std::chrono::steady_clock::time_point m_published;
+	std::unordered_map<std::string, std::vector<unsigned char>> m_repeaterState;
+	std::unordered_map<std::string, unsigned int> m_heardState;
 
 	void sendCallsigns();
 	void sendRepeater(const std::string& callsign);
+	void sendRepeaters();
+	void sendVoiceStats();
+	void sendLinkQuality();
+	void subscribe();
+	void publishEvents();
+	CRemoteRepeaterData* getInfo(CRepeaterHandler* repeater) const;
 #if USE_STARNET
 	void sendStarNetGroup(const std::string& callsign);
 #endif
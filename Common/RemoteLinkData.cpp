@@ -20,12 +20,13 @@
 
 #include "RemoteLinkData.h"
 
-CRemoteLinkData::CRemoteLinkData(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle) :
+CRemoteLinkData::CRemoteLinkData(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle, const TLinkQuality& quality) :
 m_callsign(callsign),
 m_protocol(protocol),
 m_linked(linked),
 m_direction(direction),
-m_dongle(dongle)
+m_dongle(dongle),
+m_quality(quality)
 {
 }
 
@@ -57,3 +58,8 @@ int32_t CRemoteLinkData::isDongle() const
 {
 	return m_dongle ? 1 : 0;
 }
+
+const TLinkQuality& CRemoteLinkData::getQuality() const
+{
+	return m_quality;
+}
@@ -23,12 +23,13 @@
 #include <string>
 #include <cstdint>
 
+#include "LinkQuality.h"
 #include "Defs.h"
 
 
 class CRemoteLinkData {
 public:
-	CRemoteLinkData(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle);
+	CRemoteLinkData(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle, const TLinkQuality& quality);
 	~CRemoteLinkData();
 
 	std::string getCallsign() const;
@@ -37,10 +38,13 @@ public:
 	int32_t     getDirection() const;
 	int32_t     isDongle() const;
 
+	const TLinkQuality& getQuality() const;
+
 private:
 	std::string  m_callsign;
 	PROTOCOL     m_protocol;
 	bool         m_linked;
 	DIRECTION    m_direction;
 	bool         m_dongle;
+	TLinkQuality m_quality;
 };
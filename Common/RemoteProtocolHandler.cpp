@@ -17,6 +17,7 @@
  *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -29,11 +30,25 @@
 
 const unsigned int BUFFER_LENGTH = 2000U;
 
+const unsigned int REPEATER_LENGTH = 2U * LONG_CALLSIGN_LENGTH + sizeof(int32_t);
+const unsigned int LINK_LENGTH     = LONG_CALLSIGN_LENGTH + 4U * sizeof(int32_t);
+// What fits in one datagram after the type and the link count
+const unsigned int MAX_LINKS       = (BUFFER_LENGTH - 3U - sizeof(int32_t) - REPEATER_LENGTH) / LINK_LENGTH;
+// The protocol, five counters, then the count and four percentiles of each of the four stages
+const unsigned int VOICE_STATS_LENGTH = sizeof(int32_t) + 5U * sizeof(uint64_t) + 4U * (sizeof(uint64_t) + 4U * sizeof(uint32_t));
+// Two callsigns, the protocol, four counters, the jitter and the stream count
+const unsigned int LINK_QUALITY_LENGTH = 2U * LONG_CALLSIGN_LENGTH + sizeof(int32_t) + 4U * sizeof(uint64_t) + 2U * sizeof(uint32_t);
+
 CRemoteProtocolHandler::CRemoteProtocolHandler(unsigned int port, const std::string& address) :
 m_socket(address, port),
 m_address(),
 m_port(0U),
 m_loggedIn(false),
+m_subscribed(false),
+m_subAddress(),
+m_subPort(0U),
+m_replyAddress(),
+m_replyPort(0U),
 m_type(RPHT_NONE),
 m_inBuffer(NULL),
 m_inLength(0U),
@@ -51,9 +66,9 @@ CRemoteProtocolHandler::~CRemoteProtocolHandler()
 	delete[] m_inBuffer;
 }
 
-bool CRemoteProtocolHandler::open()
+bool CRemoteProtocolHandler::open(CNetworkReader* reader)
 {
-	return m_socket.open();
+	return m_socket.open(reader);
 }
 
 RPH_TYPE CRemoteProtocolHandler::readType()
@@ -69,6 +84,9 @@ RPH_TYPE CRemoteProtocolHandler::readType()
 
 	// CUtils::dump("Incoming", m_inBuffer, length);
 
+	m_replyAddress = address;
+	m_replyPort    = port;
+
 	if (::memcmp(m_inBuffer, "LIN", 3U) == 0) {
 		m_loggedIn = false;
 		m_address  = address;
@@ -85,6 +103,17 @@ RPH_TYPE CRemoteProtocolHandler::readType()
 		}
 	}
 
+	// A subscriber renews or ends its subscription without holding the session
+	if (isFromSubscriber()) {
+		if (::memcmp(m_inBuffer, "SUB", 3U) == 0) {
+			m_type = RPHT_SUBSCRIBE;
+			return m_type;
+		} else if (::memcmp(m_inBuffer, "UNS", 3U) == 0) {
+			m_type = RPHT_UNSUBSCRIBE;
+			return m_type;
+		}
+	}
+
 	if (m_loggedIn) {
 		if (address.s_addr != m_address.s_addr || port != m_port) {
 			sendNAK("You are not logged in");
@@ -115,6 +144,50 @@ RPH_TYPE CRemoteProtocolHandler::readType()
 		}
 		m_type = RPHT_REPEATER;
 		return m_type;
+	} else if (::memcmp(m_inBuffer, "GAR", 3U) == 0) {
+		if (!m_loggedIn) {
+			sendNAK("You are not logged in");
+			return m_type;
+		}
+		m_type = RPHT_REPEATERS;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "SUB", 3U) == 0) {
+		if (!m_loggedIn) {
+			sendNAK("You are not logged in");
+			return m_type;
+		}
+		// One subscriber at a time, the subscriber's own renewals were dealt with above
+		if (m_subscribed) {
+			sendNAK("Someone else is already subscribed");
+			return m_type;
+		}
+		m_type = RPHT_SUBSCRIBE;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "UNS", 3U) == 0) {
+		if (!m_loggedIn) {
+			sendNAK("You are not logged in");
+			return m_type;
+		}
+		if (m_subscribed) {
+			sendNAK("You are not subscribed");
+			return m_type;
+		}
+		m_type = RPHT_UNSUBSCRIBE;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "GVS", 3U) == 0) {
+		if (!m_loggedIn) {
+			sendNAK("You are not logged in");
+			return m_type;
+		}
+		m_type = RPHT_VOICESTATS;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "GLQ", 3U) == 0) {
+		if (!m_loggedIn) {
+			sendNAK("You are not logged in");
+			return m_type;
+		}
+		m_type = RPHT_LINKQUALITY;
+		return m_type;
 	} else if (::memcmp(m_inBuffer, "GSN", 3U) == 0) {
 		if (!m_loggedIn) {
 			sendNAK("You are not logged in");
@@ -305,12 +378,118 @@ bool CRemoteProtocolHandler::sendCallsigns(const std::vector<std::string> & repe
 }
 
 bool CRemoteProtocolHandler::sendRepeater(const CRemoteRepeaterData& data)
+{
+	std::vector<unsigned char> repeater;
+	encodeRepeater(data, repeater);
+
+	::memcpy(m_outBuffer, "RPT", 3U);
+	::memcpy(m_outBuffer + 3U, repeater.data(), repeater.size());
+
+	// CUtils::dump("Outgoing", m_outBuffer, 3U + repeater.size());
+
+	return m_socket.write(m_outBuffer, 3U + repeater.size(), m_address, m_port);
+}
+
+bool CRemoteProtocolHandler::sendRepeaters(const std::vector<CRemoteRepeaterData*>& data)
+{
+	std::vector<unsigned char> repeater;
+
+	::memcpy(m_outBuffer, "ALL", 3U);
+	unsigned int length = 3U;
+
+	for (const CRemoteRepeaterData* rpt : data) {
+		encodeRepeater(*rpt, repeater);
+
+		// Start a new datagram when this one is full
+		if (length > 3U && length + sizeof(int32_t) + repeater.size() > BUFFER_LENGTH) {
+			if (!m_socket.write(m_outBuffer, length, m_address, m_port))
+				return false;
+			length = 3U;
+		}
+
+		int32_t links = CUtils::swap_endian_be(int32_t((repeater.size() - REPEATER_LENGTH) / LINK_LENGTH));
+		::memcpy(m_outBuffer + length, &links, sizeof(int32_t));
+		length += sizeof(int32_t);
+
+		::memcpy(m_outBuffer + length, repeater.data(), repeater.size());
+		length += repeater.size();
+	}
+
+	// CUtils::dump("Outgoing", m_outBuffer, length);
+
+	return m_socket.write(m_outBuffer, length, m_address, m_port);
+}
+
+bool CRemoteProtocolHandler::sendRepeaterEvent(const std::vector<unsigned char>& repeater)
+{
+	::memcpy(m_outBuffer, "EVR", 3U);
+	::memcpy(m_outBuffer + 3U, repeater.data(), repeater.size());
+
+	return m_socket.write(m_outBuffer, 3U + repeater.size(), m_subAddress, m_subPort);
+}
+
+bool CRemoteProtocolHandler::sendHeardEvent(const std::string& repeater, const std::string& user)
 {
 	unsigned char* p = m_outBuffer;
 
-	::memcpy(p, "RPT", 3U);
+	::memcpy(p, "EVH", 3U);
 	p += 3U;
 
+	::memset(p, ' ', LONG_CALLSIGN_LENGTH);
+	for (unsigned int i = 0U; i < repeater.length() && i < LONG_CALLSIGN_LENGTH; i++)
+		p[i] = repeater[i];
+	p += LONG_CALLSIGN_LENGTH;
+
+	::memset(p, ' ', LONG_CALLSIGN_LENGTH);
+	for (unsigned int i = 0U; i < user.length() && i < LONG_CALLSIGN_LENGTH; i++)
+		p[i] = user[i];
+	p += LONG_CALLSIGN_LENGTH;
+
+	return m_socket.write(m_outBuffer, p - m_outBuffer, m_subAddress, m_subPort);
+}
+
+bool CRemoteProtocolHandler::sendLinkQuality(const std::vector<unsigned char>& links)
+{
+	assert(links.size() % LINK_QUALITY_LENGTH == 0U);
+
+	const unsigned int perDatagram = (BUFFER_LENGTH - 3U) / LINK_QUALITY_LENGTH;
+
+	::memcpy(m_outBuffer, "LNQ", 3U);
+
+	// An empty answer still tells the client there are no links
+	std::size_t pos = 0U;
+	do {
+		std::size_t length = std::min<std::size_t>(links.size() - pos, perDatagram * LINK_QUALITY_LENGTH);
+		::memcpy(m_outBuffer + 3U, links.data() + pos, length);
+		pos += length;
+
+		if (!m_socket.write(m_outBuffer, 3U + length, m_address, m_port))
+			return false;
+	} while (pos < links.size());
+
+	return true;
+}
+
+bool CRemoteProtocolHandler::sendVoiceStats(const std::vector<unsigned char>& stats)
+{
+	::memcpy(m_outBuffer, "VST", 3U);
+	::memcpy(m_outBuffer + 3U, stats.data(), stats.size());
+
+	// CUtils::dump("Outgoing", m_outBuffer, 3U + stats.size());
+
+	return m_socket.write(m_outBuffer, 3U + stats.size(), m_address, m_port);
+}
+
+void CRemoteProtocolHandler::encodeRepeater(const CRemoteRepeaterData& data, std::vector<unsigned char>& out)
+{
+	unsigned int links = data.getLinkCount();
+	if (links > MAX_LINKS)
+		links = MAX_LINKS;
+
+	out.resize(REPEATER_LENGTH + links * LINK_LENGTH);
+
+	unsigned char* p = out.data();
+
 	::memset(p, ' ', LONG_CALLSIGN_LENGTH);
 	for (unsigned int i = 0U; i < data.getCallsign().length(); i++)
 		p[i] = data.getCallsign()[i];
@@ -325,7 +504,7 @@ bool CRemoteProtocolHandler::sendRepeater(const CRemoteRepeaterData& data)
 		p[i] = data.getReflector()[i];
 	p += LONG_CALLSIGN_LENGTH;
 
-	for (unsigned int n = 0U; n < data.getLinkCount(); n++) {
+	for (unsigned int n = 0U; n < links; n++) {
 		CRemoteLinkData* link = data.getLink(n);
 
 		::memset(p, ' ', LONG_CALLSIGN_LENGTH);
@@ -349,10 +528,61 @@ bool CRemoteProtocolHandler::sendRepeater(const CRemoteRepeaterData& data)
 		::memcpy(p, &dongle, sizeof(int32_t));
 		p += sizeof(int32_t);
 	}
+}
 
-	// CUtils::dump("Outgoing", m_outBuffer, p - m_outBuffer);
+template <typename T> static void appendValue(std::vector<unsigned char>& out, T value)
+{
+	value = CUtils::swap_endian_be(value);
 
-	return m_socket.write(m_outBuffer, p - m_outBuffer, m_address, m_port);
+	const unsigned char* p = (const unsigned char*)&value;
+	out.insert(out.end(), p, p + sizeof(T));
+}
+
+static void appendLatency(std::vector<unsigned char>& out, const CLatencySnapshot& latency)
+{
+	appendValue(out, uint64_t(latency.getCount()));
+	appendValue(out, latency.getPercentile(50.0));
+	appendValue(out, latency.getPercentile(90.0));
+	appendValue(out, latency.getPercentile(99.0));
+	appendValue(out, latency.getMax());
+}
+
+void CRemoteProtocolHandler::encodeVoiceStats(VOICE_PROTOCOL protocol, const TVoiceSnapshot& snapshot, std::vector<unsigned char>& out)
+{
+	out.reserve(out.size() + VOICE_STATS_LENGTH);
+
+	appendValue(out, int32_t(protocol));
+	appendValue(out, snapshot.framesIn);
+	appendValue(out, snapshot.framesOut);
+	appendValue(out, snapshot.drops);
+	appendValue(out, snapshot.headerRepeats);
+	appendValue(out, snapshot.late);
+
+	appendLatency(out, snapshot.decode);
+	appendLatency(out, snapshot.route);
+	appendLatency(out, snapshot.write);
+	appendLatency(out, snapshot.total);
+}
+
+void CRemoteProtocolHandler::encodeLinkQuality(const std::string& repeater, const std::string& link, VOICE_PROTOCOL protocol, const TLinkQuality& quality, std::vector<unsigned char>& out)
+{
+	out.reserve(out.size() + LINK_QUALITY_LENGTH);
+
+	std::string callsign = repeater;
+	callsign.resize(LONG_CALLSIGN_LENGTH, ' ');
+	out.insert(out.end(), callsign.begin(), callsign.end());
+
+	callsign = link;
+	callsign.resize(LONG_CALLSIGN_LENGTH, ' ');
+	out.insert(out.end(), callsign.begin(), callsign.end());
+
+	appendValue(out, int32_t(protocol));
+	appendValue(out, quality.frames);
+	appendValue(out, quality.lost);
+	appendValue(out, quality.outOfOrder);
+	appendValue(out, quality.duplicates);
+	appendValue(out, quality.jitter);
+	appendValue(out, quality.streams);
 }
 
 #if USE_STARNET
@@ -409,6 +639,26 @@ void CRemoteProtocolHandler::setLoggedIn(bool set)
 	m_loggedIn = set;
 }
 
+void CRemoteProtocolHandler::setSubscribed(bool set)
+{
+	m_subscribed = set;
+
+	if (set) {
+		m_subAddress = m_replyAddress;
+		m_subPort    = m_replyPort;
+	}
+}
+
+bool CRemoteProtocolHandler::isSubscribed() const
+{
+	return m_subscribed;
+}
+
+bool CRemoteProtocolHandler::isFromSubscriber() const
+{
+	return m_subscribed && m_replyAddress.s_addr == m_subAddress.s_addr && m_replyPort == m_subPort;
+}
+
 void CRemoteProtocolHandler::close()
 {
 	m_socket.close();
@@ -420,7 +670,7 @@ bool CRemoteProtocolHandler::sendACK()
 
 	// CUtils::dump("Outgoing", m_outBuffer, 3U);
 
-	return m_socket.write(m_outBuffer, 3U, m_address, m_port);
+	return m_socket.write(m_outBuffer, 3U, m_replyAddress, m_replyPort);
 }
 
 bool CRemoteProtocolHandler::sendNAK(const std::string& text)
@@ -434,7 +684,7 @@ bool CRemoteProtocolHandler::sendNAK(const std::string& text)
 
 	// CUtils::dump("Outgoing", m_outBuffer, 3U + text.length() + 1U);
 
-	return m_socket.write(m_outBuffer, 3U + text.length() + 1U, m_address, m_port);
+	return m_socket.write(m_outBuffer, 3U + text.length() + 1U, m_replyAddress, m_replyPort);
 }
 
 bool CRemoteProtocolHandler::sendRandom(uint32_t random)
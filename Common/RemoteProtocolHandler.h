@@ -28,6 +28,8 @@
 #endif
 #include "RemoteRepeaterData.h"
 #include "UDPReaderWriter.h"
+#include "LinkQuality.h"
+#include "VoiceStats.h"
 #include "Defs.h"
 
 
@@ -43,6 +45,11 @@ enum RPH_TYPE {
 	RPHT_LINKSCR,
 	RPHT_LOGOFF,
 	RPHT_LOGOUT,
+	RPHT_REPEATERS,
+	RPHT_SUBSCRIBE,
+	RPHT_UNSUBSCRIBE,
+	RPHT_VOICESTATS,
+	RPHT_LINKQUALITY,
 	RPHT_UNKNOWN
 };
 
@@ -51,7 +58,7 @@ public:
 	CRemoteProtocolHandler(unsigned int port, const std::string& address = "");
 	~CRemoteProtocolHandler();
 
-	bool open();
+	bool open(CNetworkReader* reader = NULL);
 
 	RPH_TYPE readType();
 
@@ -68,12 +75,33 @@ public:
 	bool     sendRandom(uint32_t random);
 	bool     sendCallsigns(const std::vector<std::string> & repeaters, const std::vector<std::string>& starNets);
 	bool     sendRepeater(const CRemoteRepeaterData& data);
+	// Every repeater in as few datagrams as will hold them, each entry preceded by its link count
+	bool     sendRepeaters(const std::vector<CRemoteRepeaterData*>& data);
+	// Pushed to a subscribed client, the repeater body is as built by encodeRepeater()
+	bool     sendRepeaterEvent(const std::vector<unsigned char>& repeater);
+	bool     sendHeardEvent(const std::string& repeater, const std::string& user);
+	// The body is the records built by encodeVoiceStats()
+	bool     sendVoiceStats(const std::vector<unsigned char>& stats);
+	// The body is the records built by encodeLinkQuality(), split over datagrams as needed
+	bool     sendLinkQuality(const std::vector<unsigned char>& links);
 #ifdef USE_STARNET
 	bool     sendStarNetGroup(const CRemoteStarNetGroup& data);
 #endif
 
 	void setLoggedIn(bool set);
 
+	// Subscribing sends events to whoever asked, they stay subscribed across other sessions.
+	// There is a single subscriber, a SUB from anyone else is refused until it ends or expires.
+	void setSubscribed(bool set);
+	bool isSubscribed() const;
+	bool isFromSubscriber() const;
+
+	static void encodeRepeater(const CRemoteRepeaterData& data, std::vector<unsigned char>& out);
+	// Appends one protocol's counters and stage percentiles
+	static void encodeVoiceStats(VOICE_PROTOCOL protocol, const TVoiceSnapshot& snapshot, std::vector<unsigned char>& out);
+	// Appends one link, G2 has a single record for the whole gateway with blank callsigns
+	static void encodeLinkQuality(const std::string& repeater, const std::string& link, VOICE_PROTOCOL protocol, const TLinkQuality& quality, std::vector<unsigned char>& out);
+
 	void close();
 
 private:
@@ -81,6 +109,11 @@ private:
 	in_addr           m_address;
 	unsigned int      m_port;
 	bool              m_loggedIn;
+	bool              m_subscribed;
+	in_addr           m_subAddress;
+	unsigned int      m_subPort;
+	in_addr           m_replyAddress;
+	unsigned int      m_replyPort;
 	RPH_TYPE          m_type;
 	unsigned char*    m_inBuffer;
 	unsigned int      m_inLength;
@@ -36,9 +36,9 @@ CRemoteRepeaterData::~CRemoteRepeaterData()
 	}
 }
 
-void CRemoteRepeaterData::addLink(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle)
+void CRemoteRepeaterData::addLink(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle, const TLinkQuality& quality)
 {
-	CRemoteLinkData *data = new CRemoteLinkData(callsign, protocol, linked, direction, dongle);
+	CRemoteLinkData *data = new CRemoteLinkData(callsign, protocol, linked, direction, dongle, quality);
 	m_links.push_back(data);
 }
 
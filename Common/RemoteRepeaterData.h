@@ -31,7 +31,7 @@ public:
 	CRemoteRepeaterData(const std::string& callsign, RECONNECT reconnect, const std::string& reflector);
 	~CRemoteRepeaterData();
 
-	void addLink(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle);
+	void addLink(const std::string& callsign, PROTOCOL protocol, bool linked, DIRECTION direction, bool dongle, const TLinkQuality& quality = TLinkQuality());
 
 	std::string getCallsign() const;
 	int32_t     getReconnect() const;
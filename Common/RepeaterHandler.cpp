@@ -28,13 +28,13 @@
 #include "HeaderData.h"
 #include "DDHandler.h"
 #include "AMBEData.h"
+#include "AMBEClassifier.h"
+#include "VoiceStats.h"
 #include "Utils.h"
 #include "Log.h"
 #include "StringUtils.h"
 
 
-const unsigned int  ETHERNET_ADDRESS_LENGTH = 6U;
-
 const unsigned char ETHERNET_BROADCAST_ADDRESS[] = {0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU};
 // Multicast address '01:00:5E:00:00:01' - IP: '224.0.0.1' (to all)
 const unsigned char TOALL_MULTICAST_ADDRESS[] = {0x01U, 0x00U, 0x5EU, 0x00U, 0x00U, 0x01U};
@@ -62,6 +62,8 @@ CAPRSHandler*              CRepeaterHandler::m_incomingAprsHandler  = NULL; //ha
 
 CCallsignList*            CRepeaterHandler::m_restrictList = NULL;
 
+CDRATSEventLoop*          CRepeaterHandler::m_dratsLoop = NULL;
+
 CRepeaterHandler::CRepeaterHandler(const std::string& callsign, const std::string& band, const std::string& address, unsigned int port, HW_TYPE hwType, const std::string& reflector, bool atStartup, RECONNECT reconnect, bool dratsEnabled, double frequency, double offset, double range, double latitude, double longitude, double agl, const std::string& description1, const std::string& description2, const std::string& url, IRepeaterProtocolHandler* handler, unsigned char band1, unsigned char band2, unsigned char band3) :
 
 m_index(0x00U),
@@ -105,6 +107,9 @@ m_silence(0U),
 m_errors(0U),
 m_textCollector(),
 m_text(),
+m_rfSlowData(),
+m_networkSlowData(),
+m_networkText(false),
 m_xBandRptr(NULL),
 #ifdef USE_STARNET
 m_starNet(NULL),
@@ -142,7 +147,9 @@ m_ccsHandler(NULL),
 m_lastReflector(),
 m_heardUser(),
 m_heardRepeater(),
-m_heardTimer(1000U, 0U, 100U)		// 100ms
+m_heardTimer(1000U, 0U, 100U),		// 100ms
+m_lastHeard(),
+m_lastHeardCount(0U)
 {
 	assert(!callsign.empty());
 	assert(port > 0U);
@@ -189,9 +196,25 @@ m_heardTimer(1000U, 0U, 100U)		// 100ms
 	m_version   = new CVersionUnit(this, callsign);
 	m_aprsUnit  = new CAPRSUnit(this);
 
+	// The slow data of each stream is descrambled once and shared by the text and the APRS collectors
+	m_rfSlowData.addConsumer(SLOW_DATA_TYPE_TEXT, [this](const unsigned char* block) { return m_textCollector.writeBlock(block); });
+	m_rfSlowData.addConsumer(SLOW_DATA_TYPE_GPS, [this](const unsigned char* block) { return m_outgoingAprsHandler != NULL && m_outgoingAprsHandler->writeBlock(m_rptCallsign, block); });
+	m_networkSlowData.addConsumer(SLOW_DATA_TYPE_TEXT, [this](const unsigned char* block) { return m_networkText && m_textCollector.writeBlock(block); });
+	m_networkSlowData.addConsumer(SLOW_DATA_TYPE_GPS, [this](const unsigned char* block) { return m_incomingAprsHandler != NULL && m_incomingAprsHandler->writeBlock(m_rptCallsign, block); });
 
 	if (dratsEnabled) {
-		m_drats = new CDRATSServer(m_localAddress, port, callsign, this);
+		// All the D-RATS servers share a single thread
+		if (m_dratsLoop == NULL) {
+			m_dratsLoop = new CDRATSEventLoop;
+			if (!m_dratsLoop->start()) {
+				delete m_dratsLoop;
+				m_dratsLoop = NULL;
+			}
+		}
+	}
+
+	if (dratsEnabled && m_dratsLoop != NULL) {
+		m_drats = new CDRATSServer(m_localAddress, port, callsign, this, m_dratsLoop);
 		bool ret = m_drats->open();
 		if (!ret) {
 			delete m_drats;
@@ -209,9 +232,12 @@ CRepeaterHandler::~CRepeaterHandler()
 	delete m_wxAudio;
 #endif
 	delete m_version;
+	delete m_aprsUnit;
 
-	if (m_drats != NULL)
+	if (m_drats != NULL) {
 		m_drats->close();
+		delete m_drats;
+	}
 }
 
 void CRepeaterHandler::initialise(unsigned int maxRepeaters)
@@ -386,6 +412,12 @@ void CRepeaterHandler::finalise()
 	}
 
 	delete[] m_repeaters;
+
+	if (m_dratsLoop != NULL) {
+		m_dratsLoop->stop();
+		delete m_dratsLoop;
+		m_dratsLoop = NULL;
+	}
 }
 
 CRepeaterHandler* CRepeaterHandler::findDVRepeater(const CHeaderData& header)
@@ -505,13 +537,24 @@ CRemoteRepeaterData* CRepeaterHandler::getInfo() const
 	return new CRemoteRepeaterData(m_rptCallsign, m_linkReconnect, m_linkStartup);
 }
 
+std::string CRepeaterHandler::getLastHeard(unsigned int& count) const
+{
+	count = m_lastHeardCount;
+
+	return m_lastHeard;
+}
+
 void CRepeaterHandler::processRepeater(CHeaderData& header)
 {
 	unsigned int id = header.getId();
 
 	// Stop duplicate headers
-	if (id == m_repeaterId)
+	if (id == m_repeaterId) {
+		CVoiceStats::headerRepeat(m_hwType == HW_ICOM ? VP_ICOM : VP_HB);
 		return;
+	}
+
+	CVoiceStats::routed(header.getTiming());
 
 	// Save the header fields
 	m_myCall1  = header.getMyCall1();
@@ -541,6 +584,9 @@ void CRepeaterHandler::processRepeater(CHeaderData& header)
 		return;
 	}
 
+	m_lastHeard = m_myCall1;
+	m_lastHeardCount++;
+
 	if (!m_heardUser.empty() && m_myCall1 != m_heardUser && m_irc != NULL)
 		m_irc->sendHeard(m_heardUser, "    ", "        ", m_heardRepeater, "        ", 0x00U, 0x00U, 0x00U);
 
@@ -571,6 +617,7 @@ void CRepeaterHandler::processRepeater(CHeaderData& header)
 	sendToIncoming(header);
 
 	// Reset the slow data text collector
+	m_rfSlowData.reset();
 	m_textCollector.reset();
 	m_text.clear();
 
@@ -715,6 +762,8 @@ void CRepeaterHandler::processRepeater(CHeaderData& header)
 
 void CRepeaterHandler::processRepeater(CAMBEData& data)
 {
+	CVoiceStats::routed(data.getTiming());
+
 	// AMBE data via RF resets the reconnect timer
 	m_linkReconnectTimer.start();
 	m_watchdogTimer.start();
@@ -725,21 +774,21 @@ void CRepeaterHandler::processRepeater(CAMBEData& data)
 	unsigned char buffer[DV_FRAME_MAX_LENGTH_BYTES];
 	data.getData(buffer, DV_FRAME_MAX_LENGTH_BYTES);
 
-	// Check for the fast data signature
-	if (!m_fastData) {
-		unsigned char slowDataType = (buffer[VOICE_FRAME_LENGTH_BYTES] ^ SCRAMBLER_BYTE1) & SLOW_DATA_TYPE_MASK;
-		if (slowDataType == SLOW_DATA_TYPE_FAST_DATA1 || slowDataType == SLOW_DATA_TYPE_FAST_DATA2)
-			m_fastData = true;
-	}
+	// Silence, DTMF and the fast data signature in one go
+	char digit = ' ';
+	unsigned int classes = CAMBEClassifier::classify(buffer, digit);
+
+	if ((classes & AMBE_CLASS_FAST_DATA) != 0U)
+		m_fastData = true;
 
 	// Don't do AMBE processing when in Fast Data mode
 	if (!m_fastData) {
-		if (::memcmp(buffer, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES) == 0)
+		if ((classes & AMBE_CLASS_SILENCE) != 0U)
 			m_silence++;
 
 		// Don't do DTMF decoding or blanking if off and not on crossband either
 		if (m_dtmfEnabled && m_g2Status != G2_XBAND) {
-			bool pressed = m_dtmf.decode(buffer, data.isEnd());
+			bool pressed = m_dtmf.decode(classes, digit, data.isEnd());
 			if (pressed) {
 				// Replace the DTMF with silence
 				::memcpy(buffer, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
@@ -781,17 +830,12 @@ void CRepeaterHandler::processRepeater(CAMBEData& data)
 	if (m_drats != NULL)
 		m_drats->writeData(data);
 
-	if (m_outgoingAprsHandler != NULL)
-		m_outgoingAprsHandler->writeData(m_rptCallsign, data);
-
-	if (m_text.empty() && !data.isEnd()) {
-		m_textCollector.writeData(data);
+	if (!data.isEnd())
+		m_rfSlowData.writeData(data);
 
-		bool hasText = m_textCollector.hasData();
-		if (hasText) {
-			m_text = m_textCollector.getData();
-			sendHeard(m_text);
-		}
+	if (m_text.empty() && m_textCollector.hasData()) {
+		m_text = m_textCollector.getData();
+		sendHeard(m_text);
 	}
 
 	data.setText(m_text);
@@ -1109,6 +1153,12 @@ bool CRepeaterHandler::process(CHeaderData& header, DIRECTION, AUDIO_SOURCE sour
 	if (m_repeaterId != 0x00U)
 		return false;
 
+	// A copy stored by the reflector handler, its own timing is long gone
+	if (source == AS_DUP)
+		CVoiceStats::reset(header.getTiming());
+	else
+		CVoiceStats::routed(header.getTiming());
+
 	// Rewrite the ID if we're using Icom hardware
 	if (m_hwType == HW_ICOM) {
 		unsigned int id1 = header.getId();
@@ -1131,6 +1181,8 @@ bool CRepeaterHandler::process(CHeaderData& header, DIRECTION, AUDIO_SOURCE sour
 	if (source == AS_DUP)
 		return true;
 
+	m_networkSlowData.reset();
+
 	if(m_incomingAprsHandler != nullptr)
 		m_incomingAprsHandler->writeHeader(m_rptCallsign, header);
 
@@ -1159,6 +1211,8 @@ bool CRepeaterHandler::process(CAMBEData& data, DIRECTION, AUDIO_SOURCE source)
 	if (m_repeaterId != 0x00U)
 		return false;
 
+	CVoiceStats::routed(data.getTiming());
+
 	// Rewrite the ID if we're using Icom hardware
 	if (m_hwType == HW_ICOM) {
 		unsigned int id = data.getId();
@@ -1173,8 +1227,11 @@ bool CRepeaterHandler::process(CAMBEData& data, DIRECTION, AUDIO_SOURCE source)
 
 	m_repeaterHandler->writeAMBE(data);
 
-	if(m_incomingAprsHandler != nullptr)
-		m_incomingAprsHandler->writeData(m_rptCallsign, data);
+	// Only the text of reflector streams is passed on to DCS, not that of local audio or G2
+	m_networkText = m_text.empty() && source != AS_G2 && source != AS_INFO && source != AS_VERSION && source != AS_XBAND && source != AS_ECHO;
+
+	if (!data.isEnd())
+		m_networkSlowData.writeData(data);
 
 	sendToIncoming(data);
 
@@ -1187,13 +1244,8 @@ bool CRepeaterHandler::process(CAMBEData& data, DIRECTION, AUDIO_SOURCE source)
 		return true;
 
 	// Collect the text from the slow data for DCS
-	if (m_text.empty() && !data.isEnd()) {
-		m_textCollector.writeData(data);
-
-		bool hasText = m_textCollector.hasData();
-		if (hasText)
-			m_text = m_textCollector.getData();
-	}
+	if (m_text.empty() && m_textCollector.hasData())
+		m_text = m_textCollector.getData();
 
 	data.setText(m_text);
 
@@ -32,8 +32,10 @@
 #include "StarNetHandler.h"
 #endif
 #include "TextCollector.h"
+#include "SlowDataDemux.h"
 #include "CacheManager.h"
 #include "CallsignList.h"
+#include "DRATSEventLoop.h"
 #include "DRATSServer.h"
 #include "CCSCallback.h"
 #include "VersionUnit.h"
@@ -119,6 +121,8 @@ public:
 	void unlink(PROTOCOL protocol, const std::string& reflector);
 
 	CRemoteRepeaterData* getInfo() const;
+	// The last station heard on RF and how many transmissions have been heard so far
+	std::string getLastHeard(unsigned int& count) const;
 
 	virtual bool process(CHeaderData& header, DIRECTION direction, AUDIO_SOURCE source);
 	virtual bool process(CAMBEData& data, DIRECTION direction, AUDIO_SOURCE source);
@@ -172,6 +176,8 @@ private:
 	static CCallsignList*   m_blackList;
 	static CCallsignList*   m_restrictList;
 
+	static CDRATSEventLoop* m_dratsLoop;
+
 	// Repeater info
 	unsigned int              m_index;
 	std::string                  m_rptCallsign;
@@ -220,6 +226,9 @@ private:
 	// Slow data handling
 	CTextCollector            m_textCollector;
 	std::string                  m_text;
+	CSlowDataDemux            m_rfSlowData;
+	CSlowDataDemux            m_networkSlowData;
+	bool                      m_networkText;
 
 	// Cross-band repeating
 	CRepeaterHandler*         m_xBandRptr;
@@ -288,6 +297,10 @@ private:
 	std::string                  m_heardRepeater;
 	CTimer                    m_heardTimer;
 
+	// Remote control heard events
+	std::string                  m_lastHeard;
+	unsigned int              m_lastHeardCount;
+
 	void g2CommandHandler(const std::string& callsign, const std::string& user, CHeaderData& header);
 #ifdef USE_CCS
 	void ccsCommandHandler(const std::string& callsign, const std::string& user, const std::string& type);
@@ -33,18 +33,24 @@ m_endMarker(endMarker)
 
 bool CSentenceCollector::addData(const unsigned char * data)
 {
-    m_collector.append(std::string((char*)data, 5U));
+    m_collector.append((const char*)data, 5U);
 
     std::string::size_type n2 = m_collector.find_last_of(m_endMarker);
 	if (n2 == std::string::npos)
 		return false;
 
+    // Drop what can no longer be part of one of our sentences, the other sentences of the stream
+    // would otherwise pile up here and be searched again with every block
     std::string::size_type n1 = m_collector.find(m_sentenceIdentifier);
-	if (n1 == std::string::npos)
+	if (n1 == std::string::npos) {
+        m_collector.erase(0U, n2);
 		return false;
+    }
 
-    if(n2 < n1)
+    if(n2 < n1) {
+        m_collector.erase(0U, n1);
         return false;
+    }
 
     std::string sentence;
     for(unsigned int i = n1; i <= n2; i++) {
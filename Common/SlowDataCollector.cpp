@@ -23,8 +23,6 @@
 #include "SlowDataCollector.h"
 #include "Log.h"
 
-const unsigned int SLOW_DATA_BLOCK_LENGTH = 6U;
-
 CSlowDataCollector::CSlowDataCollector(unsigned char slowDataType) :
 m_slowDataType(slowDataType),
 m_myCall1(),
@@ -79,9 +77,16 @@ bool CSlowDataCollector::writeData(const unsigned char* data)
         break;
 	}
 
-    if((m_buffer[0] & SLOW_DATA_TYPE_MASK) == m_slowDataType)
-        return addData(m_buffer + 1U);
-    
+    return writeBlock(m_buffer);
+}
+
+bool CSlowDataCollector::writeBlock(const unsigned char* block)
+{
+    assert(block != nullptr);
+
+    if((block[0] & SLOW_DATA_TYPE_MASK) == m_slowDataType)
+        return addData(block + 1U);
+
     return false;
 }
 
@@ -34,6 +34,7 @@ public:
     virtual std::string getMyCall2() const = 0;
     virtual void setMyCall2(const std::string& mycall) = 0;
     virtual bool writeData(const unsigned char* data) = 0;
+    virtual bool writeBlock(const unsigned char* block) = 0;
     virtual void sync() = 0;
     virtual unsigned int getData(unsigned char* data, unsigned int length) = 0;
     virtual bool getData(std::string& data) = 0;
@@ -53,6 +54,7 @@ public:
     std::string getMyCall2() const;
     void setMyCall2(const std::string& mycall);
     bool writeData(const unsigned char* data);
+    bool writeBlock(const unsigned char* block);
     void sync();
     unsigned int getData(unsigned char* data, unsigned int length);
     bool getData(std::string& data);
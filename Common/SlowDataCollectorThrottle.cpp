@@ -55,9 +55,18 @@ void CSlowDataCollectorThrottle::setMyCall2(const std::string& mycall)
 }
 
 bool CSlowDataCollectorThrottle::writeData(const unsigned char* data)
+{
+    return throttle(m_collector->writeData(data));
+}
+
+bool CSlowDataCollectorThrottle::writeBlock(const unsigned char* block)
+{
+    return throttle(m_collector->writeBlock(block));
+}
+
+bool CSlowDataCollectorThrottle::throttle(bool complete)
 {
     m_isComplete = false;
-    bool complete = m_collector->writeData(data);
     if(complete){
         if(m_isFirst) {
             m_isFirst = false;
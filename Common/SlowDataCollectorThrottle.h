@@ -33,6 +33,7 @@ public:
     std::string getMyCall2() const;
     void setMyCall2(const std::string& mycall);
     bool writeData(const unsigned char* data);
+    bool writeBlock(const unsigned char* block);
     void sync();
     unsigned int getData(unsigned char* data, unsigned int length);
     bool getData(std::string& data);
@@ -41,6 +42,8 @@ public:
     void clock(unsigned int ms);
 
 private:
+    bool throttle(bool complete);
+
     ISlowDataCollector* m_collector;
     CTimer m_timer;
     bool m_isFirst;
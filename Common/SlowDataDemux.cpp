@@ -0,0 +1,107 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <cassert>
+#include <cstring>
+
+#include "SlowDataDemux.h"
+
+CSlowDataDemux::CSlowDataDemux() :
+m_consumers(),
+m_block(),
+m_state(SS_FIRST)
+{
+}
+
+void CSlowDataDemux::addConsumer(unsigned char type, SlowDataConsumer consumer)
+{
+	assert(consumer != nullptr);
+
+	m_consumers[(type & SLOW_DATA_TYPE_MASK) >> 4].push_back(consumer);
+}
+
+bool CSlowDataDemux::writeData(const unsigned char* data)
+{
+	assert(data != nullptr);
+
+	switch (m_state) {
+		case SS_FIRST:
+			m_block[0U] = data[0U] ^ SCRAMBLER_BYTE1;
+			m_block[1U] = data[1U] ^ SCRAMBLER_BYTE2;
+			m_block[2U] = data[2U] ^ SCRAMBLER_BYTE3;
+			m_state = SS_SECOND;
+			return false;
+
+		case SS_SECOND:
+			m_block[3U] = data[0U] ^ SCRAMBLER_BYTE1;
+			m_block[4U] = data[1U] ^ SCRAMBLER_BYTE2;
+			m_block[5U] = data[2U] ^ SCRAMBLER_BYTE3;
+			m_state = SS_FIRST;
+			break;
+	}
+
+	return writeBlock(m_block);
+}
+
+bool CSlowDataDemux::writeData(const CAMBEData& data)
+{
+	if (data.isSync()) {
+		sync();
+		return false;
+	}
+
+	unsigned char buffer[DV_FRAME_MAX_LENGTH_BYTES];
+	data.getData(buffer, DV_FRAME_MAX_LENGTH_BYTES);
+
+	return writeData(buffer + VOICE_FRAME_LENGTH_BYTES);
+}
+
+bool CSlowDataDemux::writeBlock(const unsigned char* block) const
+{
+	assert(block != nullptr);
+
+	// Every consumer of the type gets the block, even once one of them has completed
+	bool complete = false;
+	for (const auto& consumer : m_consumers[(block[0U] & SLOW_DATA_TYPE_MASK) >> 4]) {
+		if (consumer(block))
+			complete = true;
+	}
+
+	return complete;
+}
+
+void CSlowDataDemux::sync()
+{
+	m_state = SS_FIRST;
+}
+
+void CSlowDataDemux::reset()
+{
+	m_state = SS_FIRST;
+	::memset(m_block, 0x00U, SLOW_DATA_BLOCK_LENGTH);
+}
+
+unsigned int CSlowDataDemux::getConsumerCount() const
+{
+	unsigned int count = 0U;
+	for (const auto& consumers : m_consumers)
+		count += (unsigned int)consumers.size();
+
+	return count;
+}
@@ -0,0 +1,58 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "AMBEData.h"
+#include "DStarDefines.h"
+#include "Defs.h"
+
+// Called with a complete, descrambled, block, the first byte holding the type and length.
+// Returns true when the block completed something the consumer was collecting.
+typedef std::function<bool(const unsigned char* block)> SlowDataConsumer;
+
+// Descrambles the slow data of a stream and cuts it into blocks, once, then hands every block
+// to the consumers registered for its type only.
+class CSlowDataDemux {
+public:
+	CSlowDataDemux();
+
+	// type is one of the SLOW_DATA_TYPE_xxx values, the length bits are ignored
+	void addConsumer(unsigned char type, SlowDataConsumer consumer);
+
+	// The three slow data bytes of a voice frame
+	bool writeData(const unsigned char* data);
+	// A whole voice frame, sync frames restart the block framing
+	bool writeData(const CAMBEData& data);
+	// An already descrambled block, from another demux for example
+	bool writeBlock(const unsigned char* block) const;
+
+	void sync();
+	void reset();
+
+	unsigned int getConsumerCount() const;
+
+private:
+	std::vector<SlowDataConsumer> m_consumers[16U];
+	unsigned char                 m_block[SLOW_DATA_BLOCK_LENGTH];
+	SLOWDATA_STATE                m_state;
+};
@@ -0,0 +1,233 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#if defined(__linux__)
+#include <linux/if_tun.h>
+#endif
+
+#include "TapDevice.h"
+#include "Log.h"
+
+CTapDevice::CTapDevice() :
+m_fd(-1),
+m_name(),
+m_readBuffer(TAP_BATCH_FRAMES * TAP_FRAME_LENGTH),
+m_readLengths(),
+m_readCount(0U),
+m_readNext(0U),
+m_writeBuffer(TAP_BATCH_FRAMES * TAP_FRAME_LENGTH),
+m_writeLengths(),
+m_writeCount(0U),
+m_framesRead(0ULL),
+m_batches(0ULL)
+{
+}
+
+CTapDevice::~CTapDevice()
+{
+	close();
+}
+
+bool CTapDevice::open(const std::string& name)
+{
+#if defined(__linux__)
+	int fd = ::open("/dev/net/tun", O_RDWR);
+	if (fd < 0) {
+		LogError("Cannot open /dev/net/tun");
+		return false;
+	}
+
+	struct ifreq ifr1;
+	::memset(&ifr1, 0x00, sizeof(struct ifreq));
+
+	ifr1.ifr_flags = IFF_TAP | IFF_NO_PI;
+	::strncpy(ifr1.ifr_name, name.c_str(), IFNAMSIZ - 1);
+
+	if (::ioctl(fd, TUNSETIFF, (void *)&ifr1) < 0) {
+		LogError("TUNSETIFF ioctl failed, closing the tap device");
+		::close(fd);
+		return false;
+	}
+
+	int sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		LogError("Unable to open the config socket, closing the tap device");
+		::close(fd);
+		return false;
+	}
+
+	struct ifreq ifr2;
+	::memset(&ifr2, 0x00, sizeof(struct ifreq));
+	::strcpy(ifr2.ifr_name, ifr1.ifr_name);
+
+	ifr2.ifr_flags = IFF_UP | IFF_BROADCAST | IFF_MULTICAST;
+	if (::ioctl(sock, SIOCSIFFLAGS, (void *)&ifr2) < 0) {
+		LogError("SIOCSIFFLAGS ioctl failed, closing the tap device");
+		::close(sock);
+		::close(fd);
+		return false;
+	}
+
+	::close(sock);
+
+	if (!open(fd))
+		return false;
+
+	m_name = std::string(ifr1.ifr_name);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool CTapDevice::open(int fd)
+{
+	assert(fd >= 0);
+
+	int flags = ::fcntl(fd, F_GETFL, 0);
+	if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		LogError("Unable to make the tap device non blocking");
+		::close(fd);
+		return false;
+	}
+
+	m_fd = fd;
+	m_readCount = 0U;
+	m_readNext  = 0U;
+	m_writeCount = 0U;
+
+	return true;
+}
+
+const unsigned char* CTapDevice::read(unsigned int& length)
+{
+	if (m_fd < 0)
+		return nullptr;
+
+	if (m_readNext >= m_readCount)
+		fill();
+
+	if (m_readNext >= m_readCount)
+		return nullptr;
+
+	length = m_readLengths[m_readNext];
+
+	return m_readBuffer.data() + (m_readNext++) * TAP_FRAME_LENGTH;
+}
+
+bool CTapDevice::write(const unsigned char* frame, unsigned int length)
+{
+	assert(frame != nullptr);
+
+	if (m_fd < 0)
+		return false;
+
+	if (length > TAP_FRAME_LENGTH)
+		length = TAP_FRAME_LENGTH;
+
+	bool ret = true;
+	if (m_writeCount >= TAP_BATCH_FRAMES)
+		ret = flush();
+
+	::memcpy(m_writeBuffer.data() + m_writeCount * TAP_FRAME_LENGTH, frame, length);
+	m_writeLengths[m_writeCount++] = length;
+
+	return ret;
+}
+
+bool CTapDevice::flush()
+{
+	bool ret = true;
+
+	for (unsigned int i = 0U; i < m_writeCount; i++) {
+		ssize_t len = ::write(m_fd, m_writeBuffer.data() + i * TAP_FRAME_LENGTH, m_writeLengths[i]);
+		if (len != ssize_t(m_writeLengths[i])) {
+			LogError("Error returned from write()");
+			ret = false;
+		}
+	}
+
+	m_writeCount = 0U;
+
+	return ret;
+}
+
+void CTapDevice::close()
+{
+	if (m_fd < 0)
+		return;
+
+	flush();
+
+	::close(m_fd);
+	m_fd = -1;
+}
+
+bool CTapDevice::isOpen() const
+{
+	return m_fd >= 0;
+}
+
+std::string CTapDevice::getName() const
+{
+	return m_name;
+}
+
+unsigned long long CTapDevice::getFramesRead() const
+{
+	return m_framesRead;
+}
+
+unsigned long long CTapDevice::getBatches() const
+{
+	return m_batches;
+}
+
+void CTapDevice::fill()
+{
+	m_readCount = 0U;
+	m_readNext  = 0U;
+
+	while (m_readCount < TAP_BATCH_FRAMES) {
+		ssize_t len = ::read(m_fd, m_readBuffer.data() + m_readCount * TAP_FRAME_LENGTH, TAP_FRAME_LENGTH);
+		if (len < 0) {
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				LogError("Error returned from read()");
+			break;
+		}
+
+		if (len == 0)
+			break;
+
+		m_readLengths[m_readCount++] = (unsigned int)len;
+	}
+
+	if (m_readCount > 0U) {
+		m_framesRead += m_readCount;
+		m_batches++;
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+const unsigned int TAP_FRAME_LENGTH = 2000U;
+const unsigned int TAP_BATCH_FRAMES = 32U;
+
+// A tap device read and written in batches. A tap hands over one frame per read() or write(), so
+// reading drains every frame that is waiting, up to a batch, in one go on a non blocking descriptor
+// rather than selecting before each one. Writes are queued and go out together on flush().
+class CTapDevice {
+public:
+	CTapDevice();
+	~CTapDevice();
+
+	// Create a tap interface, the name may contain %d for the kernel to pick a number
+	bool open(const std::string& name = "tap%d");
+	// Use a descriptor opened elsewhere, the device closes it
+	bool open(int fd);
+
+	// The next frame read from the device or nullptr if there are none, it stays valid until the next call
+	const unsigned char* read(unsigned int& length);
+
+	// Queue a frame for the device, the queue is flushed first when full
+	bool write(const unsigned char* frame, unsigned int length);
+	bool flush();
+
+	void close();
+
+	bool         isOpen() const;
+	std::string  getName() const;
+
+	unsigned long long getFramesRead() const;
+	unsigned long long getBatches() const;
+
+private:
+	int                        m_fd;
+	std::string                m_name;
+	std::vector<unsigned char> m_readBuffer;
+	unsigned int               m_readLengths[TAP_BATCH_FRAMES];
+	unsigned int               m_readCount;
+	unsigned int               m_readNext;
+	std::vector<unsigned char> m_writeBuffer;
+	unsigned int               m_writeLengths[TAP_BATCH_FRAMES];
+	unsigned int               m_writeCount;
+	unsigned long long         m_framesRead;
+	unsigned long long         m_batches;
+
+	void fill();
+};
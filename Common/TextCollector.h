@@ -30,6 +30,8 @@ public:
 	~CTextCollector();
 
 	void writeData(const CAMBEData& data);
+	// A descrambled slow data block, returns true once the whole text is there
+	bool writeBlock(const unsigned char* block);
 
 	void sync();
 
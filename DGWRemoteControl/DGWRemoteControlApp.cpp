@@ -24,6 +24,7 @@
 #include <boost/algorithm/string.hpp>
 #include <thread>
 #include <chrono>
+#include <csignal>
 
 #include "DGWRemoteControlApp.h"
 #include "DGWRemoteControlConfig.h"
@@ -39,6 +40,11 @@ const std::string RECONNECT_PARAM("Param1");
 const std::string REFLECTOR_PARAM("Param2");
 const std::string CONFIG_FILENAME("dgwremotecontrol.cfg");
 
+// Renew the event subscription well before the gateway lets it lapse
+const unsigned int SUBSCRIBE_RENEW_SECS = 60U;
+
+static volatile std::sig_atomic_t s_stop = 0;
+
 int main(int argc, const char* argv[])
 {
     std::string name, repeater, actionText, user, reflector;
@@ -48,6 +54,10 @@ int main(int argc, const char* argv[])
 		::fprintf(stderr, "\ndgwremotecontrol v%s : invalid command line usage:\n\n", LONG_VERSION.c_str());
         ::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <repeater> link <reconnect> <reflector>\n");
 		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <repeater> unlink\n");
+		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] status\n");
+		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] watch\n");
+		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] voice\n");
+		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] quality\n");
 #ifdef USE_STARNET
 		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <starnet> drop <user>\n");
 		::fprintf(stderr, "\t\tdgwremotecontrol [-name <name>] <starnet> drop all\n");
@@ -132,6 +142,22 @@ int main(int argc, const char* argv[])
 
 	handler.setLoggedIn(true);
 
+	if (actionText == "status" || actionText == "watch" || actionText == "voice" || actionText == "quality") {
+		int res;
+		if (actionText == "status")
+			res = showStatus(handler);
+		else if (actionText == "watch")
+			res = watchEvents(handler);
+		else if (actionText == "voice")
+			res = showVoiceStats(handler);
+		else
+			res = showLinkQuality(handler);
+
+		handler.logout();
+		handler.close();
+		return res;
+	}
+
 	if (actionText == "drop")
 		handler.logoff(repeater, user);
 	else
@@ -219,6 +245,19 @@ bool getCLIParams(int argc, const char* argv[], std::string& name, std::string&
         reflector = boost::to_upper_copy(positionalArgs[3]);
         boost::replace_all(reflector, "_", " ");
     }
+    // dgwremotecontrol [-name <name>] status
+    // dgwremotecontrol [-name <name>] watch
+    // dgwremotecontrol [-name <name>] voice
+    // dgwremotecontrol [-name <name>] quality
+    else if(positionalArgs.size() == 1U) {
+        actionText = boost::to_lower_copy(positionalArgs[0]);
+        if(actionText != "status" && actionText != "watch" && actionText != "voice" && actionText != "quality") {
+            ::fprintf(stderr, "Invalid action %s. Expected status, watch, voice or quality\n", positionalArgs[0].c_str());
+            ret = false;
+        }
+        repeater = "ALL";
+        reconnect = RECONNECT_NEVER;
+    }
     // dgwremotecontrol [-name <name>] <repeater> unlink
     else if(positionalArgs.size() == 2U) {
         repeater = positionalArgs[0];
@@ -277,4 +316,220 @@ void sendHash(CRemoteControlRemoteControlHandler* handler, const std::string& pa
 
 	delete[] in;
 	delete[] out;
-}
\ No newline at end of file
+}
+int showStatus(CRemoteControlRemoteControlHandler& handler)
+{
+	handler.getRepeaters();
+
+	unsigned int count = 0U;
+	while (count < 10U) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+
+		RC_TYPE type = handler.readType();
+		if (type == RCT_REPEATERS) {
+			std::vector<CRemoteControlRepeaterData*> repeaters = handler.readRepeaters();
+			for (CRemoteControlRepeaterData* data : repeaters) {
+				printRepeater(*data);
+				delete data;
+			}
+
+			// Large gateways may need more than one datagram
+			std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+			while (handler.readType() == RCT_REPEATERS) {
+				repeaters = handler.readRepeaters();
+				for (CRemoteControlRepeaterData* data : repeaters) {
+					printRepeater(*data);
+					delete data;
+				}
+			}
+
+			return 0;
+		}
+
+		if (type == RCT_NAK) {
+			::fprintf(stderr, "dgwremotecontrol: status request rejected by the gateway\n");
+			return 1;
+		}
+
+		if (type == RCT_NONE)
+			handler.retry();
+
+		count++;
+	}
+
+	::fprintf(stderr, "dgwremotecontrol: unable to get a response from the gateway\n");
+	return 1;
+}
+
+int watchEvents(CRemoteControlRemoteControlHandler& handler)
+{
+	::signal(SIGINT,  [](int) { s_stop = 1; });
+	::signal(SIGTERM, [](int) { s_stop = 1; });
+
+	handler.subscribe();
+	auto subscribed = std::chrono::steady_clock::now();
+
+	while (s_stop == 0) {
+		if (std::chrono::steady_clock::now() - subscribed >= std::chrono::seconds(SUBSCRIBE_RENEW_SECS)) {
+			// Still waiting for the last ACK, resend it and try again in a second
+			if (!handler.subscribe()) {
+				handler.retry();
+				subscribed += std::chrono::seconds(1U);
+			} else {
+				subscribed = std::chrono::steady_clock::now();
+			}
+		}
+
+		RC_TYPE type = handler.readType();
+		switch (type) {
+			case RCT_REPEATER_EVENT: {
+					CRemoteControlRepeaterData* data = handler.readRepeater();
+					if (data != NULL)
+						printRepeater(*data);
+					delete data;
+				}
+				break;
+			case RCT_HEARD_EVENT: {
+					std::string repeater, user;
+					if (handler.readHeard(repeater, user))
+						::fprintf(stdout, "%s heard %s\n", repeater.c_str(), user.c_str());
+				}
+				break;
+			case RCT_NAK:
+				::fprintf(stderr, "dgwremotecontrol: subscription rejected by the gateway, %s\n", handler.readNAK().c_str());
+				return 1;
+			case RCT_NONE:
+				std::this_thread::sleep_for(std::chrono::milliseconds(20U));
+				break;
+			default:
+				break;
+		}
+
+		::fflush(stdout);
+	}
+
+	handler.unsubscribe();
+
+	return 0;
+}
+
+int showVoiceStats(CRemoteControlRemoteControlHandler& handler)
+{
+	handler.getVoiceStats();
+
+	unsigned int count = 0U;
+	while (count < 10U) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+
+		RC_TYPE type = handler.readType();
+		if (type == RCT_VOICE_STATS) {
+			::fprintf(stdout, "%-8s %10s %10s %8s %8s %8s  %-24s %-24s %-24s %-24s\n", "Protocol", "Frames in", "Frames out", "Drops", "Repeats", "Late",
+				"Decode p50/p99/max us", "Route p50/p99/max us", "Write p50/p99/max us", "Total p50/p99/max us");
+
+			for (const TRemoteControlVoiceStats& stats : handler.readVoiceStats()) {
+				const TRemoteControlLatency* stages[] = { &stats.decode, &stats.route, &stats.write, &stats.total };
+
+				::fprintf(stdout, "%-8s %10llu %10llu %8llu %8llu %8llu ", CVoiceStats::getName(stats.protocol),
+					(unsigned long long)stats.framesIn, (unsigned long long)stats.framesOut, (unsigned long long)stats.drops,
+					(unsigned long long)stats.headerRepeats, (unsigned long long)stats.late);
+
+				for (const TRemoteControlLatency* stage : stages) {
+					char text[32U];
+					::snprintf(text, sizeof(text), "%u/%u/%u", stage->p50, stage->p99, stage->max);
+					::fprintf(stdout, " %-24s", text);
+				}
+
+				::fprintf(stdout, "\n");
+			}
+
+			return 0;
+		}
+
+		if (type == RCT_NAK) {
+			::fprintf(stderr, "dgwremotecontrol: %s\n", handler.readNAK().c_str());
+			return 1;
+		}
+
+		if (type == RCT_NONE)
+			handler.retry();
+
+		count++;
+	}
+
+	::fprintf(stderr, "dgwremotecontrol: unable to get a response from the gateway\n");
+	return 1;
+}
+
+int showLinkQuality(CRemoteControlRemoteControlHandler& handler)
+{
+	handler.getLinkQuality();
+
+	unsigned int count = 0U;
+	while (count < 10U) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+
+		RC_TYPE type = handler.readType();
+		if (type == RCT_LINK_QUALITY) {
+			::fprintf(stdout, "%-8s %-8s %-6s %7s %10s %8s %8s %8s %9s\n", "Repeater", "Link", "Proto", "Streams", "Frames", "Lost", "Order", "Dups", "Jitter ms");
+
+			for (const TRemoteControlLinkQuality& link : handler.readLinkQuality())
+				printLinkQuality(link);
+
+			// Busy gateways may need more than one datagram
+			std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+			while (handler.readType() == RCT_LINK_QUALITY) {
+				for (const TRemoteControlLinkQuality& link : handler.readLinkQuality())
+					printLinkQuality(link);
+			}
+
+			return 0;
+		}
+
+		if (type == RCT_NAK) {
+			::fprintf(stderr, "dgwremotecontrol: %s\n", handler.readNAK().c_str());
+			return 1;
+		}
+
+		if (type == RCT_NONE)
+			handler.retry();
+
+		count++;
+	}
+
+	::fprintf(stderr, "dgwremotecontrol: unable to get a response from the gateway\n");
+	return 1;
+}
+
+void printLinkQuality(const TRemoteControlLinkQuality& link)
+{
+	const TLinkQuality& quality = link.quality;
+
+	::fprintf(stdout, "%-8s %-8s %-6s %7u %10llu %8llu %8llu %8llu %9.1f\n", link.repeater.c_str(), link.link.c_str(), CVoiceStats::getName(link.protocol),
+		quality.streams, (unsigned long long)quality.frames, (unsigned long long)quality.lost, (unsigned long long)quality.outOfOrder,
+		(unsigned long long)quality.duplicates, double(quality.jitter) / 1000.0);
+}
+
+void printRepeater(const CRemoteControlRepeaterData& data)
+{
+	std::string reflector = data.getReflector();
+	boost::trim(reflector);
+
+	::fprintf(stdout, "%s reflector \"%s\" reconnect %s\n", data.getCallsign().c_str(), reflector.empty() ? "None" : reflector.c_str(), reconnectToString(data.getReconnect()));
+
+	for (unsigned int i = 0U; i < data.getLinkCount(); i++) {
+		CRemoteControlLinkData* link = data.getLink(i);
+
+		const char* protocol = "DExtra";
+		if (link->getProtocol() == PROTO_DPLUS)
+			protocol = "D-Plus";
+		else if (link->getProtocol() == PROTO_DCS)
+			protocol = "DCS";
+		else if (link->getProtocol() == PROTO_CCS)
+			protocol = "CCS";
+
+		::fprintf(stdout, "\t%s %s %s%s%s\n", link->getCallsign().c_str(), protocol,
+			link->getDirection() == DIR_INCOMING ? "incoming" : "outgoing",
+			link->isLinked() ? " linked" : " linking",
+			link->isDongle() ? " dongle" : "");
+	}
+}
@@ -24,4 +24,10 @@
 #include "RemoteControlRemoteControlHandler.h"
 
 bool getCLIParams(int argc, const char* argv[], std::string& name, std::string& repeater, std::string& actionText, RECONNECT& reconnect, std::string& user, std::string& reflector);
-void sendHash(CRemoteControlRemoteControlHandler* handler, const std::string& password, unsigned int rnd);
\ No newline at end of file
+void sendHash(CRemoteControlRemoteControlHandler* handler, const std::string& password, unsigned int rnd);
+int  showStatus(CRemoteControlRemoteControlHandler& handler);
+int  watchEvents(CRemoteControlRemoteControlHandler& handler);
+int  showVoiceStats(CRemoteControlRemoteControlHandler& handler);
+int  showLinkQuality(CRemoteControlRemoteControlHandler& handler);
+void printLinkQuality(const TRemoteControlLinkQuality& link);
+void printRepeater(const CRemoteControlRepeaterData& data);
\ No newline at end of file
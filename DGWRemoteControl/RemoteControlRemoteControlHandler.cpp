@@ -27,6 +27,11 @@ const unsigned int BUFFER_LENGTH = 2000U;
 
 const unsigned int MAX_RETRIES = 3U;
 
+const unsigned int REPEATER_LENGTH = 2U * LONG_CALLSIGN_LENGTH + sizeof(int32_t);
+const unsigned int LINK_LENGTH     = LONG_CALLSIGN_LENGTH + 4U * sizeof(int32_t);
+const unsigned int VOICE_STATS_LENGTH = sizeof(int32_t) + 5U * sizeof(uint64_t) + 4U * (sizeof(uint64_t) + 4U * sizeof(uint32_t));
+const unsigned int LINK_QUALITY_LENGTH = 2U * LONG_CALLSIGN_LENGTH + sizeof(int32_t) + 4U * sizeof(uint64_t) + 2U * sizeof(uint32_t);
+
 CRemoteControlRemoteControlHandler::CRemoteControlRemoteControlHandler(const std::string& address, unsigned int port) :
 m_socket("", 0U),
 m_address(),
@@ -96,6 +101,24 @@ RC_TYPE CRemoteControlRemoteControlHandler::readType()
 		m_retryCount = 0U;
 		m_type = RCT_STARNET;
 		return m_type;
+	} else if (::memcmp(m_inBuffer, "ALL", 3U) == 0) {
+		m_retryCount = 0U;
+		m_type = RCT_REPEATERS;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "VST", 3U) == 0) {
+		m_retryCount = 0U;
+		m_type = RCT_VOICE_STATS;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "LNQ", 3U) == 0) {
+		m_retryCount = 0U;
+		m_type = RCT_LINK_QUALITY;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "EVR", 3U) == 0) {
+		m_type = RCT_REPEATER_EVENT;
+		return m_type;
+	} else if (::memcmp(m_inBuffer, "EVH", 3U) == 0) {
+		m_type = RCT_HEARD_EVENT;
+		return m_type;
 	}
 
 	return m_type;
@@ -158,12 +181,146 @@ CRemoteControlCallsignData* CRemoteControlRemoteControlHandler::readCallsigns()
 
 CRemoteControlRepeaterData* CRemoteControlRemoteControlHandler::readRepeater()
 {
-	if (m_type != RCT_REPEATER)
+	if (m_type != RCT_REPEATER && m_type != RCT_REPEATER_EVENT)
 		return NULL;
 
+	return readRepeater(m_inBuffer + 3U, m_inLength - 3U);
+}
+
+std::vector<CRemoteControlRepeaterData*> CRemoteControlRemoteControlHandler::readRepeaters()
+{
+	std::vector<CRemoteControlRepeaterData*> repeaters;
+
+	if (m_type != RCT_REPEATERS)
+		return repeaters;
+
 	unsigned char* p = m_inBuffer + 3U;
 	unsigned int pos = 3U;
 
+	while (pos + sizeof(int32_t) <= m_inLength) {
+		int32_t links;
+		::memcpy(&links, p, sizeof(int32_t));
+		pos += sizeof(int32_t);
+		p += sizeof(int32_t);
+
+		links = CUtils::swap_endian_be(links);
+		if (links < 0)
+			break;
+
+		unsigned int length = REPEATER_LENGTH + links * LINK_LENGTH;
+		if (pos + length > m_inLength)
+			break;
+
+		repeaters.push_back(readRepeater(p, length));
+		pos += length;
+		p += length;
+	}
+
+	return repeaters;
+}
+
+bool CRemoteControlRemoteControlHandler::readHeard(std::string& repeater, std::string& user)
+{
+	if (m_type != RCT_HEARD_EVENT || m_inLength < 3U + 2U * LONG_CALLSIGN_LENGTH)
+		return false;
+
+	repeater = std::string((char*)(m_inBuffer + 3U), LONG_CALLSIGN_LENGTH);
+	user     = std::string((char*)(m_inBuffer + 3U + LONG_CALLSIGN_LENGTH), LONG_CALLSIGN_LENGTH);
+
+	return true;
+}
+
+template <typename T> static T readValue(const unsigned char*& p)
+{
+	T value;
+	::memcpy(&value, p, sizeof(T));
+	p += sizeof(T);
+
+	return CUtils::swap_endian_be(value);
+}
+
+static void readLatency(const unsigned char*& p, TRemoteControlLatency& latency)
+{
+	latency.count = readValue<uint64_t>(p);
+	latency.p50   = readValue<uint32_t>(p);
+	latency.p90   = readValue<uint32_t>(p);
+	latency.p99   = readValue<uint32_t>(p);
+	latency.max   = readValue<uint32_t>(p);
+}
+
+std::vector<TRemoteControlVoiceStats> CRemoteControlRemoteControlHandler::readVoiceStats()
+{
+	std::vector<TRemoteControlVoiceStats> stats;
+
+	if (m_type != RCT_VOICE_STATS)
+		return stats;
+
+	const unsigned char* p = m_inBuffer + 3U;
+	unsigned int pos = 3U;
+
+	while (pos + VOICE_STATS_LENGTH <= m_inLength) {
+		TRemoteControlVoiceStats entry;
+
+		int32_t protocol = readValue<int32_t>(p);
+		entry.protocol = protocol > VP_NONE && protocol < int32_t(VOICE_PROTOCOLS) ? VOICE_PROTOCOL(protocol) : VP_NONE;
+
+		entry.framesIn      = readValue<uint64_t>(p);
+		entry.framesOut     = readValue<uint64_t>(p);
+		entry.drops         = readValue<uint64_t>(p);
+		entry.headerRepeats = readValue<uint64_t>(p);
+		entry.late          = readValue<uint64_t>(p);
+
+		readLatency(p, entry.decode);
+		readLatency(p, entry.route);
+		readLatency(p, entry.write);
+		readLatency(p, entry.total);
+
+		stats.push_back(entry);
+		pos += VOICE_STATS_LENGTH;
+	}
+
+	return stats;
+}
+
+std::vector<TRemoteControlLinkQuality> CRemoteControlRemoteControlHandler::readLinkQuality()
+{
+	std::vector<TRemoteControlLinkQuality> links;
+
+	if (m_type != RCT_LINK_QUALITY)
+		return links;
+
+	const unsigned char* p = m_inBuffer + 3U;
+	unsigned int pos = 3U;
+
+	while (pos + LINK_QUALITY_LENGTH <= m_inLength) {
+		TRemoteControlLinkQuality entry;
+
+		entry.repeater = std::string((const char*)p, LONG_CALLSIGN_LENGTH);
+		p += LONG_CALLSIGN_LENGTH;
+		entry.link = std::string((const char*)p, LONG_CALLSIGN_LENGTH);
+		p += LONG_CALLSIGN_LENGTH;
+
+		int32_t protocol = readValue<int32_t>(p);
+		entry.protocol = protocol > VP_NONE && protocol < int32_t(VOICE_PROTOCOLS) ? VOICE_PROTOCOL(protocol) : VP_NONE;
+
+		entry.quality.frames     = readValue<uint64_t>(p);
+		entry.quality.lost       = readValue<uint64_t>(p);
+		entry.quality.outOfOrder = readValue<uint64_t>(p);
+		entry.quality.duplicates = readValue<uint64_t>(p);
+		entry.quality.jitter     = readValue<uint32_t>(p);
+		entry.quality.streams    = readValue<uint32_t>(p);
+
+		links.push_back(entry);
+		pos += LINK_QUALITY_LENGTH;
+	}
+
+	return links;
+}
+
+CRemoteControlRepeaterData* CRemoteControlRemoteControlHandler::readRepeater(const unsigned char* p, unsigned int length) const
+{
+	unsigned int pos = 0U;
+
 	std::string callsign((char*)p, LONG_CALLSIGN_LENGTH);
 	pos += LONG_CALLSIGN_LENGTH;
 	p += LONG_CALLSIGN_LENGTH;
@@ -179,7 +336,7 @@ CRemoteControlRepeaterData* CRemoteControlRemoteControlHandler::readRepeater()
 
 	CRemoteControlRepeaterData* data = new CRemoteControlRepeaterData(callsign, CUtils::swap_endian_be(reconnect), reflector);
 
-	while (pos < m_inLength) {
+	while (pos + LINK_LENGTH <= length) {
 		std::string callsign((char*)p, LONG_CALLSIGN_LENGTH);
 		pos += LONG_CALLSIGN_LENGTH;
 		p += LONG_CALLSIGN_LENGTH;
@@ -392,6 +549,31 @@ bool CRemoteControlRemoteControlHandler::getStarNet(const std::string& callsign)
 	}
 }
 
+bool CRemoteControlRemoteControlHandler::getRepeaters()
+{
+	return sendRequest("GAR");
+}
+
+bool CRemoteControlRemoteControlHandler::getVoiceStats()
+{
+	return sendRequest("GVS");
+}
+
+bool CRemoteControlRemoteControlHandler::getLinkQuality()
+{
+	return sendRequest("GLQ");
+}
+
+bool CRemoteControlRemoteControlHandler::subscribe()
+{
+	return sendRequest("SUB");
+}
+
+bool CRemoteControlRemoteControlHandler::unsubscribe()
+{
+	return sendRequest("UNS");
+}
+
 bool CRemoteControlRemoteControlHandler::link(const std::string& callsign, RECONNECT reconnect, const std::string& reflector)
 {
 	assert(!callsign.empty());
@@ -540,6 +722,24 @@ bool CRemoteControlRemoteControlHandler::logout()
 	return true;
 }
 
+bool CRemoteControlRemoteControlHandler::sendRequest(const char* type)
+{
+	if (!m_loggedIn || m_retryCount > 0U)
+		return false;
+
+	::memcpy(m_outBuffer, type, 3U);
+	m_outLength = 3U;
+
+	bool ret = m_socket.write(m_outBuffer, m_outLength, m_address, m_port);
+	if (!ret) {
+		m_retryCount = 0U;
+		return false;
+	} else {
+		m_retryCount = 1U;
+		return true;
+	}
+}
+
 bool CRemoteControlRemoteControlHandler::retry()
 {
 	if (m_retryCount > 0U) {
@@ -23,6 +23,10 @@
 #include "RemoteControlStarNetGroup.h"
 #include "RemoteControlCallsignData.h"
 #include "UDPReaderWriter.h"
+#include "LinkQuality.h"
+#include "VoiceStats.h"
+
+#include <vector>
 
 enum RC_TYPE {
 	RCT_NONE,
@@ -31,7 +35,42 @@ enum RC_TYPE {
 	RCT_RANDOM,
 	RCT_CALLSIGNS,
 	RCT_REPEATER,
-	RCT_STARNET
+	RCT_STARNET,
+	RCT_REPEATERS,
+	RCT_REPEATER_EVENT,
+	RCT_HEARD_EVENT,
+	RCT_VOICE_STATS,
+	RCT_LINK_QUALITY
+};
+
+struct TRemoteControlLatency {
+	uint64_t count;
+	uint32_t p50;
+	uint32_t p90;
+	uint32_t p99;
+	uint32_t max;
+};
+
+// Counted since the gateway started, latencies are in microseconds
+struct TRemoteControlVoiceStats {
+	VOICE_PROTOCOL        protocol;
+	uint64_t              framesIn;
+	uint64_t              framesOut;
+	uint64_t              drops;
+	uint64_t              headerRepeats;
+	uint64_t              late;
+	TRemoteControlLatency decode;
+	TRemoteControlLatency route;
+	TRemoteControlLatency write;
+	TRemoteControlLatency total;
+};
+
+// Counted on frames received since the link came up, G2 is one entry for the whole gateway
+struct TRemoteControlLinkQuality {
+	std::string    repeater;
+	std::string    link;
+	VOICE_PROTOCOL protocol;
+	TLinkQuality   quality;
 };
 
 class CRemoteControlRemoteControlHandler {
@@ -48,6 +87,10 @@ public:
 	CRemoteControlCallsignData* readCallsigns();
 	CRemoteControlRepeaterData* readRepeater();
 	CRemoteControlStarNetGroup* readStarNetGroup();
+	std::vector<CRemoteControlRepeaterData*> readRepeaters();
+	bool                        readHeard(std::string& repeater, std::string& user);
+	std::vector<TRemoteControlVoiceStats> readVoiceStats();
+	std::vector<TRemoteControlLinkQuality> readLinkQuality();
 
 	bool login();
 	bool sendHash(const unsigned char* hash, unsigned int length);
@@ -57,6 +100,13 @@ public:
 	bool getCallsigns();
 	bool getRepeater(const std::string& callsign);
 	bool getStarNet(const std::string& callsign);
+	bool getRepeaters();
+	bool getVoiceStats();
+	bool getLinkQuality();
+
+	// Ask for events as things change on the gateway, renewed by subscribing again
+	bool subscribe();
+	bool unsubscribe();
 
 	bool link(const std::string& callsign, RECONNECT reconnect, const std::string& reflector);
 	bool unlink(const std::string& callsign, PROTOCOL protocol, const std::string& reflector);
@@ -79,6 +129,9 @@ private:
 	unsigned int      m_inLength;
 	unsigned char*    m_outBuffer;
 	unsigned int      m_outLength;
+
+	CRemoteControlRepeaterData* readRepeater(const unsigned char* p, unsigned int length) const;
+	bool sendRequest(const char* type);
 };
 
 #endif
@@ -0,0 +1,112 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+
+#include "DExtraReflectorEmulator.h"
+#include "DStarDefines.h"
+
+const unsigned int DEXTRA_POLL_INTERVAL = 1000U;
+
+CDExtraReflectorEmulator::CDExtraReflectorEmulator(const std::string& callsign, const std::string& localAddress, const std::string& gatewayAddress) :
+CVoiceEndpoint("DExtra Reflector Emulator", localAddress, DEXTRA_PORT, gatewayAddress, DEXTRA_PORT),
+m_callsign(callsign),
+m_linked(false),
+m_lastPoll()
+{
+	m_callsign.resize(LONG_CALLSIGN_LENGTH, ' ');
+}
+
+CDExtraReflectorEmulator::~CDExtraReflectorEmulator()
+{
+}
+
+bool CDExtraReflectorEmulator::writeHeader(CHeaderData& header)
+{
+	unsigned char buffer[60U];
+	unsigned int length = header.getDExtraData(buffer, 60U, true);
+
+	return m_socket.write(buffer, length, m_gatewayAddress, m_gatewayPort);
+}
+
+bool CDExtraReflectorEmulator::writeAMBE(CAMBEData& data)
+{
+	unsigned char buffer[40U];
+	unsigned int length = data.getDExtraData(buffer, 40U);
+
+	return m_socket.write(buffer, length, m_gatewayAddress, m_gatewayPort);
+}
+
+bool CDExtraReflectorEmulator::isReady() const
+{
+	return m_linked;
+}
+
+void CDExtraReflectorEmulator::processPacket(const unsigned char* buffer, unsigned int length, in_addr address, unsigned int port, const TPacingTime& now)
+{
+	if (length >= 27U && ::memcmp(buffer, "DSVT", 4U) == 0) {
+		if (buffer[14U] == 0x80U) {
+			CHeaderData header;
+			if (length >= 56U && header.setDExtraData(buffer, length, true, address, port, DEXTRA_PORT))
+				received(header, now);
+		} else {
+			CAMBEData data;
+			data.setDExtraData(buffer, length, address, port, DEXTRA_PORT);
+			received(data, now);
+		}
+
+		return;
+	}
+
+	// Polls from the gateway need nothing, we never time the link out
+	if (length != 11U)
+		return;
+
+	// A link request is acked by sending it back with ACK appended, an unlink has no module
+	if (buffer[LONG_CALLSIGN_LENGTH + 1U] == ' ') {
+		m_linked = false;
+		return;
+	}
+
+	unsigned char reply[14U];
+	::memcpy(reply, buffer, LONG_CALLSIGN_LENGTH + 2U);
+	::memcpy(reply + LONG_CALLSIGN_LENGTH + 2U, "ACK", 3U);
+	reply[13U] = 0x00U;
+	m_socket.write(reply, 14U, address, port);
+
+	m_linked = true;
+}
+
+void CDExtraReflectorEmulator::clock(const TPacingTime& now)
+{
+	if (!m_linked || now - m_lastPoll < std::chrono::milliseconds(DEXTRA_POLL_INTERVAL))
+		return;
+
+	writePoll();
+	m_lastPoll = now;
+}
+
+void CDExtraReflectorEmulator::writePoll()
+{
+	unsigned char buffer[9U];
+
+	::memcpy(buffer, m_callsign.c_str(), LONG_CALLSIGN_LENGTH);
+	buffer[LONG_CALLSIGN_LENGTH] = 0x00U;
+
+	m_socket.write(buffer, 9U, m_gatewayAddress, m_gatewayPort);
+}
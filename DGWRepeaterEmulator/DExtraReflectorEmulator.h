@@ -0,0 +1,47 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "VoiceEndpoint.h"
+
+// Just enough of a DExtra reflector for the gateway to link to it and exchange voice with it
+class CDExtraReflectorEmulator : public CVoiceEndpoint {
+public:
+	CDExtraReflectorEmulator(const std::string& callsign, const std::string& localAddress, const std::string& gatewayAddress);
+	virtual ~CDExtraReflectorEmulator();
+
+	virtual bool writeHeader(CHeaderData& header);
+	virtual bool writeAMBE(CAMBEData& data);
+
+	// Linked by the gateway
+	virtual bool isReady() const;
+
+protected:
+	virtual void processPacket(const unsigned char* buffer, unsigned int length, in_addr address, unsigned int port, const TPacingTime& now);
+	virtual void clock(const TPacingTime& now);
+
+private:
+	std::string       m_callsign;
+	std::atomic<bool> m_linked;
+	TPacingTime       m_lastPoll;
+
+	void writePoll();
+};
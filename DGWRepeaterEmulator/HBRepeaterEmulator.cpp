@@ -0,0 +1,105 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+
+#include "HBRepeaterEmulator.h"
+#include "DStarDefines.h"
+
+const char         HB_POLL_TEXT[]   = "dgwrepeateremulator";
+const unsigned int HB_POLL_INTERVAL = 1000U;
+
+CHBRepeaterEmulator::CHBRepeaterEmulator(const std::string& localAddress, unsigned int localPort, const std::string& gatewayAddress, unsigned int gatewayPort) :
+CVoiceEndpoint("HB Repeater Emulator", localAddress, localPort, gatewayAddress, gatewayPort),
+m_lastPoll()
+{
+}
+
+CHBRepeaterEmulator::~CHBRepeaterEmulator()
+{
+}
+
+bool CHBRepeaterEmulator::writeHeader(CHeaderData& header)
+{
+	unsigned char buffer[50U];
+	unsigned int length = header.getHBRepeaterData(buffer, 50U, true);
+
+	return m_socket.write(buffer, length, m_gatewayAddress, m_gatewayPort);
+}
+
+bool CHBRepeaterEmulator::writeAMBE(CAMBEData& data)
+{
+	unsigned char buffer[30U];
+	unsigned int length = data.getHBRepeaterData(buffer, 30U);
+
+	return m_socket.write(buffer, length, m_gatewayAddress, m_gatewayPort);
+}
+
+bool CHBRepeaterEmulator::isReady() const
+{
+	// The gateway never answers a homebrew repeater, it only sends to it
+	return true;
+}
+
+void CHBRepeaterEmulator::processPacket(const unsigned char* buffer, unsigned int length, in_addr address, unsigned int port, const TPacingTime& now)
+{
+	if (length < 5U || ::memcmp(buffer, "DSRP", 4U) != 0)
+		return;
+
+	switch (buffer[4U]) {
+		case 0x20U:
+			if (length >= 49U) {
+				CHeaderData header;
+				if (header.setHBRepeaterData(buffer, length, true, address, port))
+					received(header, now);
+			}
+			break;
+
+		case 0x21U:
+			if (length >= 21U) {
+				CAMBEData data;
+				data.setHBRepeaterData(buffer, length, address, port);
+				received(data, now);
+			}
+			break;
+
+		default:
+			// Text and status are of no interest here
+			break;
+	}
+}
+
+void CHBRepeaterEmulator::clock(const TPacingTime& now)
+{
+	if (now - m_lastPoll < std::chrono::milliseconds(HB_POLL_INTERVAL))
+		return;
+
+	writePoll();
+	m_lastPoll = now;
+}
+
+void CHBRepeaterEmulator::writePoll()
+{
+	unsigned char buffer[40U];
+
+	::memcpy(buffer, "DSRP", 4U);
+	buffer[4U] = 0x0AU;
+	::memcpy(buffer + 5U, HB_POLL_TEXT, sizeof(HB_POLL_TEXT));
+
+	m_socket.write(buffer, 5U + sizeof(HB_POLL_TEXT), m_gatewayAddress, m_gatewayPort);
+}
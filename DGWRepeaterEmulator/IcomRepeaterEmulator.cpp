@@ -0,0 +1,126 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "IcomRepeaterEmulator.h"
+#include "DStarDefines.h"
+
+CIcomRepeaterEmulator::CIcomRepeaterEmulator(const std::string& localAddress, unsigned int localPort, const std::string& gatewayAddress, unsigned int gatewayPort) :
+CVoiceEndpoint("Icom Repeater Emulator", localAddress, localPort, gatewayAddress, gatewayPort),
+m_initialised(false),
+m_seqNo(0U),
+m_history(),
+m_historyCount(0U)
+{
+}
+
+CIcomRepeaterEmulator::~CIcomRepeaterEmulator()
+{
+}
+
+bool CIcomRepeaterEmulator::writeHeader(CHeaderData& header)
+{
+	header.setRptSeq(m_seqNo++);
+
+	unsigned char buffer[60U];
+	unsigned int length = header.getIcomRepeaterData(buffer, 60U, true);
+
+	return m_socket.write(buffer, length, m_gatewayAddress, m_gatewayPort);
+}
+
+bool CIcomRepeaterEmulator::writeAMBE(CAMBEData& data)
+{
+	data.setRptSeq(m_seqNo++);
+
+	unsigned char buffer[40U];
+	unsigned int length = data.getIcomRepeaterData(buffer, 40U);
+
+	return m_socket.write(buffer, length, m_gatewayAddress, m_gatewayPort);
+}
+
+bool CIcomRepeaterEmulator::isReady() const
+{
+	return m_initialised;
+}
+
+void CIcomRepeaterEmulator::processPacket(const unsigned char* buffer, unsigned int length, in_addr address, unsigned int port, const TPacingTime& now)
+{
+	if (length < 10U)
+		return;
+
+	if (::memcmp(buffer, "INIT", 4U) == 0) {
+		unsigned char reply[10U] = { 'I', 'N', 'I', 'T', 0x00U, 0x00U, 0x72U, 0x00U, 0x00U, 0x00U };
+		m_socket.write(reply, 10U, address, port);
+
+		m_historyCount = 0U;
+		m_initialised  = true;
+		return;
+	}
+
+	if (::memcmp(buffer, "DSTR", 4U) != 0)
+		return;
+
+	// Acks of our own packets
+	if (buffer[6U] == 0x72U)
+		return;
+
+	uint16_t seqNo = buffer[4U] * 256U + buffer[5U];
+	writeAck(seqNo, address, port);
+
+	// A retransmission because our ack was too slow
+	if (isRepeat(seqNo))
+		return;
+
+	if (buffer[6U] != 0x73U || buffer[7U] != 0x12U || buffer[10U] != 0x20U)
+		return;
+
+	if ((buffer[16U] & 0x80U) == 0x80U) {
+		if (length >= 58U) {
+			CHeaderData header;
+			if (header.setIcomRepeaterData(buffer, length, true, address, port))
+				received(header, now);
+		}
+	} else if (length >= 29U) {
+		CAMBEData data;
+		data.setIcomRepeaterData(buffer, length, address, port);
+		received(data, now);
+	}
+}
+
+void CIcomRepeaterEmulator::writeAck(uint16_t seqNo, in_addr address, unsigned int port)
+{
+	unsigned char ack[10U] = { 'D', 'S', 'T', 'R', (unsigned char)(seqNo / 256U), (unsigned char)(seqNo % 256U), 0x72U, 0x00U, 0x00U, 0x00U };
+
+	m_socket.write(ack, 10U, address, port);
+}
+
+bool CIcomRepeaterEmulator::isRepeat(uint16_t seqNo)
+{
+	unsigned int count = std::min(m_historyCount, ICOM_HISTORY_LENGTH);
+	for (unsigned int i = 0U; i < count; i++) {
+		if (m_history[i] == seqNo)
+			return true;
+	}
+
+	m_history[m_historyCount % ICOM_HISTORY_LENGTH] = seqNo;
+	m_historyCount++;
+
+	return false;
+}
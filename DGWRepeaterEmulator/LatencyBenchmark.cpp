@@ -0,0 +1,197 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "LatencyBenchmark.h"
+#include "DStarDefines.h"
+#include "PacingEngine.h"
+
+const unsigned int SETTLE_MS     = 2000U;
+const unsigned int STREAM_GAP_MS = 2000U;
+
+CLatencyBenchmark::CLatencyBenchmark(const std::string& repeater, const std::string& reflector, std::shared_ptr<const CAMBEVoiceLibrary> voice, unsigned int streams, unsigned int frames, unsigned int period, unsigned int burst) :
+m_repeater(repeater),
+m_reflector(reflector),
+m_voice(voice),
+m_streams(streams),
+m_frames(frames),
+m_period(period),
+m_burst(burst),
+m_voiceFrame(0U),
+m_networkToRF(),
+m_rfToNetwork()
+{
+	assert(voice != nullptr);
+	assert(frames > 0U);
+	assert(period > 0U);
+	assert(burst > 0U);
+
+	m_repeater.resize(LONG_CALLSIGN_LENGTH, ' ');
+	m_reflector.resize(LONG_CALLSIGN_LENGTH, ' ');
+}
+
+bool CLatencyBenchmark::waitForGateway(CVoiceEndpoint& repeater, CVoiceEndpoint& reflector, unsigned int timeoutMs)
+{
+	TPacingTime end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+	while (!repeater.isReady() || !reflector.isReady()) {
+		if (std::chrono::steady_clock::now() > end)
+			return false;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(100U));
+	}
+
+	// Let the link announcement go out before we start
+	std::this_thread::sleep_for(std::chrono::milliseconds(SETTLE_MS));
+
+	return true;
+}
+
+void CLatencyBenchmark::runNetworkToRF(CVoiceEndpoint& repeater, CVoiceEndpoint& reflector)
+{
+	std::string gateway = m_reflector.substr(0U, LONG_CALLSIGN_LENGTH - 1U) + "G";
+
+	CHeaderData header;
+	header.setMyCall1("N0CALL");
+	header.setMyCall2("EMU");
+	header.setCQCQCQ();
+	header.setRepeaters(gateway, m_reflector);
+
+	run(header, reflector, repeater, m_networkToRF);
+}
+
+void CLatencyBenchmark::runRFToNetwork(CVoiceEndpoint& repeater, CVoiceEndpoint& reflector)
+{
+	std::string gateway = m_repeater.substr(0U, LONG_CALLSIGN_LENGTH - 1U) + "G";
+
+	CHeaderData header;
+	header.setMyCall1("N0CALL");
+	header.setMyCall2("EMU");
+	header.setCQCQCQ();
+	header.setRepeaters(m_repeater, gateway);
+
+	run(header, repeater, reflector, m_rfToNetwork);
+}
+
+void CLatencyBenchmark::run(CHeaderData& header, CVoiceEndpoint& source, CVoiceEndpoint& sink, CLatencyRecorder& recorder)
+{
+	sink.setRecorder(&recorder);
+
+	for (unsigned int i = 0U; i < m_streams; i++) {
+		transmit(header, source, recorder);
+
+		// Anything still in the gateway comes out during the gap
+		std::this_thread::sleep_for(std::chrono::milliseconds(STREAM_GAP_MS));
+	}
+
+	sink.setRecorder(nullptr);
+}
+
+void CLatencyBenchmark::transmit(CHeaderData& header, CVoiceEndpoint& source, CLatencyRecorder& recorder)
+{
+	unsigned int id = CHeaderData::createId();
+
+	recorder.start();
+
+	header.setId(id);
+	recorder.sentHeader(std::chrono::steady_clock::now());
+	source.writeHeader(header);
+
+	CPacingEngine pacer(m_period);
+	pacer.add([&](unsigned int tick) -> bool {
+		for (unsigned int frame = tick * m_burst; frame < (tick + 1U) * m_burst; frame++) {
+			if (!transmit(id, frame, source, recorder))
+				return false;
+		}
+
+		return true;
+	});
+	pacer.run();
+}
+
+bool CLatencyBenchmark::transmit(unsigned int id, unsigned int frame, CVoiceEndpoint& source, CLatencyRecorder& recorder)
+{
+	bool end = frame + 1U >= m_frames;
+
+	unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+	if (end) {
+		::memcpy(buffer, END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES);
+	} else {
+		::memcpy(buffer, m_voice->getFrame(m_voiceFrame), VOICE_FRAME_LENGTH_BYTES);
+		m_voiceFrame = (m_voiceFrame + 1U) % m_voice->getFrameCount();
+
+		unsigned int seq = frame % 21U;
+		if (seq == 0U)
+			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+		else
+			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
+	}
+
+	CAMBEData data;
+	data.setId(id);
+	data.setSeq(frame % 21U);
+	data.setEnd(end);
+	data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+
+	recorder.sent(frame, std::chrono::steady_clock::now());
+	source.writeAMBE(data);
+
+	return !end;
+}
+
+bool CLatencyBenchmark::printResults() const
+{
+	bool ret = printResults("Network to RF", m_networkToRF);
+	ret = printResults("RF to network", m_rfToNetwork) && ret;
+
+	return ret;
+}
+
+bool CLatencyBenchmark::printResults(const std::string& title, const CLatencyRecorder& recorder)
+{
+	unsigned int sent     = recorder.getSent();
+	unsigned int received = recorder.getReceived();
+
+	::printf("%s: %u frames sent, %u received, %u lost, %u duplicated\n", title.c_str(), sent, received, sent - received, recorder.getDuplicates());
+
+	if (recorder.getHeaders() > 0U) {
+		CJitterHistogram header = recorder.getHeaderLatency();
+		::printf("  header latency  p50 %7.2f ms  max %7.2f ms\n", getPercentile(header, 0.5), header.getMax() / 1000.0);
+	}
+
+	if (received > 0U) {
+		::printf("  throughput      %7.0f frames/s\n", recorder.getThroughput());
+
+		CJitterHistogram latency = recorder.getLatency();
+		::printf("  frame latency   p50 %7.2f ms  p90 %7.2f ms  p99 %7.2f ms  max %7.2f ms\n",
+			getPercentile(latency, 0.5), getPercentile(latency, 0.9), getPercentile(latency, 0.99), latency.getMax() / 1000.0);
+	}
+
+	return received > 0U;
+}
+
+double CLatencyBenchmark::getPercentile(const CJitterHistogram& histogram, double fraction)
+{
+	// The histogram gives the top of the bucket, which can be above the largest value seen
+	return std::min(histogram.getPercentile(fraction), histogram.getMax()) / 1000.0;
+}
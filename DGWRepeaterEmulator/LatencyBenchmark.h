@@ -0,0 +1,59 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "AMBEVoiceLibrary.h"
+#include "LatencyRecorder.h"
+#include "VoiceEndpoint.h"
+
+// Plays the same voice through the gateway in both directions, from the network side through the
+// reflector to the repeater and from the repeater to the reflector, and times what comes out.
+class CLatencyBenchmark {
+public:
+	CLatencyBenchmark(const std::string& repeater, const std::string& reflector, std::shared_ptr<const CAMBEVoiceLibrary> voice, unsigned int streams, unsigned int frames, unsigned int period = 20U, unsigned int burst = 1U);
+
+	bool waitForGateway(CVoiceEndpoint& repeater, CVoiceEndpoint& reflector, unsigned int timeoutMs);
+
+	void runNetworkToRF(CVoiceEndpoint& repeater, CVoiceEndpoint& reflector);
+	void runRFToNetwork(CVoiceEndpoint& repeater, CVoiceEndpoint& reflector);
+
+	bool printResults() const;
+
+private:
+	std::string                              m_repeater;
+	std::string                              m_reflector;
+	std::shared_ptr<const CAMBEVoiceLibrary> m_voice;
+	unsigned int                             m_streams;
+	unsigned int                             m_frames;
+	unsigned int                             m_period;
+	unsigned int                             m_burst;
+	unsigned int                             m_voiceFrame;
+	CLatencyRecorder                         m_networkToRF;
+	CLatencyRecorder                         m_rfToNetwork;
+
+	void run(CHeaderData& header, CVoiceEndpoint& source, CVoiceEndpoint& sink, CLatencyRecorder& recorder);
+	void transmit(CHeaderData& header, CVoiceEndpoint& source, CLatencyRecorder& recorder);
+	bool transmit(unsigned int id, unsigned int frame, CVoiceEndpoint& source, CLatencyRecorder& recorder);
+
+	static bool   printResults(const std::string& title, const CLatencyRecorder& recorder);
+	static double getPercentile(const CJitterHistogram& histogram, double fraction);
+};
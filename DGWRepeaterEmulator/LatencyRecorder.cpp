@@ -0,0 +1,189 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "LatencyRecorder.h"
+
+const unsigned int SEQUENCE_LENGTH = 21U;
+
+const unsigned int LATENCY_BUCKET_US = 50U;
+const unsigned int LATENCY_BUCKETS   = 2000U;
+
+CLatencyRecorder::CLatencyRecorder() :
+m_mutex(),
+m_headerSent(),
+m_headerReceived(true),
+m_id(0U),
+m_sentTimes(),
+m_receivedFrames(),
+m_expected(0U),
+m_sent(0U),
+m_received(0U),
+m_duplicates(0U),
+m_headers(0U),
+m_arrivals(0UL),
+m_streamStart(),
+m_lastArrival(),
+m_activeTime(0),
+m_headerLatency(LATENCY_BUCKET_US, LATENCY_BUCKETS),
+m_latency(LATENCY_BUCKET_US, LATENCY_BUCKETS)
+{
+}
+
+void CLatencyRecorder::start()
+{
+	std::lock_guard lock(m_mutex);
+
+	m_activeTime += getStreamTime();
+	m_streamStart = TPacingTime();
+	m_lastArrival = TPacingTime();
+
+	m_headerReceived = true;
+	m_id             = 0U;
+	m_sentTimes.clear();
+	m_receivedFrames.clear();
+	m_expected = 0U;
+}
+
+void CLatencyRecorder::sentHeader(const TPacingTime& now)
+{
+	std::lock_guard lock(m_mutex);
+
+	m_headerSent     = now;
+	m_headerReceived = false;
+}
+
+void CLatencyRecorder::sent(unsigned int frame, const TPacingTime& now)
+{
+	std::lock_guard lock(m_mutex);
+
+	if (frame >= m_sentTimes.size()) {
+		m_sentTimes.resize(frame + 1U);
+		m_receivedFrames.resize(frame + 1U, false);
+	}
+
+	m_sentTimes[frame] = now;
+	m_sent++;
+
+	if (frame == 0U)
+		m_streamStart = now;
+}
+
+void CLatencyRecorder::receivedHeader(unsigned int id, const TPacingTime& now)
+{
+	std::lock_guard lock(m_mutex);
+
+	// The gateway repeats headers, only the first one counts
+	if (m_headerReceived)
+		return;
+
+	m_headerLatency.add(std::chrono::duration_cast<std::chrono::microseconds>(now - m_headerSent));
+	m_headerReceived = true;
+	m_id             = id;
+	m_headers++;
+}
+
+void CLatencyRecorder::received(unsigned int id, unsigned int seq, const TPacingTime& now)
+{
+	std::lock_guard lock(m_mutex);
+
+	// Announcements and acks the gateway makes up itself
+	if (id != m_id)
+		return;
+
+	// Counted before unwrapping, which can go wrong when the gateway drops many frames in a row
+	m_arrivals++;
+	m_lastArrival = now;
+
+	// The frame with this sequence number closest to the one we expect
+	unsigned int frame = m_expected - (m_expected % SEQUENCE_LENGTH) + seq;
+	if (frame > m_expected + SEQUENCE_LENGTH / 2U && frame >= SEQUENCE_LENGTH)
+		frame -= SEQUENCE_LENGTH;
+	else if (frame + SEQUENCE_LENGTH / 2U < m_expected)
+		frame += SEQUENCE_LENGTH;
+
+	// Not a frame we have sent yet
+	if (frame >= m_sentTimes.size())
+		return;
+
+	if (m_receivedFrames[frame]) {
+		m_duplicates++;
+		return;
+	}
+
+	m_latency.add(std::chrono::duration_cast<std::chrono::microseconds>(now - m_sentTimes[frame]));
+	m_receivedFrames[frame] = true;
+	m_received++;
+
+	if (frame >= m_expected)
+		m_expected = frame + 1U;
+}
+
+unsigned int CLatencyRecorder::getSent() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_sent;
+}
+
+unsigned int CLatencyRecorder::getReceived() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_received;
+}
+
+unsigned int CLatencyRecorder::getDuplicates() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_duplicates;
+}
+
+unsigned int CLatencyRecorder::getHeaders() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_headers;
+}
+
+CJitterHistogram CLatencyRecorder::getHeaderLatency() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_headerLatency;
+}
+
+CJitterHistogram CLatencyRecorder::getLatency() const
+{
+	std::lock_guard lock(m_mutex);
+	return m_latency;
+}
+
+double CLatencyRecorder::getThroughput() const
+{
+	std::lock_guard lock(m_mutex);
+
+	std::chrono::microseconds active = m_activeTime + getStreamTime();
+	if (active.count() <= 0)
+		return 0.0;
+
+	return double(m_arrivals) * 1000000.0 / double(active.count());
+}
+
+std::chrono::microseconds CLatencyRecorder::getStreamTime() const
+{
+	if (m_lastArrival <= m_streamStart)
+		return std::chrono::microseconds(0);
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(m_lastArrival - m_streamStart);
+}
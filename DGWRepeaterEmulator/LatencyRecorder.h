@@ -0,0 +1,73 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "PacingEngine.h"
+
+// Matches the frames coming out of the gateway against the time they were sent. The gateway gives the
+// stream a new id, which is learnt from the first header. D-Star only carries a sequence number modulo
+// 21, so it is unwrapped against the frame we expect next.
+class CLatencyRecorder {
+public:
+	CLatencyRecorder();
+
+	// Start a new stream, the latencies of the previous ones are kept
+	void start();
+
+	void sentHeader(const TPacingTime& now);
+	void sent(unsigned int frame, const TPacingTime& now);
+
+	void receivedHeader(unsigned int id, const TPacingTime& now);
+	void received(unsigned int id, unsigned int seq, const TPacingTime& now);
+
+	unsigned int getSent() const;
+	unsigned int getReceived() const;
+	unsigned int getDuplicates() const;
+	unsigned int getHeaders() const;
+
+	// Frames out of the gateway per second, from the first frame sent to the last one out, over all the streams
+	double getThroughput() const;
+
+	CJitterHistogram getHeaderLatency() const;
+	CJitterHistogram getLatency() const;
+
+private:
+	std::chrono::microseconds getStreamTime() const;
+
+	mutable std::mutex       m_mutex;
+	TPacingTime              m_headerSent;
+	bool                     m_headerReceived;
+	unsigned int             m_id;
+	std::vector<TPacingTime> m_sentTimes;
+	std::vector<bool>        m_receivedFrames;
+	unsigned int             m_expected;
+	unsigned int             m_sent;
+	unsigned int             m_received;
+	unsigned int             m_duplicates;
+	unsigned int             m_headers;
+	unsigned long            m_arrivals;
+	TPacingTime              m_streamStart;
+	TPacingTime              m_lastArrival;
+	std::chrono::microseconds m_activeTime;
+	CJitterHistogram         m_headerLatency;
+	CJitterHistogram         m_latency;
+};
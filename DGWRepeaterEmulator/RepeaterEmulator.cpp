@@ -0,0 +1,129 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+
+#include "RepeaterEmulator.h"
+#include "HBRepeaterEmulator.h"
+#include "IcomRepeaterEmulator.h"
+#include "DExtraReflectorEmulator.h"
+#include "LatencyBenchmark.h"
+#include "AMBEVoiceLibrary.h"
+#include "HeaderData.h"
+#include "DStarDefines.h"
+#include "ProgramArgs.h"
+
+int main(int argc, const char * argv[])
+{
+	TEmulatorArgs args;
+
+	if (!parseCLIArgs(argc, argv, args)) {
+		::fprintf(stderr, "dgwrepeateremulator: invalid command line usage: dgwrepeateremulator [-type hb|icom] [-address address] [-port port] [-gatewayaddress address] [-gatewayport port] [-reflector XRF999_A] [-reflectoraddress address] [-streams n] [-frames n] [-period ms] [-burst n] [-timeout s] <repeater> <file.ambe>, exiting\n");
+		return 1;
+	}
+
+	CHeaderData::initialise();
+
+	std::string indexFile = boost::replace_last_copy(args.ambeFile, ".ambe", ".indx");
+	std::shared_ptr<const CAMBEVoiceLibrary> voice = CAMBEVoiceLibrary::get(indexFile, args.ambeFile);
+	if (voice == nullptr || voice->getFrameCount() == 0U) {
+		::fprintf(stderr, "dgwrepeateremulator: unable to open %s, exiting\n", args.ambeFile.c_str());
+		return 1;
+	}
+
+	std::unique_ptr<CVoiceEndpoint> repeater;
+	if (args.type == "icom")
+		repeater.reset(new CIcomRepeaterEmulator(args.address, args.port, args.gatewayAddress, args.gatewayPort));
+	else
+		repeater.reset(new CHBRepeaterEmulator(args.address, args.port, args.gatewayAddress, args.gatewayPort));
+
+	CDExtraReflectorEmulator reflector(args.reflector, args.reflectorAddress, args.gatewayAddress);
+
+	if (!repeater->open()) {
+		::fprintf(stderr, "dgwrepeateremulator: unable to open the repeater port %s:%u, exiting\n", args.address.c_str(), args.port);
+		return 1;
+	}
+
+	if (!reflector.open()) {
+		::fprintf(stderr, "dgwrepeateremulator: unable to open the reflector port %s:%u, exiting\n", args.reflectorAddress.c_str(), DEXTRA_PORT);
+		repeater->close();
+		return 1;
+	}
+
+	CLatencyBenchmark benchmark(args.repeater, args.reflector, voice, args.streams, args.frames, args.period, args.burst);
+
+	bool ret = benchmark.waitForGateway(*repeater, reflector, args.timeout * 1000U);
+	if (ret) {
+		benchmark.runNetworkToRF(*repeater, reflector);
+		benchmark.runRFToNetwork(*repeater, reflector);
+
+		ret = benchmark.printResults();
+	} else {
+		::fprintf(stderr, "dgwrepeateremulator: the gateway did not %s within %u seconds\n", repeater->isReady() ? "link to the reflector" : "initialise the repeater", args.timeout);
+	}
+
+	reflector.close();
+	repeater->close();
+
+	return ret ? 0 : 1;
+}
+
+bool parseCLIArgs(int argc, const char * argv[], TEmulatorArgs& args)
+{
+	if (argc < 3)
+		return false;
+
+	std::unordered_map<std::string, std::string> namedArgs;
+	std::vector<std::string> positionalArgs;
+
+	CProgramArgs::eatArguments(argc, argv, namedArgs, positionalArgs);
+
+	if (positionalArgs.size() != 2U)
+		return false;
+
+	args.repeater.assign(boost::replace_all_copy(boost::to_upper_copy(positionalArgs[0]), "_", " "));
+	args.ambeFile.assign(positionalArgs[1]);
+
+	args.type.assign(namedArgs.count("type") > 0U ? boost::to_lower_copy(namedArgs["type"]) : "hb");
+	if (args.type != "hb" && args.type != "icom")
+		return false;
+
+	args.address.assign(namedArgs.count("address") > 0U ? namedArgs["address"] : "127.0.0.1");
+	args.port = namedArgs.count("port") > 0U ? ::atoi(namedArgs["port"].c_str()) : 20011U;
+
+	args.gatewayAddress.assign(namedArgs.count("gatewayaddress") > 0U ? namedArgs["gatewayaddress"] : "127.0.0.1");
+	args.gatewayPort = namedArgs.count("gatewayport") > 0U ? ::atoi(namedArgs["gatewayport"].c_str()) : (args.type == "icom" ? 20000U : 20010U);
+
+	args.reflector.assign(boost::replace_all_copy(boost::to_upper_copy(namedArgs.count("reflector") > 0U ? namedArgs["reflector"] : std::string("XRF999_A")), "_", " "));
+	args.reflectorAddress.assign(namedArgs.count("reflectoraddress") > 0U ? namedArgs["reflectoraddress"] : "127.0.0.2");
+
+	args.streams = namedArgs.count("streams") > 0U ? ::atoi(namedArgs["streams"].c_str()) : 3U;
+	args.frames  = namedArgs.count("frames")  > 0U ? ::atoi(namedArgs["frames"].c_str())  : 250U;
+	args.timeout = namedArgs.count("timeout") > 0U ? ::atoi(namedArgs["timeout"].c_str()) : 30U;
+
+	// More frames, or frames more often, than a radio would send, to find where the gateway saturates
+	args.period = namedArgs.count("period") > 0U ? ::atoi(namedArgs["period"].c_str()) : DSTAR_FRAME_TIME_MS;
+	args.burst  = namedArgs.count("burst")  > 0U ? ::atoi(namedArgs["burst"].c_str())  : 1U;
+
+	return args.port > 0U && args.gatewayPort > 0U && args.streams > 0U && args.frames > 0U && args.period > 0U && args.burst > 0U && args.reflector.length() == LONG_CALLSIGN_LENGTH;
+}
@@ -0,0 +1,40 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+
+struct TEmulatorArgs {
+	std::string  type;
+	std::string  repeater;
+	std::string  ambeFile;
+	std::string  address;
+	unsigned int port;
+	std::string  gatewayAddress;
+	unsigned int gatewayPort;
+	std::string  reflector;
+	std::string  reflectorAddress;
+	unsigned int streams;
+	unsigned int frames;
+	unsigned int period;
+	unsigned int burst;
+	unsigned int timeout;
+};
+
+bool parseCLIArgs(int argc, const char * argv[], TEmulatorArgs& args);
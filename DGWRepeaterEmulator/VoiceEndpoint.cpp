@@ -0,0 +1,105 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "VoiceEndpoint.h"
+
+const unsigned int BUFFER_LENGTH = 255U;
+const unsigned int WAIT_MS       = 10U;
+
+CVoiceEndpoint::CVoiceEndpoint(const std::string& name, const std::string& localAddress, unsigned int localPort, const std::string& gatewayAddress, unsigned int gatewayPort) :
+CThread(name),
+m_socket(localAddress, localPort),
+m_gatewayAddress(),
+m_gatewayPort(gatewayPort),
+m_stopped(false),
+m_mutex(),
+m_recorder(nullptr)
+{
+	m_gatewayAddress = CUDPReaderWriter::lookup(gatewayAddress);
+}
+
+CVoiceEndpoint::~CVoiceEndpoint()
+{
+}
+
+bool CVoiceEndpoint::open()
+{
+	if (m_gatewayAddress.s_addr == INADDR_NONE)
+		return false;
+
+	bool ret = m_socket.open();
+	if (!ret)
+		return false;
+
+	Create();
+	Run();
+
+	return true;
+}
+
+void CVoiceEndpoint::close()
+{
+	m_stopped = true;
+	Wait();
+
+	m_socket.close();
+}
+
+void CVoiceEndpoint::setRecorder(CLatencyRecorder* recorder)
+{
+	std::lock_guard lock(m_mutex);
+	m_recorder = recorder;
+}
+
+void* CVoiceEndpoint::Entry()
+{
+	unsigned char buffer[BUFFER_LENGTH];
+
+	while (!m_stopped) {
+		in_addr address;
+		unsigned int port;
+		int length = m_socket.read(buffer, BUFFER_LENGTH, address, port, WAIT_MS);
+
+		TPacingTime now = std::chrono::steady_clock::now();
+
+		if (length > 0)
+			processPacket(buffer, length, address, port, now);
+
+		clock(now);
+	}
+
+	return nullptr;
+}
+
+void CVoiceEndpoint::clock(const TPacingTime&)
+{
+}
+
+void CVoiceEndpoint::received(const CHeaderData& header, const TPacingTime& now)
+{
+	std::lock_guard lock(m_mutex);
+	if (m_recorder != nullptr)
+		m_recorder->receivedHeader(header.getId(), now);
+}
+
+void CVoiceEndpoint::received(const CAMBEData& data, const TPacingTime& now)
+{
+	std::lock_guard lock(m_mutex);
+	if (m_recorder != nullptr)
+		m_recorder->received(data.getId(), data.getSeq(), now);
+}
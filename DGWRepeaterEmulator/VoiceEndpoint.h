@@ -0,0 +1,67 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "UDPReaderWriter.h"
+#include "HeaderData.h"
+#include "AMBEData.h"
+#include "Thread.h"
+#include "LatencyRecorder.h"
+
+// One end of a voice path through the gateway. A thread waits on the socket so that every packet is
+// time stamped as soon as it arrives, the protocol specific classes only decode and answer them.
+class CVoiceEndpoint : public CThread {
+public:
+	CVoiceEndpoint(const std::string& name, const std::string& localAddress, unsigned int localPort, const std::string& gatewayAddress, unsigned int gatewayPort);
+	virtual ~CVoiceEndpoint();
+
+	bool open();
+	void close();
+
+	virtual bool writeHeader(CHeaderData& header) = 0;
+	virtual bool writeAMBE(CAMBEData& data) = 0;
+
+	// Whether the gateway has talked to us yet
+	virtual bool isReady() const = 0;
+
+	// Voice received from the gateway is handed to the recorder, if any
+	void setRecorder(CLatencyRecorder* recorder);
+
+	void* Entry();
+
+protected:
+	CUDPReaderWriter m_socket;
+	in_addr          m_gatewayAddress;
+	unsigned int     m_gatewayPort;
+
+	virtual void processPacket(const unsigned char* buffer, unsigned int length, in_addr address, unsigned int port, const TPacingTime& now) = 0;
+	virtual void clock(const TPacingTime& now);
+
+	void received(const CHeaderData& header, const TPacingTime& now);
+	void received(const CAMBEData& data, const TPacingTime& now);
+
+private:
+	std::atomic<bool> m_stopped;
+	std::mutex        m_mutex;
+	CLatencyRecorder* m_recorder;
+};
@@ -0,0 +1,116 @@
+#!/bin/bash
+#
+#   Copyright (C) 2026 by agent
+#
+#   This program is free software; you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation; either version 2 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program; if not, write to the Free Software
+#   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+#
+
+# Runs the locally built dstargateway between an emulated repeater and an emulated DExtra reflector,
+# once with a homebrew repeater and once with an Icom RP2C, and prints the latency in both directions.
+# An MQTT broker has to be listening on 127.0.0.1:1883, dstargateway will not start without one.
+#
+# usage: benchmark.sh [streams] [frames]
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+GATEWAY=${DSTARGATEWAY:-$ROOT/DStarGateway/dstargateway}
+EMULATOR=$ROOT/DGWRepeaterEmulator/dgwrepeateremulator
+STREAMS=${1:-3}
+FRAMES=${2:-250}
+
+WORK=$(mktemp -d)
+GATEWAY_PID=
+
+cleanup() {
+	[ -n "$GATEWAY_PID" ] && kill $GATEWAY_PID 2>/dev/null && wait $GATEWAY_PID 2>/dev/null
+	rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+mkdir -p "$WORK/hostfiles" "$WORK/hostfiles.d"
+echo '{"reflectors":[{"name":"XRF999","reflector_type":"XRF","ipv4":"127.0.0.2"}]}' > "$WORK/hostfiles.d/DStar_Hosts.json"
+
+RESULT=0
+
+for TYPE in HB Icom; do
+	cat > "$WORK/dstargateway.cfg" <<CFG
+[General]
+Callsign=N0CALL
+Address=127.0.0.1
+IcomAddress=127.0.0.1
+IcomPort=20000
+HBAddress=127.0.0.1
+HBPort=20010
+
+[IRCDDB 1]
+Enabled=0
+
+[Repeater 1]
+Enabled=1
+Band=B
+Callsign=N0CALL
+Address=127.0.0.1
+Port=20011
+Type=$TYPE
+Reflector=XRF999 A
+ReflectorAtStartup=1
+ReflectorReconnect=Never
+
+[APRS]
+Enabled=0
+
+[Log]
+DisplayLevel=5
+
+[Paths]
+Data=$ROOT/Data/
+
+[Hosts Files]
+HostsFiles=$WORK/hostfiles/
+CustomHostsfiles=$WORK/hostfiles.d/
+
+[Dextra]
+Enabled=1
+
+[D-Plus]
+Enabled=0
+
+[DCS]
+Enabled=0
+
+[XLX]
+Enabled=0
+
+[Daemon]
+Daemon=0
+CFG
+
+	echo "=== $TYPE repeater ==="
+
+	# The emulator goes first, an Icom gateway only sends INIT once when it starts
+	"$EMULATOR" -type ${TYPE,,} -streams $STREAMS -frames $FRAMES N0CALL_B "$ROOT/Data/en_GB.ambe" &
+	EMULATOR_PID=$!
+	sleep 1
+
+	"$GATEWAY" "$WORK/dstargateway.cfg" > "$WORK/dstargateway.log" 2>&1 &
+	GATEWAY_PID=$!
+
+	wait $EMULATOR_PID || { RESULT=1; cat "$WORK/dstargateway.log"; }
+
+	kill $GATEWAY_PID 2>/dev/null
+	wait $GATEWAY_PID 2>/dev/null
+	GATEWAY_PID=
+done
+
+exit $RESULT
@@ -0,0 +1,169 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "DGWStatusApp.h"
+#include "ProgramArgs.h"
+#include "Defs.h"
+
+static volatile std::sig_atomic_t s_stop = 0;
+
+int main(int argc, const char* argv[])
+{
+	std::string name;
+	unsigned int interval;
+
+	if (!parseCLIArgs(argc, argv, name, interval)) {
+		::fprintf(stderr, "dgwstatus: invalid command line usage: dgwstatus [-name <segment name>] [-watch <seconds>], exiting\n");
+		return 1;
+	}
+
+	::signal(SIGINT,  [](int) { s_stop = 1; });
+	::signal(SIGTERM, [](int) { s_stop = 1; });
+
+	CStatusSegment segment(name);
+
+	do {
+		// The gateway removes the segment when it stops, a watcher picks up the new one after a restart
+		if (!segment.isRunning() && !segment.open()) {
+			if (interval == 0U) {
+				::fprintf(stderr, "dgwstatus: unable to open the status segment %s, is the gateway running with [Status Segment] enabled ?\n", name.c_str());
+				return 1;
+			}
+		} else {
+			SStatusData data;
+			if (segment.read(data)) {
+				printStatus(data);
+			} else {
+				::fprintf(stderr, "dgwstatus: the status segment %s is being updated too often to be read\n", name.c_str());
+				if (interval == 0U)
+					return 1;
+			}
+		}
+
+		if (interval > 0U)
+			std::this_thread::sleep_for(std::chrono::seconds(interval));
+	} while (interval > 0U && s_stop == 0);
+
+	return 0;
+}
+
+bool parseCLIArgs(int argc, const char * argv[], std::string& name, unsigned int& interval)
+{
+	name.assign("/dstargateway");
+	interval = 0U;
+
+	std::unordered_map<std::string, std::string> namedArgs;
+	std::vector<std::string> positionalArgs;
+
+	CProgramArgs::eatArguments(argc, argv, namedArgs, positionalArgs);
+
+	if (!positionalArgs.empty())
+		return false;
+
+	if (namedArgs.count("name") == 1)
+		name.assign(namedArgs["name"]);
+
+	if (namedArgs.count("watch") == 1) {
+		interval = (unsigned int)::strtoul(namedArgs["watch"].c_str(), nullptr, 10);
+		if (interval == 0U)
+			return false;
+	}
+
+	return true;
+}
+
+static const char* ircDDBStatusToString(int32_t status)
+{
+	switch (status) {
+		case IS_DISCONNECTED: return "disconnected";
+		case IS_CONNECTING:   return "connecting";
+		case IS_CONNECTED:    return "connected";
+		default:              return "disabled";
+	}
+}
+
+static const char* protocolToString(uint8_t protocol)
+{
+	switch (protocol) {
+		case PROTO_DPLUS: return "D-Plus";
+		case PROTO_DCS:   return "DCS";
+		case PROTO_CCS:   return "CCS";
+		default:          return "DExtra";
+	}
+}
+
+static std::string qualityToString(const TLinkQuality& quality)
+{
+	char text[160U];
+	::snprintf(text, sizeof(text), "%u streams, %llu frames, %llu lost, %llu out of order, %llu duplicated, jitter %.1fms", quality.streams,
+		(unsigned long long)quality.frames, (unsigned long long)quality.lost, (unsigned long long)quality.outOfOrder,
+		(unsigned long long)quality.duplicates, double(quality.jitter) / 1000.0);
+
+	return text;
+}
+
+void printStatus(const SStatusData& data)
+{
+	std::time_t updated = std::time_t(data.updated / 1000U);
+	char timeText[32U];
+	::strftime(timeText, sizeof(timeText), "%Y-%m-%d %H:%M:%S", ::localtime(&updated));
+
+	::fprintf(stdout, "%s updated %s.%03u, ircDDB %s\n", data.gateway, timeText, (unsigned int)(data.updated % 1000U), ircDDBStatusToString(data.ircDDBStatus));
+	::fprintf(stdout, "caches: %u users, %u repeaters, %u gateways\n", data.userCacheCount, data.repeaterCacheCount, data.gatewayCacheCount);
+	::fprintf(stdout, "frames: repeater %llu, DExtra %llu, D-Plus %llu, DCS %llu, G2 %llu, DD %llu\n",
+		(unsigned long long)data.traffic.repeaterFrames, (unsigned long long)data.traffic.dextraFrames,
+		(unsigned long long)data.traffic.dplusFrames, (unsigned long long)data.traffic.dcsFrames,
+		(unsigned long long)data.traffic.g2Frames, (unsigned long long)data.traffic.ddFrames);
+
+	if (data.g2Quality.streams > 0U)
+		::fprintf(stdout, "G2: %s\n", qualityToString(data.g2Quality).c_str());
+
+	if (data.dongles[0] != '\0')
+		::fprintf(stdout, "dongles: %s\n", data.dongles);
+
+	for (uint32_t i = 0U; i < data.repeaterCount && i < STATUS_MAX_REPEATERS; i++) {
+		const SStatusRepeater& repeater = data.repeaters[i];
+
+		::fprintf(stdout, "%s linked to \"%s\" reflector \"%s\", last heard \"%s\" (%u headers)\n", repeater.callsign,
+			repeater.linkCallsign, repeater.reflector, repeater.lastHeard, repeater.heardCount);
+
+		for (uint32_t n = 0U; n < repeater.linkCount && n < STATUS_MAX_LINKS; n++) {
+			const SStatusLink& link = repeater.links[n];
+
+			::fprintf(stdout, "\t%s %s %s%s%s\n", link.callsign, protocolToString(link.protocol),
+				link.direction == DIR_INCOMING ? "incoming" : "outgoing",
+				link.linked != 0U ? " linked" : " linking",
+				link.dongle != 0U ? " dongle" : "");
+
+			if (link.quality.streams > 0U)
+				::fprintf(stdout, "\t\t%s\n", qualityToString(link.quality).c_str());
+		}
+	}
+
+	::fflush(stdout);
+}
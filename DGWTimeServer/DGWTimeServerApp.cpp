@@ -139,6 +139,7 @@ bool CDGWTimeServerApp::createThread()
 	bool ret = m_thread->setGateway(timeserver.callsign, rptrs[0], rptrs[1], rptrs[2], rptrs[3], timeserver.address, paths.data);
 	if(ret) {
 		m_thread->setAnnouncements(timeserver.language, timeserver.format, timeserver.interval);
+		m_thread->setCache(timeserver.cache, paths.cache.empty() ? "" : paths.cache + "/dgwtimeserver.cache");
 	}
 
 	return ret;
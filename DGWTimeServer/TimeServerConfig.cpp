@@ -133,6 +133,8 @@ bool CTimeServerConfig::loadTimeServer(const CConfig & cfg)
 	else if(interval == "30")	m_timeServer.interval = INTERVAL_30MINS;
 	else if(interval == "60")	m_timeServer.interval = INTERVAL_60MINS;
 
+	ret = cfg.getValue("timeserver", "cache", m_timeServer.cache, true) && ret;
+
 	return ret;
 }
 
@@ -147,6 +149,7 @@ bool CTimeServerConfig::loadDaemon(const CConfig & cfg)
 bool CTimeServerConfig::loadPaths(const CConfig & cfg)
 {
 	bool ret = cfg.getValue("paths", "data", m_paths.data, 1, 1024, "");
+	ret = cfg.getValue("paths", "cache", m_paths.cache, 0, 1024, "") && ret;
 	return ret;
 }
 
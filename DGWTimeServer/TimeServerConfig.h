@@ -31,6 +31,7 @@ typedef struct {
     FORMAT format;
     LANGUAGE language;
     INTERVAL interval;
+    bool cache;
 } TTimeServer;
 
 typedef struct {
@@ -45,6 +46,7 @@ typedef struct {
 
 typedef struct {
     std::string data;
+    std::string cache;
 } TPaths;
 
 class CTimeServerConfig
@@ -18,18 +18,20 @@
  */
 
 #include <sys/stat.h>
+#include <chrono>
 #include <cstring>
 #include <cstdlib>
 #include <stdio.h>
 #include <vector>
 #include <boost/algorithm/string.hpp>
-#include <chrono>
 
 #include "TimeServerThread.h"
 #include "DStarDefines.h"
 #include "Utils.h"
 #include "NetUtils.h"
 #include "StringUtils.h"
+#include "G2FanOut.h"
+#include "TimeAnnouncementLibrary.h"
 
 const unsigned int MAX_FRAMES = 60U * DSTAR_FRAMES_PER_SEC;
 
@@ -48,7 +50,11 @@ m_interval(INTERVAL_15MINS),
 m_data(),
 m_killed(false),
 m_dataPath(""),
-m_ambeFileReader(nullptr)
+m_ambeFileReader(nullptr),
+m_ambeSignature(),
+m_cache(true),
+m_cacheFile(),
+m_library(nullptr)
 {
 	CHeaderData::initialise();
 	m_address.s_addr = INADDR_NONE; 
@@ -61,7 +67,8 @@ CTimeServerThread::~CTimeServerThread()
 
 	m_data.clear();
 
-	delete[] m_ambeFileReader;
+	delete m_ambeFileReader;
+	delete m_library;
 }
 
 void * CTimeServerThread::Entry()
@@ -81,6 +88,14 @@ void * CTimeServerThread::Entry()
 		}
 	}
 
+	if (m_cache) {
+		// Everything an announcement depends on apart from the time itself
+		std::string tag = CStringUtils::string_format("%s|%d|%d|%s", m_callsign.c_str(), int(m_language), int(m_format), m_ambeSignature.c_str());
+		m_library = new CTimeAnnouncementLibrary(tag);
+		if (!m_cacheFile.empty())
+			m_library->load(m_cacheFile);
+	}
+
 	printf("Starting the Time Server thread\n");
 
 	unsigned int lastMin = 0U;
@@ -161,8 +176,23 @@ void CTimeServerThread::setAnnouncements(LANGUAGE language, FORMAT format, INTER
 	m_interval = interval;
 }
 
+void CTimeServerThread::setCache(bool enabled, const std::string& cacheFile)
+{
+	m_cache     = enabled;
+	m_cacheFile = cacheFile;
+}
+
 void CTimeServerThread::sendTime(unsigned int hour, unsigned int min)
 {
+	const std::vector<unsigned char>* frames = m_library != nullptr ? m_library->find(hour, min) : nullptr;
+	if (frames != nullptr) {
+		printf("Sending cached %02u:%02u announcement\n", hour, min);
+		send(*frames, hour, min);
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
 	std::vector<std::string> words;
 
 	switch (m_language) {
@@ -207,7 +237,20 @@ void CTimeServerThread::sendTime(unsigned int hour, unsigned int min)
 			break;
 	}
 
-	send(words, hour, min);
+	std::vector<unsigned char> rendered;
+	if (!render(words, hour, min, rendered))
+		return;
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	printf("Rendered %02u:%02u announcement in %lld us\n", hour, min, (long long)elapsed.count());
+
+	if (m_library != nullptr) {
+		m_library->insert(hour, min, rendered);
+		if (!m_cacheFile.empty() && !m_library->save(m_cacheFile))
+			fprintf(stderr, "Cannot save the time announcements to %s\n", m_cacheFile.c_str());
+	}
+
+	send(rendered, hour, min);
 }
 
 std::vector<std::string> CTimeServerThread::sendTimeEnGB1(unsigned int hour, unsigned int min)
@@ -983,11 +1026,18 @@ bool CTimeServerThread::loadAMBE()
 			break;
 	}
 
+	m_ambeSignature.clear();
+	for (auto fileName : { indxFileName, ambeFileName }) {
+		struct stat sbuf;
+		if (::stat((m_dataPath + "/" + fileName).c_str(), &sbuf) == 0)
+			m_ambeSignature += CStringUtils::string_format("%s:%lld:%lld;", fileName.c_str(), (long long)sbuf.st_size, (long long)sbuf.st_mtime);
+	}
+
 	m_ambeFileReader = new CAMBEFileReader(m_dataPath + "/" + indxFileName, m_dataPath + "/" + ambeFileName);
 	bool ret = m_ambeFileReader->read();
 
 	if (!ret) {
-		delete[] m_ambeFileReader;
+		delete m_ambeFileReader;
 		m_ambeFileReader = nullptr;
 		return false;
 	}
@@ -1078,11 +1128,8 @@ void CTimeServerThread::buildAudio(const std::vector<std::string>& words, CSlowD
 	m_data.push_back(dataOut);
 }
 
-bool CTimeServerThread::send(const std::vector<std::string> &words, unsigned int hour, unsigned int min)
+std::string CTimeServerThread::buildHeader(CHeaderData& header, unsigned int hour, unsigned int min) const
 {
-	CSlowDataEncoder encoder;
-
-	CHeaderData header;
 	header.setMyCall1(m_callsign);
 	header.setRptCall1(m_callsignG);
 	header.setRptCall2(m_callsign);		// Just for the slow data header
@@ -1145,6 +1192,15 @@ bool CTimeServerThread::send(const std::vector<std::string> &words, unsigned int
 			break;
 	}
 
+	return slowData;
+}
+
+bool CTimeServerThread::render(const std::vector<std::string>& words, unsigned int hour, unsigned int min, std::vector<unsigned char>& frames)
+{
+	CHeaderData header;
+	std::string slowData = buildHeader(header, hour, min);
+
+	CSlowDataEncoder encoder;
 	encoder.setHeaderData(header);
 	encoder.setTextData(slowData);
 
@@ -1164,95 +1220,48 @@ bool CTimeServerThread::send(const std::vector<std::string> &words, unsigned int
 		printf("Sending text \"%s\"\n", slowData.c_str());
 	}
 
-	// Build id and socket lists
-	std::vector<unsigned int> ids;
-	std::vector<CUDPReaderWriter *> sockets;
-	for(auto rpt : m_repeaters) {
-		auto socket = new CUDPReaderWriter("", 0U);
-		sockets.push_back(socket);
-		ids.push_back(CHeaderData::createId());
+	// Only the DV bytes are kept, the sequence numbers and the end flag follow from the position
+	frames.resize(m_data.size() * DV_FRAME_LENGTH_BYTES);
+	for (unsigned int i = 0U; i < m_data.size(); i++) {
+		m_data[i]->getData(frames.data() + i * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
+		delete m_data[i];
 	}
-
-	// open them all
-	bool allOpen = std::all_of(sockets.begin(), sockets.end(), [](CUDPReaderWriter* s) { return s->open(); });
-	if(allOpen) {
-		//send headers
-		for(unsigned int i = 0; i < m_repeaters.size(); i++) {
-			CHeaderData headerCopy(header);
-			headerCopy.setId(ids[i]);
-			headerCopy.setRptCall2(m_repeaters[i]);
-			sendHeader(*(sockets[i]), headerCopy);
-			Sleep(5);
-		}
-
-		// send audio
-		bool loop = true;
-		unsigned int out = 0U;
-		auto start = std::chrono::high_resolution_clock::now();
-
-		while(loop) {
-			unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
-			needed /= DSTAR_FRAME_TIME_MS;
-
-			while (out < needed) {
-				for(unsigned int i = 0; i < m_repeaters.size(); i++) {
-					CAMBEData data(*(m_data[out]));
-					data.setId(ids[i]);
-					sendData(*(sockets[i]), data);
-					Sleep(5);
-				}
-
-				delete m_data[out];
-				m_data[out] = nullptr;
-				out++;
-
-				if (out >= m_data.size()) {
-					loop = false;
-					break;
-				}
-			}
-		}
-	}
-
 	m_data.clear();
 
-	for(auto socket : sockets) {
-		socket->close();
-		delete socket;
-	}
-
 	return true;
 }
 
-
-bool CTimeServerThread::sendHeader(CUDPReaderWriter& socket, const CHeaderData &header)
+bool CTimeServerThread::send(const std::vector<unsigned char>& frames, unsigned int hour, unsigned int min)
 {
-	unsigned char buffer[60U];
-	unsigned int length = header.getG2Data(buffer, 60U, true);
+	CHeaderData header;
+	buildHeader(header, hour, min);
 
-#if defined(DUMP_TX)
-	CUtils::dump("Sending Header", buffer, length);
-	return true;
-#else
-	for (unsigned int i = 0U; i < 5U; i++) {
-		bool res = socket.write(buffer, length, header.getYourAddress(), header.getYourPort());
-		if (!res)
-			return false;
-	}
+	unsigned int count = frames.size() / DV_FRAME_LENGTH_BYTES;
 
-	return true;
-#endif
-}
+	// Every repeater gets its own copy of each frame, all sent together from one socket
+	CG2FanOut fanOut;
+	fanOut.setHeader(header, m_repeaters);
 
-bool CTimeServerThread::sendData(CUDPReaderWriter& socket, const CAMBEData& data)
-{
-	unsigned char buffer[40U];
-	unsigned int length = data.getG2Data(buffer, 40U);
+	CAMBEData data;
+	for (unsigned int i = 0U; i < count; i++) {
+		data.setSeq(i % 21U);
+		data.setEnd(i + 1U == count);
+		data.setData(frames.data() + i * DV_FRAME_LENGTH_BYTES, DV_FRAME_LENGTH_BYTES);
+		fanOut.addFrame(data);
+	}
+
+	CUDPReaderWriter socket("", 0U);
+	if (!socket.open())
+		return false;
 
 #if defined(DUMP_TX)
-	CUtils::dump("Sending Data", buffer, length);
-	return true;
+	printf("Would send %u frames to %u repeaters\n", fanOut.getFrameCount(), fanOut.getStreamCount());
+	bool ret = true;
 #else
-	return socket.write(buffer, length, data.getYourAddress(), data.getYourPort());
+	bool ret = fanOut.send(socket, m_address, G2_DV_PORT);
 #endif
+
+	socket.close();
+
+	return ret;
 }
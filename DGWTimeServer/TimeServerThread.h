@@ -28,6 +28,7 @@
 #include "AMBEData.h"
 #include "Thread.h"
 #include "AMBEFileReader.h"
+#include "TimeAnnouncementLibrary.h"
 
 class CTimeServerThread : public CThread
 {
@@ -37,6 +38,7 @@ public:
 
 	bool setGateway(const std::string& callsign, const std::string& rpt1, const std::string& rpt2, const std::string& rpt3, const std::string& rpt4, const std::string& address, const std::string& dataPath);
 	void setAnnouncements(LANGUAGE language, FORMAT format, INTERVAL interval);
+	void setCache(bool enabled, const std::string& cacheFile);
 
 	void * Entry();
 	void kill();
@@ -55,6 +57,10 @@ private:
 	bool             		 m_killed;
 	std::string		 		 m_dataPath;
 	CAMBEFileReader * 		 m_ambeFileReader;
+	std::string				 m_ambeSignature;
+	bool					 m_cache;
+	std::string				 m_cacheFile;
+	CTimeAnnouncementLibrary* m_library;
 
 	void sendTime(unsigned int hour, unsigned int min);
 
@@ -71,9 +77,9 @@ private:
 	std::vector<std::string> sendTimeNoNO(unsigned int hour, unsigned int min);
 	std::vector<std::string> sendTimePtPT(unsigned int hour, unsigned int min);
 
-	bool send(const std::vector<std::string>& words, unsigned int hour, unsigned int min);
-	bool sendHeader(CUDPReaderWriter& socket, const CHeaderData& header);
-	bool sendData(CUDPReaderWriter& socket, const CAMBEData& data);
+	std::string buildHeader(CHeaderData& header, unsigned int hour, unsigned int min) const;
+	bool render(const std::vector<std::string>& words, unsigned int hour, unsigned int min, std::vector<unsigned char>& frames);
+	bool send(const std::vector<unsigned char>& frames, unsigned int hour, unsigned int min);
 
 	bool loadAMBE();
 
@@ -19,8 +19,6 @@
 
 #include <cassert>
 #include <boost/algorithm/string.hpp>
-#include <thread>
-#include <chrono>
 
 #include "ProgramArgs.h"
 #include "DStarDefines.h"
@@ -28,6 +26,7 @@
 #include "SlowDataEncoder.h"
 #include "APRSUtils.h"
 #include "StringUtils.h"
+#include "PacingEngine.h"
 
 int main(int argc, const char * argv[])
 {
@@ -145,60 +144,53 @@ bool CVoiceTransmit::run()
 
 	delete header;
 
-	auto start = std::chrono::high_resolution_clock::now();
-
-	unsigned int out   = 0U;
 	unsigned int seqNo = 0U;
-	bool loop = true;
 
-	while (loop) {
-		unsigned int needed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
-		needed /= DSTAR_FRAME_TIME_MS;
+	// One frame every 20ms on absolute deadlines, sleeping in between
+	CPacingEngine pacer(DSTAR_FRAME_TIME_MS);
+	pacer.add([&](unsigned int) -> bool {
 		unsigned char buffer[DV_FRAME_LENGTH_BYTES];
 
-		while (out < needed) {
-			CAMBEData* ambe = m_store->getAMBE();
-
-			if (ambe == NULL) {
-				CAMBEData data;
-				data.setData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES);
-				data.setDestination(address, G2_DV_PORT);
-				data.setId(id);
-				data.setSeq(seqNo);
-				data.setEnd(true);
-
-				sendData(&data);
-
-				m_socket.close();
-
-				loop = false;
-				break;
-			}
-
-			ambe->getData(buffer, DV_FRAME_LENGTH_BYTES);
-			// Insert sync bytes when the sequence number is zero, slow data otherwise
-			if (seqNo == 0U) {
-				::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
-			} else if (overrideSlowData) {
-				slowData->getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
-			}
-			ambe->setData(buffer, DV_FRAME_LENGTH_BYTES);
-		
-			ambe->setSeq(seqNo);
-			ambe->setDestination(address, G2_DV_PORT);
-			ambe->setEnd(false);
-			ambe->setId(id);
-
-			sendData(ambe);
-			delete ambe;
-
-			out++;
-			seqNo++;
-			if(seqNo >= 21U) seqNo = 0U;
+		CAMBEData* ambe = m_store->getAMBE();
+
+		if (ambe == NULL) {
+			CAMBEData data;
+			data.setData(END_PATTERN_BYTES, DV_FRAME_LENGTH_BYTES);
+			data.setDestination(address, G2_DV_PORT);
+			data.setId(id);
+			data.setSeq(seqNo);
+			data.setEnd(true);
+
+			sendData(&data);
+
+			m_socket.close();
+
+			return false;
 		}
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(10U));
-	}
+		ambe->getData(buffer, DV_FRAME_LENGTH_BYTES);
+		// Insert sync bytes when the sequence number is zero, slow data otherwise
+		if (seqNo == 0U) {
+			::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+		} else if (overrideSlowData) {
+			slowData->getInterleavedData(buffer + VOICE_FRAME_LENGTH_BYTES);
+		}
+		ambe->setData(buffer, DV_FRAME_LENGTH_BYTES);
+	
+		ambe->setSeq(seqNo);
+		ambe->setDestination(address, G2_DV_PORT);
+		ambe->setEnd(false);
+		ambe->setId(id);
+
+		sendData(ambe);
+		delete ambe;
+
+		seqNo++;
+		if(seqNo >= 21U) seqNo = 0U;
+
+		return true;
+	});
+	pacer.run();
 
 	if(slowData != nullptr) delete slowData;
 
@@ -0,0 +1,81 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "AMBEClassifier.h"
+#include "DStarDefines.h"
+#include "DTMF.h"
+
+namespace {
+	uint64_t load64(const unsigned char* data)
+	{
+		// memcpy keeps it alignment safe, the compilers turn it into a single load
+		uint64_t word;
+		::memcpy(&word, data, sizeof(word));
+		return word;
+	}
+
+	const uint64_t SILENCE_WORD   = load64(NULL_AMBE_DATA_BYTES);
+	const uint64_t DTMF_MASK_WORD = load64(DTMF_MASK);
+	const uint64_t DTMF_SIG_WORD  = load64(DTMF_SIG);
+
+	// Indexed by the DTMF_SYM_MASK bits of bytes 4, 5, 7 and 8, from bit 0 up. All sixteen
+	// combinations are digits, so a frame with the DTMF signature always decodes to something.
+	const char DTMF_DIGITS[] = {
+		'1', '3', '2', 'A', '7', '9', '8', 'C',
+		'4', '6', '5', 'B', '*', '#', '0', 'D'
+	};
+}
+
+unsigned int CAMBEClassifier::classifyVoice(const unsigned char* ambe, char& digit)
+{
+	assert(ambe != nullptr);
+
+	uint64_t word = load64(ambe);
+
+	if (word == SILENCE_WORD && ambe[8U] == NULL_AMBE_DATA_BYTES[8U])
+		return AMBE_CLASS_SILENCE;
+
+	if ((word & DTMF_MASK_WORD) == DTMF_SIG_WORD && (ambe[8U] & DTMF_MASK[8U]) == DTMF_SIG[8U]) {
+		unsigned int index = ((ambe[4U] & DTMF_SYM_MASK[0U]) != 0U ? 0x01U : 0x00U) |
+							 ((ambe[5U] & DTMF_SYM_MASK[1U]) != 0U ? 0x02U : 0x00U) |
+							 ((ambe[7U] & DTMF_SYM_MASK[2U]) != 0U ? 0x04U : 0x00U) |
+							 ((ambe[8U] & DTMF_SYM_MASK[3U]) != 0U ? 0x08U : 0x00U);
+		digit = DTMF_DIGITS[index];
+		return AMBE_CLASS_DTMF;
+	}
+
+	return AMBE_CLASS_VOICE;
+}
+
+unsigned int CAMBEClassifier::classify(const unsigned char* frame, char& digit)
+{
+	assert(frame != nullptr);
+
+	unsigned int classes = classifyVoice(frame, digit);
+
+	unsigned char slowDataType = (frame[VOICE_FRAME_LENGTH_BYTES] ^ SCRAMBLER_BYTE1) & SLOW_DATA_TYPE_MASK;
+	if (slowDataType == SLOW_DATA_TYPE_FAST_DATA1 || slowDataType == SLOW_DATA_TYPE_FAST_DATA2)
+		classes |= AMBE_CLASS_FAST_DATA;
+
+	return classes;
+}
@@ -0,0 +1,36 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#pragma once
+
+const unsigned int AMBE_CLASS_VOICE     = 0x00U;
+const unsigned int AMBE_CLASS_SILENCE   = 0x01U;
+const unsigned int AMBE_CLASS_DTMF      = 0x02U;
+const unsigned int AMBE_CLASS_FAST_DATA = 0x04U;
+
+// Tells what a DV frame carries in one pass. The nine AMBE bytes are compared as a 64 bit word plus
+// one byte instead of byte by byte, and the DTMF digit comes from a table indexed by the four symbol bits.
+class CAMBEClassifier {
+public:
+	// The nine voice bytes only, returns AMBE_CLASS_SILENCE or AMBE_CLASS_DTMF, digit is set for the latter
+	static unsigned int classifyVoice(const unsigned char* ambe, char& digit);
+
+	// A whole DV frame, voice followed by the still scrambled slow data, may add AMBE_CLASS_FAST_DATA
+	static unsigned int classify(const unsigned char* frame, char& digit);
+};
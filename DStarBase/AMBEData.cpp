@@ -39,7 +39,8 @@ m_yourPort(0U),
 m_myPort(0U),
 m_errors(0U),
 m_text(),
-m_header()
+m_header(),
+m_timing()
 {
 	m_data = new unsigned char[DV_FRAME_LENGTH_BYTES];
 }
@@ -57,7 +58,8 @@ m_yourPort(data.m_yourPort),
 m_myPort(data.m_myPort),
 m_errors(data.m_errors),
 m_text(data.m_text),
-m_header(data.m_header)
+m_header(data.m_header),
+m_timing(data.m_timing)
 {
 	m_data = new unsigned char[DV_FRAME_LENGTH_BYTES];
 	::memcpy(m_data, data.m_data, DV_FRAME_LENGTH_BYTES);
@@ -604,6 +606,16 @@ unsigned int CAMBEData::getErrors() const
 	return m_errors;
 }
 
+TVoiceTiming& CAMBEData::getTiming()
+{
+	return m_timing;
+}
+
+const TVoiceTiming& CAMBEData::getTiming() const
+{
+	return m_timing;
+}
+
 void CAMBEData::setData(const unsigned char *data, unsigned int length)
 {
 	assert(data != NULL);
@@ -637,6 +649,7 @@ CAMBEData& CAMBEData::operator=(const CAMBEData& data)
 		m_errors      = data.m_errors;
 		m_text        = data.m_text;
 		m_header      = data.m_header;
+		m_timing      = data.m_timing;
 
 		::memcpy(m_data, data.m_data, DV_FRAME_LENGTH_BYTES);
 	}
@@ -82,6 +82,9 @@ public:
 
 	unsigned int getErrors() const;
 
+	TVoiceTiming&       getTiming();
+	const TVoiceTiming& getTiming() const;
+
 	CHeaderData& getHeader();
 
 	CAMBEData& operator=(const CAMBEData& data);
@@ -100,4 +103,5 @@ private:
 	unsigned int   m_errors;
 	std::string       m_text;
 	CHeaderData    m_header;
+	TVoiceTiming   m_timing;
 };
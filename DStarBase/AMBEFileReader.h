@@ -18,41 +18,12 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "AMBEData.h"
-
-class CIndexRecord {
-public:
-	CIndexRecord(const std::string& name, unsigned int start, unsigned int length) :
-	m_name(name),
-	m_start(start),
-	m_length(length)
-	{
-	}
-
-	std::string getName() const
-	{
-		return m_name;
-	}
-
-	unsigned int getStart() const
-	{
-		return m_start;
-	}
-
-	unsigned int getLength() const
-	{
-		return m_length;
-	}
-
-private:
-	std::string     m_name;
-	unsigned int m_start;
-	unsigned int m_length;
-};
+#include "AMBEVoiceLibrary.h"
 
 class CAMBEFileReader
 {
@@ -63,12 +34,7 @@ public:
     bool lookup(const std::string &id, std::vector<CAMBEData *>& data);
 
 private:
-    bool readAmbe();
-    bool readIndex();
-
     std::string      m_indexFile;
     std::string      m_ambeFile;
-    unsigned char*   m_ambe;
-    unsigned int     m_ambeLength;
-    std::unordered_map<std::string, CIndexRecord*> m_index;
-};
\ No newline at end of file
+    std::shared_ptr<const CAMBEVoiceLibrary> m_library;
+};
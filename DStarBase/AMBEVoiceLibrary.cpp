@@ -0,0 +1,394 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <sys/stat.h>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "AMBEVoiceLibrary.h"
+#include "DStarDefines.h"
+#include "Log.h"
+
+namespace {
+	std::mutex m_librariesMutex;
+	std::unordered_map<std::string, std::weak_ptr<const CAMBEVoiceLibrary>> m_libraries;
+
+	uint32_t hashName(const char* name, std::size_t length)
+	{
+		uint32_t hash = 2166136261U;
+		for (std::size_t i = 0U; i < length; i++) {
+			hash ^= (unsigned char)name[i];
+			hash *= 16777619U;
+		}
+
+		return hash;
+	}
+
+	const TAMBEIndexHeader* getHeader(const unsigned char* index)
+	{
+		return (const TAMBEIndexHeader*)index;
+	}
+
+	const uint32_t* getBuckets(const unsigned char* index)
+	{
+		return (const uint32_t*)(index + sizeof(TAMBEIndexHeader));
+	}
+
+	const TAMBEIndexEntry* getEntries(const unsigned char* index)
+	{
+		return (const TAMBEIndexEntry*)(getBuckets(index) + getHeader(index)->m_bucketCount);
+	}
+
+	const char* getNames(const unsigned char* index)
+	{
+		return (const char*)(getEntries(index) + getHeader(index)->m_entryCount);
+	}
+}
+
+CAMBEVoiceLibrary::CAMBEVoiceLibrary(const std::string& indexFile, const std::string& ambeFile) :
+m_indexFile(indexFile),
+m_ambeFile(ambeFile),
+m_ambe(),
+m_frames(0U),
+m_mappedIndex(),
+m_compiledIndex(),
+m_index(nullptr),
+m_indexSize(0U)
+{
+}
+
+CAMBEVoiceLibrary::~CAMBEVoiceLibrary()
+{
+}
+
+std::shared_ptr<const CAMBEVoiceLibrary> CAMBEVoiceLibrary::get(const std::string& indexFile, const std::string& ambeFile)
+{
+	std::string key = ambeFile + "\n" + indexFile;
+
+	std::lock_guard<std::mutex> lock(m_librariesMutex);
+
+	auto it = m_libraries.find(key);
+	if (it != m_libraries.end()) {
+		std::shared_ptr<const CAMBEVoiceLibrary> library = it->second.lock();
+		if (library != nullptr)
+			return library;
+	}
+
+	std::shared_ptr<CAMBEVoiceLibrary> library(new CAMBEVoiceLibrary(indexFile, ambeFile));
+	if (!library->loadAmbe() || !library->loadIndex()) {
+		m_libraries.erase(key);
+		return nullptr;
+	}
+
+	m_libraries[key] = library;
+
+	return library;
+}
+
+bool CAMBEVoiceLibrary::find(const std::string& id, unsigned int& start, unsigned int& length) const
+{
+	const TAMBEIndexHeader* header = getHeader(m_index);
+	const uint32_t* buckets        = getBuckets(m_index);
+	const TAMBEIndexEntry* entries = getEntries(m_index);
+	const char* names              = getNames(m_index);
+
+	uint32_t hash = hashName(id.c_str(), id.size());
+	uint32_t mask = header->m_bucketCount - 1U;
+
+	for (uint32_t i = hash & mask; buckets[i] != AMBE_INDEX_EMPTY; i = (i + 1U) & mask) {
+		const TAMBEIndexEntry& entry = entries[buckets[i]];
+		if (entry.m_hash == hash && entry.m_nameLength == id.size() && ::memcmp(names + entry.m_nameOffset, id.c_str(), id.size()) == 0) {
+			start  = entry.m_start;
+			length = entry.m_length;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const unsigned char* CAMBEVoiceLibrary::getFrame(unsigned int n) const
+{
+	assert(n < getFrameCount());
+
+	if (n < AMBE_SILENCE_LENGTH)
+		return NULL_AMBE_DATA_BYTES;
+
+	// Skip the "AMBE" header
+	return m_ambe.getData() + 4U + (n - AMBE_SILENCE_LENGTH) * VOICE_FRAME_LENGTH_BYTES;
+}
+
+unsigned int CAMBEVoiceLibrary::getFrameCount() const
+{
+	return m_frames + AMBE_SILENCE_LENGTH;
+}
+
+unsigned int CAMBEVoiceLibrary::getEntryCount() const
+{
+	return getHeader(m_index)->m_entryCount;
+}
+
+bool CAMBEVoiceLibrary::loadAmbe()
+{
+	struct stat sbuf;
+	if (stat(m_ambeFile.c_str(), &sbuf)) {
+		LogWarning("File %s not readable\n", m_ambeFile.c_str());
+		return false;
+	}
+
+	if (!m_ambe.open(m_ambeFile)) {
+		LogError("Cannot open %s for reading\n", m_ambeFile.c_str());
+		return false;
+	}
+
+	LogInfo("Mapping %s\n", m_ambeFile.c_str());
+
+	if (m_ambe.getSize() < 4U) {
+		LogError("Unable to read the header from %s\n", m_ambeFile.c_str());
+		m_ambe.close();
+		return false;
+	}
+
+	if (::memcmp(m_ambe.getData(), "AMBE", 4U)) {
+		LogError("Invalid header from %s\n", m_ambeFile.c_str());
+		m_ambe.close();
+		return false;
+	}
+
+	// Length of the file minus the header
+	m_frames = (unsigned int)((m_ambe.getSize() - 4U) / VOICE_FRAME_LENGTH_BYTES);
+
+	return true;
+}
+
+bool CAMBEVoiceLibrary::loadIndex()
+{
+	struct stat sbuf;
+	if (stat(m_indexFile.c_str(), &sbuf)) {
+		LogError("File %s not readable\n", m_indexFile.c_str());
+		return false;
+	}
+
+	std::string binaryFile = getBinaryIndexName(m_indexFile);
+	if (m_mappedIndex.open(binaryFile)) {
+		if (checkIndex(m_mappedIndex.getData(), m_mappedIndex.getSize(), uint32_t(sbuf.st_size), int64_t(sbuf.st_mtime))) {
+			LogInfo("Mapping %s\n", binaryFile.c_str());
+			m_index     = m_mappedIndex.getData();
+			m_indexSize = m_mappedIndex.getSize();
+			return true;
+		}
+
+		LogInfo("%s is out of date, rebuilding it\n", binaryFile.c_str());
+		m_mappedIndex.close();
+	}
+
+	if (!compileIndex(m_indexFile, m_frames, m_compiledIndex))
+		return false;
+
+	m_index     = m_compiledIndex.data();
+	m_indexSize = m_compiledIndex.size();
+
+	saveIndex();
+
+	return true;
+}
+
+bool CAMBEVoiceLibrary::checkIndex(const unsigned char* data, std::size_t size, uint32_t sourceSize, int64_t sourceTime) const
+{
+	if (size < sizeof(TAMBEIndexHeader))
+		return false;
+
+	const TAMBEIndexHeader* header = getHeader(data);
+	if (::memcmp(header->m_magic, AMBE_INDEX_MAGIC, 4U) != 0 || header->m_version != AMBE_INDEX_VERSION)
+		return false;
+
+	if (header->m_ambeFrames != m_frames || header->m_sourceSize != sourceSize || header->m_sourceTime != sourceTime)
+		return false;
+
+	uint64_t bucketCount = header->m_bucketCount;
+	uint64_t entryCount  = header->m_entryCount;
+	if (bucketCount == 0U || (bucketCount & (bucketCount - 1U)) != 0U || entryCount >= bucketCount)
+		return false;
+
+	uint64_t namesOffset = sizeof(TAMBEIndexHeader) + bucketCount * sizeof(uint32_t) + entryCount * sizeof(TAMBEIndexEntry);
+	if (namesOffset > size)
+		return false;
+
+	// Never trust a file on disk to stay within the mapping
+	uint64_t namesLength = size - namesOffset;
+	const uint32_t* buckets        = getBuckets(data);
+	const TAMBEIndexEntry* entries = getEntries(data);
+
+	for (uint64_t i = 0U; i < bucketCount; i++) {
+		if (buckets[i] != AMBE_INDEX_EMPTY && buckets[i] >= entryCount)
+			return false;
+	}
+
+	for (uint64_t i = 0U; i < entryCount; i++) {
+		const TAMBEIndexEntry& entry = entries[i];
+		if (uint64_t(entry.m_nameOffset) + entry.m_nameLength > namesLength)
+			return false;
+		if (uint64_t(entry.m_start) + entry.m_length > getFrameCount())
+			return false;
+	}
+
+	return true;
+}
+
+void CAMBEVoiceLibrary::saveIndex() const
+{
+	std::string binaryFile = getBinaryIndexName(m_indexFile);
+	std::string tempFile   = binaryFile + ".tmp";
+
+	// Best effort only, the data directory may well be read only
+	FILE* file = ::fopen(tempFile.c_str(), "wb");
+	if (file == nullptr) {
+		LogDebug("Cannot create %s, the index will be rebuilt at each start\n", tempFile.c_str());
+		return;
+	}
+
+	bool ok = ::fwrite(m_index, 1U, m_indexSize, file) == m_indexSize;
+	ok = (::fclose(file) == 0) && ok;
+
+	if (!ok || ::rename(tempFile.c_str(), binaryFile.c_str()) != 0) {
+		LogDebug("Cannot write %s, the index will be rebuilt at each start\n", binaryFile.c_str());
+		::remove(tempFile.c_str());
+	}
+}
+
+bool CAMBEVoiceLibrary::compileIndex(const std::string& indexFile, unsigned int ambeFrames, std::vector<unsigned char>& index)
+{
+	struct stat sbuf;
+	if (stat(indexFile.c_str(), &sbuf)) {
+		LogError("File %s not readable\n", indexFile.c_str());
+		return false;
+	}
+
+	FILE *file = fopen(indexFile.c_str(), "r");
+	if (file == nullptr) {
+		LogError("Cannot open %s for reading\n", indexFile.c_str());
+		return false;
+	}
+
+	LogInfo("Reading %s\n", indexFile.c_str());
+
+	struct TRecord {
+		std::string  m_name;
+		unsigned int m_start;
+		unsigned int m_length;
+	};
+
+	// Add a silence entry at the beginning
+	std::vector<TRecord> records;
+	std::unordered_map<std::string, std::size_t> positions;
+	records.push_back({ " ", 0U, AMBE_SILENCE_LENGTH });
+	positions[" "] = 0U;
+
+	char line[128];
+	while (fgets(line, 128, file)) {
+		if (strlen(line) && '#'!=line[0]) {
+			const char* space = " \t\r\n";
+			const char* name = strtok(line, space);
+			const char* strt = strtok(NULL, space);
+			const char* leng = strtok(NULL, space);
+
+			if (name != NULL && strt != NULL && leng != NULL) {
+				unsigned long start  = std::stoul(strt);
+				unsigned long length = std::stoul(leng);
+
+				if (start >= ambeFrames || (start + length) > ambeFrames) {
+					LogInfo("The start or end for *%s* is out of range, start: %lu, end: %lu\n", name, start, start + length);
+				} else {
+					// Later lines win, as they always have
+					auto it = positions.find(name);
+					if (it != positions.end()) {
+						records[it->second].m_start  = start + AMBE_SILENCE_LENGTH;
+						records[it->second].m_length = length;
+					} else {
+						positions[name] = records.size();
+						records.push_back({ name, (unsigned int)(start + AMBE_SILENCE_LENGTH), (unsigned int)length });
+					}
+				}
+			}
+		}
+	}
+
+	fclose(file);
+
+	// Keep the table at most half full so that probes stay short
+	uint32_t bucketCount = 16U;
+	while (bucketCount < records.size() * 2U)
+		bucketCount *= 2U;
+
+	std::size_t namesLength = 0U;
+	for (const auto& record : records)
+		namesLength += record.m_name.size();
+
+	index.assign(sizeof(TAMBEIndexHeader) + bucketCount * sizeof(uint32_t) + records.size() * sizeof(TAMBEIndexEntry) + namesLength, 0U);
+
+	TAMBEIndexHeader* header = (TAMBEIndexHeader*)index.data();
+	::memcpy(header->m_magic, AMBE_INDEX_MAGIC, 4U);
+	header->m_version     = AMBE_INDEX_VERSION;
+	header->m_bucketCount = bucketCount;
+	header->m_entryCount  = uint32_t(records.size());
+	header->m_ambeFrames  = ambeFrames;
+	header->m_sourceSize  = uint32_t(sbuf.st_size);
+	header->m_sourceTime  = int64_t(sbuf.st_mtime);
+
+	uint32_t* buckets        = (uint32_t*)getBuckets(index.data());
+	TAMBEIndexEntry* entries = (TAMBEIndexEntry*)getEntries(index.data());
+	char* names              = (char*)getNames(index.data());
+
+	for (uint32_t i = 0U; i < bucketCount; i++)
+		buckets[i] = AMBE_INDEX_EMPTY;
+
+	uint32_t nameOffset = 0U;
+	for (uint32_t n = 0U; n < records.size(); n++) {
+		const TRecord& record = records[n];
+
+		TAMBEIndexEntry& entry = entries[n];
+		entry.m_hash       = hashName(record.m_name.c_str(), record.m_name.size());
+		entry.m_nameOffset = nameOffset;
+		entry.m_nameLength = uint32_t(record.m_name.size());
+		entry.m_start      = record.m_start;
+		entry.m_length     = record.m_length;
+
+		::memcpy(names + nameOffset, record.m_name.c_str(), record.m_name.size());
+		nameOffset += entry.m_nameLength;
+
+		uint32_t i = entry.m_hash & (bucketCount - 1U);
+		while (buckets[i] != AMBE_INDEX_EMPTY)
+			i = (i + 1U) & (bucketCount - 1U);
+		buckets[i] = n;
+	}
+
+	return true;
+}
+
+std::string CAMBEVoiceLibrary::getBinaryIndexName(const std::string& indexFile)
+{
+	const std::string extension(".indx");
+
+	if (indexFile.size() > extension.size() && indexFile.compare(indexFile.size() - extension.size(), extension.size(), extension) == 0)
+		return indexFile.substr(0U, indexFile.size() - extension.size()) + ".indb";
+
+	return indexFile + ".indb";
+}
@@ -0,0 +1,90 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+const unsigned int AMBE_SILENCE_LENGTH = 10U;
+
+// Binary index (.indb) compiled from a text .indx file. It is laid out so that it can be used
+// straight from a read only mapping:
+//   header, bucket table (entry number or AMBE_INDEX_EMPTY), entries, names
+const char         AMBE_INDEX_MAGIC[] = "AMBX";
+const uint32_t     AMBE_INDEX_VERSION = 1U;
+const uint32_t     AMBE_INDEX_EMPTY   = 0xFFFFFFFFU;
+
+struct TAMBEIndexHeader {
+	char     m_magic[4U];
+	uint32_t m_version;
+	uint32_t m_bucketCount;			// Always a power of two
+	uint32_t m_entryCount;
+	uint32_t m_ambeFrames;			// Frames in the .ambe file the index was checked against
+	uint32_t m_sourceSize;			// Size and modification time of the .indx it was compiled from
+	int64_t  m_sourceTime;
+};
+
+struct TAMBEIndexEntry {
+	uint32_t m_hash;
+	uint32_t m_nameOffset;
+	uint32_t m_nameLength;
+	uint32_t m_start;				// In frames, including the leading silence
+	uint32_t m_length;
+};
+
+// One .ambe/.indx pair, mapped read only and shared by every CAMBEFileReader in the process
+class CAMBEVoiceLibrary {
+public:
+	~CAMBEVoiceLibrary();
+
+	static std::shared_ptr<const CAMBEVoiceLibrary> get(const std::string& indexFile, const std::string& ambeFile);
+
+	bool find(const std::string& id, unsigned int& start, unsigned int& length) const;
+
+	// Frame n of the voice data, the first AMBE_SILENCE_LENGTH frames are silence
+	const unsigned char* getFrame(unsigned int n) const;
+	unsigned int         getFrameCount() const;
+
+	unsigned int         getEntryCount() const;
+
+	static bool compileIndex(const std::string& indexFile, unsigned int ambeFrames, std::vector<unsigned char>& index);
+
+	static std::string getBinaryIndexName(const std::string& indexFile);
+
+private:
+	CAMBEVoiceLibrary(const std::string& indexFile, const std::string& ambeFile);
+
+	bool loadAmbe();
+	bool loadIndex();
+	bool checkIndex(const unsigned char* data, std::size_t size, uint32_t sourceSize, int64_t sourceTime) const;
+	void saveIndex() const;
+
+	std::string                m_indexFile;
+	std::string                m_ambeFile;
+	CMappedFile                m_ambe;
+	unsigned int               m_frames;
+	CMappedFile                m_mappedIndex;
+	std::vector<unsigned char> m_compiledIndex;
+	const unsigned char*       m_index;
+	std::size_t                m_indexSize;
+};
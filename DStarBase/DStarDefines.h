@@ -89,6 +89,7 @@ const unsigned char SLOW_DATA_TYPE_FAST_DATA1	= 0x80U;
 const unsigned char SLOW_DATA_TYPE_FAST_DATA2	= 0x90U;
 const unsigned char SLOW_DATA_TYPE_SQUELCH		= 0xC0U;
 const unsigned char SLOW_DATA_LENGTH_MASK		= 0x0FU;
+const unsigned int  SLOW_DATA_BLOCK_LENGTH		= 6U;
 
 const unsigned char DATA_MASK           = 0x80U;
 const unsigned char REPEATER_MASK       = 0x40U;
@@ -21,6 +21,7 @@
 
 #include <cstdio>
 #include "DTMF.h"
+#include "AMBEClassifier.h"
 #include "Log.h"
 
 CDTMF::CDTMF() :
@@ -39,51 +40,15 @@ CDTMF::~CDTMF()
 
 bool CDTMF::decode(const unsigned char* ambe, bool end)
 {
-	// DTMF begins with these byte values
-	if (!end && (ambe[0] & DTMF_MASK[0]) == DTMF_SIG[0] && (ambe[1] & DTMF_MASK[1]) == DTMF_SIG[1] &&
-				(ambe[2] & DTMF_MASK[2]) == DTMF_SIG[2] && (ambe[3] & DTMF_MASK[3]) == DTMF_SIG[3] &&
-				(ambe[4] & DTMF_MASK[4]) == DTMF_SIG[4] && (ambe[5] & DTMF_MASK[5]) == DTMF_SIG[5] &&
-				(ambe[6] & DTMF_MASK[6]) == DTMF_SIG[6] && (ambe[7] & DTMF_MASK[7]) == DTMF_SIG[7] &&
-				(ambe[8] & DTMF_MASK[8]) == DTMF_SIG[8]) {
-		unsigned char sym0 = ambe[4] & DTMF_SYM_MASK[0];
-		unsigned char sym1 = ambe[5] & DTMF_SYM_MASK[1];
-		unsigned char sym2 = ambe[7] & DTMF_SYM_MASK[2];
-		unsigned char sym3 = ambe[8] & DTMF_SYM_MASK[3];
-
-		char c = ' ';
-		if (sym0 == DTMF_SYM0[0] && sym1 == DTMF_SYM0[1] && sym2 == DTMF_SYM0[2] && sym3 == DTMF_SYM0[3])
-			c = '0';
-		else if (sym0 == DTMF_SYM1[0] && sym1 == DTMF_SYM1[1] && sym2 == DTMF_SYM1[2] && sym3 == DTMF_SYM1[3])
-			c = '1';
-		else if (sym0 == DTMF_SYM2[0] && sym1 == DTMF_SYM2[1] && sym2 == DTMF_SYM2[2] && sym3 == DTMF_SYM2[3])
-			c = '2';
-		else if (sym0 == DTMF_SYM3[0] && sym1 == DTMF_SYM3[1] && sym2 == DTMF_SYM3[2] && sym3 == DTMF_SYM3[3])
-			c = '3';
-		else if (sym0 == DTMF_SYM4[0] && sym1 == DTMF_SYM4[1] && sym2 == DTMF_SYM4[2] && sym3 == DTMF_SYM4[3])
-			c = '4';
-		else if (sym0 == DTMF_SYM5[0] && sym1 == DTMF_SYM5[1] && sym2 == DTMF_SYM5[2] && sym3 == DTMF_SYM5[3])
-			c = '5';
-		else if (sym0 == DTMF_SYM6[0] && sym1 == DTMF_SYM6[1] && sym2 == DTMF_SYM6[2] && sym3 == DTMF_SYM6[3])
-			c = '6';
-		else if (sym0 == DTMF_SYM7[0] && sym1 == DTMF_SYM7[1] && sym2 == DTMF_SYM7[2] && sym3 == DTMF_SYM7[3])
-			c = '7';
-		else if (sym0 == DTMF_SYM8[0] && sym1 == DTMF_SYM8[1] && sym2 == DTMF_SYM8[2] && sym3 == DTMF_SYM8[3])
-			c = '8';
-		else if (sym0 == DTMF_SYM9[0] && sym1 == DTMF_SYM9[1] && sym2 == DTMF_SYM9[2] && sym3 == DTMF_SYM9[3])
-			c = '9';
-		else if (sym0 == DTMF_SYMA[0] && sym1 == DTMF_SYMA[1] && sym2 == DTMF_SYMA[2] && sym3 == DTMF_SYMA[3])
-			c = 'A';
-		else if (sym0 == DTMF_SYMB[0] && sym1 == DTMF_SYMB[1] && sym2 == DTMF_SYMB[2] && sym3 == DTMF_SYMB[3])
-			c = 'B';
-		else if (sym0 == DTMF_SYMC[0] && sym1 == DTMF_SYMC[1] && sym2 == DTMF_SYMC[2] && sym3 == DTMF_SYMC[3])
-			c = 'C';
-		else if (sym0 == DTMF_SYMD[0] && sym1 == DTMF_SYMD[1] && sym2 == DTMF_SYMD[2] && sym3 == DTMF_SYMD[3])
-			c = 'D';
-		else if (sym0 == DTMF_SYMS[0] && sym1 == DTMF_SYMS[1] && sym2 == DTMF_SYMS[2] && sym3 == DTMF_SYMS[3])
-			c = '*';
-		else if (sym0 == DTMF_SYMH[0] && sym1 == DTMF_SYMH[1] && sym2 == DTMF_SYMH[2] && sym3 == DTMF_SYMH[3])
-			c = '#';
+	char c = ' ';
+	unsigned int classes = CAMBEClassifier::classifyVoice(ambe, c);
 
+	return decode(classes, c, end);
+}
+
+bool CDTMF::decode(unsigned int classes, char c, bool end)
+{
+	if (!end && (classes & AMBE_CLASS_DTMF) != 0U) {
 		LogDebug("Received DTMF Tone %c", c);
 
 		if (c == m_lastChar) {
@@ -27,6 +27,8 @@ public:
 	~CDTMF();
 
 	bool decode(const unsigned char* ambe, bool end);
+	// When the frame has already been through CAMBEClassifier
+	bool decode(unsigned int classes, char digit, bool end);
 
 	bool hasCommand() const;
 
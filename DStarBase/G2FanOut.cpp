@@ -0,0 +1,144 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include "G2FanOut.h"
+#include "DStarDefines.h"
+#include "PacingEngine.h"
+
+const unsigned int G2_HEADER_LENGTH = 56U;
+const unsigned int G2_FRAME_LENGTH  = 15U + DV_FRAME_LENGTH_BYTES;
+
+CG2FanOut::CG2FanOut() :
+m_ids(),
+m_headers(),
+m_headerLength(G2_HEADER_LENGTH),
+m_frames(),
+m_frameCount(0U)
+{
+}
+
+void CG2FanOut::setHeader(const CHeaderData& header, const std::vector<std::string>& repeaters)
+{
+	clear();
+
+	m_headers.resize(repeaters.size() * G2_HEADER_LENGTH);
+
+	for (unsigned int i = 0U; i < repeaters.size(); i++) {
+		unsigned int id = CHeaderData::createId();
+		m_ids.push_back(id);
+
+		CHeaderData headerCopy(header);
+		headerCopy.setId(id);
+		headerCopy.setRptCall2(repeaters[i]);
+
+		m_headerLength = headerCopy.getG2Data(m_headers.data() + i * G2_HEADER_LENGTH, G2_HEADER_LENGTH, true);
+		assert(m_headerLength == G2_HEADER_LENGTH);
+	}
+}
+
+void CG2FanOut::addFrame(const CAMBEData& data)
+{
+	unsigned int streams = getStreamCount();
+	if (streams == 0U)
+		return;
+
+	unsigned int offset = (unsigned int)m_frames.size();
+	m_frames.resize(offset + streams * G2_FRAME_LENGTH);
+
+	unsigned char buffer[40U];
+	unsigned int length = data.getG2Data(buffer, 40U);
+	assert(length == G2_FRAME_LENGTH);
+
+	// Only the stream id differs from one repeater to the next
+	unsigned char* packet = m_frames.data() + offset;
+	for (unsigned int i = 0U; i < streams; i++, packet += G2_FRAME_LENGTH) {
+		::memcpy(packet, buffer, length);
+
+		packet[12U] = m_ids[i] / 256U;
+		packet[13U] = m_ids[i] % 256U;
+	}
+
+	m_frameCount++;
+}
+
+void CG2FanOut::clear()
+{
+	m_ids.clear();
+	m_headers.clear();
+	m_frames.clear();
+	m_frameCount = 0U;
+}
+
+unsigned int CG2FanOut::getStreamCount() const
+{
+	return (unsigned int)m_ids.size();
+}
+
+unsigned int CG2FanOut::getFrameCount() const
+{
+	return m_frameCount;
+}
+
+unsigned int CG2FanOut::getId(unsigned int stream) const
+{
+	assert(stream < m_ids.size());
+
+	return m_ids[stream];
+}
+
+bool CG2FanOut::sendHeaders(CUDPReaderWriter& socket, const in_addr& address, unsigned int port, unsigned int repeats) const
+{
+	for (unsigned int i = 0U; i < repeats; i++) {
+		if (!socket.writeBatch(m_headers.data(), m_headerLength, getStreamCount(), address, port))
+			return false;
+	}
+
+	return true;
+}
+
+bool CG2FanOut::sendFrame(CUDPReaderWriter& socket, unsigned int frame, const in_addr& address, unsigned int port) const
+{
+	assert(frame < m_frameCount);
+
+	unsigned int streams = getStreamCount();
+
+	return socket.writeBatch(m_frames.data() + frame * streams * G2_FRAME_LENGTH, G2_FRAME_LENGTH, streams, address, port);
+}
+
+bool CG2FanOut::send(CUDPReaderWriter& socket, const in_addr& address, unsigned int port) const
+{
+	if (getStreamCount() == 0U || m_frameCount == 0U)
+		return false;
+
+	if (!sendHeaders(socket, address, port))
+		return false;
+
+	bool ok = true;
+
+	CPacingEngine pacer(DSTAR_FRAME_TIME_MS);
+	pacer.add([&](unsigned int frame) -> bool {
+		ok = sendFrame(socket, frame, address, port) && ok;
+		return (frame + 1U) < m_frameCount;
+	});
+	pacer.run();
+
+	return ok;
+}
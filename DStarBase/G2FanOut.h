@@ -0,0 +1,58 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+
+#include "HeaderData.h"
+#include "AMBEData.h"
+#include "UDPReaderWriter.h"
+
+// One G2 stream sent to several repeaters of the same gateway at once. Every packet is built up front:
+// a block per frame holding one copy for each repeater, with that repeater's stream id patched in.
+// Sending a frame to all the repeaters is then a single batched write from a single socket.
+class CG2FanOut {
+public:
+	CG2FanOut();
+
+	// RPT2 of the header is replaced with each repeater in turn, each one gets its own stream id
+	void setHeader(const CHeaderData& header, const std::vector<std::string>& repeaters);
+	void addFrame(const CAMBEData& data);
+	void clear();
+
+	unsigned int getStreamCount() const;
+	unsigned int getFrameCount() const;
+	unsigned int getId(unsigned int stream) const;
+
+	bool sendHeaders(CUDPReaderWriter& socket, const in_addr& address, unsigned int port, unsigned int repeats = 5U) const;
+	bool sendFrame(CUDPReaderWriter& socket, unsigned int frame, const in_addr& address, unsigned int port) const;
+
+	// The headers then every frame on its 20ms deadline, returns once the last frame has gone
+	bool send(CUDPReaderWriter& socket, const in_addr& address, unsigned int port) const;
+
+private:
+	std::vector<unsigned int>  m_ids;
+	std::vector<unsigned char> m_headers;
+	unsigned int               m_headerLength;
+	std::vector<unsigned char> m_frames;
+	unsigned int               m_frameCount;
+};
@@ -61,7 +61,8 @@ m_rptCall2(NULL),
 m_yourAddress(),
 m_yourPort(0U),
 m_myPort(0U),
-m_errors(0U)
+m_errors(0U),
+m_timing()
 {
 	m_myCall1  = new unsigned char[LONG_CALLSIGN_LENGTH];
 	m_myCall2  = new unsigned char[SHORT_CALLSIGN_LENGTH];
@@ -93,7 +94,8 @@ m_rptCall2(NULL),
 m_yourAddress(header.m_yourAddress),
 m_yourPort(header.m_yourPort),
 m_myPort(header.m_myPort),
-m_errors(header.m_errors)
+m_errors(header.m_errors),
+m_timing(header.m_timing)
 {
 	m_myCall1  = new unsigned char[LONG_CALLSIGN_LENGTH];
 	m_myCall2  = new unsigned char[SHORT_CALLSIGN_LENGTH];
@@ -127,7 +129,8 @@ m_rptCall2(NULL),
 m_yourAddress(),
 m_yourPort(0U),
 m_myPort(0U),
-m_errors(0U)
+m_errors(0U),
+m_timing()
 {
 	m_myCall1  = new unsigned char[LONG_CALLSIGN_LENGTH];
 	m_myCall2  = new unsigned char[SHORT_CALLSIGN_LENGTH];
@@ -940,6 +943,16 @@ unsigned int CHeaderData::getMyPort() const
 	return m_myPort;
 }
 
+TVoiceTiming& CHeaderData::getTiming()
+{
+	return m_timing;
+}
+
+const TVoiceTiming& CHeaderData::getTiming() const
+{
+	return m_timing;
+}
+
 CHeaderData& CHeaderData::operator =(const CHeaderData& header)
 {
 	if (&header != this) {
@@ -955,6 +968,7 @@ CHeaderData& CHeaderData::operator =(const CHeaderData& header)
 		m_yourPort    = header.m_yourPort;
 		m_myPort      = header.m_myPort;
 		m_errors      = header.m_errors;
+		m_timing      = header.m_timing;
 
 		::memcpy(m_myCall1,  header.m_myCall1,  LONG_CALLSIGN_LENGTH);
 		::memcpy(m_myCall2,  header.m_myCall2,  SHORT_CALLSIGN_LENGTH);
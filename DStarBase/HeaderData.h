@@ -24,6 +24,8 @@
 
 #include <netinet/in.h>
 
+#include "VoiceStats.h"
+
 class CHeaderData {
 public:
 	CHeaderData();
@@ -99,6 +101,9 @@ public:
 
 	unsigned int getErrors() const;
 
+	TVoiceTiming&       getTiming();
+	const TVoiceTiming& getTiming() const;
+
 	static void initialise();
 	static void finalise();
 	static unsigned int createId();
@@ -123,4 +128,5 @@ private:
 	unsigned int   m_yourPort;
 	unsigned int   m_myPort;
 	unsigned int   m_errors;
+	TVoiceTiming   m_timing;
 };
@@ -0,0 +1,180 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+
+#include "LinkQuality.h"
+#include "DStarDefines.h"
+#include "Log.h"
+
+const unsigned int SEQUENCE_LENGTH = 21U;
+const uint64_t     FRAME_TIME_US   = DSTAR_FRAME_TIME_MS * 1000U;
+
+// A frame less than half a sequence behind the newest one is taken as late rather than early
+const unsigned int MAX_LATE_FRAMES = SEQUENCE_LENGTH / 2U;
+const unsigned int WINDOW_LENGTH   = 32U;
+
+CLinkQuality::CLinkQuality() :
+m_link(),
+m_stream(),
+m_active(false),
+m_first(true),
+m_highest(SEQUENCE_LENGTH - 1U),
+m_window(0U),
+m_arrival(0U),
+m_jitter(0U)
+{
+}
+
+void CLinkQuality::start(uint64_t arrival)
+{
+	if (m_active)
+		end();
+
+	m_stream = TLinkQuality();
+	m_stream.streams = 1U;
+
+	m_active  = true;
+	m_first   = true;
+	m_arrival = arrival;
+	m_jitter  = 0U;
+
+	// The first frame is expected to be zero, everything before it counts as received
+	m_highest = SEQUENCE_LENGTH - 1U;
+	m_window  = 0xFFFFFFFFU;
+}
+
+void CLinkQuality::frame(unsigned int seq, uint64_t arrival)
+{
+	// The sequence comes straight off the network, five bits can hold more than 0-20
+	if (seq >= SEQUENCE_LENGTH)
+		return;
+
+	// DCS has no header, its streams start with their first frame
+	if (!m_active)
+		start(arrival);
+
+	unsigned int ahead = (seq + SEQUENCE_LENGTH - m_highest) % SEQUENCE_LENGTH;
+	uint64_t elapsed = arrival > m_arrival ? arrival - m_arrival : 0U;
+
+	// The first frame of a stream can only be ahead of the header
+	if (!m_first) {
+		if (ahead == 0U && elapsed < FRAME_TIME_US * SEQUENCE_LENGTH / 2U) {
+			m_stream.duplicates++;
+			return;
+		}
+
+		if (ahead > MAX_LATE_FRAMES && elapsed < FRAME_TIME_US * MAX_LATE_FRAMES) {
+			uint32_t bit = 1U << (SEQUENCE_LENGTH - ahead);
+			if ((m_window & bit) != 0U) {
+				m_stream.duplicates++;
+			} else {
+				m_window |= bit;
+				m_stream.outOfOrder++;
+				m_stream.frames++;
+				if (m_stream.lost > 0U)
+					m_stream.lost--;
+			}
+
+			return;
+		}
+	}
+
+	// After a silence work out how many whole sequences were missed
+	uint64_t distance = ahead;
+	if (!m_first) {
+		uint64_t expected = (elapsed + FRAME_TIME_US / 2U) / FRAME_TIME_US;
+		if (expected > distance + SEQUENCE_LENGTH / 2U)
+			distance += ((expected - distance + SEQUENCE_LENGTH / 2U) / SEQUENCE_LENGTH) * SEQUENCE_LENGTH;
+	}
+	if (distance == 0U)
+		distance = SEQUENCE_LENGTH;
+
+	m_stream.lost += distance - 1U;
+	m_stream.frames++;
+
+	m_window = distance < WINDOW_LENGTH ? (m_window << distance) | 1U : 1U;
+
+	if (!m_first) {
+		int64_t transit = int64_t(elapsed) - int64_t(distance * FRAME_TIME_US);
+		uint64_t d = transit < 0 ? uint64_t(-transit) : uint64_t(transit);
+		m_jitter += d - ((m_jitter + 8U) >> 4);
+		m_stream.jitter = uint32_t(m_jitter >> 4);
+	}
+
+	m_highest = seq;
+	m_arrival = arrival;
+	m_first   = false;
+}
+
+bool CLinkQuality::end()
+{
+	if (!m_active)
+		return false;
+
+	m_active = false;
+
+	add(m_link, m_stream);
+
+	return true;
+}
+
+void CLinkQuality::report(const std::string& repeater, const char* protocol, const std::string& reflector) const
+{
+	assert(protocol != NULL);
+
+	if (m_stream.lost > 0U || m_stream.outOfOrder > 0U || m_stream.duplicates > 0U)
+		LogInfo("%s stream from %s to %s: %llu frames, %llu lost, %llu out of order, %llu duplicated, jitter %uus", protocol, reflector.c_str(), repeater.c_str(),
+			(unsigned long long)m_stream.frames, (unsigned long long)m_stream.lost, (unsigned long long)m_stream.outOfOrder,
+			(unsigned long long)m_stream.duplicates, m_stream.jitter);
+
+	writeJSONStream(repeater, protocol, reflector, m_stream.frames, m_stream.lost, m_stream.outOfOrder, m_stream.duplicates, m_stream.jitter);
+}
+
+bool CLinkQuality::isActive() const
+{
+	return m_active;
+}
+
+const TLinkQuality& CLinkQuality::getStream() const
+{
+	return m_stream;
+}
+
+void CLinkQuality::getLink(TLinkQuality& quality) const
+{
+	quality = m_link;
+
+	if (m_active)
+		add(quality, m_stream);
+}
+
+void CLinkQuality::add(TLinkQuality& totals, const TLinkQuality& stream)
+{
+	totals.frames     += stream.frames;
+	totals.lost       += stream.lost;
+	totals.outOfOrder += stream.outOfOrder;
+	totals.duplicates += stream.duplicates;
+	totals.jitter      = stream.jitter;
+	totals.streams    += stream.streams;
+}
+
+uint64_t CLinkQuality::getArrival(const TVoiceTiming& timing)
+{
+	return timing.received != 0U ? timing.received : CVoiceStats::now();
+}
@@ -0,0 +1,74 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "VoiceStats.h"
+
+// Counted on frames received from a link, for one stream or summed over every stream of the link
+struct TLinkQuality {
+	uint64_t frames;		// Received at least once
+	uint64_t lost;			// Gaps in the sequence that were never filled
+	uint64_t outOfOrder;	// Arrived after a later frame, no longer counted as lost
+	uint64_t duplicates;
+	uint32_t jitter;		// RFC 3550 interarrival jitter in microseconds
+	uint32_t streams;
+};
+
+// Follows the 0-20 D-Star frame sequence of one stream at a time. A window of the last 32 frames
+// tells late frames from duplicates, and after a silence the arrival time gives the number of
+// whole sequences that went missing, which the sequence number alone cannot show.
+class CLinkQuality {
+public:
+	CLinkQuality();
+
+	void start(uint64_t arrival);
+	// Sequence numbers outside 0-20 are ignored
+	void frame(unsigned int seq, uint64_t arrival);
+	// Adds the stream to the link totals, returns false if there was no stream
+	bool end();
+
+	// Logs the stream when anything went wrong with it and publishes it as an MQTT event
+	void report(const std::string& repeater, const char* protocol, const std::string& reflector) const;
+
+	bool isActive() const;
+
+	// The stream in progress, or the last one once it has ended
+	const TLinkQuality& getStream() const;
+	// Every stream including the one in progress, the jitter is that of the latest stream
+	void getLink(TLinkQuality& quality) const;
+
+	// Folds a stream into the totals of a link, the jitter is taken from the stream
+	static void add(TLinkQuality& totals, const TLinkQuality& stream);
+
+	// The receive time stamped by the protocol handler, or now when voice statistics are off
+	static uint64_t getArrival(const TVoiceTiming& timing);
+
+private:
+	TLinkQuality m_link;
+	TLinkQuality m_stream;
+	bool         m_active;
+	bool         m_first;
+	unsigned int m_highest;
+	uint32_t     m_window;
+	uint64_t     m_arrival;
+	uint64_t     m_jitter;		// Scaled by 16 as in RFC 3550 A.8
+};
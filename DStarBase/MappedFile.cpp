@@ -0,0 +1,150 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "MappedFile.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+CMappedFile::CMappedFile() :
+m_data(nullptr),
+m_size(0U)
+#if defined(_WIN32) || defined(_WIN64)
+,
+m_file(INVALID_HANDLE_VALUE),
+m_mapping(nullptr)
+#endif
+{
+}
+
+CMappedFile::~CMappedFile()
+{
+	close();
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+bool CMappedFile::open(const std::string& fileName)
+{
+	close();
+
+	m_file = ::CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+		close();
+		return false;
+	}
+
+	m_mapping = ::CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping == nullptr) {
+		close();
+		return false;
+	}
+
+	m_data = (const unsigned char*)::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (m_data == nullptr) {
+		close();
+		return false;
+	}
+
+	m_size = std::size_t(size.QuadPart);
+
+	return true;
+}
+
+void CMappedFile::close()
+{
+	if (m_data != nullptr)
+		::UnmapViewOfFile(m_data);
+
+	if (m_mapping != nullptr)
+		::CloseHandle(m_mapping);
+
+	if (m_file != INVALID_HANDLE_VALUE)
+		::CloseHandle(m_file);
+
+	m_data    = nullptr;
+	m_size    = 0U;
+	m_mapping = nullptr;
+	m_file    = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool CMappedFile::open(const std::string& fileName)
+{
+	close();
+
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat sbuf;
+	if (::fstat(fd, &sbuf) != 0 || sbuf.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	void* data = ::mmap(nullptr, std::size_t(sbuf.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+	// The mapping stays valid once the descriptor is closed
+	::close(fd);
+
+	if (data == MAP_FAILED)
+		return false;
+
+	m_data = (const unsigned char*)data;
+	m_size = std::size_t(sbuf.st_size);
+
+	return true;
+}
+
+void CMappedFile::close()
+{
+	if (m_data != nullptr)
+		::munmap((void*)m_data, m_size);
+
+	m_data = nullptr;
+	m_size = 0U;
+}
+
+#endif
+
+bool CMappedFile::isOpen() const
+{
+	return m_data != nullptr;
+}
+
+const unsigned char* CMappedFile::getData() const
+{
+	return m_data;
+}
+
+std::size_t CMappedFile::getSize() const
+{
+	return m_size;
+}
@@ -0,0 +1,49 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// A read only view of a whole file. The pages are shared with the page cache and with every other
+// mapping of the same file, so nothing is copied onto the heap.
+class CMappedFile {
+public:
+	CMappedFile();
+	~CMappedFile();
+
+	bool open(const std::string& fileName);
+	void close();
+
+	bool isOpen() const;
+
+	const unsigned char* getData() const;
+	std::size_t          getSize() const;
+
+private:
+	CMappedFile(const CMappedFile&) = delete;
+	CMappedFile& operator=(const CMappedFile&) = delete;
+
+	const unsigned char* m_data;
+	std::size_t          m_size;
+#if defined(_WIN32) || defined(_WIN64)
+	void*                m_file;
+	void*                m_mapping;
+#endif
+};
@@ -0,0 +1,186 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "StatusSegment.h"
+#include "Log.h"
+
+CStatusSegment::CStatusSegment(const std::string& name) :
+m_name(name),
+m_segment(nullptr),
+m_writer(false)
+{
+	// POSIX shared memory object names start with a single slash
+	if (m_name.empty() || m_name[0] != '/')
+		m_name.insert(0U, "/");
+}
+
+CStatusSegment::~CStatusSegment()
+{
+	close();
+}
+
+bool CStatusSegment::create()
+{
+	close();
+
+	// A segment left behind by a gateway that did not shut down cleanly is reused
+	int fd = ::shm_open(m_name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if (fd < 0) {
+		LogError("Cannot create the status segment %s, err=%d", m_name.c_str(), errno);
+		return false;
+	}
+
+	if (::ftruncate(fd, sizeof(SStatusSegment)) != 0) {
+		LogError("Cannot size the status segment %s, err=%d", m_name.c_str(), errno);
+		::close(fd);
+		return false;
+	}
+
+	void* segment = ::mmap(nullptr, sizeof(SStatusSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (segment == MAP_FAILED) {
+		LogError("Cannot map the status segment %s, err=%d", m_name.c_str(), errno);
+		return false;
+	}
+
+	m_segment = (SStatusSegment*)segment;
+	m_writer  = true;
+
+	m_segment->sequence.store(0U, std::memory_order_relaxed);
+	::memset(&m_segment->data, 0x00, sizeof(SStatusData));
+	m_segment->magic   = STATUS_SEGMENT_MAGIC;
+	m_segment->version = STATUS_SEGMENT_VERSION;
+	m_segment->size    = sizeof(SStatusSegment);
+	m_segment->running.store(1U, std::memory_order_release);
+
+	LogInfo("Status segment %s created, %u bytes", m_name.c_str(), (unsigned int)sizeof(SStatusSegment));
+
+	return true;
+}
+
+void CStatusSegment::write(const SStatusData& data)
+{
+	if (m_segment == nullptr || !m_writer)
+		return;
+
+	// An odd sequence number tells the readers that an update is in progress
+	uint32_t sequence = m_segment->sequence.load(std::memory_order_relaxed);
+	m_segment->sequence.store(sequence + 1U, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	::memcpy(&m_segment->data, &data, sizeof(SStatusData));
+
+	m_segment->sequence.store(sequence + 2U, std::memory_order_release);
+}
+
+bool CStatusSegment::open()
+{
+	close();
+
+	int fd = ::shm_open(m_name.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+
+	struct stat sbuf;
+	if (::fstat(fd, &sbuf) != 0 || std::size_t(sbuf.st_size) != sizeof(SStatusSegment)) {
+		::close(fd);
+		return false;
+	}
+
+	void* segment = ::mmap(nullptr, sizeof(SStatusSegment), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (segment == MAP_FAILED)
+		return false;
+
+	m_segment = (SStatusSegment*)segment;
+	m_writer  = false;
+
+	if (m_segment->magic != STATUS_SEGMENT_MAGIC || m_segment->version != STATUS_SEGMENT_VERSION || m_segment->size != sizeof(SStatusSegment)) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool CStatusSegment::read(SStatusData& data) const
+{
+	if (m_segment == nullptr)
+		return false;
+
+	for (unsigned int i = 0U; i < STATUS_READ_RETRIES; i++) {
+		uint32_t before = m_segment->sequence.load(std::memory_order_acquire);
+		if ((before & 1U) == 0U) {
+			::memcpy(&data, (const void*)&m_segment->data, sizeof(SStatusData));
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			uint32_t after = m_segment->sequence.load(std::memory_order_relaxed);
+			if (before == after)
+				return true;
+		}
+
+		std::this_thread::yield();
+	}
+
+	return false;
+}
+
+bool CStatusSegment::isRunning() const
+{
+	return m_segment != nullptr && m_segment->running.load(std::memory_order_acquire) == 1U;
+}
+
+void CStatusSegment::close()
+{
+	if (m_segment == nullptr)
+		return;
+
+	// Readers that still have the segment mapped see that the gateway went away and reopen
+	if (m_writer) {
+		m_segment->running.store(0U, std::memory_order_release);
+		::shm_unlink(m_name.c_str());
+	}
+
+	::munmap((void*)m_segment, sizeof(SStatusSegment));
+
+	m_segment = nullptr;
+	m_writer  = false;
+}
+
+bool CStatusSegment::isOpen() const
+{
+	return m_segment != nullptr;
+}
+
+void CStatusSegment::setString(char* dest, unsigned int length, const std::string& src)
+{
+	std::size_t n = std::min(src.size(), std::size_t(length - 1U));
+	::memcpy(dest, src.data(), n);
+	::memset(dest + n, 0x00, length - n);
+}
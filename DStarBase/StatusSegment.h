@@ -0,0 +1,124 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "DStarDefines.h"
+#include "LinkQuality.h"
+
+// Layout of the gateway status shared memory segment. The gateway is the only writer and rewrites
+// SStatusData in place under a sequence lock, readers map the segment read only and retry their
+// copy whenever the sequence number was odd or changed while they were copying.
+// Bump STATUS_SEGMENT_VERSION on any layout change.
+
+const uint32_t STATUS_SEGMENT_MAGIC   = 0x53574744U;	// "DGWS"
+const uint32_t STATUS_SEGMENT_VERSION = 2U;
+
+const unsigned int STATUS_MAX_REPEATERS     = 8U;
+const unsigned int STATUS_MAX_LINKS         = 16U;
+const unsigned int STATUS_CALLSIGN_LENGTH   = LONG_CALLSIGN_LENGTH + 1U;
+const unsigned int STATUS_DONGLES_LENGTH    = 256U;
+const unsigned int STATUS_READ_RETRIES      = 1000U;
+
+struct SStatusLink {
+	char         callsign[STATUS_CALLSIGN_LENGTH];
+	uint8_t      protocol;			// PROTOCOL
+	uint8_t      linked;
+	uint8_t      direction;			// DIRECTION
+	uint8_t      dongle;
+	TLinkQuality quality;			// Frames received over the link
+};
+
+struct SStatusRepeater {
+	char        callsign[STATUS_CALLSIGN_LENGTH];
+	char        linkCallsign[STATUS_CALLSIGN_LENGTH];
+	char        reflector[STATUS_CALLSIGN_LENGTH];
+	char        lastHeard[STATUS_CALLSIGN_LENGTH];
+	int32_t     linkStatus;		// LINK_STATUS
+	int32_t     reconnect;		// RECONNECT
+	uint32_t    heardCount;
+	uint32_t    linkCount;
+	SStatusLink links[STATUS_MAX_LINKS];
+};
+
+struct SStatusTraffic {
+	uint64_t repeaterFrames;
+	uint64_t dextraFrames;
+	uint64_t dplusFrames;
+	uint64_t dcsFrames;
+	uint64_t g2Frames;
+	uint64_t ddFrames;
+};
+
+struct SStatusData {
+	uint64_t        updated;		// Milliseconds since the epoch
+	char            gateway[STATUS_CALLSIGN_LENGTH];
+	int32_t         ircDDBStatus;	// IRCDDB_STATUS
+	uint32_t        userCacheCount;
+	uint32_t        repeaterCacheCount;
+	uint32_t        gatewayCacheCount;
+	SStatusTraffic  traffic;
+	TLinkQuality    g2Quality;		// Every G2 stream, they have no lasting link
+	char            dongles[STATUS_DONGLES_LENGTH];
+	uint32_t        repeaterCount;
+	SStatusRepeater repeaters[STATUS_MAX_REPEATERS];
+};
+
+struct SStatusSegment {
+	uint32_t              magic;
+	uint32_t              version;
+	uint32_t              size;
+	std::atomic<uint32_t> running;
+	std::atomic<uint32_t> sequence;
+	SStatusData           data;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The status segment needs lock free atomics to be shared between processes");
+
+class CStatusSegment {
+public:
+	CStatusSegment(const std::string& name);
+	~CStatusSegment();
+
+	// Writer side, used by the gateway
+	bool create();
+	void write(const SStatusData& data);
+
+	// Reader side
+	bool open();
+	bool read(SStatusData& data) const;
+	bool isRunning() const;
+
+	void close();
+
+	bool isOpen() const;
+
+	static void setString(char* dest, unsigned int length, const std::string& src);
+
+private:
+	CStatusSegment(const CStatusSegment&) = delete;
+	CStatusSegment& operator=(const CStatusSegment&) = delete;
+
+	std::string     m_name;
+	SStatusSegment* m_segment;
+	bool            m_writer;
+};
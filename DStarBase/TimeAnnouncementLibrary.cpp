@@ -0,0 +1,161 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "TimeAnnouncementLibrary.h"
+#include "Log.h"
+
+CTimeAnnouncementLibrary::CTimeAnnouncementLibrary(const std::string& tag) :
+m_tag(tag),
+m_slots(MINUTES_PER_DAY),
+m_count(0U)
+{
+}
+
+const std::vector<unsigned char>* CTimeAnnouncementLibrary::find(unsigned int hour, unsigned int min) const
+{
+	assert(hour < 24U && min < 60U);
+
+	const std::vector<unsigned char>& slot = m_slots[hour * 60U + min];
+
+	return slot.empty() ? nullptr : &slot;
+}
+
+void CTimeAnnouncementLibrary::insert(unsigned int hour, unsigned int min, const std::vector<unsigned char>& frames)
+{
+	assert(hour < 24U && min < 60U);
+	assert(!frames.empty());
+
+	std::vector<unsigned char>& slot = m_slots[hour * 60U + min];
+	if (slot.empty())
+		m_count++;
+
+	slot = frames;
+}
+
+void CTimeAnnouncementLibrary::clear()
+{
+	for (auto& slot : m_slots)
+		slot.clear();
+
+	m_count = 0U;
+}
+
+unsigned int CTimeAnnouncementLibrary::size() const
+{
+	return m_count;
+}
+
+const std::string& CTimeAnnouncementLibrary::getTag() const
+{
+	return m_tag;
+}
+
+bool CTimeAnnouncementLibrary::load(const std::string& fileName)
+{
+	FILE* file = ::fopen(fileName.c_str(), "rb");
+	if (file == nullptr)
+		return false;
+
+	std::vector<std::vector<unsigned char>> slots(MINUTES_PER_DAY);
+	unsigned int count = 0U;
+
+	TTimeAnnouncementHeader header;
+	bool ok = ::fread(&header, sizeof(header), 1U, file) == 1U;
+	ok = ok && ::memcmp(header.m_magic, TIME_ANNOUNCEMENT_MAGIC, 4U) == 0 && header.m_version == TIME_ANNOUNCEMENT_VERSION;
+	ok = ok && header.m_tagLength == m_tag.length() && header.m_entryCount <= MINUTES_PER_DAY;
+
+	if (ok) {
+		std::string tag(header.m_tagLength, ' ');
+		ok = (header.m_tagLength == 0U || ::fread(&tag[0], 1U, header.m_tagLength, file) == header.m_tagLength) && tag == m_tag;
+	}
+
+	for (uint32_t i = 0U; ok && i < header.m_entryCount; i++) {
+		TTimeAnnouncementEntry entry;
+		ok = ::fread(&entry, sizeof(entry), 1U, file) == 1U;
+		ok = ok && entry.m_minute < MINUTES_PER_DAY && entry.m_length > 0U && slots[entry.m_minute].empty();
+
+		// Nothing real comes anywhere near a megabyte, a bigger length means the file is damaged
+		ok = ok && entry.m_length <= 1024U * 1024U;
+		if (ok) {
+			slots[entry.m_minute].resize(entry.m_length);
+			ok = ::fread(slots[entry.m_minute].data(), 1U, entry.m_length, file) == entry.m_length;
+			count++;
+		}
+	}
+
+	::fclose(file);
+
+	if (!ok) {
+		LogInfo("%s is out of date or damaged, ignoring it\n", fileName.c_str());
+		return false;
+	}
+
+	m_slots.swap(slots);
+	m_count = count;
+
+	LogInfo("Loaded %u time announcements from %s\n", m_count, fileName.c_str());
+
+	return true;
+}
+
+bool CTimeAnnouncementLibrary::save(const std::string& fileName) const
+{
+	std::string tempFile = fileName + ".tmp";
+
+	FILE* file = ::fopen(tempFile.c_str(), "wb");
+	if (file == nullptr) {
+		LogDebug("Cannot create %s\n", tempFile.c_str());
+		return false;
+	}
+
+	TTimeAnnouncementHeader header;
+	::memcpy(header.m_magic, TIME_ANNOUNCEMENT_MAGIC, 4U);
+	header.m_version    = TIME_ANNOUNCEMENT_VERSION;
+	header.m_tagLength  = uint32_t(m_tag.length());
+	header.m_entryCount = m_count;
+
+	bool ok = ::fwrite(&header, sizeof(header), 1U, file) == 1U;
+	ok = ok && ::fwrite(m_tag.data(), 1U, m_tag.length(), file) == m_tag.length();
+
+	for (unsigned int i = 0U; ok && i < MINUTES_PER_DAY; i++) {
+		if (m_slots[i].empty())
+			continue;
+
+		TTimeAnnouncementEntry entry;
+		entry.m_minute = i;
+		entry.m_length = uint32_t(m_slots[i].size());
+
+		ok = ::fwrite(&entry, sizeof(entry), 1U, file) == 1U;
+		ok = ok && ::fwrite(m_slots[i].data(), 1U, m_slots[i].size(), file) == m_slots[i].size();
+	}
+
+	ok = (::fclose(file) == 0) && ok;
+
+	if (!ok || ::rename(tempFile.c_str(), fileName.c_str()) != 0) {
+		LogDebug("Cannot write %s\n", fileName.c_str());
+		::remove(tempFile.c_str());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,67 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const unsigned int MINUTES_PER_DAY = 24U * 60U;
+
+// Saved file: header, then for every rendered minute its TTimeAnnouncementEntry followed by the frames
+const char     TIME_ANNOUNCEMENT_MAGIC[] = "TIMA";
+const uint32_t TIME_ANNOUNCEMENT_VERSION = 1U;
+
+struct TTimeAnnouncementHeader {
+	char     m_magic[4U];
+	uint32_t m_version;
+	uint32_t m_tagLength;			// Followed by the tag itself
+	uint32_t m_entryCount;
+};
+
+struct TTimeAnnouncementEntry {
+	uint32_t m_minute;				// Minute of the day
+	uint32_t m_length;				// In bytes
+};
+
+// Fully rendered time announcements, one slot per minute of the day. An announcement only depends on
+// the time and on the settings summed up by the tag (callsign, language, format, voice files), so once
+// rendered it can be replayed as is, and it stays valid across restarts as long as the tag matches.
+class CTimeAnnouncementLibrary {
+public:
+	CTimeAnnouncementLibrary(const std::string& tag);
+
+	// nullptr when that minute has not been rendered yet
+	const std::vector<unsigned char>* find(unsigned int hour, unsigned int min) const;
+	void insert(unsigned int hour, unsigned int min, const std::vector<unsigned char>& frames);
+	void clear();
+
+	unsigned int size() const;
+	const std::string& getTag() const;
+
+	// Loading a file written with another tag, or a damaged one, leaves the library untouched
+	bool load(const std::string& fileName);
+	bool save(const std::string& fileName) const;
+
+private:
+	std::string                             m_tag;
+	std::vector<std::vector<unsigned char>> m_slots;
+	unsigned int                            m_count;
+};
@@ -0,0 +1,168 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cassert>
+#include <chrono>
+
+#include "VoiceStats.h"
+#include "DStarDefines.h"
+
+// A frame is late when it leaves more than one frame time after it arrived
+const uint64_t LATE_FRAME_US = DSTAR_FRAME_TIME_MS * 1000U;
+
+struct TVoiceCounters {
+	std::atomic<uint64_t> counters[CVoiceStats::VC_LATE + 1U];
+	CLatencyHistogram     decode;
+	CLatencyHistogram     route;
+	CLatencyHistogram     write;
+	CLatencyHistogram     total;
+};
+
+std::atomic<bool> CVoiceStats::m_enabled(false);
+
+static TVoiceCounters m_counters[VOICE_PROTOCOLS];
+
+static uint32_t elapsed(uint64_t from, uint64_t to)
+{
+	if (to <= from)
+		return 0U;
+
+	uint64_t us = to - from;
+
+	return us > UINT32_MAX ? UINT32_MAX : uint32_t(us);
+}
+
+void CVoiceStats::setEnabled(bool enabled)
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void CVoiceStats::reset(TVoiceTiming& timing)
+{
+	timing.source   = VP_NONE;
+	timing.received = 0U;
+	timing.decoded  = 0U;
+	timing.routed   = 0U;
+}
+
+void CVoiceStats::snapshot(VOICE_PROTOCOL protocol, TVoiceSnapshot& snapshot)
+{
+	assert(protocol < VOICE_PROTOCOLS);
+
+	const TVoiceCounters& counters = m_counters[protocol];
+
+	snapshot.framesIn      = counters.counters[VC_FRAMES_IN].load(std::memory_order_relaxed);
+	snapshot.framesOut     = counters.counters[VC_FRAMES_OUT].load(std::memory_order_relaxed);
+	snapshot.drops         = counters.counters[VC_DROPS].load(std::memory_order_relaxed);
+	snapshot.headerRepeats = counters.counters[VC_HEADER_REPEATS].load(std::memory_order_relaxed);
+	snapshot.late          = counters.counters[VC_LATE].load(std::memory_order_relaxed);
+
+	counters.decode.snapshot(snapshot.decode);
+	counters.route.snapshot(snapshot.route);
+	counters.write.snapshot(snapshot.write);
+	counters.total.snapshot(snapshot.total);
+}
+
+void CVoiceStats::subtract(TVoiceSnapshot& later, const TVoiceSnapshot& earlier)
+{
+	later.framesIn      -= earlier.framesIn;
+	later.framesOut     -= earlier.framesOut;
+	later.drops         -= earlier.drops;
+	later.headerRepeats -= earlier.headerRepeats;
+	later.late          -= earlier.late;
+
+	later.decode.subtract(earlier.decode);
+	later.route.subtract(earlier.route);
+	later.write.subtract(earlier.write);
+	later.total.subtract(earlier.total);
+}
+
+const char* CVoiceStats::getName(VOICE_PROTOCOL protocol)
+{
+	switch (protocol) {
+		case VP_HB:     return "HB";
+		case VP_ICOM:   return "Icom";
+		case VP_DEXTRA: return "DExtra";
+		case VP_DPLUS:  return "DPlus";
+		case VP_DCS:    return "DCS";
+		case VP_G2:     return "G2";
+		default:        return "None";
+	}
+}
+
+uint64_t CVoiceStats::now()
+{
+	return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void CVoiceStats::decodedInt(TVoiceTiming& timing, VOICE_PROTOCOL protocol, uint64_t received)
+{
+	assert(protocol < VOICE_PROTOCOLS);
+
+	timing.source   = protocol;
+	timing.received = received;
+	timing.decoded  = now();
+	timing.routed   = 0U;
+
+	TVoiceCounters& counters = m_counters[protocol];
+	counters.counters[VC_FRAMES_IN].fetch_add(1U, std::memory_order_relaxed);
+	counters.decode.record(elapsed(timing.received, timing.decoded));
+}
+
+void CVoiceStats::routedInt(TVoiceTiming& timing)
+{
+	assert(timing.source < VOICE_PROTOCOLS);
+
+	// A frame going to several repeaters keeps its first routing time
+	if (timing.routed != 0U)
+		return;
+
+	timing.routed = now();
+
+	m_counters[timing.source].route.record(elapsed(timing.decoded, timing.routed));
+}
+
+void CVoiceStats::writtenInt(const TVoiceTiming& timing, VOICE_PROTOCOL protocol)
+{
+	assert(protocol < VOICE_PROTOCOLS);
+
+	TVoiceCounters& counters = m_counters[protocol];
+	counters.counters[VC_FRAMES_OUT].fetch_add(1U, std::memory_order_relaxed);
+
+	// Frames made in the gateway, such as announcements, have no receive time
+	if (timing.received == 0U)
+		return;
+
+	uint64_t written = now();
+
+	if (timing.routed != 0U)
+		counters.write.record(elapsed(timing.routed, written));
+
+	uint32_t total = elapsed(timing.received, written);
+	counters.total.record(total);
+
+	if (total > LATE_FRAME_US)
+		counters.counters[VC_LATE].fetch_add(1U, std::memory_order_relaxed);
+}
+
+void CVoiceStats::count(VOICE_PROTOCOL protocol, VOICE_COUNTER type)
+{
+	assert(protocol < VOICE_PROTOCOLS);
+
+	m_counters[protocol].counters[type].fetch_add(1U, std::memory_order_relaxed);
+}
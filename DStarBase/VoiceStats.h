@@ -0,0 +1,139 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "LatencyHistogram.h"
+
+enum VOICE_PROTOCOL {
+	VP_NONE,
+	VP_HB,
+	VP_ICOM,
+	VP_DEXTRA,
+	VP_DPLUS,
+	VP_DCS,
+	VP_G2
+};
+
+const unsigned int VOICE_PROTOCOLS = VP_G2 + 1U;
+
+// How far a frame has got through the gateway, in microseconds of the monotonic clock.
+// A stage it has not been through, or every stage while statistics are off, is zero.
+struct TVoiceTiming {
+	VOICE_PROTOCOL source;
+	uint64_t       received;
+	uint64_t       decoded;
+	uint64_t       routed;
+};
+
+// Decode and route are measured on frames received from the protocol, write and total on frames
+// sent to it. Total runs from the receive on the source socket to the write on this one.
+struct TVoiceSnapshot {
+	uint64_t         framesIn;
+	uint64_t         framesOut;
+	uint64_t         drops;
+	uint64_t         headerRepeats;
+	uint64_t         late;
+	CLatencySnapshot decode;
+	CLatencySnapshot route;
+	CLatencySnapshot write;
+	CLatencySnapshot total;
+};
+
+// Gateway wide counters and stage latency histograms for the voice path. Every hook is a
+// relaxed load and a branch while statistics are off.
+class CVoiceStats {
+public:
+	enum VOICE_COUNTER {
+		VC_FRAMES_IN,
+		VC_FRAMES_OUT,
+		VC_DROPS,
+		VC_HEADER_REPEATS,
+		VC_LATE
+	};
+
+	static void setEnabled(bool enabled);
+	static bool isEnabled()
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	// Taken as the packet comes off the socket
+	static uint64_t stamp()
+	{
+		return isEnabled() ? now() : 0U;
+	}
+
+	// The packet stamped at received has been decoded into a frame from the protocol
+	static void decoded(TVoiceTiming& timing, VOICE_PROTOCOL protocol, uint64_t received)
+	{
+		if (received != 0U)
+			decodedInt(timing, protocol, received);
+	}
+
+	// The frame has reached the repeater handler
+	static void routed(TVoiceTiming& timing)
+	{
+		if (timing.decoded != 0U)
+			routedInt(timing);
+	}
+
+	// The frame has been handed to the protocol's socket
+	static void written(const TVoiceTiming& timing, VOICE_PROTOCOL protocol)
+	{
+		if (isEnabled())
+			writtenInt(timing, protocol);
+	}
+
+	// A packet that could not be decoded or had nowhere to go
+	static void dropped(VOICE_PROTOCOL protocol)
+	{
+		if (isEnabled())
+			count(protocol, VC_DROPS);
+	}
+
+	// A header for a stream that is already being relayed
+	static void headerRepeat(VOICE_PROTOCOL protocol)
+	{
+		if (isEnabled())
+			count(protocol, VC_HEADER_REPEATS);
+	}
+
+	// For frames sent again later from a stored copy, which would otherwise count the wait
+	static void reset(TVoiceTiming& timing);
+
+	static void snapshot(VOICE_PROTOCOL protocol, TVoiceSnapshot& snapshot);
+
+	// Leaves what happened between the earlier snapshot and the later one
+	static void subtract(TVoiceSnapshot& later, const TVoiceSnapshot& earlier);
+
+	static const char* getName(VOICE_PROTOCOL protocol);
+
+	static uint64_t now();
+
+private:
+	static std::atomic<bool> m_enabled;
+
+	static void decodedInt(TVoiceTiming& timing, VOICE_PROTOCOL protocol, uint64_t received);
+	static void routedInt(TVoiceTiming& timing);
+	static void writtenInt(const TVoiceTiming& timing, VOICE_PROTOCOL protocol);
+	static void count(VOICE_PROTOCOL protocol, VOICE_COUNTER type);
+};
@@ -47,6 +47,7 @@
 #include "APRSISHandlerThread.h"
 #include "DummyAPRSHandlerThread.h"
 #include "HostsFilesManager.h"
+#include "VoiceStats.h"
 
 // In Log.cpp
 extern CMQTTConnection* m_mqtt;
@@ -120,6 +121,16 @@ int main(int argc, char *argv[])
 
 	LogInitialise(logConf.displayLevel, logConf.mqttLevel);
 
+	// Thread scheduling, before any thread is started
+	TThreads threadsConf;
+	config->getThreads(threadsConf);
+
+	for (const auto& setting : threadsConf.settings)
+		CThread::setSettings(setting.first, setting.second);
+
+	if (threadsConf.lockMemory)
+		CThread::lockMemory();
+
 	// Setup MQTT
 	TMQTT mqttConf;
 	config->getMQTT(mqttConf);
@@ -129,6 +140,10 @@ int main(int argc, char *argv[])
 	//	subscriptions.push_back(std::make_pair("command", CDStarGatewayApp::onCommand));
 
 	m_mqtt = new CMQTTConnection(mqttConf.address, mqttConf.port, mqttConf.name, mqttConf.authenticate, mqttConf.username, mqttConf.password, subscriptions, mqttConf.keepalive);
+	m_mqtt->setTopicPolicy("log", MQTT_QUEUE_POLICY::DROP_OLDEST, 200U);
+	// Not coalesced, status snapshots share this topic with link and stream events that must all be delivered
+	m_mqtt->setTopicPolicy("json", MQTT_QUEUE_POLICY::DROP_OLDEST, 100U);
+	m_mqtt->setTopicPolicy("aprs-gateway/aprs", MQTT_QUEUE_POLICY::DROP_NEWEST, 50U);
 	bool ret = m_mqtt->open();
 	if (!ret)
 		return 1;
@@ -279,7 +294,7 @@ bool CDStarGatewayApp::createThread()
 		LogDebug("Adding repeaters - CDStarGatewayApp::createThread - Rpt Idx %i - Thread ID %s", i, THREAD_ID_STR(std::this_thread::get_id()));
 		TRepeater rptrConfig;
 		m_config->getRepeater(i, rptrConfig);
-		auto  repeaterProtocolHandler = repeaterProtocolFactory.getRepeaterProtocolHandler(rptrConfig.hwType, generalConfig, rptrConfig.address, rptrConfig.port);
+		auto  repeaterProtocolHandler = repeaterProtocolFactory.getRepeaterProtocolHandler(rptrConfig.hwType, generalConfig, rptrConfig.address, rptrConfig.port, m_thread->getNetworkReader());
 		if(repeaterProtocolHandler == nullptr)
 			continue;
 		atLeastOneRepeater = true;
@@ -390,12 +405,26 @@ bool CDStarGatewayApp::createThread()
 	LogInfo("Remote enabled: %d, port %u", int(remoteConfig.enabled), remoteConfig.port);
 	m_thread->setRemote(remoteConfig.enabled, remoteConfig.password, remoteConfig.port);
 
+	// Setup status segment
+	TStatusSegment statusSegmentConfig;
+	m_config->getStatusSegment(statusSegmentConfig);
+	LogInfo("Status segment enabled: %d, name %s", int(statusSegmentConfig.enabled), statusSegmentConfig.name.c_str());
+	m_thread->setStatusSegment(statusSegmentConfig.enabled, statusSegmentConfig.name);
+
+	// Setup voice statistics
+	TVoiceStatistics voiceStatisticsConfig;
+	m_config->getVoiceStatistics(voiceStatisticsConfig);
+	LogInfo("Voice statistics enabled: %d, interval %us", int(voiceStatisticsConfig.enabled), voiceStatisticsConfig.interval);
+	CVoiceStats::setEnabled(voiceStatisticsConfig.enabled);
+	m_thread->setVoiceStatistics(voiceStatisticsConfig.enabled, voiceStatisticsConfig.interval);
+
 	// Get final things ready
 	m_thread->setIcomRepeaterHandler(repeaterProtocolFactory.getIcomProtocolHandler());
 	m_thread->setHBRepeaterHandler(repeaterProtocolFactory.getHBProtocolHandler());
 	m_thread->setDummyRepeaterHandler(repeaterProtocolFactory.getDummyProtocolHandler());
 	m_thread->setInfoEnabled(true);
 	m_thread->setEchoEnabled(true);
+	m_thread->setEchoMemory(generalConfig.echoMemory);
 	m_thread->setDTMFEnabled(true);
 	m_thread->setLog(true, log.logIRCDDBTraffic);
 
@@ -21,10 +21,13 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <sched.h>
+#include <boost/algorithm/string.hpp>
 
 #include "Utils.h"
 #include "DStarGatewayConfig.h"
 #include "DStarDefines.h"
+#include "IcomSendWindow.h"
 #include "Log.h"
 #include "StringUtils.h"
 
@@ -79,6 +82,9 @@ bool CDStarGatewayConfig::load()
 		ret = loadDaemon(cfg) && ret;
 		ret = loadAccessControl(cfg) && ret;
 		ret = loadDRats(cfg) && ret;
+		ret = loadStatusSegment(cfg) && ret;
+		ret = loadVoiceStatistics(cfg) && ret;
+		ret = loadThreads(cfg) && ret;
 	}
 
 	if (ret) {
@@ -243,7 +249,7 @@ bool CDStarGatewayConfig::loadRepeaters(const CConfig& cfg)
 		ret = cfg.getValue(section, "ReflectorAtStartup", repeater->reflectorAtStartup, !repeater->reflector.empty()) && ret;
 
 		std::string reconnect;
-		ret = cfg.getValue(section, "ReflectorReconnect", reconnect, "Mever", {"Never", "Fixed", "5", "10", "15", "20", "25", "30", "60", "90", "120", "180"}) && ret;
+		ret = cfg.getValue(section, "ReflectorReconnect", reconnect, "Never", {"Never", "Fixed", "5", "10", "15", "20", "25", "30", "60", "90", "120", "180"}) && ret;
 		if(ret) {
 			if (reconnect == "Never")		repeater->reflectorReconnect = RECONNECT_NEVER;
 			else if(reconnect == "5")		repeater->reflectorReconnect = RECONNECT_5MINS;
@@ -319,11 +325,13 @@ bool CDStarGatewayConfig::loadGeneral(const CConfig& cfg)
 	ret = cfg.getValue("General", "HBPort", m_general.hbPort, 1U, 65535U, 20010U) && ret;
 	ret = cfg.getValue("General", "IcomAddress", m_general.icomAddress, 0, 20, "127.0.0.1") && ret;
 	ret = cfg.getValue("General", "IcomPort", m_general.icomPort, 1U, 65535U, 20000U) && ret;
+	ret = cfg.getValue("General", "IcomWindow", m_general.icomWindow, 1U, ICOM_MAX_WINDOW_SIZE, ICOM_WINDOW_SIZE) && ret;
 	ret = cfg.getValue("General", "Latitude", m_general.latitude, -90.0, 90.0, 0.0) && ret;
 	ret = cfg.getValue("General", "Longitude", m_general.longitude, -180.0, 180.0, 0.0) && ret;
 	ret = cfg.getValue("General", "Description1", m_general.description1, 0, 1024, "") && ret;
 	ret = cfg.getValue("General", "Description2", m_general.description2, 0, 1024, "") && ret;
 	ret = cfg.getValue("General", "URL", m_general.url, 0, 1024, "") && ret;
+	ret = cfg.getValue("General", "EchoMemory", m_general.echoMemory, 16U, 65536U, 256U) && ret;
 	
 	std::string type;
 	ret = cfg.getValue("General", "Type", type, "Repeater", {"Repeater", "Hotspot"}) && ret;
@@ -383,6 +391,78 @@ bool CDStarGatewayConfig::loadDRats(const CConfig& cfg)
 	return ret;
 }
 
+bool CDStarGatewayConfig::loadStatusSegment(const CConfig& cfg)
+{
+	bool ret = cfg.getValue("Status Segment", "Enabled", m_statusSegment.enabled, false);
+	ret = cfg.getValue("Status Segment", "Name", m_statusSegment.name, 1, 255, "/dstargateway") && ret;
+
+	return ret;
+}
+
+bool CDStarGatewayConfig::loadVoiceStatistics(const CConfig& cfg)
+{
+	bool ret = cfg.getValue("Voice Statistics", "Enabled", m_voiceStatistics.enabled, false);
+	ret = cfg.getValue("Voice Statistics", "Interval", m_voiceStatistics.interval, 10U, 3600U, 60U) && ret;
+
+	return ret;
+}
+
+bool CDStarGatewayConfig::loadThreads(const CConfig& cfg)
+{
+	// Every thread of the gateway that can be given its own [Thread <role>] section
+	const std::vector<std::string> roles = { "Gateway", "Network", "Icom", "APRS", "DRats", "DPlus", "IRCDDB Client", "IRCDDB App", "MQTT" };
+
+	bool ret = cfg.getValue("Threads", "LockMemory", m_threads.lockMemory, false);
+
+	m_threads.settings.clear();
+
+	for (const std::string& role : roles) {
+		std::string section = "Thread " + role;
+
+		TThreadSettings settings;
+		std::string policy;
+		ret = cfg.getValue(section, "Policy", policy, "Other", {"Other", "FIFO", "RR"}) && ret;
+		if (policy == "FIFO")		settings.policy = TP_FIFO;
+		else if (policy == "RR")	settings.policy = TP_RR;
+		else						settings.policy = TP_OTHER;
+
+		ret = cfg.getValue(section, "Priority", settings.priority, 1U, 99U, 1U) && ret;
+
+		std::string cpus;
+		ret = cfg.getValue(section, "CPUs", cpus, 0U, 255U, "") && ret;
+
+		std::stringstream stream(cpus);
+		std::string cpu;
+		while (std::getline(stream, cpu, ',')) {
+			boost::trim(cpu);
+			if (cpu.empty())
+				continue;
+
+			if (cpu.find_first_not_of("0123456789") != std::string::npos || cpu.length() > 4U) {
+				LogError("Configuration error: %s.CPUs has an invalid CPU number (%s)", section.c_str(), cpu.c_str());
+				ret = false;
+				continue;
+			}
+
+			unsigned int number = std::stoul(cpu);
+#if defined(CPU_SETSIZE)
+			if (number >= CPU_SETSIZE) {
+				LogError("Configuration error: %s.CPUs has a CPU number out of range (%u), the highest is %d", section.c_str(), number, CPU_SETSIZE - 1);
+				ret = false;
+				continue;
+			}
+#endif
+
+			settings.cpus.push_back(number);
+		}
+
+		if (settings.policy != TP_OTHER || !settings.cpus.empty())
+			m_threads.settings[role] = settings;
+	}
+
+	return ret;
+}
+
 bool CDStarGatewayConfig::open(CConfig& cfg)
 {
 	try {
@@ -505,3 +585,18 @@ void CDStarGatewayConfig::getDRats(TDRats& drats) const
 {
 	drats = m_drats;
 }
+
+void CDStarGatewayConfig::getStatusSegment(TStatusSegment& statusSegment) const
+{
+	statusSegment = m_statusSegment;
+}
+
+void CDStarGatewayConfig::getVoiceStatistics(TVoiceStatistics& voiceStatistics) const
+{
+	voiceStatistics = m_voiceStatistics;
+}
+
+void CDStarGatewayConfig::getThreads(TThreads& threads) const
+{
+	threads = m_threads;
+}
@@ -18,11 +18,13 @@
  */
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
 #include "Defs.h"
 #include "Config.h"
+#include "Thread.h"
 
 struct TDaemon {
 	bool daemon;
@@ -38,12 +40,14 @@ struct TGeneral {
 	unsigned int hbPort;
 	std::string icomAddress;
 	unsigned int icomPort;
+	unsigned int icomWindow;
 	double latitude;
 	double longitude;
 	std::string description1;
 	std::string description2;
 	std::string url; 
 	TEXT_LANG language;
+	unsigned int echoMemory;
 };
 
 struct TRepeater {
@@ -138,6 +142,21 @@ struct TRemote {
 	std::string  password;
 };
 
+struct TStatusSegment {
+	bool        enabled;
+	std::string name;
+};
+
+struct TVoiceStatistics {
+	bool         enabled;
+	unsigned int interval;
+};
+
+struct TThreads {
+	bool                                   lockMemory;
+	std::map<std::string, TThreadSettings> settings;
+};
+
 #ifdef USE_GPSD
 struct TGPSD {
 	std::string m_address;
@@ -178,6 +197,9 @@ public:
 	void getDaemon(TDaemon& gen) const;
 	void getAccessControl(TAccessControl& accessControl) const;
 	void getDRats(TDRats& drats) const;
+	void getStatusSegment(TStatusSegment& statusSegment) const;
+	void getVoiceStatistics(TVoiceStatistics& voiceStatistics) const;
+	void getThreads(TThreads& threads) const;
 
 private:
 	bool open(CConfig& cfg);
@@ -200,6 +222,9 @@ private:
 	bool loadDaemon(const CConfig& cfg);
 	bool loadAccessControl(const CConfig& cfg);
 	bool loadDRats(const CConfig& cfg);
+	bool loadStatusSegment(const CConfig& cfg);
+	bool loadVoiceStatistics(const CConfig& cfg);
+	bool loadThreads(const CConfig& cfg);
 
 	std::string             m_fileName;
 	TGeneral                m_general;
@@ -219,6 +244,9 @@ private:
 	TDaemon                 m_daemon;
 	TAccessControl          m_accessControl;
 	TDRats                  m_drats;
+	TStatusSegment          m_statusSegment;
+	TVoiceStatistics        m_voiceStatistics;
+	TThreads                m_threads;
 
 	std::vector<TRepeater*> m_repeaters;
 	std::vector<TircDDB*>   m_ircDDB;
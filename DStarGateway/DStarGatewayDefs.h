@@ -44,4 +44,4 @@ const unsigned int MAX_DPLUS_LINKS    = 5U;
 const unsigned int MAX_DCS_LINKS      = 5U;
 const unsigned int MAX_STARNETS       = 5U;
 const unsigned int MAX_ROUTES         = MAX_REPEATERS + 5U;
-const unsigned int MAX_DD_ROUTES      = 20U;
+const unsigned int MAX_DD_ROUTES      = 256U;
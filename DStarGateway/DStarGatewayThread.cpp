@@ -20,6 +20,7 @@
 
 #include <arpa/inet.h>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 
@@ -47,17 +48,21 @@
 #include "PollData.h"
 #include "AMBEData.h"
 #include "CCSData.h"
+#include "VoiceStats.h"
 #include "DDData.h"
 #include "Utils.h"
 #include "Defs.h"
 #include "Log.h"
 #include "StringUtils.h"
 #include "HostsFilesManager.h"
+#include "UDPReaderWriter.h"
 
 const std::string LOOPBACK_ADDRESS("127.0.0.1");
 
 const unsigned int REMOTE_DUMMY_PORT = 65016U;
 
+const unsigned int STATUS_SEGMENT_INTERVAL_MS = 250U;
+
 CDStarGatewayThread::CDStarGatewayThread(const std::string& dataDir, const std::string& name) :
 CThread("Gateway"),
 m_dataDir(dataDir),
@@ -90,6 +95,7 @@ m_ccsEnabled(true),
 m_ccsHost(),
 m_infoEnabled(true),
 m_echoEnabled(true),
+m_echoMemory(256U),
 m_dtmfEnabled(true),
 m_logEnabled(false),
 m_logIRCDDB(false),
@@ -101,6 +107,17 @@ m_remotePassword(),
 m_remotePort(0U),
 m_remote(NULL),
 m_statusFileTimer(1000U, 2U * 60U),		// 2 minutes
+m_statusSegmentEnabled(false),
+m_statusSegmentName(),
+m_statusSegment(nullptr),
+m_statusSegmentTimer(1000U, 0U, STATUS_SEGMENT_INTERVAL_MS),
+m_voiceStatsEnabled(false),
+m_voiceStatsTimer(1000U),
+m_voiceStats(),
+m_voiceJSON(),
+m_traffic(),
+m_networkReader(),
+m_networkReaderStarted(false),
 m_status1(),
 m_status2(),
 m_status3(),
@@ -125,6 +142,8 @@ m_restrictList(nullptr)
 	CCCSHandler::initialise(MAX_REPEATERS);
 #endif
 	CAudioUnit::initialise();
+
+	m_networkReaderStarted = m_networkReader.start();
 }
 
 CDStarGatewayThread::~CDStarGatewayThread()
@@ -138,7 +157,7 @@ void* CDStarGatewayThread::Entry()
 	CHostsFilesManager::UpdateHosts(); 
 
 	std::string dextraAddress = m_dextraEnabled ? m_gatewayAddress : LOOPBACK_ADDRESS;
-	m_dextraPool = new CDExtraProtocolHandlerPool(DEXTRA_PORT, dextraAddress);
+	m_dextraPool = new CDExtraProtocolHandlerPool(DEXTRA_PORT, dextraAddress, getNetworkReader());
 	// Allocate the incoming port
 	CDExtraProtocolHandler* dextraHandler = m_dextraPool->getIncomingHandler();
 	if(dextraHandler != NULL) {
@@ -150,7 +169,7 @@ void* CDStarGatewayThread::Entry()
 	}
 
 	std::string dplusAddress = m_dplusEnabled ? m_gatewayAddress : LOOPBACK_ADDRESS;
-	m_dplusPool = new CDPlusProtocolHandlerPool(DPLUS_PORT, dplusAddress);
+	m_dplusPool = new CDPlusProtocolHandlerPool(DPLUS_PORT, dplusAddress, getNetworkReader());
 	CDPlusProtocolHandler* dplusHandler = m_dplusPool->getIncomingHandler();
 	if(dplusHandler != NULL) {
 		CDPlusHandler::setDPlusProtocolIncoming(dplusHandler);
@@ -160,7 +179,7 @@ void* CDStarGatewayThread::Entry()
 	}
 
 	std::string dcsAddress = m_dcsEnabled ? m_gatewayAddress : LOOPBACK_ADDRESS;
-	m_dcsPool = new CDCSProtocolHandlerPool(DCS_PORT, dcsAddress);
+	m_dcsPool = new CDCSProtocolHandlerPool(DCS_PORT, dcsAddress, getNetworkReader());
 	CDCSProtocolHandler* dcsHandler = m_dcsPool->getIncomingHandler();
 	if(dcsHandler != NULL) {
 		CDCSHandler::setDCSProtocolIncoming(dcsHandler);
@@ -170,7 +189,7 @@ void* CDStarGatewayThread::Entry()
 	}
 
 	m_g2HandlerPool = new CG2ProtocolHandlerPool(G2_DV_PORT, m_gatewayAddress);
-	bool ret = m_g2HandlerPool->open();
+	bool ret = m_g2HandlerPool->open(getNetworkReader());
 	if (!ret) {
 		LogError("Could not open the G2 protocol handler");
 		delete m_g2HandlerPool;
@@ -216,6 +235,7 @@ void* CDStarGatewayThread::Entry()
 	CRepeaterHandler::setAPRSHandlers(m_outgoingAprsHandler, m_incomingAprsHandler);
 	CRepeaterHandler::setInfoEnabled(m_infoEnabled);
 	CRepeaterHandler::setEchoEnabled(m_echoEnabled);
+	CEchoUnit::initialise(m_echoMemory * 1024U);
 	CRepeaterHandler::setDTMFEnabled(m_dtmfEnabled);
 	if (m_whiteList != NULL) {
 		CDExtraHandler::setWhiteList(m_whiteList);
@@ -262,13 +282,22 @@ void* CDStarGatewayThread::Entry()
 
 	if (m_remoteEnabled && !m_remotePassword.empty() && m_remotePort > 0U) {
 		m_remote = new CRemoteHandler(m_remotePassword, m_remotePort, m_gatewayAddress);
-		bool res = m_remote->open();
+		bool res = m_remote->open(getNetworkReader());
 		if (!res) {
 			delete m_remote;
 			m_remote = NULL;
 		}
 	}
 
+	if (m_statusSegmentEnabled) {
+		m_statusSegment = new CStatusSegment(m_statusSegmentName);
+		bool res = m_statusSegment->create();
+		if (!res) {
+			delete m_statusSegment;
+			m_statusSegment = nullptr;
+		}
+	}
+
 	CRepeaterHandler::startup();
 
 #ifdef USE_CALLSIGN_SERVER
@@ -283,6 +312,14 @@ void* CDStarGatewayThread::Entry()
 
 	m_statusFileTimer.start();
 	m_statusTimer2.start();
+	m_statusSegmentTimer.start();
+
+	if (m_voiceStatsEnabled) {
+		for (unsigned int i = VP_HB; i < VOICE_PROTOCOLS; i++)
+			CVoiceStats::snapshot(VOICE_PROTOCOL(i), m_voiceStats[i]);
+
+		m_voiceStatsTimer.start();
+	}
 
 #ifndef DEBUG_DSTARGW
 	try {
@@ -314,8 +351,9 @@ void* CDStarGatewayThread::Entry()
 			if (m_remote != NULL)
 				m_remote->process();
 
+			// Only step the clock on by whole milliseconds, the loop now often goes round in less
 			unsigned long ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()- timePoint).count();
-			timePoint = std::chrono::steady_clock::now();
+			timePoint += std::chrono::milliseconds(ms);
 
 			CRepeaterHandler::clock(ms);
 			CG2Handler::clock(ms);
@@ -338,10 +376,27 @@ void* CDStarGatewayThread::Entry()
 				m_statusFileTimer.start();
 			}
 
+			if (m_statusSegment != nullptr) {
+				m_statusSegmentTimer.clock(ms);
+				if (m_statusSegmentTimer.hasExpired()) {
+					publishStatus();
+					m_statusSegmentTimer.start();
+				}
+			}
+
+			if (m_voiceStatsEnabled) {
+				m_voiceStatsTimer.clock(ms);
+				if (m_voiceStatsTimer.hasExpired()) {
+					publishVoiceStats();
+					m_voiceStatsTimer.start();
+				}
+			}
+
 			if (m_outgoingAprsHandler != NULL)
 				m_outgoingAprsHandler->clock(ms);
 
-			::std::this_thread::sleep_for(std::chrono::milliseconds(TIME_PER_TIC_MS));
+			// Go round again as soon as a datagram is queued, or after a tick when it is quiet
+			m_networkReader.wait(TIME_PER_TIC_MS);
 		}
 #ifndef DEBUG_DSTARGW
 	}
@@ -411,6 +466,11 @@ void* CDStarGatewayThread::Entry()
 		delete m_remote;
 	}
 
+	if (m_statusSegment != nullptr) {
+		m_statusSegment->close();
+		delete m_statusSegment;
+	}
+
 	if(m_outgoingAprsHandler != nullptr) {
 		m_outgoingAprsHandler->close();
 		delete m_outgoingAprsHandler;
@@ -429,6 +489,9 @@ void* CDStarGatewayThread::Entry()
 	CCCSHandler::finalise();
 #endif
 	CAudioUnit::finalise();
+	CEchoUnit::finalise();
+
+	m_networkReader.stop();
 
 	return NULL;
 }
@@ -589,6 +652,11 @@ void CDStarGatewayThread::setEchoEnabled(bool enabled)
 	m_echoEnabled = enabled;
 }
 
+void CDStarGatewayThread::setEchoMemory(unsigned int memory)
+{
+	m_echoMemory = memory;
+}
+
 void CDStarGatewayThread::setDTMFEnabled(bool enabled)
 {
 	m_dtmfEnabled = enabled;
@@ -618,6 +686,18 @@ void CDStarGatewayThread::setRemote(bool enabled, const std::string& password, u
 	}
 }
 
+void CDStarGatewayThread::setStatusSegment(bool enabled, const std::string& name)
+{
+	m_statusSegmentEnabled = enabled;
+	m_statusSegmentName    = name;
+}
+
+void CDStarGatewayThread::setVoiceStatistics(bool enabled, unsigned int interval)
+{
+	m_voiceStatsEnabled = enabled;
+	m_voiceStatsTimer.setTimeout(interval);
+}
+
 void CDStarGatewayThread::setWhiteList(CCallsignList* list)
 {
 	assert(list != NULL);
@@ -827,13 +907,16 @@ void CDStarGatewayThread::processRepeater(IRepeaterProtocolHandler* handler)
 			case RT_HEADER: {
 					CHeaderData* header = handler->readHeader();
 					if (header != NULL) {
+						m_traffic.repeaterFrames++;
 						// LogInfo("Repeater header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X", header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
 
 						CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(*header);
-						if (repeater == NULL)
+						if (repeater == NULL) {
 							LogInfo("Header received from unknown repeater, %s", header->getRptCall1().c_str());
-						else
+							CVoiceStats::dropped(header->getTiming().source);
+						} else {
 							repeater->processRepeater(*header);
+						}
 
 						delete header;
 					}
@@ -843,9 +926,12 @@ void CDStarGatewayThread::processRepeater(IRepeaterProtocolHandler* handler)
 			case RT_AMBE: {
 					CAMBEData* data = handler->readAMBE();
 					if (data != NULL) {
+						m_traffic.repeaterFrames++;
 						CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(*data, false);
 						if (repeater != NULL)
 							repeater->processRepeater(*data);
+						else
+							CVoiceStats::dropped(data->getTiming().source);
 
 						delete data;
 					}
@@ -855,6 +941,7 @@ void CDStarGatewayThread::processRepeater(IRepeaterProtocolHandler* handler)
 			case RT_BUSY_HEADER: {
 					CHeaderData* header = handler->readBusyHeader();
 					if (header != NULL) {
+						m_traffic.repeaterFrames++;
 						// LogInfo("Repeater busy header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X", header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
 
 						CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(*header);
@@ -871,6 +958,7 @@ void CDStarGatewayThread::processRepeater(IRepeaterProtocolHandler* handler)
 			case RT_BUSY_AMBE: {
 					CAMBEData* data = handler->readBusyAMBE();
 					if (data != NULL) {
+						m_traffic.repeaterFrames++;
 						CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(*data, true);
 						if (repeater != NULL)
 							repeater->processBusy(*data);
@@ -883,6 +971,7 @@ void CDStarGatewayThread::processRepeater(IRepeaterProtocolHandler* handler)
 			case RT_DD: {
 					CDDData* data = handler->readDD();
 					if (data != NULL) {
+						m_traffic.ddFrames++;
 						// LogInfo("DD header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X", data->getMyCall1().c_str(), data->getMyCall2().c_str(), data->getYourCall().c_str(), data->getRptCall1().c_str(), data->getRptCall2().c_str(), data->getFlag1(), data->getFlag2(), data->getFlag3());
 
 						CRepeaterHandler* repeater = CRepeaterHandler::findDDRepeater();
@@ -929,6 +1018,7 @@ void CDStarGatewayThread::processDExtra()
 			case DE_HEADER: {
 					CHeaderData* header = m_dextraPool->readHeader();
 					if (header != NULL) {
+						m_traffic.dextraFrames++;
 						// LogInfo("DExtra header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s", header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str());
 						CDExtraHandler::process(*header);
 						delete header;
@@ -939,6 +1029,7 @@ void CDStarGatewayThread::processDExtra()
 			case DE_AMBE: {
 					CAMBEData* data = m_dextraPool->readAMBE();
 					if (data != NULL) {
+						m_traffic.dextraFrames++;
 						CDExtraHandler::process(*data);
 						delete data;
 					}
@@ -978,6 +1069,7 @@ void CDStarGatewayThread::processDPlus()
 			case DP_HEADER: {
 					CHeaderData* header = m_dplusPool->readHeader();
 					if (header != NULL) {
+						m_traffic.dplusFrames++;
 						// LogInfo("D-Plus header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s", header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str());
 						CDPlusHandler::process(*header);
 						delete header;
@@ -988,6 +1080,7 @@ void CDStarGatewayThread::processDPlus()
 			case DP_AMBE: {
 					CAMBEData* data = m_dplusPool->readAMBE();
 					if (data != NULL) {
+						m_traffic.dplusFrames++;
 						CDPlusHandler::process(*data);
 						delete data;
 					}
@@ -1027,6 +1120,7 @@ void CDStarGatewayThread::processDCS()
 			case DC_DATA: {
 					CAMBEData* data = m_dcsPool->readData();
 					if (data != NULL) {
+						m_traffic.dcsFrames++;
 						// LogInfo("DCS header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s", header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str());
 						CDCSHandler::process(*data);
 						delete data;
@@ -1049,6 +1143,7 @@ void CDStarGatewayThread::processG2()
 			case GT_HEADER: {
 					CHeaderData* header = m_g2HandlerPool->readHeader();
 					if (header != NULL) {
+						m_traffic.g2Frames++;
 						LogDebug("G2 header - My: %s/%s  Your: %s  Rpt1: %s  Rpt2: %s  Flags: %02X %02X %02X", header->getMyCall1().c_str(), header->getMyCall2().c_str(), header->getYourCall().c_str(), header->getRptCall1().c_str(), header->getRptCall2().c_str(), header->getFlag1(), header->getFlag2(), header->getFlag3());
 						CG2Handler::process(*header);
 						delete header;
@@ -1059,6 +1154,7 @@ void CDStarGatewayThread::processG2()
 			case GT_AMBE: {
 					CAMBEData* data = m_g2HandlerPool->readAMBE();
 					if (data != NULL) {
+						m_traffic.g2Frames++;
 						CG2Handler::process(*data);
 						delete data;
 					}
@@ -1073,6 +1169,9 @@ void CDStarGatewayThread::processG2()
 
 void CDStarGatewayThread::processDD()
 {
+	// Frames received from the repeaters since the last pass go to the tap device together
+	CDDHandler::flush();
+
 	for (;;) {
 		CDDData* data = CDDHandler::read();
 		if (data == NULL)
@@ -1128,6 +1227,136 @@ CDStarGatewayStatusData* CDStarGatewayThread::getStatus() const
 	return status;
 }
 
+CNetworkReader* CDStarGatewayThread::getNetworkReader()
+{
+	return m_networkReaderStarted ? &m_networkReader : NULL;
+}
+
+void CDStarGatewayThread::publishStatus()
+{
+	// Built privately so that the segment is only marked busy for the final copy
+	SStatusData data;
+	::memset(&data, 0x00, sizeof(SStatusData));
+
+	data.updated = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	CStatusSegment::setString(data.gateway, STATUS_CALLSIGN_LENGTH, m_gatewayCallsign);
+	data.ircDDBStatus = int32_t(m_lastStatus);
+
+	unsigned int users, repeaters, gateways;
+	m_cache.getCounts(users, repeaters, gateways);
+	data.userCacheCount     = users;
+	data.repeaterCacheCount = repeaters;
+	data.gatewayCacheCount  = gateways;
+
+	data.traffic = m_traffic;
+	CG2Handler::getQuality(data.g2Quality);
+
+	std::string dongles;
+	dongles += CDExtraHandler::getDongles();
+	dongles += CDPlusHandler::getDongles();
+	CStatusSegment::setString(data.dongles, STATUS_DONGLES_LENGTH, dongles);
+
+	for (unsigned int i = 0U; i < MAX_REPEATERS && data.repeaterCount < STATUS_MAX_REPEATERS; i++) {
+		std::string callsign, linkCallsign;
+		LINK_STATUS linkStatus;
+		bool ret = CRepeaterHandler::getRepeater(i, callsign, linkStatus, linkCallsign);
+		if (!ret)
+			continue;
+
+		CRepeaterHandler* repeater = CRepeaterHandler::findDVRepeater(callsign);
+		if (repeater == NULL)
+			continue;
+
+		SStatusRepeater& entry = data.repeaters[data.repeaterCount++];
+		CStatusSegment::setString(entry.callsign, STATUS_CALLSIGN_LENGTH, callsign);
+		CStatusSegment::setString(entry.linkCallsign, STATUS_CALLSIGN_LENGTH, linkCallsign);
+		entry.linkStatus = int32_t(linkStatus);
+
+		unsigned int heardCount;
+		std::string lastHeard = repeater->getLastHeard(heardCount);
+		CStatusSegment::setString(entry.lastHeard, STATUS_CALLSIGN_LENGTH, lastHeard);
+		entry.heardCount = heardCount;
+
+		CRemoteRepeaterData* info = repeater->getInfo();
+		if (info == NULL)
+			continue;
+
+		CDExtraHandler::getInfo(repeater, *info);
+		CDPlusHandler::getInfo(repeater, *info);
+		CDCSHandler::getInfo(repeater, *info);
+#ifdef USE_CCS
+		CCCSHandler::getInfo(repeater, *info);
+#endif
+
+		CStatusSegment::setString(entry.reflector, STATUS_CALLSIGN_LENGTH, info->getReflector());
+		entry.reconnect = info->getReconnect();
+
+		for (unsigned int n = 0U; n < info->getLinkCount() && entry.linkCount < STATUS_MAX_LINKS; n++) {
+			CRemoteLinkData* link = info->getLink(n);
+
+			SStatusLink& linkEntry = entry.links[entry.linkCount++];
+			CStatusSegment::setString(linkEntry.callsign, STATUS_CALLSIGN_LENGTH, link->getCallsign());
+			linkEntry.protocol  = uint8_t(link->getProtocol());
+			linkEntry.linked    = uint8_t(link->isLinked());
+			linkEntry.direction = uint8_t(link->getDirection());
+			linkEntry.dongle    = uint8_t(link->isDongle());
+			linkEntry.quality   = link->getQuality();
+		}
+
+		delete info;
+	}
+
+	m_statusSegment->write(data);
+}
+
+void CDStarGatewayThread::publishVoiceStats()
+{
+	unsigned int interval = m_voiceStatsTimer.getTimeout();
+
+	for (unsigned int i = VP_HB; i < VOICE_PROTOCOLS; i++) {
+		VOICE_PROTOCOL protocol = VOICE_PROTOCOL(i);
+
+		TVoiceSnapshot current;
+		CVoiceStats::snapshot(protocol, current);
+
+		TVoiceSnapshot delta = current;
+		CVoiceStats::subtract(delta, m_voiceStats[i]);
+		m_voiceStats[i] = current;
+
+		// Idle protocols would only add noise
+		if (delta.framesIn == 0U && delta.framesOut == 0U && delta.drops == 0U)
+			continue;
+
+		m_voiceJSON.begin("voice");
+		m_voiceJSON.add("decode_max_us", uint64_t(delta.decode.getMax()));
+		m_voiceJSON.add("decode_p50_us", uint64_t(delta.decode.getPercentile(50.0)));
+		m_voiceJSON.add("decode_p90_us", uint64_t(delta.decode.getPercentile(90.0)));
+		m_voiceJSON.add("decode_p99_us", uint64_t(delta.decode.getPercentile(99.0)));
+		m_voiceJSON.add("drops", delta.drops);
+		m_voiceJSON.add("frames_in", delta.framesIn);
+		m_voiceJSON.add("frames_out", delta.framesOut);
+		m_voiceJSON.add("header_repeats", delta.headerRepeats);
+		m_voiceJSON.add("interval", uint64_t(interval));
+		m_voiceJSON.add("late", delta.late);
+		m_voiceJSON.add("protocol", CVoiceStats::getName(protocol));
+		m_voiceJSON.add("route_max_us", uint64_t(delta.route.getMax()));
+		m_voiceJSON.add("route_p50_us", uint64_t(delta.route.getPercentile(50.0)));
+		m_voiceJSON.add("route_p90_us", uint64_t(delta.route.getPercentile(90.0)));
+		m_voiceJSON.add("route_p99_us", uint64_t(delta.route.getPercentile(99.0)));
+		m_voiceJSON.addTimestamp();
+		m_voiceJSON.add("total_max_us", uint64_t(delta.total.getMax()));
+		m_voiceJSON.add("total_p50_us", uint64_t(delta.total.getPercentile(50.0)));
+		m_voiceJSON.add("total_p90_us", uint64_t(delta.total.getPercentile(90.0)));
+		m_voiceJSON.add("total_p99_us", uint64_t(delta.total.getPercentile(99.0)));
+		m_voiceJSON.add("write_max_us", uint64_t(delta.write.getMax()));
+		m_voiceJSON.add("write_p50_us", uint64_t(delta.write.getPercentile(50.0)));
+		m_voiceJSON.add("write_p90_us", uint64_t(delta.write.getPercentile(90.0)));
+		m_voiceJSON.add("write_p99_us", uint64_t(delta.write.getPercentile(99.0)));
+
+		writeJSON(m_voiceJSON.end());
+	}
+}
+
 void CDStarGatewayThread::readStatusFiles()
 {
 	readStatusFile(STATUS1_FILE_NAME, 0U, m_status1);
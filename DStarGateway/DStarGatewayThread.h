@@ -30,6 +30,10 @@
 #include "DCSProtocolHandlerPool.h"
 #include "G2ProtocolHandlerPool.h"
 #include "RemoteHandler.h"
+#include "StatusSegment.h"
+#include "NetworkReader.h"
+#include "VoiceStats.h"
+#include "JSONWriter.h"
 #include "CacheManager.h"
 #include "CallsignList.h"
 #include "APRSHandler.h"
@@ -69,15 +73,20 @@ public:
 	virtual void setAPRSWriters(CAPRSHandler* outgoingAprsWriter, CAPRSHandler* incomingAPRSHandler);
 	virtual void setInfoEnabled(bool enabled);
 	virtual void setEchoEnabled(bool enabled);
+	virtual void setEchoMemory(unsigned int memory);
 	virtual void setDTMFEnabled(bool enabled);
 	virtual void setDDModeEnabled(bool enabled);
 	virtual void setRemote(bool enabled, const std::string& password, unsigned int port);
+	virtual void setStatusSegment(bool enabled, const std::string& name);
+	virtual void setVoiceStatistics(bool enabled, unsigned int interval);
 	virtual void setLocation(double latitude, double longitude);
 	virtual void setWhiteList(CCallsignList* list);
 	virtual void setBlackList(CCallsignList* list);
 	virtual void setRestrictList(CCallsignList* list);
 
 	virtual CDStarGatewayStatusData* getStatus() const;
+	// The reader the gateway's own sockets are received on, NULL if it could not be started
+	virtual CNetworkReader* getNetworkReader();
 
 	virtual void kill();
 	
@@ -115,6 +124,7 @@ private:
 	std::string                  m_ccsHost;
 	bool                      m_infoEnabled;
 	bool                      m_echoEnabled;
+	unsigned int              m_echoMemory;
 	bool                      m_dtmfEnabled;
 	bool                      m_logEnabled;
 	bool					  m_logIRCDDB;
@@ -126,6 +136,17 @@ private:
 	unsigned int              m_remotePort;
 	CRemoteHandler*           m_remote;
 	CTimer                    m_statusFileTimer;
+	bool                      m_statusSegmentEnabled;
+	std::string               m_statusSegmentName;
+	CStatusSegment*           m_statusSegment;
+	CTimer                    m_statusSegmentTimer;
+	bool                      m_voiceStatsEnabled;
+	CTimer                    m_voiceStatsTimer;
+	TVoiceSnapshot            m_voiceStats[VOICE_PROTOCOLS];
+	CJSONWriter               m_voiceJSON;
+	SStatusTraffic            m_traffic;
+	CNetworkReader            m_networkReader;
+	bool                      m_networkReaderStarted;
 	std::string                  m_status1;
 	std::string                  m_status2;
 	std::string                  m_status3;
@@ -145,6 +166,9 @@ private:
 	void processG2();
 	void processDD();
 
+	void publishStatus();
+	void publishVoiceStats();
+
 	void readStatusFiles();
 	void readStatusFile(const std::string& filename, unsigned int n, std::string& var);
 };
@@ -29,14 +29,14 @@ m_icomCount(0U)
 
 }
 
-IRepeaterProtocolHandler * CRepeaterProtocolHandlerFactory::getRepeaterProtocolHandler(HW_TYPE hwType, const TGeneral& generalConfig, const std::string& repeaterAddress, unsigned int repeaterPort)
+IRepeaterProtocolHandler * CRepeaterProtocolHandlerFactory::getRepeaterProtocolHandler(HW_TYPE hwType, const TGeneral& generalConfig, const std::string& repeaterAddress, unsigned int repeaterPort, CNetworkReader* reader)
 {
     IRepeaterProtocolHandler * handler = NULL;
     switch (hwType)
     {
     case HW_ICOM:
         if(m_icomRepeaterHandler == NULL) {
-            CIcomRepeaterProtocolHandler * icomRepeaterHandler = new CIcomRepeaterProtocolHandler(generalConfig.icomAddress, generalConfig.icomPort, repeaterAddress, repeaterPort);
+            CIcomRepeaterProtocolHandler * icomRepeaterHandler = new CIcomRepeaterProtocolHandler(generalConfig.icomAddress, generalConfig.icomPort, repeaterAddress, repeaterPort, generalConfig.icomWindow);
 			bool res = icomRepeaterHandler->open();
             if (res) {
                 LogInfo("Icom repeater controller listening on %s:%u", generalConfig.icomAddress.c_str(), generalConfig.icomPort);
@@ -55,7 +55,7 @@ IRepeaterProtocolHandler * CRepeaterProtocolHandlerFactory::getRepeaterProtocolH
         break;
     case HW_HOMEBREW:
         if(m_hbRepeaterHandler == NULL) {
-    		CHBRepeaterProtocolHandler * hbRepeaterHandler = new CHBRepeaterProtocolHandler(generalConfig.hbAddress, generalConfig.hbPort);
+    		CHBRepeaterProtocolHandler * hbRepeaterHandler = new CHBRepeaterProtocolHandler(generalConfig.hbAddress, generalConfig.hbPort, reader);
 			bool res = hbRepeaterHandler->open();
 			if (res) {
                 LogInfo("Home Brew repeater controller listening on %s:%u", generalConfig.hbAddress.c_str(), generalConfig.hbPort);
@@ -32,7 +32,7 @@ class CRepeaterProtocolHandlerFactory
 public:
     CRepeaterProtocolHandlerFactory();
 
-    IRepeaterProtocolHandler * getRepeaterProtocolHandler(HW_TYPE hwType, const TGeneral& generalConfig, const std::string& repeaterAddress, unsigned int repeaterPort);
+    IRepeaterProtocolHandler * getRepeaterProtocolHandler(HW_TYPE hwType, const TGeneral& generalConfig, const std::string& repeaterAddress, unsigned int repeaterPort, CNetworkReader* reader = NULL);
 
 	CIcomRepeaterProtocolHandler * getIcomProtocolHandler();
 	CHBRepeaterProtocolHandler * getHBProtocolHandler();
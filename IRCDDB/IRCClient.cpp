@@ -25,16 +25,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <fcntl.h>
 #include <errno.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
 #include <chrono>
 #include <thread>
 
 #include "IRCClient.h"
+#include "Thread.h"
 #include "Utils.h"
 #include "Log.h"
 
+// Outgoing flood control, stay below what the ircDDB servers tolerate before throttling us
+const unsigned int IRC_SEND_BURST = 10U;
+const unsigned int IRC_SEND_RATE  = 2U;	// messages per second
+
+// Maximum time we wait for outgoing messages before processing the receive queue again
+const unsigned int IRC_POLL_MS = 100U;
+
 IRCClient::IRCClient(IRCApplication *app, const std::string& update_channel, const std::string& hostName, unsigned int port, const std::string& callsign,
-										const std::string& password, const std::string& versionInfo, const std::string& localAddr)
+										const std::string& password, const std::string& versionInfo, const std::string& localAddr) :
+m_rateLimiter(IRC_SEND_BURST, IRC_SEND_RATE)
 {
 	CUtils::safeStringCopy(m_host_name, hostName.c_str(), sizeof m_host_name);
 
@@ -80,6 +90,8 @@ void IRCClient::stopWork()
 
 void IRCClient::Entry()
 {
+	CThread::configure("IRCDDB Client");
+
 	const unsigned int MAXIPV4ADDR = 10;
 	struct sockaddr_in addr[MAXIPV4ADDR];
 	struct sockaddr_in myaddr;
@@ -258,6 +270,8 @@ void IRCClient::Entry()
 					m_recv = new IRCReceiver(sock, m_recvQ);
 					m_recv->startWork();
 
+					m_rateLimiter.reset();
+
 					m_proto->setNetworkReady(true);
 					state = 5;
 					timer = 0;
@@ -276,7 +290,7 @@ void IRCClient::Entry()
 						timer = 0;
 						state = 6;
 					}
-					while (5==state && m_sendQ->messageAvailable()) {
+					while (5==state && m_sendQ->messageAvailable() && m_rateLimiter.consume()) {
 						IRCMessage *m = m_sendQ->getMessage();
 						std::string out;
 
@@ -330,7 +344,16 @@ void IRCClient::Entry()
 				}
 				break;
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+		if (5 == state) {
+			// Send as soon as something is queued or the rate limiter lets the next message through
+			if (m_sendQ->messageAvailable())
+				std::this_thread::sleep_for(std::chrono::milliseconds(std::max(1U, std::min(m_rateLimiter.getWaitTime(), IRC_POLL_MS))));
+			else
+				m_sendQ->waitMessage(IRC_POLL_MS);
+		} else {
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
 	}
 	return;
 }
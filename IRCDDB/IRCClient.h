@@ -29,6 +29,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "IRCMessageQueue.h"
 #include "IRCProtocol.h"
 #include "IRCApplication.h"
+#include "IRCRateLimiter.h"
 
 class IRCClient 
 {
@@ -55,6 +56,7 @@ private:
 	IRCMessageQueue *m_sendQ;
 	IRCProtocol *m_proto;
 	IRCApplication *m_app;
+	IRCRateLimiter m_rateLimiter;
 	std::thread m_thread;
 
 };
\ No newline at end of file
@@ -21,15 +21,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <netdb.h>
-#include <map>
+#include <algorithm>
 #include <mutex>
 #include <regex>
 #include <cstdio>
+#include <cstring>
 #include <chrono>
 #include <thread>
 #include <boost/algorithm/string.hpp>
 
 #include "IRCDDBApp.h"
+#include "IRCDDBFlatMap.h"
+#include "Thread.h"
 #include "Utils.h"
 #include "Log.h"
 
@@ -57,26 +60,33 @@ public:
 	}
 };
 
+// The repeater callsign is the key of the table, only the gateway is stored inline
 class IRCDDBAppRptrObject
 {
 public:
-	std::string m_arearp_cs;
 	time_t m_lastChanged;
-	std::string m_zonerp_cs;
+	char m_zonerp_cs[8];
 
-	IRCDDBAppRptrObject ()
+	IRCDDBAppRptrObject () :
+	m_lastChanged(0)
 	{
+		::memset(m_zonerp_cs, 0, sizeof(m_zonerp_cs));
 	}
 
-	IRCDDBAppRptrObject (time_t &dt, std::string& repeaterCallsign, std::string& gatewayCallsign, time_t &maxTime)
+	IRCDDBAppRptrObject (time_t &dt, const std::string& gatewayCallsign, time_t &maxTime)
 	{
-		m_arearp_cs = repeaterCallsign;
 		m_lastChanged = dt;
-		m_zonerp_cs = gatewayCallsign;
+		::memset(m_zonerp_cs, 0, sizeof(m_zonerp_cs));
+		::memcpy(m_zonerp_cs, gatewayCallsign.c_str(), std::min(gatewayCallsign.size(), sizeof(m_zonerp_cs)));
 
 		if (dt > maxTime)
 			maxTime = dt;
 	}
+
+	std::string getZone() const
+	{
+		return std::string(m_zonerp_cs, ::strnlen(m_zonerp_cs, sizeof(m_zonerp_cs)));
+	}
 };
 
 class IRCDDBAppPrivate
@@ -114,20 +124,20 @@ public:
 	bool m_initReady;
 	std::atomic<bool> m_terminateThread{false};
 
-	std::map<std::string, IRCDDBAppUserObject> m_userMap;
+	IRCDDBFlatMap<IRCDDBAppUserObject> m_userMap;
 	std::mutex m_userMapMutex;
 
-	std::map<std::string, IRCDDBAppRptrObject> m_rptrMap;
+	IRCDDBFlatMap<IRCDDBAppRptrObject> m_rptrMap;
 	std::mutex m_rptrMapMutex;
 
-	std::map<std::string, std::string> m_moduleQRG;
+	IRCDDBFlatMap<std::string> m_moduleQRG;
 	std::mutex m_moduleQRGMutex;
 
-	std::map<std::string, std::string> m_moduleQTH;
-	std::map<std::string, std::string> m_moduleURL;
+	IRCDDBFlatMap<std::string> m_moduleQTH;
+	IRCDDBFlatMap<std::string> m_moduleURL;
 	std::mutex m_moduleQTHURLMutex;
 
-	std::map<std::string, std::string> m_moduleWD;
+	IRCDDBFlatMap<std::string> m_moduleWD;
 	std::mutex m_moduleWDMutex;
 };
 
@@ -184,9 +194,10 @@ void IRCDDBApp::rptrQTH(const std::string& callsign, double latitude, double lon
 
 	std::lock_guard lochQTHURL(m_d->m_moduleQTHURLMutex);
 
-	m_d->m_moduleQTH[cs] = cs + std::string(" ") + pos + std::string(" ") + d1 + std::string(" ") + d2;
+	std::string& qth = m_d->m_moduleQTH[cs];
+	qth = cs + std::string(" ") + pos + std::string(" ") + d1 + std::string(" ") + d2;
 
-	LogInfo("QTH: %s\n", m_d->m_moduleQTH[cs].c_str());
+	LogInfo("QTH: %s\n", qth.c_str());
 
 	std::string url = infoURL;
 
@@ -195,8 +206,9 @@ void IRCDDBApp::rptrQTH(const std::string& callsign, double latitude, double lon
 		url.erase(sm.position(0), sm.length());
 
 	if (url.size()) {
-		m_d->m_moduleURL[cs] = cs + std::string(" ") + url;
-		LogInfo("URL: %s\n", m_d->m_moduleURL[cs].c_str());
+		std::string& moduleURL = m_d->m_moduleURL[cs];
+		moduleURL = cs + std::string(" ") + url;
+		LogInfo("URL: %s\n", moduleURL.c_str());
 	}
 
 	m_d->m_infoTimer = 5; // send info in 5 seconds
@@ -213,8 +225,9 @@ void IRCDDBApp::rptrQRG(const std::string& callsign, double txFrequency, double
 	CUtils::ReplaceChar(f, ',', '.');
 
 	std::lock_guard lockModuleQRG(m_d->m_moduleQRGMutex);
-	m_d->m_moduleQRG[cs] = cs + std::string(" ") + f;
-	LogInfo("QRG: %s\n", m_d->m_moduleQRG[cs].c_str());
+	std::string& qrg = m_d->m_moduleQRG[cs];
+	qrg = cs + std::string(" ") + f;
+	LogInfo("QRG: %s\n", qrg.c_str());
 
 	m_d->m_infoTimer = 5; // send info in 5 seconds
 }
@@ -299,16 +312,14 @@ unsigned int IRCDDBApp::calculateUsn(const std::string& nick)
 {
 	std::string::size_type pos = nick.find_last_of('-');
 	std::string lnick = std::string::npos==pos ? nick : nick.substr(0, pos);
-	lnick.push_back('-');
+	lnick.append("-0");
 	unsigned int maxUsn = 0;
-	for (int i = 1; i <= 4; i++) {
-		std::string ircUser = lnick + std::to_string(i);
+	for (char i = '1'; i <= '4'; i++) {
+		lnick.back() = i;
 
-		if (m_d->m_userMap.count(ircUser) == 1) {
-			IRCDDBAppUserObject obj = m_d->m_userMap[ircUser];
-			if (obj.m_usn > maxUsn)
-				maxUsn = obj.m_usn;
-		}
+		const IRCDDBAppUserObject* obj = m_d->m_userMap.find(lnick);
+		if (obj != nullptr && obj->m_usn > maxUsn)
+			maxUsn = obj->m_usn;
 	}
 	return maxUsn + 1;
 }
@@ -323,7 +334,7 @@ void IRCDDBApp::userJoin(const std::string& nick, const std::string& name, const
 	IRCDDBAppUserObject u(lnick, name, host);
 	u.m_usn = calculateUsn(lnick);
 
-	m_d->m_userMap[lnick] = u;
+	m_d->m_userMap[lnick] = std::move(u);
 
 	/*if (m_d->m_initReady)*/ {
 		std::string::size_type hyphenPos = nick.find('-');
@@ -351,14 +362,13 @@ void IRCDDBApp::userLeave(const std::string& nick)
 	m_d->m_userMap.erase(lnick);
 
 	if (m_d->m_currentServer.size()) {
-		if (m_d->m_userMap.count(m_d->m_myNick) != 1) {
+		const IRCDDBAppUserObject* me = m_d->m_userMap.find(m_d->m_myNick);
+		if (me == nullptr) {
 			LogInfo("IRCDDBApp::userLeave: could not find own nick\n");
 			return;
 		}
 
-		IRCDDBAppUserObject me = m_d->m_userMap[m_d->m_myNick];
-
-		if (me.m_op == false) {
+		if (me->m_op == false) {
 			// if I am not op, then look for new server
 
 			if (0 == m_d->m_currentServer.compare(lnick)) {
@@ -399,10 +409,8 @@ bool IRCDDBApp::findServerUser()
 	bool found = false;
 	std::lock_guard lockUserMap(m_d->m_userMapMutex);
 
-	std::map<std::string, IRCDDBAppUserObject>::iterator it;
-
-	for (it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
-		IRCDDBAppUserObject u = it->second;
+	for (auto it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
+		const IRCDDBAppUserObject& u = it->second;
 
 		if (0==u.m_nick.compare(0, 2, "s-") && u.m_op && m_d->m_myNick.compare(u.m_nick) && 0==u.m_nick.compare(m_d->m_bestServer)) {
 			m_d->m_currentServer = u.m_nick;
@@ -416,8 +424,8 @@ bool IRCDDBApp::findServerUser()
 	}
 
 	if (8 == m_d->m_bestServer.size()) {
-		for (it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
-			IRCDDBAppUserObject u = it->second;
+		for (auto it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
+			const IRCDDBAppUserObject& u = it->second;
 
 			if (0==u.m_nick.compare(m_d->m_bestServer.substr(0,7)) && u.m_op && m_d->m_myNick.compare(u.m_nick) ) {
 				m_d->m_currentServer = u.m_nick;
@@ -431,8 +439,8 @@ bool IRCDDBApp::findServerUser()
 		return true;
 	}
 
-	for (it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
-		IRCDDBAppUserObject u = it->second;
+	for (auto it = m_d->m_userMap.begin(); it != m_d->m_userMap.end(); ++it) {
+		const IRCDDBAppUserObject& u = it->second;
 		if (0==u.m_nick.compare(0, 2, "s-") && u.m_op && m_d->m_myNick.compare(u.m_nick)) {
 			m_d->m_currentServer = u.m_nick;
 			found = true;
@@ -449,8 +457,9 @@ void IRCDDBApp::userChanOp(const std::string& nick, bool op)
 	std::string lnick = nick;
 	CUtils::ToLower(lnick);
 
-	if (m_d->m_userMap.count(lnick) == 1)
-		m_d->m_userMap[lnick].m_op = op;
+	IRCDDBAppUserObject* u = m_d->m_userMap.find(lnick);
+	if (u != nullptr)
+		u->m_op = op;
 }
 
 static const int numberOfTables = 2;
@@ -464,17 +473,17 @@ std::string IRCDDBApp::getIPAddressFromCall(std::string& zonerp_cs)
 	CUtils::ToLower(gw);
 	CUtils::Trim(gw);
 
-	std::lock_guard lockUserMap(m_d->m_userMapMutex);
-	for (int j=1; j <= 4; j++) {
-		std::string ircUser = gw + std::string("-") + std::to_string(j);
+	// Nicks are the gateway callsign followed by -1 to -4, probe them in place
+	gw.append("-0");
 
-		if (m_d->m_userMap.count(ircUser) == 1) {
-			IRCDDBAppUserObject o = m_d->m_userMap[ircUser];
+	std::lock_guard lockUserMap(m_d->m_userMapMutex);
+	for (char j = '1'; j <= '4'; j++) {
+		gw.back() = j;
 
-			if (o.m_usn >= max_usn) {
-				max_usn = o.m_usn;
-				ipAddr = o.m_host.c_str();
-			}
+		const IRCDDBAppUserObject* o = m_d->m_userMap.find(gw);
+		if (o != nullptr && o->m_usn >= max_usn) {
+			max_usn = o->m_usn;
+			ipAddr = o->m_host;
 		}
 	}
 	return ipAddr;
@@ -484,9 +493,10 @@ std::string IRCDDBApp::getIPAddressFromNick(std::string& ircUser)
 {
 	std::string ipAddress;
 
-	if (m_d->m_userMap.count(ircUser) == 1) {
-		ipAddress.assign(m_d->m_userMap[ircUser].m_host);
-	}
+	std::lock_guard lockUserMap(m_d->m_userMapMutex);
+	const IRCDDBAppUserObject* o = m_d->m_userMap.find(ircUser);
+	if (o != nullptr)
+		ipAddress.assign(o->m_host);
 
 	return ipAddress;
 }
@@ -550,13 +560,13 @@ bool IRCDDBApp::findRepeater(const std::string& rptrCall)
 	std::string zonerp_cs;
 	std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
 
-	if (1 == m_d->m_rptrMap.count(arearp_cs)) {
-		IRCDDBAppRptrObject o = m_d->m_rptrMap[arearp_cs];
-		zonerp_cs = o.m_zonerp_cs;
+	const IRCDDBAppRptrObject* o = m_d->m_rptrMap.find(arearp_cs);
+	if (o != nullptr) {
+		s = o->getZone();
+		zonerp_cs = s;
 		CUtils::ReplaceChar(zonerp_cs, '_', ' ');
 		zonerp_cs.resize(7, ' ');
 		zonerp_cs.push_back('G');
-		s = o.m_zonerp_cs;
 	}
 
 	IRCMessage * m2 = new IRCMessage("IDRT_REPEATER");
@@ -580,7 +590,7 @@ void IRCDDBApp::sendDStarGatewayInfo(const std::string &subcommand, const std::v
 			command.append(*it);
 		}
 		IRCMessage *m = new IRCMessage(srv, command);
-		q->putMessage(m);
+		q->putMessage(m, IRCP_INFO);
 	}
 }
 
@@ -636,8 +646,9 @@ bool IRCDDBApp::sendHeard(const std::string& myCall, const std::string& myCallEx
 			if (20 == tx_msg.size())
 				cmd += std::string(" ") + tx_msg;
 		}
+		// A newer heard of the same station on the same repeater supersedes a still queued one
 		IRCMessage *m = new IRCMessage(srv, cmd);
-		q->putMessage(m);
+		q->putMessage(m, IRCP_HEARD, std::string(statsMsg ? "HEARD# " : "HEARD ") + my + std::string(" ") + r1);
 		return true;
 	}
 	return false;
@@ -652,7 +663,7 @@ bool IRCDDBApp::findUser(const std::string& usrCall)
 		std::string usr(usrCall);
 		CUtils::ReplaceChar(usr, ' ', '_');
 		IRCMessage * m =new IRCMessage(srv, std::string("FIND ") + usr);
-		q->putMessage(m);
+		q->putMessage(m, IRCP_QUERY);
 	} else {
 		IRCMessage *m2 = new IRCMessage("IDRT_USER");
 		m2->addParam(usrCall);
@@ -671,7 +682,7 @@ bool IRCDDBApp::notifyRepeaterG2NatTraversal(const std::string& repeater)
 		return true; //return true because this return value is handled as a network error, whoch is actually uncleve
 
 	IRCMessage * ircMessage = new IRCMessage(nick, "NATTRAVERSAL_G2");
-	m_d->m_sendQ->putMessage(ircMessage);
+	m_d->m_sendQ->putMessage(ircMessage, IRCP_QUERY);
 
 	return true;
 }
@@ -685,7 +696,7 @@ bool IRCDDBApp::notifyRepeaterDextraNatTraversal(const std::string& repeater, un
 
 	IRCMessage * ircMessage = new IRCMessage(nick, "NATTRAVERSAL_DEXTRA");
 	ircMessage->addParam(std::to_string(myLocalPort));
-	m_d->m_sendQ->putMessage(ircMessage);
+	m_d->m_sendQ->putMessage(ircMessage, IRCP_QUERY);
 
 	return true;
 }
@@ -699,7 +710,7 @@ bool IRCDDBApp::notifyRepeaterDPlusNatTraversal(const std::string& repeater, uns
 
 	IRCMessage * ircMessage = new IRCMessage(nick, "NATTRAVERSAL_DPLUS");
 	ircMessage->addParam(std::to_string(myLocalPort));
-	m_d->m_sendQ->putMessage(ircMessage);
+	m_d->m_sendQ->putMessage(ircMessage, IRCP_QUERY);
 
 	return true;
 }
@@ -712,12 +723,13 @@ bool IRCDDBApp::getNickForRepeater(const std::string& repeater, std::string& nic
 	if(firstSpacePos == std::string::npos)
 		return false;
 
-	auto lrepeater = repeater.substr(0, firstSpacePos);
-	CUtils::ToLower(lrepeater);
+	nick = repeater.substr(0, firstSpacePos);
+	CUtils::ToLower(nick);
+	nick.append("-0");
 	
-	for(unsigned int i = 1; i <= 4U; i++) {
-		nick = lrepeater + "-" + std::to_string(i);
-		if(m_d->m_userMap.count(nick) == 1) {
+	for(char i = '1'; i <= '4'; i++) {
+		nick.back() = i;
+		if(m_d->m_userMap.contains(nick)) {
 			return true;
 		}
 	}
@@ -822,8 +834,7 @@ void IRCDDBApp::doUpdate(std::string& msg)
 
 			if (tableID == 1) {
 				std::lock_guard lockRptrMap(m_d->m_rptrMapMutex);
-				IRCDDBAppRptrObject newRptr(dt, key, value, m_maxTime);
-				m_d->m_rptrMap[key] = newRptr;
+				m_d->m_rptrMap[key] = IRCDDBAppRptrObject(dt, value, m_maxTime);
 
 				if (m_d->m_initReady) {
 					std::string arearp_cs(key);
@@ -853,10 +864,10 @@ void IRCDDBApp::doUpdate(std::string& msg)
 				if(std::regex_search(msg, sm1, m_d->m_fromPattern))
 					nick = sm1[1];
 
-				if (1 == m_d->m_rptrMap.count(value)) {
+				const IRCDDBAppRptrObject* o = m_d->m_rptrMap.find(value);
+				if (o != nullptr) {
 					// LogDebug("doUptate RPTR already present");
-					IRCDDBAppRptrObject o = m_d->m_rptrMap[value];
-					zonerp_cs = o.m_zonerp_cs;
+					zonerp_cs = o->getZone();
 					CUtils::ReplaceChar(zonerp_cs, '_', ' ');
 					zonerp_cs.resize(7, ' ');
 					ip_addr = nick.empty() ? getIPAddressFromCall(zonerp_cs) : getIPAddressFromNick(nick);
@@ -870,8 +881,7 @@ void IRCDDBApp::doUpdate(std::string& msg)
 
 					if(!ip_addr.empty()) {
 						auto tmp = boost::replace_all_copy(zonerp_cs, " ", "_");
-						IRCDDBAppRptrObject newRptr(dt, value, tmp, m_maxTime);
-						m_d->m_rptrMap[value] = newRptr;
+						m_d->m_rptrMap[value] = IRCDDBAppRptrObject(dt, tmp, m_maxTime);
 					}
 				}
 
@@ -1001,6 +1011,8 @@ static bool needsDatabaseUpdate(int tableID)
 
 void IRCDDBApp::Entry()
 {
+	CThread::configure("IRCDDB App");
+
 	int sendlistTableID = 0;
 	while (!m_d->m_terminateThread.load(std::memory_order_relaxed)) {
 		if (m_d->m_timer > 0)
@@ -1058,7 +1070,7 @@ void IRCDDBApp::Entry()
 						IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("SENDLIST") + getTableIDString(sendlistTableID, true) + std::string(" ") + getLastEntryTime(sendlistTableID));
 						IRCMessageQueue *q = getSendQ();
 						if (q)
-							q->putMessage(m);
+							q->putMessage(m, IRCP_LIST);
 						m_d->m_state = 5; // wait for answers
 					} else
 						m_d->m_state = 3; // don't send SENDLIST for this table, go to next table
@@ -1104,7 +1116,7 @@ void IRCDDBApp::Entry()
 								IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRQTH: ") + value);
 								IRCMessageQueue *q = getSendQ();
 								if (q != NULL)
-									q->putMessage(m);
+									q->putMessage(m, IRCP_INFO, std::string("RPTRQTH ") + it->first);
 							}
 							m_d->m_moduleQTH.clear();
 
@@ -1113,7 +1125,7 @@ void IRCDDBApp::Entry()
 								IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRURL: ") + value);
 								IRCMessageQueue *q = getSendQ();
 								if (q != NULL)
-									q->putMessage(m);
+									q->putMessage(m, IRCP_INFO, std::string("RPTRURL ") + it->first);
 							}
 							m_d->m_moduleURL.clear();
 						}
@@ -1124,7 +1136,7 @@ void IRCDDBApp::Entry()
 							IRCMessage* m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRQRG: ") + value);
 							IRCMessageQueue* q = getSendQ();
 							if (q != NULL)
-								q->putMessage(m);
+								q->putMessage(m, IRCP_INFO, std::string("RPTRQRG ") + it->first);
 						}
 						m_d->m_moduleQRG.clear();
 					}
@@ -1141,7 +1153,7 @@ void IRCDDBApp::Entry()
 							IRCMessage *m = new IRCMessage(m_d->m_currentServer, std::string("IRCDDB RPTRSW: ") + value);
 							IRCMessageQueue *q = getSendQ();
 							if (q)
-								q->putMessage(m);
+								q->putMessage(m, IRCP_INFO, std::string("RPTRSW ") + it->first);
 						}
 						m_d->m_moduleWD.clear();
 					}
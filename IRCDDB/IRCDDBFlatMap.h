@@ -0,0 +1,209 @@
+/*
+CIRCDDB - ircDDB client library in C++
+
+Copyright (c) 2026 by Geoffrey Merck F4FXL / KC3FRA
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Hash map keyed by strings, built for the large ircDDB user and repeater tables.
+// Entries are stored densely in a vector, an open addressing index (linear probing, backward shift deletion)
+// of 8 byte buckets points into it. Lookups take a std::string_view so callers do not build temporary strings.
+// Callsign and nick keys fit in the std::string small buffer, so a row costs no allocation of its own.
+// Erasing moves the last entry into the hole, iteration order is therefore unspecified.
+template <typename V>
+class IRCDDBFlatMap
+{
+public:
+	typedef std::pair<std::string, V> value_type;
+	typedef typename std::vector<value_type>::iterator iterator;
+	typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+	IRCDDBFlatMap() :
+	m_buckets(),
+	m_entries()
+	{
+	}
+
+	iterator begin() { return m_entries.begin(); }
+	iterator end() { return m_entries.end(); }
+	const_iterator begin() const { return m_entries.cbegin(); }
+	const_iterator end() const { return m_entries.cend(); }
+
+	std::size_t size() const { return m_entries.size(); }
+	bool empty() const { return m_entries.empty(); }
+
+	// Bytes owned by the table itself, keys longer than the small string buffer are not accounted for
+	std::size_t memoryUsage() const
+	{
+		return m_buckets.capacity() * sizeof(Bucket) + m_entries.capacity() * sizeof(value_type);
+	}
+
+	V* find(std::string_view key)
+	{
+		std::size_t bucket;
+		return lookup(key, hash(key), bucket) ? &m_entries[m_buckets[bucket].m_index].second : nullptr;
+	}
+
+	const V* find(std::string_view key) const
+	{
+		std::size_t bucket;
+		return lookup(key, hash(key), bucket) ? &m_entries[m_buckets[bucket].m_index].second : nullptr;
+	}
+
+	bool contains(std::string_view key) const
+	{
+		return find(key) != nullptr;
+	}
+
+	V& operator[](std::string_view key)
+	{
+		uint32_t h = hash(key);
+		std::size_t bucket;
+		if (lookup(key, h, bucket))
+			return m_entries[m_buckets[bucket].m_index].second;
+
+		if ((m_entries.size() + 1U) * 4U > m_buckets.size() * 3U) {
+			rehash(m_buckets.empty() ? 16U : m_buckets.size() * 2U);
+			lookup(key, h, bucket);
+		}
+
+		m_buckets[bucket].m_hash  = h;
+		m_buckets[bucket].m_index = uint32_t(m_entries.size());
+		m_entries.emplace_back(std::string(key), V());
+
+		return m_entries.back().second;
+	}
+
+	bool erase(std::string_view key)
+	{
+		std::size_t bucket;
+		if (!lookup(key, hash(key), bucket))
+			return false;
+
+		uint32_t index = m_buckets[bucket].m_index;
+		removeBucket(bucket);
+
+		// Keep the entries dense, the last one takes the place of the erased one
+		uint32_t last = uint32_t(m_entries.size() - 1U);
+		if (index != last) {
+			std::size_t lastBucket;
+			lookup(m_entries[last].first, hash(m_entries[last].first), lastBucket);
+			m_buckets[lastBucket].m_index = index;
+			m_entries[index] = std::move(m_entries[last]);
+		}
+		m_entries.pop_back();
+
+		return true;
+	}
+
+	void clear()
+	{
+		m_entries.clear();
+		for (auto& bucket : m_buckets)
+			bucket.m_index = EMPTY;
+	}
+
+	void reserve(std::size_t count)
+	{
+		m_entries.reserve(count);
+
+		std::size_t buckets = m_buckets.empty() ? 16U : m_buckets.size();
+		while (count * 4U > buckets * 3U)
+			buckets *= 2U;
+
+		if (buckets != m_buckets.size())
+			rehash(buckets);
+	}
+
+private:
+	static const uint32_t EMPTY = 0xFFFFFFFFU;
+
+	struct Bucket {
+		uint32_t m_hash;
+		uint32_t m_index;
+	};
+
+	std::vector<Bucket> m_buckets;
+	std::vector<value_type> m_entries;
+
+	static uint32_t hash(std::string_view key)
+	{
+		// FNV-1a
+		uint32_t h = 2166136261U;
+		for (char c : key) {
+			h ^= (unsigned char)c;
+			h *= 16777619U;
+		}
+		return h;
+	}
+
+	// Returns true and the bucket when found, otherwise false and the free bucket ending the probe sequence
+	bool lookup(std::string_view key, uint32_t h, std::size_t& bucket) const
+	{
+		bucket = 0U;
+		if (m_buckets.empty())
+			return false;
+
+		std::size_t mask = m_buckets.size() - 1U;
+		for (bucket = h & mask; m_buckets[bucket].m_index != EMPTY; bucket = (bucket + 1U) & mask) {
+			if (m_buckets[bucket].m_hash == h && m_entries[m_buckets[bucket].m_index].first == key)
+				return true;
+		}
+
+		return false;
+	}
+
+	// Backward shift, move the following buckets of the cluster into the hole so no tombstones are needed
+	void removeBucket(std::size_t hole)
+	{
+		std::size_t mask = m_buckets.size() - 1U;
+		std::size_t next = (hole + 1U) & mask;
+		while (m_buckets[next].m_index != EMPTY) {
+			std::size_t home = m_buckets[next].m_hash & mask;
+			if (((next - home) & mask) >= ((next - hole) & mask)) {
+				m_buckets[hole] = m_buckets[next];
+				hole = next;
+			}
+			next = (next + 1U) & mask;
+		}
+
+		m_buckets[hole].m_index = EMPTY;
+	}
+
+	void rehash(std::size_t count)
+	{
+		m_buckets.assign(count, Bucket{ 0U, EMPTY });
+
+		std::size_t mask = count - 1U;
+		for (uint32_t i = 0U; i < m_entries.size(); i++) {
+			uint32_t h = hash(m_entries[i].first);
+			std::size_t bucket = h & mask;
+			while (m_buckets[bucket].m_index != EMPTY)
+				bucket = (bucket + 1U) & mask;
+
+			m_buckets[bucket].m_hash  = h;
+			m_buckets[bucket].m_index = i;
+		}
+	}
+};
@@ -24,19 +24,24 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
+
 #include "IRCMessageQueue.h"
 
-IRCMessageQueue::IRCMessageQueue()
+IRCMessageQueue::IRCMessageQueue() :
+m_eof(false),
+m_count(0U),
+m_coalesced(0U)
 {
-	m_eof = false;
 }
 
 IRCMessageQueue::~IRCMessageQueue()
 {
 	std::lock_guard lockAccessQueue(m_accessMutex);
-	while (! m_queue.empty()) {
-		delete m_queue.front();
-		m_queue.pop();
+	for (unsigned int i = 0U; i < IRCP_COUNT; i++) {
+		for (auto& entry : m_queues[i])
+			delete entry.m_message;
+		m_queues[i].clear();
 	}
 }
 
@@ -53,7 +58,7 @@ void IRCMessageQueue::signalEOF()
 bool IRCMessageQueue::messageAvailable()
 {
   std::lock_guard lockAccessQueue(m_accessMutex);
-  bool retv = ! m_queue.empty();
+  bool retv = m_count > 0U;
 
   return retv;
 }
@@ -61,26 +66,73 @@ bool IRCMessageQueue::messageAvailable()
 IRCMessage *IRCMessageQueue::peekFirst()
 {
 	std::lock_guard lockAccessQueue(m_accessMutex);
-	IRCMessage *msg = m_queue.empty() ? NULL : m_queue.front();
+	std::list<IRCQueueEntry> *queue = firstQueue();
+	IRCMessage *msg = queue == NULL ? NULL : queue->front().m_message;
 	return msg;
 }
 
 IRCMessage *IRCMessageQueue::getMessage()
 {
 	std::lock_guard lockAccessQueue(m_accessMutex);
-	IRCMessage *msg = m_queue.empty() ? NULL : m_queue.front();
-	if (msg)
-		m_queue.pop();
-	
+	std::list<IRCQueueEntry> *queue = firstQueue();
+	if (queue == NULL)
+		return NULL;
+
+	IRCMessage *msg = queue->front().m_message;
+	if (!queue->front().m_key.empty())
+		m_keys.erase(queue->front().m_key);
+
+	queue->pop_front();
+	m_count--;
+
 	return msg;
 }
 
-void IRCMessageQueue::putMessage(IRCMessage *m)
+void IRCMessageQueue::putMessage(IRCMessage *m, IRC_PRIORITY priority, const std::string& key)
 {
 	std::lock_guard lockAccessQueue(m_accessMutex);
-	m_queue.push(m);
+
+	if (!key.empty()) {
+		auto it = m_keys.find(key);
+		if (it != m_keys.end()) {
+			// Keep the place in the queue, only the content is refreshed
+			delete it->second->m_message;
+			it->second->m_message = m;
+			m_coalesced++;
+			return;
+		}
+	}
+
+	m_queues[priority].push_back({ m, key });
+	m_count++;
+
+	if (!key.empty())
+		m_keys[key] = std::prev(m_queues[priority].end());
+
+	m_available.notify_one();
 }
 
+bool IRCMessageQueue::waitMessage(unsigned int ms)
+{
+	std::unique_lock lockAccessQueue(m_accessMutex);
+	return m_available.wait_for(lockAccessQueue, std::chrono::milliseconds(ms), [this] { return m_count > 0U; });
+}
 
+unsigned int IRCMessageQueue::getCoalesced()
+{
+	std::lock_guard lockAccessQueue(m_accessMutex);
+	return m_coalesced;
+}
 
+std::list<IRCMessageQueue::IRCQueueEntry> *IRCMessageQueue::firstQueue()
+{
+	if (m_count == 0U)
+		return NULL;
+
+	for (unsigned int i = 0U; i < IRCP_COUNT; i++) {
+		if (!m_queues[i].empty())
+			return &m_queues[i];
+	}
 
+	return NULL;
+}
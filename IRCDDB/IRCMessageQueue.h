@@ -27,10 +27,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include <mutex>
-#include <queue>
+#include <condition_variable>
+#include <list>
+#include <string>
+#include <unordered_map>
 
 #include "IRCMessage.h"
 
+// Send classes, highest priority first. Messages of the same class are sent in FIFO order.
+enum IRC_PRIORITY {
+	IRCP_CONTROL,	// IRC protocol traffic (PONG, NICK, JOIN, QUIT, ...)
+	IRCP_QUERY,		// routing lookups and NAT traversal for a call in progress
+	IRCP_LIST,		// SENDLIST database synchronisation
+	IRCP_HEARD,		// heard updates
+	IRCP_INFO,		// repeater QTH/QRG/URL/SW and DStarGateway info
+	IRCP_COUNT
+};
+
 class IRCMessageQueue
 {
 public:
@@ -42,11 +55,28 @@ public:
 	bool messageAvailable();
 	IRCMessage *getMessage();
 	IRCMessage *peekFirst();
-	void putMessage(IRCMessage *m);
+
+	// A non empty key replaces a still queued message with the same key instead of queuing a new one
+	void putMessage(IRCMessage *m, IRC_PRIORITY priority = IRCP_CONTROL, const std::string& key = "");
+
+	bool waitMessage(unsigned int ms);
+
+	unsigned int getCoalesced();
 
 private:
+	struct IRCQueueEntry {
+		IRCMessage *m_message;
+		std::string m_key;
+	};
+
 	bool m_eof;
 	std::mutex m_accessMutex;
-	std::queue<IRCMessage *> m_queue;
+	std::condition_variable m_available;
+	std::list<IRCQueueEntry> m_queues[IRCP_COUNT];
+	std::unordered_map<std::string, std::list<IRCQueueEntry>::iterator> m_keys;
+	unsigned int m_count;
+	unsigned int m_coalesced;
+
+	std::list<IRCQueueEntry> *firstQueue();
 };
 
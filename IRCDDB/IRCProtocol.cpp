@@ -60,6 +60,7 @@ IRCProtocol::IRCProtocol(IRCApplication *app, const std::string& callsign, const
 	m_pingTimer = 60; // 30 seconds
 	m_state = 0;
 	m_timer = 0;
+	m_lastTick = std::chrono::steady_clock::now();
 	
 	chooseNewNick();
 }
@@ -88,8 +89,13 @@ void IRCProtocol::setNetworkReady(bool b)
 
 bool IRCProtocol::processQueues(IRCMessageQueue *recvQ, IRCMessageQueue *sendQ)
 {
-	if (m_timer > 0)
-		m_timer--;
+	// We may be called more often than every 500ms when there is traffic to send, the timers still count half seconds
+	auto now = std::chrono::steady_clock::now();
+	if (now - m_lastTick >= std::chrono::milliseconds(500)) {
+		m_lastTick = now;
+		if (m_timer > 0)
+			m_timer--;
+	}
 
 	while (recvQ->messageAvailable()) {
 		IRCMessage *m = recvQ->getMessage();
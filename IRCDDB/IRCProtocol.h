@@ -24,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <string>
 #include <array>
+#include <chrono>
 
 #include "IRCMessageQueue.h"
 #include "IRCApplication.h"
@@ -51,6 +52,7 @@ private:
 	int m_state;
 	int m_timer;
 	int m_pingTimer;
+	std::chrono::steady_clock::time_point m_lastTick;
 
 	IRCApplication *m_app;
 };
@@ -0,0 +1,83 @@
+/*
+CIRCDDB - ircDDB client library in C++
+
+Copyright (c) 2026 by Geoffrey Merck F4FXL / KC3FRA
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cassert>
+#include <cmath>
+
+#include "IRCRateLimiter.h"
+
+IRCRateLimiter::IRCRateLimiter(unsigned int burst, unsigned int ratePerSecond) :
+m_burst(burst),
+m_ratePerSecond(ratePerSecond),
+m_tokens(burst),
+m_lastRefill(std::chrono::steady_clock::now())
+{
+	assert(burst > 0U);
+	assert(ratePerSecond > 0U);
+}
+
+bool IRCRateLimiter::consume()
+{
+	return consume(std::chrono::steady_clock::now());
+}
+
+bool IRCRateLimiter::consume(const std::chrono::steady_clock::time_point& now)
+{
+	refill(now);
+
+	if (m_tokens < 1.0)
+		return false;
+
+	m_tokens -= 1.0;
+	return true;
+}
+
+unsigned int IRCRateLimiter::getWaitTime()
+{
+	return getWaitTime(std::chrono::steady_clock::now());
+}
+
+unsigned int IRCRateLimiter::getWaitTime(const std::chrono::steady_clock::time_point& now)
+{
+	refill(now);
+
+	if (m_tokens >= 1.0)
+		return 0U;
+
+	return (unsigned int)std::ceil((1.0 - m_tokens) * 1000.0 / double(m_ratePerSecond));
+}
+
+void IRCRateLimiter::reset()
+{
+	m_tokens = m_burst;
+	m_lastRefill = std::chrono::steady_clock::now();
+}
+
+void IRCRateLimiter::refill(const std::chrono::steady_clock::time_point& now)
+{
+	if (now <= m_lastRefill)
+		return;
+
+	std::chrono::duration<double> elapsed = now - m_lastRefill;
+	m_lastRefill = now;
+
+	m_tokens += elapsed.count() * double(m_ratePerSecond);
+	if (m_tokens > double(m_burst))
+		m_tokens = double(m_burst);
+}
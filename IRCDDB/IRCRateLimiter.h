@@ -0,0 +1,46 @@
+/*
+CIRCDDB - ircDDB client library in C++
+
+Copyright (c) 2026 by Geoffrey Merck F4FXL / KC3FRA
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+
+// Token bucket keeping our outgoing traffic under the server flood limits
+class IRCRateLimiter
+{
+public:
+	IRCRateLimiter(unsigned int burst, unsigned int ratePerSecond);
+
+	bool consume();
+	bool consume(const std::chrono::steady_clock::time_point& now);
+
+	// Milliseconds until the next token is available, 0 if one is available now
+	unsigned int getWaitTime();
+	unsigned int getWaitTime(const std::chrono::steady_clock::time_point& now);
+
+	void reset();
+
+private:
+	unsigned int m_burst;
+	unsigned int m_ratePerSecond;
+	double m_tokens;
+	std::chrono::steady_clock::time_point m_lastRefill;
+
+	void refill(const std::chrono::steady_clock::time_point& now);
+};
@@ -0,0 +1,125 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "AMBEClassifier.h"
+#include "DTMF.h"
+#include "DStarDefines.h"
+
+namespace AMBEClassifierTests
+{
+    class AMBEClassifier_benchmark : public ::testing::Test {
+    protected:
+        static const unsigned int FRAMES = 100000U;
+        static const unsigned int ROUNDS = 5U;
+
+        // Mostly voice with some silence and DTMF, the way a real over looks like
+        void SetUp() override
+        {
+            std::mt19937 random(20260102U);
+            std::uniform_int_distribution<unsigned int> byte(0U, 255U);
+
+            m_frames.resize(FRAMES * DV_FRAME_LENGTH_BYTES);
+            for (unsigned int n = 0U; n < FRAMES; n++) {
+                unsigned char* frame = m_frames.data() + n * DV_FRAME_LENGTH_BYTES;
+                for (unsigned int i = 0U; i < DV_FRAME_LENGTH_BYTES; i++)
+                    frame[i] = (unsigned char)byte(random);
+
+                if ((n % 10U) == 0U)
+                    ::memcpy(frame, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+                else if ((n % 10U) == 1U) {
+                    for (unsigned int i = 0U; i < VOICE_FRAME_LENGTH_BYTES; i++)
+                        frame[i] = (frame[i] & ~DTMF_MASK[i]) | DTMF_SIG[i];
+                }
+            }
+        }
+
+        template<typename F> double framesPerSecond(F classify)
+        {
+            double best = 0.0;
+            for (unsigned int round = 0U; round < ROUNDS; round++) {
+                unsigned int found = 0U;
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned int n = 0U; n < FRAMES; n++)
+                    found += classify(m_frames.data() + n * DV_FRAME_LENGTH_BYTES);
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                EXPECT_GT(found, 0U);
+                best = std::max(best, FRAMES / elapsed);
+            }
+
+            return best;
+        }
+
+        std::vector<unsigned char> m_frames;
+    };
+
+    TEST_F(AMBEClassifier_benchmark, DISABLED_classifyFrames)
+    {
+        // The memcmp, the nine masked compares and the chain of symbol compares
+        double byteRate = framesPerSecond([](const unsigned char* frame) {
+            unsigned int found = 0U;
+            if (::memcmp(frame, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES) == 0)
+                found++;
+
+            unsigned char slowDataType = (frame[VOICE_FRAME_LENGTH_BYTES] ^ SCRAMBLER_BYTE1) & SLOW_DATA_TYPE_MASK;
+            if (slowDataType == SLOW_DATA_TYPE_FAST_DATA1 || slowDataType == SLOW_DATA_TYPE_FAST_DATA2)
+                found++;
+
+            if ((frame[0] & DTMF_MASK[0]) == DTMF_SIG[0] && (frame[1] & DTMF_MASK[1]) == DTMF_SIG[1] &&
+                (frame[2] & DTMF_MASK[2]) == DTMF_SIG[2] && (frame[3] & DTMF_MASK[3]) == DTMF_SIG[3] &&
+                (frame[4] & DTMF_MASK[4]) == DTMF_SIG[4] && (frame[5] & DTMF_MASK[5]) == DTMF_SIG[5] &&
+                (frame[6] & DTMF_MASK[6]) == DTMF_SIG[6] && (frame[7] & DTMF_MASK[7]) == DTMF_SIG[7] &&
+                (frame[8] & DTMF_MASK[8]) == DTMF_SIG[8]) {
+                const unsigned char* symbols[] = { DTMF_SYM0, DTMF_SYM1, DTMF_SYM2, DTMF_SYM3, DTMF_SYM4, DTMF_SYM5, DTMF_SYM6, DTMF_SYM7,
+                                                   DTMF_SYM8, DTMF_SYM9, DTMF_SYMA, DTMF_SYMB, DTMF_SYMC, DTMF_SYMD, DTMF_SYMS, DTMF_SYMH };
+                unsigned char sym0 = frame[4] & DTMF_SYM_MASK[0];
+                unsigned char sym1 = frame[5] & DTMF_SYM_MASK[1];
+                unsigned char sym2 = frame[7] & DTMF_SYM_MASK[2];
+                unsigned char sym3 = frame[8] & DTMF_SYM_MASK[3];
+                for (auto sym : symbols) {
+                    if (sym0 == sym[0] && sym1 == sym[1] && sym2 == sym[2] && sym3 == sym[3]) {
+                        found++;
+                        break;
+                    }
+                }
+            }
+
+            return found;
+        });
+
+        double classifierRate = framesPerSecond([](const unsigned char* frame) {
+            char digit;
+            unsigned int classes = CAMBEClassifier::classify(frame, digit);
+            return ((classes & AMBE_CLASS_SILENCE) != 0U ? 1U : 0U) + ((classes & AMBE_CLASS_FAST_DATA) != 0U ? 1U : 0U) + ((classes & AMBE_CLASS_DTMF) != 0U ? 1U : 0U);
+        });
+
+        std::cout << "Byte by byte    : " << (unsigned long)byteRate << " frames/s" << std::endl;
+        std::cout << "CAMBEClassifier : " << (unsigned long)classifierRate << " frames/s" << std::endl;
+
+        EXPECT_GT(classifierRate, 0.0);
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "AMBEClassifier.h"
+#include "DTMF.h"
+#include "DStarDefines.h"
+
+namespace AMBEClassifierTests
+{
+    using Frame = std::array<unsigned char, DV_FRAME_LENGTH_BYTES>;
+
+    // What CRepeaterHandler and CDTMF used to do, byte by byte and symbol by symbol
+    static unsigned int reference(const unsigned char* frame, char& digit)
+    {
+        unsigned int classes = AMBE_CLASS_VOICE;
+
+        if (::memcmp(frame, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES) == 0)
+            classes |= AMBE_CLASS_SILENCE;
+
+        bool dtmf = true;
+        for (unsigned int i = 0U; i < VOICE_FRAME_LENGTH_BYTES; i++)
+            dtmf = dtmf && (frame[i] & DTMF_MASK[i]) == DTMF_SIG[i];
+
+        if (dtmf) {
+            const unsigned char* symbols[] = { DTMF_SYM0, DTMF_SYM1, DTMF_SYM2, DTMF_SYM3, DTMF_SYM4, DTMF_SYM5, DTMF_SYM6, DTMF_SYM7,
+                                               DTMF_SYM8, DTMF_SYM9, DTMF_SYMA, DTMF_SYMB, DTMF_SYMC, DTMF_SYMD, DTMF_SYMS, DTMF_SYMH };
+            const char digits[] = "0123456789ABCD*#";
+
+            unsigned char sym[4] = { (unsigned char)(frame[4] & DTMF_SYM_MASK[0]), (unsigned char)(frame[5] & DTMF_SYM_MASK[1]),
+                                     (unsigned char)(frame[7] & DTMF_SYM_MASK[2]), (unsigned char)(frame[8] & DTMF_SYM_MASK[3]) };
+
+            digit = ' ';
+            for (unsigned int i = 0U; i < 16U; i++) {
+                if (::memcmp(sym, symbols[i], 4U) == 0)
+                    digit = digits[i];
+            }
+
+            classes |= AMBE_CLASS_DTMF;
+        }
+
+        unsigned char slowDataType = (frame[VOICE_FRAME_LENGTH_BYTES] ^ SCRAMBLER_BYTE1) & SLOW_DATA_TYPE_MASK;
+        if (slowDataType == SLOW_DATA_TYPE_FAST_DATA1 || slowDataType == SLOW_DATA_TYPE_FAST_DATA2)
+            classes |= AMBE_CLASS_FAST_DATA;
+
+        return classes;
+    }
+
+    // Same as Tests/DTMF
+    static Frame makeFrame(const unsigned char sym[4])
+    {
+        Frame frame;
+        ::memcpy(frame.data(), DTMF_SIG, VOICE_FRAME_LENGTH_BYTES);
+        frame[4] |= sym[0];
+        frame[5] |= sym[1];
+        frame[7] |= sym[2];
+        frame[8] |= sym[3];
+        ::memcpy(frame.data() + VOICE_FRAME_LENGTH_BYTES, DATA_SYNC_BYTES, DATA_FRAME_LENGTH_BYTES);
+        return frame;
+    }
+
+    class AMBEClassifier_classify : public ::testing::Test {};
+
+    TEST_F(AMBEClassifier_classify, everyDTMFDigit)
+    {
+        const unsigned char* symbols[] = { DTMF_SYM0, DTMF_SYM1, DTMF_SYM2, DTMF_SYM3, DTMF_SYM4, DTMF_SYM5, DTMF_SYM6, DTMF_SYM7,
+                                           DTMF_SYM8, DTMF_SYM9, DTMF_SYMA, DTMF_SYMB, DTMF_SYMC, DTMF_SYMD, DTMF_SYMS, DTMF_SYMH };
+        const char digits[] = "0123456789ABCD*#";
+
+        for (unsigned int i = 0U; i < 16U; i++) {
+            Frame frame = makeFrame(symbols[i]);
+
+            char digit = ' ';
+            EXPECT_EQ(CAMBEClassifier::classify(frame.data(), digit), AMBE_CLASS_DTMF);
+            EXPECT_EQ(digit, digits[i]);
+        }
+    }
+
+    TEST_F(AMBEClassifier_classify, silenceAndFastData)
+    {
+        Frame frame;
+        ::memcpy(frame.data(), NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+        frame[9]  = SLOW_DATA_TYPE_TEXT ^ SCRAMBLER_BYTE1;
+        frame[10] = 'A' ^ SCRAMBLER_BYTE2;
+        frame[11] = 'B' ^ SCRAMBLER_BYTE3;
+
+        char digit;
+        EXPECT_EQ(CAMBEClassifier::classify(frame.data(), digit), AMBE_CLASS_SILENCE);
+        EXPECT_EQ(CAMBEClassifier::classifyVoice(frame.data(), digit), AMBE_CLASS_SILENCE);
+
+        frame[9] = SLOW_DATA_TYPE_FAST_DATA1 ^ SCRAMBLER_BYTE1;
+        EXPECT_EQ(CAMBEClassifier::classify(frame.data(), digit), AMBE_CLASS_SILENCE | AMBE_CLASS_FAST_DATA);
+
+        frame[9] = (SLOW_DATA_TYPE_FAST_DATA2 | 0x0AU) ^ SCRAMBLER_BYTE1;
+        EXPECT_EQ(CAMBEClassifier::classify(frame.data(), digit), AMBE_CLASS_SILENCE | AMBE_CLASS_FAST_DATA);
+
+        frame[8] ^= 0x01U;
+        EXPECT_EQ(CAMBEClassifier::classify(frame.data(), digit), AMBE_CLASS_FAST_DATA) << "Only the exact silence pattern is silence";
+    }
+
+    TEST_F(AMBEClassifier_classify, sameAsByteByByte)
+    {
+        std::mt19937 random(20260101U);
+        std::uniform_int_distribution<unsigned int> byte(0U, 255U);
+
+        unsigned int dtmf = 0U;
+        for (unsigned int n = 0U; n < 200000U; n++) {
+            Frame frame;
+            for (auto& b : frame)
+                b = (unsigned char)byte(random);
+
+            // Random bytes hardly ever look like DTMF, force the signature on half of them
+            if ((n % 2U) == 0U) {
+                for (unsigned int i = 0U; i < VOICE_FRAME_LENGTH_BYTES; i++)
+                    frame[i] = (frame[i] & ~DTMF_MASK[i]) | DTMF_SIG[i];
+            }
+
+            char expectedDigit = ' ', digit = ' ';
+            unsigned int expected = reference(frame.data(), expectedDigit);
+            unsigned int classes  = CAMBEClassifier::classify(frame.data(), digit);
+
+            ASSERT_EQ(classes, expected) << "Frame " << n;
+            if ((expected & AMBE_CLASS_DTMF) != 0U) {
+                ASSERT_EQ(digit, expectedDigit) << "Frame " << n;
+                dtmf++;
+            }
+        }
+
+        EXPECT_GE(dtmf, 100000U);
+    }
+}
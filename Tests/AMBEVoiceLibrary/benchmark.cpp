@@ -0,0 +1,136 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+#include "AMBEFileReader.h"
+
+namespace AMBEVoiceLibraryTests
+{
+    // Loads every language shipped in Data/, twice, the way a time server and the audio unit would
+    class AMBEVoiceLibrary_benchmark : public ::testing::Test {
+    protected:
+        std::filesystem::path m_dir;
+        std::vector<std::string> m_languages;
+
+        void SetUp() override
+        {
+            m_dir = std::filesystem::temp_directory_path() / ("AMBEVoiceLibrary_benchmark_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(m_dir);
+
+            for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::current_path() / "../Data")) {
+                if (entry.path().extension() == ".ambe" || entry.path().extension() == ".indx")
+                    std::filesystem::copy_file(entry.path(), m_dir / entry.path().filename());
+                if (entry.path().extension() == ".indx")
+                    m_languages.push_back(entry.path().stem().string());
+            }
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_dir);
+        }
+
+        static long residentKiB()
+        {
+            long pages = 0L, resident = 0L;
+            FILE* file = ::fopen("/proc/self/statm", "r");
+            if (file != nullptr) {
+                if (::fscanf(file, "%ld %ld", &pages, &resident) != 2)
+                    resident = 0L;
+                ::fclose(file);
+            }
+
+            return resident * ::sysconf(_SC_PAGESIZE) / 1024L;
+        }
+
+        // What every user used to do: its own heap copy of the voice data and a parsed index
+        struct TLegacyCopy {
+            std::vector<unsigned char> m_ambe;
+            std::unordered_map<std::string, std::pair<unsigned int, unsigned int>> m_index;
+        };
+
+        static void loadLegacy(const std::string& base, TLegacyCopy& copy)
+        {
+            std::ifstream ambe(base + ".ambe", std::ios::binary);
+            copy.m_ambe.assign(std::istreambuf_iterator<char>(ambe), std::istreambuf_iterator<char>());
+
+            std::ifstream index(base + ".indx");
+            std::string name;
+            unsigned int start, length;
+            while (index >> name >> start >> length)
+                copy.m_index[name] = std::make_pair(start, length);
+        }
+    };
+
+    TEST_F(AMBEVoiceLibrary_benchmark, DISABLED_loadAllLanguages)
+    {
+        ASSERT_FALSE(m_languages.empty());
+
+        long rss = residentKiB();
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<TLegacyCopy>> copies;
+        for (unsigned int pass = 0U; pass < 2U; pass++) {
+            for (const auto& language : m_languages) {
+                copies.emplace_back(new TLegacyCopy);
+                loadLegacy((m_dir / language).string(), *copies.back());
+            }
+        }
+        double legacyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        long legacyKiB = residentKiB() - rss;
+        copies.clear();
+
+        std::vector<std::unique_ptr<CAMBEFileReader>> readers;
+        auto load = [&]() {
+            readers.clear();
+            for (unsigned int pass = 0U; pass < 2U; pass++) {
+                for (const auto& language : m_languages) {
+                    readers.emplace_back(new CAMBEFileReader((m_dir / (language + ".indx")).string(), (m_dir / (language + ".ambe")).string()));
+                    EXPECT_TRUE(readers.back()->read()) << language;
+                }
+            }
+        };
+
+        // The first start compiles and saves the binary indexes, later starts only map them
+        start = std::chrono::steady_clock::now();
+        load();
+        double coldMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        readers.clear();
+
+        rss = residentKiB();
+        start = std::chrono::steady_clock::now();
+        load();
+        double warmMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        long mappedKiB = residentKiB() - rss;
+
+        std::cout << m_languages.size() << " languages, each loaded twice" << std::endl;
+        std::cout << "heap copies       : " << legacyMs << " ms, " << legacyKiB << " KiB resident" << std::endl;
+        std::cout << "mapped, first run : " << coldMs << " ms" << std::endl;
+        std::cout << "mapped, later runs: " << warmMs << " ms, " << mappedKiB << " KiB resident" << std::endl;
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+
+#include "AMBEVoiceLibrary.h"
+#include "DStarDefines.h"
+
+namespace AMBEVoiceLibraryTests
+{
+    class AMBEVoiceLibrary_get : public ::testing::Test {
+    protected:
+        std::filesystem::path m_dir;
+
+        void SetUp() override
+        {
+            m_dir = std::filesystem::temp_directory_path() / ("AMBEVoiceLibrary_get_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(m_dir);
+            std::filesystem::copy_file(std::filesystem::current_path() / "AMBEFileReader/TIME_fr_FR2.ambe", m_dir / "TIME_fr_FR2.ambe");
+            std::filesystem::copy_file(std::filesystem::current_path() / "AMBEFileReader/TIME_fr_FR2.indx", m_dir / "TIME_fr_FR2.indx");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_dir);
+        }
+
+        std::string indexFile() const { return (m_dir / "TIME_fr_FR2.indx").string(); }
+        std::string ambeFile() const  { return (m_dir / "TIME_fr_FR2.ambe").string(); }
+        std::string binaryFile() const { return (m_dir / "TIME_fr_FR2.indb").string(); }
+    };
+
+    TEST_F(AMBEVoiceLibrary_get, sameFilesAreShared)
+    {
+        auto first  = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+        auto second = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+
+        ASSERT_NE(first, nullptr);
+        EXPECT_EQ(first.get(), second.get()) << "Both users shall share one mapping";
+    }
+
+    TEST_F(AMBEVoiceLibrary_get, binaryIndexIsWrittenAndReused)
+    {
+        unsigned int start1, length1;
+        {
+            auto library = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+            ASSERT_NE(library, nullptr);
+            ASSERT_TRUE(library->find("midi", start1, length1));
+        }
+
+        ASSERT_TRUE(std::filesystem::exists(binaryFile())) << "The compiled index shall be saved next to the .indx";
+        auto written = std::filesystem::last_write_time(binaryFile());
+
+        unsigned int start2, length2;
+        {
+            auto library = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+            ASSERT_NE(library, nullptr);
+            ASSERT_TRUE(library->find("midi", start2, length2));
+        }
+
+        EXPECT_EQ(start1, start2);
+        EXPECT_EQ(length1, length2);
+        EXPECT_EQ(std::filesystem::last_write_time(binaryFile()), written) << "An up to date index shall not be rewritten";
+    }
+
+    TEST_F(AMBEVoiceLibrary_get, corruptBinaryIndexIsRebuilt)
+    {
+        CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+        ASSERT_TRUE(std::filesystem::exists(binaryFile()));
+
+        {
+            std::fstream file(binaryFile(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(sizeof(TAMBEIndexHeader));
+            for (unsigned int i = 0U; i < 64U; i++)
+                file.put(char(0x7F));
+        }
+
+        auto library = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+        ASSERT_NE(library, nullptr);
+
+        unsigned int start, length;
+        EXPECT_TRUE(library->find("midi", start, length));
+        EXPECT_TRUE(library->find(" ", start, length));
+    }
+
+    TEST_F(AMBEVoiceLibrary_get, silenceComesFirst)
+    {
+        auto library = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+        ASSERT_NE(library, nullptr);
+
+        unsigned int start, length;
+        ASSERT_TRUE(library->find(" ", start, length));
+        EXPECT_EQ(start, 0U);
+        EXPECT_EQ(length, AMBE_SILENCE_LENGTH);
+
+        for (unsigned int i = 0U; i < AMBE_SILENCE_LENGTH; i++)
+            EXPECT_EQ(::memcmp(library->getFrame(i), NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES), 0);
+    }
+
+    TEST_F(AMBEVoiceLibrary_get, framesMatchTheFile)
+    {
+        auto library = CAMBEVoiceLibrary::get(indexFile(), ambeFile());
+        ASSERT_NE(library, nullptr);
+
+        std::ifstream file(ambeFile(), std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        ASSERT_EQ(library->getFrameCount(), AMBE_SILENCE_LENGTH + (content.size() - 4U) / VOICE_FRAME_LENGTH_BYTES);
+
+        unsigned int start, length;
+        ASSERT_TRUE(library->find("une", start, length));
+        ASSERT_GT(length, 0U);
+
+        for (unsigned int i = 0U; i < length; i++) {
+            std::size_t offset = 4U + (start + i - AMBE_SILENCE_LENGTH) * VOICE_FRAME_LENGTH_BYTES;
+            EXPECT_EQ(::memcmp(library->getFrame(start + i), content.data() + offset, VOICE_FRAME_LENGTH_BYTES), 0);
+        }
+    }
+
+    TEST_F(AMBEVoiceLibrary_get, missingFiles)
+    {
+        EXPECT_EQ(CAMBEVoiceLibrary::get(indexFile(), "/this/file/does/not/exist"), nullptr);
+        EXPECT_EQ(CAMBEVoiceLibrary::get("/this/file/does/not/exist", ambeFile()), nullptr);
+    }
+}
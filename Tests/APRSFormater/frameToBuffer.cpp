@@ -0,0 +1,60 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include "APRSFormater.h"
+
+namespace APRSFormaterTests
+{
+    class APRSFormater_frameToBuffer : public ::testing::Test {};
+
+    TEST_F(APRSFormater_frameToBuffer, matchesFrameToString)
+    {
+        CAPRSFrame frame("N0CALL", "APRS", { "WIDE1-1", " ", "", "WIDE2-2" }, "Lorem Ipsum", APFT_UNKNOWN);
+
+        std::string expected;
+        EXPECT_TRUE(CAPRSFormater::frameToString(expected, frame));
+
+        char buffer[100U];
+        unsigned int length = CAPRSFormater::frameToBuffer(buffer, sizeof(buffer), frame);
+
+        EXPECT_EQ(length, expected.length());
+        EXPECT_EQ(std::string(buffer, length), "N0CALL>APRS,WIDE1-1,WIDE2-2:Lorem Ipsum");
+    }
+
+    TEST_F(APRSFormater_frameToBuffer, tooSmallBufferIsLeftUntouched)
+    {
+        CAPRSFrame frame("N0CALL", "APRS", { "WIDE1-1" }, "Lorem Ipsum", APFT_UNKNOWN);
+
+        char buffer[20U];
+        ::memset(buffer, 'x', sizeof(buffer));
+
+        EXPECT_EQ(CAPRSFormater::frameToBuffer(buffer, sizeof(buffer), frame), 0U);
+        EXPECT_EQ(buffer[0], 'x');
+    }
+
+    TEST_F(APRSFormater_frameToBuffer, invalidFrame)
+    {
+        CAPRSFrame frame("N0CALL", "", { }, "Lorem Ipsum", APFT_UNKNOWN);
+
+        char buffer[100U];
+        EXPECT_EQ(CAPRSFormater::frameToBuffer(buffer, sizeof(buffer), frame), 0U);
+    }
+}
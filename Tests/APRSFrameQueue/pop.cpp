@@ -0,0 +1,114 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "APRSFrameQueue.h"
+
+namespace APRSFrameQueueTests
+{
+    class APRSFrameQueue_pop : public ::testing::Test {};
+
+    static double threadCpuMs()
+    {
+        timespec ts;
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+    }
+
+    TEST_F(APRSFrameQueue_pop, idleWriterUsesNoCpu)
+    {
+        CAPRSFrameQueue queue;
+        std::atomic<bool> stop(false);
+        double cpuMs = 0.0;
+        unsigned int wakeUps = 0U;
+
+        std::thread writer([&] {
+            double start = threadCpuMs();
+            std::vector<std::string> batch;
+            while (!stop) {
+                queue.pop(batch, 16U, 1000U);
+                wakeUps++;
+            }
+            cpuMs = threadCpuMs() - start;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        stop = true;
+        queue.wakeUp();
+        writer.join();
+
+        std::cout << "Idle writer used " << cpuMs << " ms of CPU in 500 ms, " << wakeUps << " wake ups" << std::endl;
+
+        EXPECT_LT(cpuMs, 20.0);
+        EXPECT_LE(wakeUps, 2U);
+    }
+
+    TEST_F(APRSFrameQueue_pop, burstIsNotLost)
+    {
+        // 50 stations each sending a burst of 5 frames within 50 ms, well above anything seen on RF
+        const unsigned int STATIONS = 50U;
+        const unsigned int FRAMES   = 5U;
+
+        CAPRSFrameQueue queue;
+        unsigned int received = 0U;
+        std::atomic<bool> stop(false);
+
+        std::thread writer([&] {
+            std::vector<std::string> batch;
+            while (!stop || queue.size() > 0U) {
+                batch.clear();
+                received += queue.pop(batch, 16U, 100U);
+            }
+        });
+
+        for (unsigned int i = 0U; i < FRAMES; i++) {
+            for (unsigned int station = 0U; station < STATIONS; station++)
+                EXPECT_TRUE(queue.push("N" + std::to_string(station) + "CALL", "frame"));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        stop = true;
+        queue.wakeUp();
+        writer.join();
+
+        TAPRSQueueStats stats = queue.getStats();
+        EXPECT_EQ(received, STATIONS * FRAMES);
+        EXPECT_EQ(stats.queued, (unsigned long long)(STATIONS * FRAMES));
+        EXPECT_EQ(stats.dropped, 0ULL);
+        EXPECT_EQ(stats.limited, 0ULL);
+    }
+
+    TEST_F(APRSFrameQueue_pop, batchIsBounded)
+    {
+        CAPRSFrameQueue queue(100U, 100U, 0U);
+        for (unsigned int i = 0U; i < 50U; i++)
+            queue.push("N0CALL", "x");
+
+        std::vector<std::string> batch;
+        EXPECT_EQ(queue.pop(batch, 16U, 0U), 16U);
+        EXPECT_EQ(queue.size(), 34U);
+    }
+}
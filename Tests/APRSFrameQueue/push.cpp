@@ -0,0 +1,71 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "APRSFrameQueue.h"
+
+namespace APRSFrameQueueTests
+{
+    class APRSFrameQueue_push : public ::testing::Test {};
+
+    TEST_F(APRSFrameQueue_push, fullQueueDropsOldest)
+    {
+        CAPRSFrameQueue queue(4U, 100U, 0U);
+
+        for (unsigned int i = 0U; i < 4U; i++)
+            EXPECT_TRUE(queue.push("N0CALL", std::to_string(i)));
+
+        EXPECT_FALSE(queue.push("N0CALL", "4"));
+
+        std::vector<std::string> batch;
+        EXPECT_EQ(queue.pop(batch, 100U, 0U), 4U);
+        EXPECT_EQ(batch.front(), "1");
+        EXPECT_EQ(batch.back(), "4");
+
+        TAPRSQueueStats stats = queue.getStats();
+        EXPECT_EQ(stats.queued, 5ULL);
+        EXPECT_EQ(stats.dropped, 1ULL);
+        EXPECT_EQ(stats.limited, 0ULL);
+    }
+
+    TEST_F(APRSFrameQueue_push, rateLimitsEachSource)
+    {
+        CAPRSFrameQueue queue(100U, 3U, 60U);
+        auto now = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0U; i < 3U; i++)
+            EXPECT_TRUE(queue.push("F4FXL", "x", now));
+        EXPECT_FALSE(queue.push("F4FXL", "x", now));
+
+        // Another station is not penalised by the first one
+        EXPECT_TRUE(queue.push("KC3FRA", "x", now));
+
+        // One frame per second comes back
+        EXPECT_FALSE(queue.push("F4FXL", "x", now + std::chrono::milliseconds(500)));
+        EXPECT_TRUE(queue.push("F4FXL", "x", now + std::chrono::milliseconds(1500)));
+
+        TAPRSQueueStats stats = queue.getStats();
+        EXPECT_EQ(stats.queued, 5ULL);
+        EXPECT_EQ(stats.limited, 2ULL);
+        EXPECT_EQ(queue.size(), 5U);
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <gtest/gtest.h>
+
+#include "APRSParser.h"
+#include "APRSFormater.h"
+
+namespace APRSParserTests
+{
+    class APRSParser_benchmark : public ::testing::Test {
+    protected:
+        static constexpr unsigned int FRAMES = 200000U;
+        static constexpr unsigned int ROUNDS = 5U;
+
+        // What an inbound feed mixed with DPRS looks like
+        const std::vector<std::string> m_frames = {
+            "F4FXL-8>API51,DSTAR:!1234.56N/12345.67E[/A=000886QRV DStar\r\r\n",
+            "N0CALL>APRS,WIDE1-1,WIDE2-2::F4ABC    :Test Message{12",
+            "F5ZEE-C>APRS::F5ZEE-C  :EQNS.0,0.16016,-40,0,0,0,0,0,0,0,0,0,0,0,0",
+            "F8DSN-15>API510,DSTAR*,qAR,F8DSN-B:;F1ZBV    *091510h4802.40N/00647.12ErPHG7430/A=003182R Vosges",
+            "KC3FRA>APDG01,TCPIP*,qAC,T2ROMANIA:>DStar gateway status",
+            "F5ZEE-C>APRS:T#581,342,000,000,000,000,00000000"
+        };
+
+        // The split and copy parser this replaced, kept to measure against
+        static bool legacyParse(const std::string& frameStr, CAPRSFrame& frame)
+        {
+            frame.clear();
+
+            auto pos = frameStr.find_first_of(':');
+            if(pos == std::string::npos || pos == frameStr.length() - 1)
+                return false;
+
+            auto header = frameStr.substr(0, pos);
+            auto body = frameStr.substr(pos + 1);
+
+            std::vector<std::string> headerSplits;
+            boost::split(headerSplits, header, [](char c) { return c == ',' || c == '>';});
+            if(headerSplits.size() < 2 || std::any_of(headerSplits.begin(), headerSplits.end(), [](std::string s){ return s.empty(); }))
+                return false;
+
+            frame.getSource().assign(headerSplits[0]);
+            frame.getDestination().assign(headerSplits[1]);
+            for(unsigned int i = 2; i < headerSplits.size(); i++)
+                frame.getPath().push_back(headerSplits[i]);
+
+            frame.getBody().assign(body);
+            frame.getType() = CAPRSParser::parseType(frame.getBody(), frame.getSource());
+
+            return frame.getType() != APFT_UNKNOWN;
+        }
+
+        template<typename F> double framesPerSecond(F process)
+        {
+            double best = 0.0;
+            for (unsigned int round = 0U; round < ROUNDS; round++) {
+                unsigned int done = 0U;
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned int n = 0U; n < FRAMES; n++)
+                    done += process(m_frames[n % m_frames.size()]);
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                EXPECT_EQ(done, FRAMES);
+                best = std::max(best, FRAMES / elapsed);
+            }
+
+            return best;
+        }
+    };
+
+    TEST_F(APRSParser_benchmark, DISABLED_parseAndFormat)
+    {
+        CAPRSFrame frame;
+        std::string output;
+
+        double legacy = framesPerSecond([&](const std::string& raw) {
+            CAPRSFrame fresh;
+            std::string formatted;
+            return legacyParse(raw, fresh) && CAPRSFormater::frameToString(formatted, fresh) ? 1U : 0U;
+        });
+
+        double current = framesPerSecond([&](const std::string& raw) {
+            return CAPRSParser::parseFrame(raw, frame) && CAPRSFormater::frameToString(output, frame) ? 1U : 0U;
+        });
+
+        std::cout << "APRS parse and format, split and copy: " << unsigned(legacy) << " frames/s, string_view: " << unsigned(current) << " frames/s" << std::endl;
+
+        EXPECT_GT(current, 0.0);
+    }
+}
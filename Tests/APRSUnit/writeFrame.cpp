@@ -0,0 +1,183 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "APRSUnit.h"
+
+namespace APRSUnitTests
+{
+    class CRecordingCallback : public IRepeaterCallback {
+    public:
+        bool process(CHeaderData& header, DIRECTION, AUDIO_SOURCE) override
+        {
+            m_yourCalls.push_back(header.getYourCall());
+            return true;
+        }
+
+        bool process(CAMBEData& data, DIRECTION, AUDIO_SOURCE) override
+        {
+            m_ends += data.isEnd() ? 1U : 0U;
+            return true;
+        }
+
+        std::vector<std::string> m_yourCalls;
+        unsigned int m_ends = 0U;
+    };
+
+    class APRSUnit_writeFrame : public ::testing::Test {
+    protected:
+        static CAPRSFrame message(const std::string& recipient, const std::string& text)
+        {
+            std::string addressee(recipient);
+            addressee.resize(9U, ' ');
+            return CAPRSFrame("KC3FRA", "APRS", { "WIDE1-1" }, ":" + addressee + ":" + text, APFT_MESSAGE);
+        }
+
+        static CAPRSFrame status(const std::string& text)
+        {
+            return CAPRSFrame("KC3FRA", "APRS", { "WIDE1-1" }, ">" + text, APFT_STATUS);
+        }
+
+        // Clocks the unit in real time until the transmission in progress has ended
+        static void transmit(CAPRSUnit& unit, CRecordingCallback& callback)
+        {
+            unsigned int ends = callback.m_ends;
+            for (unsigned int i = 0U; i < 500U && callback.m_ends == ends; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                unit.clock(20U);
+            }
+        }
+    };
+
+    TEST_F(APRSUnit_writeFrame, duplicatesAreSuppressed)
+    {
+        CRecordingCallback callback;
+        CAPRSUnit unit(&callback);
+
+        CAPRSFrame frame = message("F4FXL", "Salut");
+        unit.writeFrame(frame);
+
+        // Same frame coming in through another igate
+        CAPRSFrame other = message("F4FXL", "Salut");
+        other.getPath() = { "TCPIP*", "qAC", "T2ROMANIA" };
+        unit.writeFrame(other);
+
+        EXPECT_EQ(unit.getQueued(), 1U);
+        EXPECT_EQ(unit.getStats().duplicates, 1ULL);
+
+        // Sending it empties the queue, once the window has passed the frame is new again
+        unit.clock(APRS_DUPLICATE_WINDOW_MS);
+        EXPECT_EQ(unit.getQueued(), 0U);
+
+        unit.writeFrame(frame);
+        EXPECT_EQ(unit.getQueued(), 1U);
+        EXPECT_EQ(unit.getStats().received, 3ULL);
+        EXPECT_EQ(unit.getStats().duplicates, 1ULL);
+    }
+
+    TEST_F(APRSUnit_writeFrame, otherFramesAreNotQueued)
+    {
+        CRecordingCallback callback;
+        CAPRSUnit unit(&callback);
+
+        CAPRSFrame frame = status("QRV");
+        unit.writeFrame(frame);
+        EXPECT_EQ(unit.getQueued(), 0U);
+        EXPECT_EQ(unit.getStats().unsupported, 1ULL);
+
+        // Nothing was remembered of it either
+        unit.writeFrame(frame);
+        EXPECT_EQ(unit.getStats().unsupported, 2ULL);
+        EXPECT_EQ(unit.getStats().duplicates, 0ULL);
+        EXPECT_EQ(unit.getStats().dropped, 0ULL);
+    }
+
+    TEST_F(APRSUnit_writeFrame, fullQueuePushesOutTheOldestMessage)
+    {
+        CRecordingCallback callback;
+        CAPRSUnit unit(&callback);
+
+        for (unsigned int i = 0U; i < APRS_QUEUE_DEPTH; i++) {
+            CAPRSFrame frame = message("G4KLX", std::to_string(i));
+            unit.writeFrame(frame);
+        }
+
+        CAPRSFrame msg = message("F4FXL", "Salut");
+        unit.writeFrame(msg);
+        EXPECT_EQ(unit.getQueued(), APRS_QUEUE_DEPTH);
+        EXPECT_EQ(unit.getStats().dropped, 1ULL);
+
+        // A copy of a message that was pushed out is still a duplicate within the window
+        CAPRSFrame first = message("G4KLX", "0");
+        unit.writeFrame(first);
+        EXPECT_EQ(unit.getStats().duplicates, 1ULL);
+
+        // The oldest message left goes out first
+        unit.clock(3000U);
+        ASSERT_EQ(callback.m_yourCalls.size(), 1U);
+        EXPECT_EQ(callback.m_yourCalls[0], "G4KLX   ");
+    }
+
+    TEST_F(APRSUnit_writeFrame, airtimeBudgetIsEnforced)
+    {
+        CRecordingCallback callback;
+        CAPRSUnit unit(&callback, 4000U, 60000U);
+
+        CAPRSFrame first = message("F4FXL", "Salut, comment vas tu?");
+        CAPRSFrame second = message("G4KLX", "Hello Jonathan");
+        unit.writeFrame(first);
+        unit.writeFrame(second);
+
+        unit.clock(3000U);
+        ASSERT_EQ(callback.m_yourCalls.size(), 1U);
+        unsigned int used = unit.getStats().airtimeMs;
+        EXPECT_GT(used, 0U);
+        EXPECT_LT(unit.getAirtimeAvailable(), 4000U);
+
+        transmit(unit, callback);
+        EXPECT_EQ(callback.m_ends, 1U);
+
+        // Not enough budget left for the second message yet
+        unit.clock(20U);
+        EXPECT_EQ(callback.m_yourCalls.size(), 1U);
+
+        unit.clock(60000U);
+        ASSERT_EQ(callback.m_yourCalls.size(), 2U);
+        EXPECT_EQ(callback.m_yourCalls[1], "G4KLX   ");
+        EXPECT_EQ(unit.getStats().transmitted, 2ULL);
+    }
+
+    TEST_F(APRSUnit_writeFrame, messageLongerThanBudgetIsDropped)
+    {
+        CRecordingCallback callback;
+        CAPRSUnit unit(&callback, 100U, 60000U);
+
+        CAPRSFrame msg = message("F4FXL", "Salut");
+        unit.writeFrame(msg);
+        unit.clock(3000U);
+
+        EXPECT_TRUE(callback.m_yourCalls.empty());
+        EXPECT_EQ(unit.getStats().dropped, 1ULL);
+        EXPECT_EQ(unit.getStats().transmitted, 0ULL);
+    }
+}
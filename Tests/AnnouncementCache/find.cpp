@@ -0,0 +1,101 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AnnouncementCache.h"
+
+namespace AnnouncementCacheTests
+{
+    class AnnouncementCache_find : public ::testing::Test {
+    protected:
+        static std::shared_ptr<const std::vector<unsigned char>> frames(unsigned char value)
+        {
+            return std::make_shared<const std::vector<unsigned char>>(12U, value);
+        }
+    };
+
+    TEST_F(AnnouncementCache_find, missThenHit)
+    {
+        CAnnouncementCache cache(4U);
+
+        EXPECT_EQ(cache.find("linked to XLX307 B"), nullptr);
+        cache.insert("linked to XLX307 B", frames(1U));
+
+        auto found = cache.find("linked to XLX307 B");
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->at(0), 1U);
+
+        EXPECT_EQ(cache.getHits(), 1ULL);
+        EXPECT_EQ(cache.getMisses(), 1ULL);
+        EXPECT_DOUBLE_EQ(cache.getHitRate(), 0.5);
+    }
+
+    TEST_F(AnnouncementCache_find, leastRecentlyUsedIsEvicted)
+    {
+        CAnnouncementCache cache(2U);
+
+        cache.insert("a", frames(1U));
+        cache.insert("b", frames(2U));
+        cache.find("a");
+        cache.insert("c", frames(3U));
+
+        EXPECT_EQ(cache.size(), 2U);
+        EXPECT_NE(cache.find("a"), nullptr);
+        EXPECT_EQ(cache.find("b"), nullptr) << "b was the least recently used";
+        EXPECT_NE(cache.find("c"), nullptr);
+    }
+
+    TEST_F(AnnouncementCache_find, evictedEntryStaysValidForItsUser)
+    {
+        CAnnouncementCache cache(1U);
+
+        cache.insert("not linked", frames(7U));
+        auto playing = cache.find("not linked");
+        cache.insert("linked to REF001 C", frames(8U));
+
+        EXPECT_EQ(cache.find("not linked"), nullptr);
+        ASSERT_NE(playing, nullptr);
+        EXPECT_EQ(playing->at(11), 7U);
+    }
+
+    TEST_F(AnnouncementCache_find, insertReplacesExisting)
+    {
+        CAnnouncementCache cache(2U);
+
+        cache.insert("a", frames(1U));
+        cache.insert("a", frames(2U));
+
+        EXPECT_EQ(cache.size(), 1U);
+        EXPECT_EQ(cache.find("a")->at(0), 2U);
+    }
+
+    TEST_F(AnnouncementCache_find, clearEmptiesTheCache)
+    {
+        CAnnouncementCache cache(2U);
+
+        cache.insert("a", frames(1U));
+        cache.clear();
+
+        EXPECT_EQ(cache.size(), 0U);
+        EXPECT_EQ(cache.find("a"), nullptr);
+    }
+}
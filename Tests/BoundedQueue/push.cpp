@@ -0,0 +1,51 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BoundedQueue.h"
+
+namespace BoundedQueueTests
+{
+    class BoundedQueue_push : public ::testing::Test {};
+
+    TEST_F(BoundedQueue_push, fullQueueRefusesNewEntries)
+    {
+        CBoundedQueue<unsigned int> queue(3U);
+
+        for (unsigned int i = 0U; i < 3U; i++)
+            EXPECT_TRUE(queue.push(i));
+
+        EXPECT_FALSE(queue.push(3U));
+        EXPECT_EQ(queue.size(), 3U);
+        EXPECT_EQ(queue.getDropped(), 1U);
+
+        // Nothing was overwritten
+        unsigned int value = 99U;
+        EXPECT_TRUE(queue.peek(value));
+        EXPECT_EQ(value, 0U);
+
+        for (unsigned int i = 0U; i < 3U; i++) {
+            EXPECT_TRUE(queue.pop(value));
+            EXPECT_EQ(value, i);
+        }
+
+        EXPECT_TRUE(queue.empty());
+        EXPECT_FALSE(queue.pop(value));
+    }
+}
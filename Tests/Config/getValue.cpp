@@ -54,4 +54,17 @@ namespace ConfigTests
         EXPECT_TRUE(ret);
         EXPECT_STREQ(value.c_str(), "http://xlxapi.rlx.lu/api.php?do=GetXLXDMRMaster");
     }
-}
\ No newline at end of file
+
+    TEST_F(Config_getValue, getAllowedValue)
+    {
+        CConfig config(m_configPath);
+
+        bool ret = config.load();
+        std::string value;
+        bool valid = config.getValue("Repeater 1", "Type", value, "", {"HB", "Icom", "Dummy"});
+
+        EXPECT_TRUE(ret);
+        EXPECT_TRUE(valid);
+        EXPECT_STREQ(value.c_str(), "Icom");
+    }
+}
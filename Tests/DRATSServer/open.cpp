@@ -0,0 +1,198 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "DRATSEventLoop.h"
+#include "DRATSServer.h"
+#include "DStarDefines.h"
+
+namespace DRATSServerTests
+{
+    const unsigned int MODULES = 4U;
+    const unsigned int BASE_PORT = 47300U;
+
+    class Callback : public IRepeaterCallback {
+    public:
+        bool process(CHeaderData&, DIRECTION, AUDIO_SOURCE) override
+        {
+            m_headers++;
+            return true;
+        }
+
+        bool process(CAMBEData& data, DIRECTION, AUDIO_SOURCE) override
+        {
+            if (data.isEnd())
+                m_ends++;
+            return true;
+        }
+
+        std::atomic<unsigned int> m_headers{ 0U };
+        std::atomic<unsigned int> m_ends{ 0U };
+    };
+
+    class DRATSServer_open : public ::testing::Test {
+    protected:
+        static unsigned int threads()
+        {
+            unsigned int count = 0U;
+            DIR* dir = ::opendir("/proc/self/task");
+            while (dir != nullptr && ::readdir(dir) != nullptr)
+                count++;
+            if (dir != nullptr)
+                ::closedir(dir);
+            return count - 2U;
+        }
+
+        static unsigned long rssKiB()
+        {
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            while (std::getline(status, line)) {
+                if (line.compare(0U, 6U, "VmRSS:") == 0)
+                    return std::stoul(line.substr(6U));
+            }
+            return 0UL;
+        }
+
+        static int connect(unsigned int port)
+        {
+            int fd = ::socket(PF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr;
+            ::memset(&addr, 0x00, sizeof(addr));
+            addr.sin_family      = AF_INET;
+            addr.sin_port        = htons(port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (::connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+                ::close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        // Two frames of GPS slow data carry up to five bytes
+        static void writeText(CDRATSServer& server, const std::string& text)
+        {
+            for (unsigned int pos = 0U; pos < text.size(); pos += 5U) {
+                unsigned int length = std::min<unsigned int>(5U, text.size() - pos);
+
+                unsigned char slowData[6U];
+                ::memset(slowData, 'f', 6U);
+                slowData[0U] = SLOW_DATA_TYPE_GPS | length;
+                ::memcpy(slowData + 1U, text.data() + pos, length);
+
+                for (unsigned int half = 0U; half < 2U; half++) {
+                    unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+                    ::memcpy(buffer, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+                    buffer[VOICE_FRAME_LENGTH_BYTES + 0U] = slowData[half * 3U + 0U] ^ SCRAMBLER_BYTE1;
+                    buffer[VOICE_FRAME_LENGTH_BYTES + 1U] = slowData[half * 3U + 1U] ^ SCRAMBLER_BYTE2;
+                    buffer[VOICE_FRAME_LENGTH_BYTES + 2U] = slowData[half * 3U + 2U] ^ SCRAMBLER_BYTE3;
+
+                    CAMBEData data;
+                    data.setSeq(1U);
+                    data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+                    server.writeData(data);
+                }
+            }
+        }
+    };
+
+    TEST_F(DRATSServer_open, modulesShareOneThread)
+    {
+        unsigned int threadsBefore = threads();
+        unsigned long rssBefore = rssKiB();
+
+        CDRATSEventLoop loop;
+        ASSERT_TRUE(loop.start());
+
+        Callback callback;
+        CDRATSServer* servers[MODULES];
+        for (unsigned int i = 0U; i < MODULES; i++) {
+            servers[i] = new CDRATSServer("127.0.0.1", BASE_PORT + i, "F4FXL  " + std::string(1U, 'A' + i), &callback, &loop);
+            ASSERT_TRUE(servers[i]->open());
+        }
+
+        EXPECT_EQ(threads(), threadsBefore + 1U);
+        std::cout << MODULES << " D-RATS modules : " << threads() - threadsBefore << " thread(s), " << rssKiB() - rssBefore << " KiB RSS" << std::endl;
+
+        for (unsigned int i = 0U; i < MODULES; i++) {
+            servers[i]->close();
+            delete servers[i];
+        }
+
+        loop.stop();
+    }
+
+    TEST_F(DRATSServer_open, messagesGoBothWays)
+    {
+        CDRATSEventLoop loop;
+        ASSERT_TRUE(loop.start());
+
+        Callback callback;
+        CDRATSServer server("127.0.0.1", BASE_PORT + MODULES, "F4FXL  B", &callback, &loop);
+        ASSERT_TRUE(server.open());
+
+        int fd = connect(BASE_PORT + MODULES);
+        ASSERT_GE(fd, 0);
+
+        // From the network to RF
+        const char message[] = "[SOB]hello[EOB]";
+        ASSERT_EQ(::send(fd, message, sizeof(message) - 1U, 0), ssize_t(sizeof(message) - 1U));
+
+        for (unsigned int i = 0U; i < 200U && callback.m_ends == 0U; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        EXPECT_EQ(callback.m_headers, 1U);
+        EXPECT_EQ(callback.m_ends, 1U);
+
+        // From RF to the network, once the connection has been accepted
+        CHeaderData header;
+        server.writeHeader(header);
+        writeText(server, "[SOB]world[EOB]");
+
+        timeval tv = { 2L, 0L };
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        std::string received;
+        char buffer[100U];
+        while (received.find("[EOB]") == std::string::npos) {
+            ssize_t len = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (len <= 0)
+                break;
+            received.append(buffer, len);
+        }
+
+        EXPECT_EQ(received, "[SOB]world[EOB]");
+
+        ::close(fd);
+        server.close();
+        loop.stop();
+    }
+}
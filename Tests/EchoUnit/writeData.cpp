@@ -0,0 +1,217 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "EchoUnit.h"
+#include "DStarDefines.h"
+
+// Counts every allocation made through operator new in the test binary
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+static std::atomic<unsigned long> g_allocations(0UL);
+
+void* operator new(std::size_t size)
+{
+    g_allocations++;
+    void* p = std::malloc(size == 0U ? 1U : size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#pragma GCC diagnostic pop
+
+namespace EchoUnitTests
+{
+    class CRecordingCallback : public IRepeaterCallback {
+    public:
+        bool process(CHeaderData&, DIRECTION, AUDIO_SOURCE) override
+        {
+            m_headers++;
+            return true;
+        }
+
+        bool process(CAMBEData& data, DIRECTION, AUDIO_SOURCE) override
+        {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            data.getData(buffer, DV_FRAME_LENGTH_BYTES);
+            m_frames.push_back(buffer[0]);
+            m_ends += data.isEnd() ? 1U : 0U;
+            return true;
+        }
+
+        unsigned int m_headers = 0U;
+        unsigned int m_ends = 0U;
+        std::vector<unsigned char> m_frames;
+    };
+
+    class EchoUnit_writeData : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            // Room for two minutes of recording
+            CEchoUnit::initialise(2U * 60U * DSTAR_FRAMES_PER_SEC * sizeof(TEchoFrame));
+        }
+
+        void TearDown() override
+        {
+            CEchoUnit::finalise();
+        }
+
+        static CHeaderData header()
+        {
+            CHeaderData header;
+            header.setMyCall1("F4FXL");
+            return header;
+        }
+
+        static CAMBEData frame(unsigned int n, bool end = false)
+        {
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES] = { 0 };
+            buffer[0] = (unsigned char)n;
+
+            CAMBEData data;
+            data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+            data.setId(0x1234U);
+            data.setSeq(n % 21U);
+            data.setEnd(end);
+            return data;
+        }
+
+        static long residentKiB()
+        {
+            long pages = 0L, resident = 0L;
+            FILE* file = ::fopen("/proc/self/statm", "r");
+            if (file != nullptr) {
+                if (::fscanf(file, "%ld %ld", &pages, &resident) != 2)
+                    resident = 0L;
+                ::fclose(file);
+            }
+
+            return resident * ::sysconf(_SC_PAGESIZE) / 1024L;
+        }
+    };
+
+    TEST_F(EchoUnit_writeData, recordsAndPlaysBack)
+    {
+        CRecordingCallback callback;
+        CEchoUnit echo(&callback, "F4FXL  G");
+
+        echo.writeHeader(header());
+        for (unsigned int i = 0U; i < 10U; i++)
+            echo.writeData(frame(i, i == 9U));
+
+        echo.clock(REPLY_TIME * 1000U);
+        EXPECT_EQ(callback.m_headers, 1U);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(12U * DSTAR_FRAME_TIME_MS));
+        echo.clock(0U);
+
+        ASSERT_EQ(callback.m_frames.size(), 10U);
+        for (unsigned int i = 0U; i < 10U; i++)
+            EXPECT_EQ(callback.m_frames[i], i);
+        EXPECT_EQ(callback.m_ends, 1U);
+    }
+
+    TEST_F(EchoUnit_writeData, concurrentModulesShareThePool)
+    {
+        CRecordingCallback callback1, callback2, callback3;
+        CEchoUnit echo1(&callback1, "F4FXL  A");
+        CEchoUnit echo2(&callback2, "F4FXL  B");
+        CEchoUnit echo3(&callback3, "F4FXL  C");
+
+        echo1.writeHeader(header());
+        echo2.writeHeader(header());
+        echo3.writeHeader(header());
+
+        // The pool holds two minutes, the three recordings share it as they grow and get truncated
+        for (unsigned int i = 0U; i < 60U * DSTAR_FRAMES_PER_SEC; i++) {
+            echo1.writeData(frame(i));
+            echo2.writeData(frame(i));
+            echo3.writeData(frame(i));
+        }
+
+        echo1.cancel();
+        echo2.cancel();
+        echo3.cancel();
+
+        // Everything went back to the pool, a new recording can use it all
+        echo3.writeHeader(header());
+        for (unsigned int i = 0U; i < 60U * DSTAR_FRAMES_PER_SEC; i++)
+            echo3.writeData(frame(i));
+        echo3.cancel();
+    }
+
+    TEST_F(EchoUnit_writeData, oneMinuteAllocationsAndMemory)
+    {
+        const unsigned int FRAMES = 60U * DSTAR_FRAMES_PER_SEC;
+
+        std::vector<CAMBEData> input;
+        for (unsigned int i = 0U; i < FRAMES; i++)
+            input.push_back(frame(i));
+
+        // What recording used to cost, one heap copy per frame
+        long rss = residentKiB();
+        unsigned long allocations = g_allocations;
+        std::vector<CAMBEData*> copies(FRAMES, nullptr);
+        for (unsigned int i = 0U; i < FRAMES; i++)
+            copies[i] = new CAMBEData(input[i]);
+        unsigned long oldAllocations = g_allocations - allocations;
+        long oldKiB = residentKiB() - rss;
+        for (auto copy : copies)
+            delete copy;
+
+        CRecordingCallback callback;
+        CEchoUnit echo(&callback, "F4FXL  G");
+        echo.writeHeader(header());
+
+        rss = residentKiB();
+        allocations = g_allocations;
+        for (unsigned int i = 0U; i < FRAMES; i++)
+            echo.writeData(input[i]);
+        unsigned long newAllocations = g_allocations - allocations;
+        long newKiB = residentKiB() - rss;
+
+        echo.cancel();
+
+        std::cout << "heap copies : " << oldAllocations << " allocations, " << oldKiB << " KiB resident" << std::endl;
+        std::cout << "frame pool  : " << newAllocations << " allocations, " << newKiB << " KiB resident (" << FRAMES * sizeof(TEchoFrame) / 1024U << " KiB of slots)" << std::endl;
+
+        EXPECT_EQ(newAllocations, 0UL) << "Recording shall not allocate";
+        EXPECT_GE(oldAllocations, FRAMES);
+    }
+}
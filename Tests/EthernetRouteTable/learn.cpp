@@ -0,0 +1,130 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "EthernetRouteTable.h"
+
+namespace EthernetRouteTableTests
+{
+    class EthernetRouteTable_learn : public ::testing::Test {
+    protected:
+        static void address(unsigned char* addr, unsigned int n)
+        {
+            addr[0U] = 0x02U;
+            addr[1U] = 0x00U;
+            addr[2U] = 0x00U;
+            addr[3U] = (n >> 16) & 0xFFU;
+            addr[4U] = (n >> 8) & 0xFFU;
+            addr[5U] = n & 0xFFU;
+        }
+    };
+
+    TEST_F(EthernetRouteTable_learn, learntRouteIsFound)
+    {
+        CEthernetRouteTable table(8U, 60U);
+        unsigned char addr[ETHERNET_ADDRESS_LENGTH];
+        address(addr, 1U);
+
+        std::string callsign;
+        EXPECT_FALSE(table.find(addr, callsign));
+
+        EXPECT_TRUE(table.learn(addr, "F4FXL   "));
+        EXPECT_FALSE(table.learn(addr, "F4FXL   "));
+
+        EXPECT_TRUE(table.find(addr, callsign));
+        EXPECT_EQ(callsign, "F4FXL   ");
+        EXPECT_EQ(table.size(), 1U);
+    }
+
+    TEST_F(EthernetRouteTable_learn, routesAgeOut)
+    {
+        CEthernetRouteTable table(8U, 60U);
+        auto now = std::chrono::steady_clock::now();
+        unsigned char addr1[ETHERNET_ADDRESS_LENGTH];
+        unsigned char addr2[ETHERNET_ADDRESS_LENGTH];
+        address(addr1, 1U);
+        address(addr2, 2U);
+
+        table.learn(addr1, "F4FXL   ", now);
+        table.learn(addr2, "KC3FRA  ", now + std::chrono::seconds(30));
+
+        EXPECT_EQ(table.expire(now + std::chrono::seconds(61)), 1U);
+
+        std::string callsign;
+        EXPECT_FALSE(table.find(addr1, callsign));
+        EXPECT_TRUE(table.find(addr2, callsign));
+        EXPECT_EQ(callsign, "KC3FRA  ");
+    }
+
+    TEST_F(EthernetRouteTable_learn, oldestRouteMakesWayWhenFull)
+    {
+        CEthernetRouteTable table(3U, 3600U);
+        auto now = std::chrono::steady_clock::now();
+        unsigned char addr[ETHERNET_ADDRESS_LENGTH];
+
+        address(addr, 1U);
+        table.learn(addr, "F4FXL   ", now);
+        address(addr, 2U);
+        table.learn(addr, "KC3FRA  ", now + std::chrono::seconds(1));
+        address(addr, 3U);
+        table.learn(addr, "G4KLX   ", now + std::chrono::seconds(2));
+
+        // Hearing the first station again makes the second one the oldest
+        address(addr, 1U);
+        table.learn(addr, "F4FXL   ", now + std::chrono::seconds(3));
+
+        address(addr, 4U);
+        EXPECT_TRUE(table.learn(addr, "DL5DI   ", now + std::chrono::seconds(4)));
+
+        std::string callsign;
+        EXPECT_EQ(table.size(), 3U);
+        EXPECT_EQ(table.getEvicted(), 1ULL);
+        address(addr, 2U);
+        EXPECT_FALSE(table.find(addr, callsign));
+        address(addr, 1U);
+        EXPECT_TRUE(table.find(addr, callsign));
+    }
+
+    TEST_F(EthernetRouteTable_learn, staticRoutesStay)
+    {
+        const unsigned char broadcast[] = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU };
+
+        CEthernetRouteTable table(2U, 60U);
+        auto now = std::chrono::steady_clock::now();
+        table.addStatic(broadcast, "        ");
+
+        unsigned char addr[ETHERNET_ADDRESS_LENGTH];
+        address(addr, 1U);
+        table.learn(addr, "F4FXL   ", now);
+        address(addr, 2U);
+        EXPECT_TRUE(table.learn(addr, "KC3FRA  ", now + std::chrono::seconds(1)));
+
+        // A station cannot take over a static route either
+        EXPECT_FALSE(table.learn(broadcast, "F4FXL   ", now));
+
+        table.expire(now + std::chrono::hours(24));
+
+        std::string callsign;
+        EXPECT_TRUE(table.find(broadcast, callsign));
+        EXPECT_EQ(callsign, "        ");
+        EXPECT_EQ(table.size(), 1U);
+    }
+}
@@ -0,0 +1,194 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "G2FanOut.h"
+#include "DStarDefines.h"
+
+namespace G2FanOutTests
+{
+    struct TReceived {
+        std::chrono::steady_clock::time_point time;
+        unsigned int length;
+        unsigned int id;
+        unsigned int seq;
+    };
+
+    // A plain blocking socket on the loopback, timestamping every packet as it comes in
+    class G2FanOut_send : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            m_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+            ASSERT_GE(m_fd, 0);
+
+            int size = 1024 * 1024;
+            ::setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+            timeval tv = { 0, 200000 };
+            ::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+            sockaddr_in addr;
+            ::memset(&addr, 0, sizeof(addr));
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port        = 0;
+            ASSERT_EQ(::bind(m_fd, (sockaddr*)&addr, sizeof(addr)), 0);
+
+            socklen_t len = sizeof(addr);
+            ASSERT_EQ(::getsockname(m_fd, (sockaddr*)&addr, &len), 0);
+            m_address = addr.sin_addr;
+            m_port    = ntohs(addr.sin_port);
+
+            m_running = true;
+            m_thread = std::thread([this]() {
+                unsigned char buffer[100U];
+                while (m_running) {
+                    ssize_t n = ::recv(m_fd, buffer, sizeof(buffer), 0);
+                    if (n <= 0)
+                        continue;
+
+                    TReceived packet = { std::chrono::steady_clock::now(), (unsigned int)n, buffer[12] * 256U + buffer[13], n == 27 ? buffer[14] : 0U };
+                    m_received.push_back(packet);
+                }
+            });
+        }
+
+        void TearDown() override
+        {
+            m_running = false;
+            if (m_thread.joinable())
+                m_thread.join();
+            ::close(m_fd);
+        }
+
+        void stop()
+        {
+            // Give the last packets time to land before looking at them
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            m_running = false;
+            m_thread.join();
+        }
+
+        int                    m_fd;
+        in_addr                m_address;
+        unsigned int           m_port;
+        std::atomic<bool>      m_running;
+        std::thread            m_thread;
+        std::vector<TReceived> m_received;
+    };
+
+    TEST_F(G2FanOut_send, framesArriveTogetherAndOnTime)
+    {
+        const unsigned int FRAMES = 50U;
+        const std::vector<std::string> repeaters = { "F4FXL  A", "F4FXL  B", "F4FXL  C", "F4FXL  D" };
+
+        CHeaderData header;
+        header.setMyCall1("F4FXL   ");
+        header.setRptCall1("F4FXL  G");
+        header.setRptCall2("F4FXL   ");
+        header.setYourCall("CQCQCQ  ");
+
+        CG2FanOut fanOut;
+        fanOut.setHeader(header, repeaters);
+
+        unsigned char ambe[DV_FRAME_LENGTH_BYTES];
+        for (unsigned int i = 0U; i < FRAMES; i++) {
+            ::memset(ambe, i, DV_FRAME_LENGTH_BYTES);
+            CAMBEData data;
+            data.setSeq(i % 21U);
+            data.setData(ambe, DV_FRAME_LENGTH_BYTES);
+            fanOut.addFrame(data);
+        }
+
+        ASSERT_EQ(fanOut.getStreamCount(), repeaters.size());
+        ASSERT_EQ(fanOut.getFrameCount(), FRAMES);
+
+        CUDPReaderWriter socket("", 0U);
+        ASSERT_TRUE(socket.open());
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(fanOut.send(socket, m_address, m_port));
+        auto end = std::chrono::steady_clock::now();
+        socket.close();
+
+        stop();
+
+        const unsigned int streams = repeaters.size();
+        ASSERT_EQ(m_received.size(), streams * 5U + streams * FRAMES);
+
+        // One distinct id per repeater
+        std::map<unsigned int, unsigned int> streamOf;
+        for (unsigned int i = 0U; i < streams; i++)
+            streamOf[fanOut.getId(i)] = i;
+        ASSERT_EQ(streamOf.size(), streams);
+
+        std::vector<std::vector<TReceived>> frames(streams);
+        for (const auto& packet : m_received) {
+            ASSERT_EQ(streamOf.count(packet.id), 1U);
+            if (packet.length == 27U)
+                frames[streamOf[packet.id]].push_back(packet);
+            else
+                EXPECT_EQ(packet.length, 56U);
+        }
+
+        for (unsigned int s = 0U; s < streams; s++) {
+            ASSERT_EQ(frames[s].size(), FRAMES);
+            for (unsigned int n = 0U; n < FRAMES; n++)
+                EXPECT_EQ(frames[s][n].seq, n % 21U) << "Frames out of order";
+        }
+
+        // Every copy of a frame goes out in the same batch, so they all land within a fraction of a frame period
+        std::chrono::microseconds worstSpread(0);
+        for (unsigned int n = 0U; n < FRAMES; n++) {
+            auto first = frames[0U][n].time;
+            auto last  = frames[0U][n].time;
+            for (unsigned int s = 1U; s < streams; s++) {
+                first = std::min(first, frames[s][n].time);
+                last  = std::max(last, frames[s][n].time);
+            }
+            worstSpread = std::max(worstSpread, std::chrono::duration_cast<std::chrono::microseconds>(last - first));
+        }
+
+        auto span     = std::chrono::duration_cast<std::chrono::microseconds>(frames[0U][FRAMES - 1U].time - frames[0U][0U].time);
+        auto spacing  = span / (FRAMES - 1U);
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+        std::cout << "Fan out to " << streams << " repeaters: worst spread " << worstSpread.count() << " us, average spacing "
+                  << spacing.count() << " us, " << FRAMES << " frames in " << duration.count() << " ms" << std::endl;
+
+        EXPECT_LT(worstSpread.count(), 5000) << "Copies of a frame should not be spread over the frame period";
+        EXPECT_NEAR(spacing.count(), DSTAR_FRAME_TIME_MS * 1000, 2000);
+        EXPECT_GE(duration.count(), FRAMES * DSTAR_FRAME_TIME_MS);
+        EXPECT_LT(duration.count(), FRAMES * DSTAR_FRAME_TIME_MS + 200U) << "Sending time must not grow with the number of repeaters";
+    }
+}
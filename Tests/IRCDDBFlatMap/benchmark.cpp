@@ -0,0 +1,132 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "IRCDDBFlatMap.h"
+
+namespace IRCDDBFlatMapTests
+{
+    static std::size_t s_mapBytes = 0U;
+
+    // Counts what std::map allocates for its nodes
+    template <typename T>
+    struct CountingAllocator
+    {
+        typedef T value_type;
+
+        CountingAllocator() = default;
+        template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(std::size_t n)
+        {
+            s_mapBytes += n * sizeof(T);
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            s_mapBytes -= n * sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U> bool operator==(const CountingAllocator<U>&) const { return true; }
+        template <typename U> bool operator!=(const CountingAllocator<U>&) const { return false; }
+    };
+
+    // Same shape as the previous repeater row : key duplicated in the value, two strings and a time
+    struct OldRptrObject
+    {
+        std::string m_arearp_cs;
+        time_t m_lastChanged;
+        std::string m_zonerp_cs;
+    };
+
+    struct NewRptrObject
+    {
+        time_t m_lastChanged;
+        char m_zonerp_cs[8];
+    };
+
+    class IRCDDBFlatMap_benchmark : public ::testing::Test {};
+
+    TEST_F(IRCDDBFlatMap_benchmark, DISABLED_repeaterTable200k)
+    {
+        const unsigned int ROWS = 200000U;
+
+        std::vector<std::string> keys;
+        keys.reserve(ROWS);
+        for (unsigned int i = 0U; i < ROWS; i++) {
+            char key[16];
+            ::snprintf(key, sizeof(key), "%c%c%u_%c", 'A' + (i % 26U), 'A' + ((i / 26U) % 26U), i % 100000U, 'A' + (i / 100000U));
+            std::string k(key);
+            k.resize(8U, '_');
+            keys.push_back(k);
+        }
+
+        s_mapBytes = 0U;
+        std::map<std::string, OldRptrObject, std::less<std::string>, CountingAllocator<std::pair<const std::string, OldRptrObject>>> oldMap;
+        IRCDDBFlatMap<NewRptrObject> newMap;
+
+        for (const auto& key : keys) {
+            oldMap[key] = OldRptrObject{ key, 0, key };
+            NewRptrObject& o = newMap[key];
+            o.m_lastChanged = 0;
+            ::memcpy(o.m_zonerp_cs, key.c_str(), 8U);
+        }
+
+        ASSERT_EQ(oldMap.size(), ROWS);
+        ASSERT_EQ(newMap.size(), ROWS);
+
+        // Old lookups went through count() then operator[] with a copy of the object
+        auto start = std::chrono::steady_clock::now();
+        std::size_t found = 0U;
+        for (const auto& key : keys) {
+            std::string lookup(key.c_str(), key.size());
+            if (oldMap.count(lookup) == 1U) {
+                OldRptrObject o = oldMap[lookup];
+                found += o.m_zonerp_cs.size();
+            }
+        }
+        auto oldTime = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::size_t found2 = 0U;
+        for (const auto& key : keys) {
+            const NewRptrObject* o = newMap.find(std::string_view(key.c_str(), key.size()));
+            if (o != nullptr)
+                found2 += sizeof(o->m_zonerp_cs);
+        }
+        auto newTime = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(found, found2);
+
+        auto oldNs = std::chrono::duration_cast<std::chrono::nanoseconds>(oldTime).count() / ROWS;
+        auto newNs = std::chrono::duration_cast<std::chrono::nanoseconds>(newTime).count() / ROWS;
+        std::cout << "std::map      : " << s_mapBytes / 1024U << " KiB, " << oldNs << " ns/lookup" << std::endl;
+        std::cout << "IRCDDBFlatMap : " << newMap.memoryUsage() / 1024U << " KiB, " << newNs << " ns/lookup" << std::endl;
+
+        EXPECT_LT(newMap.memoryUsage(), s_mapBytes);
+    }
+}
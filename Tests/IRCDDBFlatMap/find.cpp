@@ -0,0 +1,85 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+
+#include "IRCDDBFlatMap.h"
+
+namespace IRCDDBFlatMapTests
+{
+    class IRCDDBFlatMap_find : public ::testing::Test {};
+
+    TEST_F(IRCDDBFlatMap_find, emptyMap)
+    {
+        IRCDDBFlatMap<int> map;
+
+        EXPECT_EQ(map.find("F4FXL"), nullptr);
+        EXPECT_FALSE(map.erase("F4FXL"));
+        EXPECT_EQ(map.begin(), map.end());
+    }
+
+    TEST_F(IRCDDBFlatMap_find, insertFindEraseManyKeys)
+    {
+        IRCDDBFlatMap<unsigned int> map;
+
+        for (unsigned int i = 0U; i < 5000U; i++)
+            map["f4fxl-" + std::to_string(i)] = i;
+
+        EXPECT_EQ(map.size(), 5000U);
+
+        // Erase every other key, backward shift must keep the remaining keys reachable
+        for (unsigned int i = 0U; i < 5000U; i += 2U)
+            EXPECT_TRUE(map.erase("f4fxl-" + std::to_string(i)));
+
+        EXPECT_EQ(map.size(), 2500U);
+
+        for (unsigned int i = 0U; i < 5000U; i++) {
+            const unsigned int* value = map.find("f4fxl-" + std::to_string(i));
+            if (i % 2U == 0U) {
+                EXPECT_EQ(value, nullptr) << i;
+            } else {
+                ASSERT_NE(value, nullptr) << i;
+                EXPECT_EQ(*value, i);
+            }
+        }
+
+        unsigned int count = 0U;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            EXPECT_EQ(it->first, "f4fxl-" + std::to_string(it->second));
+            count++;
+        }
+        EXPECT_EQ(count, 2500U);
+    }
+
+    TEST_F(IRCDDBFlatMap_find, operatorBracketUpdatesInPlace)
+    {
+        IRCDDBFlatMap<std::string> map;
+
+        map["F4FXL__B"] = "first";
+        map["F4FXL__B"] = "second";
+
+        EXPECT_EQ(map.size(), 1U);
+        ASSERT_NE(map.find(std::string_view("F4FXL__BXXX", 8)), nullptr);
+        EXPECT_EQ(*map.find("F4FXL__B"), "second");
+
+        map.clear();
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.find("F4FXL__B"), nullptr);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCMessageQueue.h"
+
+namespace IRCMessageQueueTests
+{
+    class IRCMessageQueue_getMessage : public ::testing::Test {};
+
+    TEST_F(IRCMessageQueue_getMessage, emptyQueueReturnsNull)
+    {
+        IRCMessageQueue queue;
+
+        EXPECT_FALSE(queue.messageAvailable());
+        EXPECT_EQ(queue.getMessage(), nullptr);
+        EXPECT_EQ(queue.peekFirst(), nullptr);
+    }
+
+    TEST_F(IRCMessageQueue_getMessage, sameClassIsFIFO)
+    {
+        IRCMessageQueue queue;
+        queue.putMessage(new IRCMessage("s-1", "UPDATE 1"), IRCP_HEARD);
+        queue.putMessage(new IRCMessage("s-1", "UPDATE 2"), IRCP_HEARD);
+        queue.putMessage(new IRCMessage("s-1", "UPDATE 3"), IRCP_HEARD);
+
+        for (auto expected : { "UPDATE 1", "UPDATE 2", "UPDATE 3" }) {
+            IRCMessage * m = queue.getMessage();
+            ASSERT_NE(m, nullptr);
+            EXPECT_STREQ(m->getParam(1).c_str(), expected);
+            delete m;
+        }
+
+        EXPECT_FALSE(queue.messageAvailable());
+    }
+
+    TEST_F(IRCMessageQueue_getMessage, higherPriorityFirst)
+    {
+        IRCMessageQueue queue;
+        queue.putMessage(new IRCMessage("s-1", "IRCDDB RPTRQTH: F4FXL_B"), IRCP_INFO);
+        queue.putMessage(new IRCMessage("s-1", "UPDATE heard"), IRCP_HEARD);
+        queue.putMessage(new IRCMessage("s-1", "FIND F4FXL"), IRCP_QUERY);
+        queue.putMessage(new IRCMessage("PONG"));
+
+        EXPECT_STREQ(queue.peekFirst()->getCommand().c_str(), "PONG");
+
+        IRCMessage * m = queue.getMessage();
+        EXPECT_STREQ(m->getCommand().c_str(), "PONG");
+        delete m;
+
+        for (auto expected : { "FIND F4FXL", "UPDATE heard", "IRCDDB RPTRQTH: F4FXL_B" }) {
+            m = queue.getMessage();
+            ASSERT_NE(m, nullptr);
+            EXPECT_STREQ(m->getParam(1).c_str(), expected);
+            delete m;
+        }
+    }
+}
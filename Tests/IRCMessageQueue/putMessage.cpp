@@ -0,0 +1,83 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IRCMessageQueue.h"
+
+namespace IRCMessageQueueTests
+{
+    class IRCMessageQueue_putMessage : public ::testing::Test {};
+
+    TEST_F(IRCMessageQueue_putMessage, sameKeyIsCoalescedInPlace)
+    {
+        IRCMessageQueue queue;
+        queue.putMessage(new IRCMessage("s-1", "UPDATE F4FXL 1"), IRCP_HEARD, "HEARD F4FXL");
+        queue.putMessage(new IRCMessage("s-1", "UPDATE KC3FRA"), IRCP_HEARD, "HEARD KC3FRA");
+        queue.putMessage(new IRCMessage("s-1", "UPDATE F4FXL 2"), IRCP_HEARD, "HEARD F4FXL");
+
+        EXPECT_EQ(queue.getCoalesced(), 1U);
+
+        // The refreshed message keeps the place of the first one
+        for (auto expected : { "UPDATE F4FXL 2", "UPDATE KC3FRA" }) {
+            IRCMessage * m = queue.getMessage();
+            ASSERT_NE(m, nullptr);
+            EXPECT_STREQ(m->getParam(1).c_str(), expected);
+            delete m;
+        }
+
+        EXPECT_FALSE(queue.messageAvailable());
+    }
+
+    TEST_F(IRCMessageQueue_putMessage, keyIsReleasedOnceSent)
+    {
+        IRCMessageQueue queue;
+        queue.putMessage(new IRCMessage("s-1", "UPDATE F4FXL 1"), IRCP_HEARD, "HEARD F4FXL");
+        delete queue.getMessage();
+
+        queue.putMessage(new IRCMessage("s-1", "UPDATE F4FXL 2"), IRCP_HEARD, "HEARD F4FXL");
+
+        EXPECT_EQ(queue.getCoalesced(), 0U);
+        IRCMessage * m = queue.getMessage();
+        ASSERT_NE(m, nullptr);
+        EXPECT_STREQ(m->getParam(1).c_str(), "UPDATE F4FXL 2");
+        delete m;
+    }
+
+    TEST_F(IRCMessageQueue_putMessage, emptyKeyIsNeverCoalesced)
+    {
+        IRCMessageQueue queue;
+        queue.putMessage(new IRCMessage("s-1", "FIND F4FXL"), IRCP_QUERY);
+        queue.putMessage(new IRCMessage("s-1", "FIND F4FXL"), IRCP_QUERY);
+
+        EXPECT_EQ(queue.getCoalesced(), 0U);
+        delete queue.getMessage();
+        delete queue.getMessage();
+        EXPECT_FALSE(queue.messageAvailable());
+    }
+
+    TEST_F(IRCMessageQueue_putMessage, wakesUpWaitingSender)
+    {
+        IRCMessageQueue queue;
+
+        EXPECT_FALSE(queue.waitMessage(10U));
+
+        queue.putMessage(new IRCMessage("PONG"));
+        EXPECT_TRUE(queue.waitMessage(10U));
+    }
+}
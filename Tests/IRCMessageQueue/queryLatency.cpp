@@ -0,0 +1,74 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "IRCMessageQueue.h"
+#include "IRCRateLimiter.h"
+
+namespace IRCMessageQueueTests
+{
+    class IRCMessageQueue_queryLatency : public ::testing::Test {};
+
+    // Simulates a busy multi module gateway : a backlog of heard updates keeps arriving at 20/s while the rate limiter
+    // lets 2 messages/s through. Measures how long a FIND issued in the middle of it waits before being sent.
+    TEST_F(IRCMessageQueue_queryLatency, findIsNotDelayedByHeardLoad)
+    {
+        const auto step = std::chrono::milliseconds(10);
+        IRCMessageQueue queue;
+        IRCRateLimiter limiter(10U, 2U);
+        auto now = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0U; i < 500U; i++)
+            queue.putMessage(new IRCMessage("s-1", "UPDATE " + std::to_string(i)), IRCP_HEARD, "HEARD " + std::to_string(i));
+
+        std::chrono::steady_clock::time_point findQueued;
+        std::chrono::steady_clock::time_point findSent;
+        bool findDone = false;
+
+        for (unsigned int tick = 0U; tick < 2000U && !findDone; tick++) {
+            now += step;
+
+            if (tick % 5U == 0U)
+                queue.putMessage(new IRCMessage("s-1", "UPDATE load " + std::to_string(tick)), IRCP_HEARD, "HEARD load " + std::to_string(tick));
+
+            if (tick == 1000U) {
+                queue.putMessage(new IRCMessage("s-1", "FIND F4FXL"), IRCP_QUERY);
+                findQueued = now;
+            }
+
+            while (queue.messageAvailable() && limiter.consume(now)) {
+                IRCMessage * m = queue.getMessage();
+                if (m->getParam(1) == "FIND F4FXL") {
+                    findSent = now;
+                    findDone = true;
+                }
+                delete m;
+            }
+        }
+
+        ASSERT_TRUE(findDone);
+        auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(findSent - findQueued).count();
+        std::cout << "FIND latency with " << (queue.messageAvailable() ? "pending" : "no") << " heard backlog : " << latency << "ms" << std::endl;
+
+        // At most one token interval, a plain FIFO would have queued it behind hundreds of heard updates
+        EXPECT_LE(latency, 500);
+    }
+}
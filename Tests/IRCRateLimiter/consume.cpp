@@ -0,0 +1,59 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "IRCRateLimiter.h"
+
+namespace IRCRateLimiterTests
+{
+    class IRCRateLimiter_consume : public ::testing::Test {};
+
+    TEST_F(IRCRateLimiter_consume, burstThenRate)
+    {
+        IRCRateLimiter limiter(5U, 2U);
+        auto now = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0U; i < 5U; i++)
+            EXPECT_TRUE(limiter.consume(now)) << "burst message " << i;
+
+        EXPECT_FALSE(limiter.consume(now));
+        EXPECT_EQ(limiter.getWaitTime(now), 500U);
+
+        now += std::chrono::milliseconds(250);
+        EXPECT_FALSE(limiter.consume(now));
+        EXPECT_EQ(limiter.getWaitTime(now), 250U);
+
+        now += std::chrono::milliseconds(250);
+        EXPECT_TRUE(limiter.consume(now));
+        EXPECT_FALSE(limiter.consume(now));
+    }
+
+    TEST_F(IRCRateLimiter_consume, neverExceedsBurst)
+    {
+        IRCRateLimiter limiter(3U, 10U);
+        auto now = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+
+        unsigned int sent = 0U;
+        while (limiter.consume(now))
+            sent++;
+
+        EXPECT_EQ(sent, 3U);
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+// Just enough of an Icom RP2C controller on the loopback to exercise the gateway side of the link.
+// It answers INIT, acks DSTR packets and loses a given share of them in both directions.
+class CRP2CEmulator {
+public:
+    CRP2CEmulator(double loss, unsigned int seed = 20260103U) :
+    m_fd(-1),
+    m_port(0U),
+    m_loss(loss),
+    m_random(seed),
+    m_thread(),
+    m_stop(false),
+    m_mutex(),
+    m_received(),
+    m_copies(0U),
+    m_acks(0U)
+    {
+    }
+
+    ~CRP2CEmulator()
+    {
+        stop();
+    }
+
+    bool start()
+    {
+        m_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (m_fd < 0)
+            return false;
+
+        timeval tv = { 0, 10000 };
+        ::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        sockaddr_in addr;
+        ::memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port        = 0;
+        if (::bind(m_fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+            return false;
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(m_fd, (sockaddr*)&addr, &len);
+        m_port = ntohs(addr.sin_port);
+
+        m_thread = std::thread([this] { run(); });
+
+        return true;
+    }
+
+    void stop()
+    {
+        m_stop = true;
+        if (m_thread.joinable())
+            m_thread.join();
+
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    unsigned int getPort() const
+    {
+        return m_port;
+    }
+
+    // Distinct RP2C sequence numbers that made it through
+    unsigned int getReceived()
+    {
+        std::lock_guard lock(m_mutex);
+        return m_received.size();
+    }
+
+    unsigned int getCopies()
+    {
+        std::lock_guard lock(m_mutex);
+        return m_copies;
+    }
+
+    // A free port for the gateway end, found the same way
+    static unsigned int getFreePort()
+    {
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+        sockaddr_in addr;
+        ::memset(&addr, 0, sizeof(addr));
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port        = 0;
+        ::bind(fd, (sockaddr*)&addr, sizeof(addr));
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd, (sockaddr*)&addr, &len);
+        ::close(fd);
+
+        return ntohs(addr.sin_port);
+    }
+
+private:
+    int                                m_fd;
+    unsigned int                       m_port;
+    double                             m_loss;
+    std::mt19937                       m_random;
+    std::thread                        m_thread;
+    std::atomic<bool>                  m_stop;
+    std::mutex                         m_mutex;
+    std::set<unsigned int>             m_received;
+    unsigned int                       m_copies;
+    unsigned int                       m_acks;
+
+    bool lost()
+    {
+        return std::uniform_real_distribution<double>(0.0, 1.0)(m_random) < m_loss;
+    }
+
+    void run()
+    {
+        unsigned char buffer[2500U];
+
+        while (!m_stop) {
+            sockaddr_in from;
+            socklen_t fromLen = sizeof(from);
+            ssize_t length = ::recvfrom(m_fd, buffer, sizeof(buffer), 0, (sockaddr*)&from, &fromLen);
+            if (length < 10)
+                continue;
+
+            if (::memcmp(buffer, "INIT", 4U) == 0) {
+                // Our own sequence number starts just before a wrap
+                unsigned char reply[10U] = { 'I', 'N', 'I', 'T', 0xFFU, 0xF0U, 0x72U, 0x00U, 0x00U, 0x00U };
+                ::sendto(m_fd, reply, 10U, 0, (sockaddr*)&from, fromLen);
+                continue;
+            }
+
+            if (::memcmp(buffer, "DSTR", 4U) != 0 || buffer[6U] != 0x73U)
+                continue;
+
+            if (lost())
+                continue;
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_received.insert(buffer[4U] * 256U + buffer[5U]);
+                m_copies++;
+            }
+
+            if (lost())
+                continue;
+
+            unsigned char ack[10U] = { 'D', 'S', 'T', 'R', buffer[4U], buffer[5U], 0x72U, 0x00U, 0x00U, 0x00U };
+            ::sendto(m_fd, ack, 10U, 0, (sockaddr*)&from, fromLen);
+            m_acks++;
+        }
+    }
+};
@@ -0,0 +1,100 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "IcomRepeaterProtocolHandler.h"
+#include "DStarDefines.h"
+#include "RP2CEmulator.h"
+
+namespace IcomRepeaterProtocolHandlerTests
+{
+    class IcomRepeaterProtocolHandler_writeAMBE : public ::testing::Test {
+    protected:
+        static constexpr unsigned int FRAMES = 300U;
+
+        // Writes FRAMES voice frames 2 ms apart, ten times faster than real time,
+        // and returns how long it took for the RP2C to have all of them
+        static double deliver(CRP2CEmulator& rp2c, unsigned int& refused)
+        {
+            // The emulator acks every packet by its own sequence number, as a window needs
+            CIcomRepeaterProtocolHandler handler("127.0.0.1", CRP2CEmulator::getFreePort(), "127.0.0.1", rp2c.getPort(), 8U);
+            EXPECT_TRUE(handler.open());
+
+            unsigned char buffer[DV_FRAME_LENGTH_BYTES];
+            ::memcpy(buffer, NULL_AMBE_DATA_BYTES, VOICE_FRAME_LENGTH_BYTES);
+            ::memcpy(buffer + VOICE_FRAME_LENGTH_BYTES, NULL_SLOW_DATA_BYTES, DATA_FRAME_LENGTH_BYTES);
+
+            refused = 0U;
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned int i = 0U; i < FRAMES; i++) {
+                CAMBEData data;
+                data.setId(0x1234U);
+                data.setSeq(i % 21U);
+                data.setData(buffer, DV_FRAME_LENGTH_BYTES);
+                if (!handler.writeAMBE(data))
+                    refused++;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+
+            while (rp2c.getReceived() < FRAMES && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            handler.close();
+
+            return elapsed;
+        }
+    };
+
+    TEST_F(IcomRepeaterProtocolHandler_writeAMBE, noLoss)
+    {
+        CRP2CEmulator rp2c(0.0);
+        ASSERT_TRUE(rp2c.start());
+
+        unsigned int refused = 0U;
+        double elapsed = deliver(rp2c, refused);
+
+        std::cout << "RP2C without loss: " << FRAMES << " frames in " << elapsed << " ms, " << rp2c.getCopies() << " copies received" << std::endl;
+
+        EXPECT_EQ(refused, 0U);
+        EXPECT_EQ(rp2c.getReceived(), FRAMES);
+    }
+
+    TEST_F(IcomRepeaterProtocolHandler_writeAMBE, tenPercentLossBothWays)
+    {
+        CRP2CEmulator rp2c(0.1);
+        ASSERT_TRUE(rp2c.start());
+
+        unsigned int refused = 0U;
+        double elapsed = deliver(rp2c, refused);
+
+        std::cout << "RP2C with 10% loss: " << FRAMES << " frames in " << elapsed << " ms, " << rp2c.getCopies() << " copies received" << std::endl;
+
+        // Every frame gets through, and the retries do not hold the stream up by more than a few retry times
+        EXPECT_EQ(refused, 0U);
+        EXPECT_EQ(rp2c.getReceived(), FRAMES);
+        EXPECT_LT(elapsed, FRAMES * 2.0 + 1000.0);
+    }
+}
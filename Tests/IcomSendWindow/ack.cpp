@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "IcomSendWindow.h"
+
+namespace IcomSendWindowTests
+{
+    class IcomSendWindow_ack : public ::testing::Test {
+    protected:
+        static void add(CIcomSendWindow& window, const CIcomSendWindow::TIcomTime& now)
+        {
+            unsigned char packet[10U] = { 'D', 'S', 'T', 'R', 0x00U, 0x00U, 0x73U, 0x12U, 0x00U, 0x00U };
+            packet[4U] = window.getNextSeqNo() / 256U;
+            packet[5U] = window.getNextSeqNo() % 256U;
+            window.add(packet, 10U, now);
+        }
+    };
+
+    TEST_F(IcomSendWindow_ack, windowFillsAndDrains)
+    {
+        CIcomSendWindow window(4U);
+        window.setNextSeqNo(0xFFFEU);
+        auto now = std::chrono::steady_clock::now();
+
+        for (unsigned int i = 0U; i < 4U; i++)
+            add(window, now);
+
+        EXPECT_TRUE(window.isFull());
+        EXPECT_EQ(window.getNextSeqNo(), 0x0002U);
+
+        // Acks may come in any order, across the wrap of the sequence number
+        EXPECT_TRUE(window.ack(0x0001U, now));
+        EXPECT_TRUE(window.ack(0xFFFEU, now));
+        EXPECT_FALSE(window.isFull());
+        EXPECT_EQ(window.getInFlight(), 2U);
+
+        EXPECT_TRUE(window.ack(0x0000U, now));
+        EXPECT_TRUE(window.ack(0xFFFFU, now));
+        EXPECT_TRUE(window.isEmpty());
+        EXPECT_EQ(window.getStats().acked, 4ULL);
+    }
+
+    TEST_F(IcomSendWindow_ack, onlyOverduePacketsAreRetransmitted)
+    {
+        CIcomSendWindow window(4U);
+        auto now = std::chrono::steady_clock::now();
+
+        add(window, now);
+        add(window, now + std::chrono::milliseconds(100));
+        add(window, now + std::chrono::milliseconds(100));
+        window.ack(1U, now + std::chrono::milliseconds(101));
+
+        std::vector<unsigned int> resent;
+        unsigned int count = window.retransmit(now + std::chrono::milliseconds(ICOM_INITIAL_RETRY_MS), [&resent](const unsigned char* data, unsigned int) {
+            resent.push_back(data[4U] * 256U + data[5U]);
+        });
+
+        // Packet 0 is overdue, packet 1 was acked and packet 2 still has time
+        ASSERT_EQ(count, 1U);
+        EXPECT_EQ(resent[0U], 0U);
+        EXPECT_EQ(window.getMaxTries(), 2U);
+        EXPECT_EQ(window.getStats().retransmitted, 1ULL);
+
+        // The late ack of the first copy still clears it, a second one is a duplicate
+        EXPECT_TRUE(window.ack(0U, now + std::chrono::milliseconds(250)));
+        EXPECT_FALSE(window.ack(0U, now + std::chrono::milliseconds(251)));
+        EXPECT_EQ(window.getStats().duplicateAcks, 1ULL);
+        EXPECT_EQ(window.getInFlight(), 1U);
+    }
+
+    TEST_F(IcomSendWindow_ack, retryTimeFollowsRoundTrip)
+    {
+        CIcomSendWindow window;
+        auto now = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(window.getRetryTime(), ICOM_INITIAL_RETRY_MS);
+
+        for (unsigned int i = 0U; i < 20U; i++) {
+            uint16_t seqNo = window.getNextSeqNo();
+            add(window, now);
+            now += std::chrono::milliseconds(2);
+            window.ack(seqNo, now);
+        }
+
+        // A fast link brings it down to the floor
+        EXPECT_EQ(window.getRetryTime(), ICOM_MIN_RETRY_MS);
+
+        for (unsigned int i = 0U; i < 20U; i++) {
+            uint16_t seqNo = window.getNextSeqNo();
+            add(window, now);
+            now += std::chrono::milliseconds(60);
+            window.ack(seqNo, now);
+        }
+
+        EXPECT_GT(window.getRetryTime(), 60U);
+        EXPECT_LT(window.getRetryTime(), ICOM_INITIAL_RETRY_MS);
+    }
+
+    TEST_F(IcomSendWindow_ack, unknownSequenceNumberResyncs)
+    {
+        CIcomSendWindow window(4U);
+        window.setNextSeqNo(100U);
+        auto now = std::chrono::steady_clock::now();
+
+        add(window, now);
+        add(window, now);
+
+        EXPECT_FALSE(window.ack(5000U, now));
+        EXPECT_TRUE(window.isEmpty());
+        EXPECT_EQ(window.getNextSeqNo(), 5000U);
+        EXPECT_EQ(window.getStats().resyncs, 1ULL);
+    }
+
+    TEST_F(IcomSendWindow_ack, stopAndWaitFollowsTheRP2C)
+    {
+        CIcomSendWindow window;
+        window.setNextSeqNo(100U);
+        auto now = std::chrono::steady_clock::now();
+
+        add(window, now);
+        EXPECT_TRUE(window.isFull());
+        EXPECT_TRUE(window.ack(100U, now));
+        EXPECT_EQ(window.getNextSeqNo(), 101U);
+
+        // After a loss the RP2C acks the number it expects, the packet is done with and that number is used next
+        add(window, now);
+        EXPECT_FALSE(window.ack(100U, now));
+        EXPECT_TRUE(window.isEmpty());
+        EXPECT_EQ(window.getNextSeqNo(), 100U);
+        EXPECT_EQ(window.getStats().duplicateAcks, 0ULL);
+        EXPECT_EQ(window.getStats().resyncs, 1ULL);
+    }
+}
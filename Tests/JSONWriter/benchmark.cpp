@@ -0,0 +1,83 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "JSONWriter.h"
+#include "Utils.h"
+
+namespace JSONWriterTests
+{
+    class JSONWriter_benchmark : public ::testing::Test {
+    protected:
+        static const unsigned int EVENTS = 100000U;
+
+        template<typename F> static double eventsPerSecond(F f)
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::size_t total = 0U;
+            for (unsigned int i = 0U; i < EVENTS; i++)
+                total += f();
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            EXPECT_GT(total, 0U);
+            return EVENTS / elapsed;
+        }
+    };
+
+    TEST_F(JSONWriter_benchmark, DISABLED_linkEventThroughput)
+    {
+        const std::string repeater  = "F4FXL  B";
+        const std::string reflector = "XRF123 A";
+
+        double nlohmannRate = eventsPerSecond([&]() {
+            nlohmann::json json;
+            json["timestamp"] = CUtils::createTimestamp();
+            json["repeater"]  = repeater;
+            json["action"]    = "linking";
+            json["reason"]    = "USER";
+            json["reflector"] = reflector;
+            json["protocol"]  = "DExtra";
+
+            nlohmann::json top;
+            top["link"] = json;
+            return top.dump().size();
+        });
+
+        CJSONWriter writer;
+        double writerRate = eventsPerSecond([&]() {
+            writer.begin("link");
+            writer.add("action", "linking");
+            writer.add("protocol", "DExtra");
+            writer.add("reason", "USER");
+            writer.add("reflector", reflector);
+            writer.add("repeater", repeater);
+            writer.addTimestamp();
+            return writer.end().size();
+        });
+
+        std::cout << "nlohmann::json : " << (unsigned long)nlohmannRate << " events/s" << std::endl;
+        std::cout << "CJSONWriter    : " << (unsigned long)writerRate << " events/s" << std::endl;
+
+        EXPECT_GT(writerRate, 0.0);
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "JSONWriter.h"
+
+namespace JSONWriterTests
+{
+    class JSONWriter_end : public ::testing::Test {
+    protected:
+        static std::string reference(const std::string& topLevel, const nlohmann::json& json)
+        {
+            nlohmann::json top;
+            top[topLevel] = json;
+            return top.dump();
+        }
+    };
+
+    TEST_F(JSONWriter_end, statusMatchesNlohmann)
+    {
+        CJSONWriter writer;
+        writer.begin("status");
+        writer.add("message", "DStarGateway started");
+        writer.add("timestamp", "2026-01-02 03:04:05.678");
+
+        nlohmann::json json;
+        json["timestamp"] = "2026-01-02 03:04:05.678";
+        json["message"]   = "DStarGateway started";
+
+        EXPECT_EQ(writer.end(), reference("status", json));
+    }
+
+    TEST_F(JSONWriter_end, linkMatchesNlohmann)
+    {
+        CJSONWriter writer;
+        writer.begin("link");
+        writer.add("action", "linking");
+        writer.add("protocol", "DExtra");
+        writer.add("reason", "USER");
+        writer.add("reflector", "XRF123 A");
+        writer.add("repeater", "F4FXL  B");
+        writer.add("timestamp", "2026-01-02 03:04:05.678");
+
+        nlohmann::json json;
+        json["timestamp"] = "2026-01-02 03:04:05.678";
+        json["repeater"]  = "F4FXL  B";
+        json["action"]    = "linking";
+        json["reason"]    = "USER";
+        json["reflector"] = "XRF123 A";
+        json["protocol"]  = "DExtra";
+
+        EXPECT_EQ(writer.end(), reference("link", json));
+    }
+
+    TEST_F(JSONWriter_end, escapingMatchesNlohmann)
+    {
+        const std::string values[] = {
+            "",
+            "quote \" and backslash \\",
+            "slash / stays",
+            "\b\f\n\r\t",
+            std::string("\x01\x02\x1f\x7f", 4U),
+            std::string("nul\0inside", 10U),
+            "UTF-8 \xc3\xa9t\xc3\xa9 \xe2\x82\xac \xf0\x9f\x93\xa1",
+        };
+
+        for (const auto& value : values) {
+            CJSONWriter writer;
+            writer.begin("status");
+            writer.add("message", value);
+
+            nlohmann::json json;
+            json["message"] = value;
+
+            EXPECT_EQ(writer.end(), reference("status", json));
+        }
+    }
+
+    TEST_F(JSONWriter_end, numbersMatchNlohmann)
+    {
+        CJSONWriter writer;
+        writer.begin("voice");
+        writer.add("frames_in", uint64_t(0U));
+        writer.add("frames_out", uint64_t(18446744073709551615ULL));
+        writer.add("protocol", "DExtra");
+        writer.add("total_p99_us", uint64_t(1234U));
+
+        nlohmann::json json;
+        json["total_p99_us"] = uint64_t(1234U);
+        json["protocol"]     = "DExtra";
+        json["frames_out"]   = uint64_t(18446744073709551615ULL);
+        json["frames_in"]    = uint64_t(0U);
+
+        EXPECT_EQ(writer.end(), reference("voice", json));
+    }
+
+    TEST_F(JSONWriter_end, bufferIsReusedBetweenEvents)
+    {
+        CJSONWriter writer;
+        writer.begin("link");
+        writer.add("action", "failed");
+        writer.add("repeater", "F4FXL  B");
+        writer.end();
+
+        writer.begin("status");
+        writer.add("message", "ok");
+
+        EXPECT_EQ(writer.end(), "{\"status\":{\"message\":\"ok\"}}");
+    }
+
+    TEST_F(JSONWriter_end, timestampHasCreateTimestampFormat)
+    {
+        CJSONWriter writer;
+        writer.begin("status");
+        writer.addTimestamp();
+
+        const std::string& text = writer.end();
+        auto parsed = nlohmann::json::parse(text);
+        std::string timestamp = parsed["status"]["timestamp"];
+
+        // YYYY-MM-DD HH:MM:SS.mmm
+        ASSERT_EQ(timestamp.size(), 23U);
+        EXPECT_EQ(timestamp[4], '-');
+        EXPECT_EQ(timestamp[10], ' ');
+        EXPECT_EQ(timestamp[13], ':');
+        EXPECT_EQ(timestamp[19], '.');
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "LatencyHistogram.h"
+
+namespace LatencyHistogramTests
+{
+    class LatencyHistogram_getPercentile : public ::testing::Test {
+    
+    };
+
+    TEST_F(LatencyHistogram_getPercentile, emptyIsZero)
+    {
+        CLatencyHistogram histogram;
+        CLatencySnapshot snapshot;
+        histogram.snapshot(snapshot);
+
+        EXPECT_EQ(snapshot.getCount(), 0U);
+        EXPECT_EQ(snapshot.getMax(), 0U);
+        EXPECT_EQ(snapshot.getPercentile(50.0), 0U);
+    }
+
+    TEST_F(LatencyHistogram_getPercentile, bucketsAreWithinAnEighth)
+    {
+        for (uint32_t value : { 0U, 1U, 7U, 8U, 15U, 16U, 100U, 20000U, 1000000U, 0xFFFFFFFFU }) {
+            unsigned int bucket = CLatencySnapshot::getBucket(value);
+            ASSERT_LT(bucket, LATENCY_BUCKETS);
+
+            uint32_t bound = CLatencySnapshot::getUpperBound(bucket);
+            EXPECT_GE(bound, value);
+            EXPECT_LE(double(bound), double(value) * 1.125 + 1.0);
+        }
+
+        // Values below the sub bucket count are exact
+        EXPECT_EQ(CLatencySnapshot::getUpperBound(CLatencySnapshot::getBucket(5U)), 5U);
+    }
+
+    TEST_F(LatencyHistogram_getPercentile, percentilesOfAKnownSpread)
+    {
+        CLatencyHistogram histogram;
+        for (uint32_t value = 1U; value <= 1000U; value++)
+            histogram.record(value);
+
+        CLatencySnapshot snapshot;
+        histogram.snapshot(snapshot);
+
+        EXPECT_EQ(snapshot.getCount(), 1000U);
+        EXPECT_EQ(snapshot.getMax(), 1000U);
+        EXPECT_NEAR(double(snapshot.getPercentile(50.0)), 500.0, 500.0 * 0.125);
+        EXPECT_NEAR(double(snapshot.getPercentile(99.0)), 990.0, 990.0 * 0.125);
+        EXPECT_EQ(snapshot.getPercentile(100.0), 1000U);
+    }
+
+    TEST_F(LatencyHistogram_getPercentile, subtractLeavesTheInterval)
+    {
+        CLatencyHistogram histogram;
+        for (unsigned int i = 0U; i < 100U; i++)
+            histogram.record(50000U);
+
+        CLatencySnapshot earlier;
+        histogram.snapshot(earlier);
+
+        for (unsigned int i = 0U; i < 10U; i++)
+            histogram.record(100U);
+
+        CLatencySnapshot later;
+        histogram.snapshot(later);
+        later.subtract(earlier);
+
+        EXPECT_EQ(later.getCount(), 10U);
+        EXPECT_LE(later.getMax(), 112U);
+        EXPECT_GE(later.getPercentile(99.0), 100U);
+        EXPECT_LE(later.getPercentile(99.0), 112U);
+
+        // Nothing new, nothing left
+        CLatencySnapshot same;
+        histogram.snapshot(same);
+        CLatencySnapshot again;
+        histogram.snapshot(again);
+        again.subtract(same);
+        EXPECT_EQ(again.getCount(), 0U);
+        EXPECT_EQ(again.getMax(), 0U);
+    }
+}
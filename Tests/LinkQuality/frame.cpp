@@ -0,0 +1,138 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "LinkQuality.h"
+
+namespace LinkQualityTests
+{
+    class LinkQuality_frame : public ::testing::Test {
+    protected:
+        // Sends frames of one stream 20ms apart, seqs are absolute frame numbers within the stream
+        void send(std::initializer_list<unsigned int> frames, uint64_t late = 0U)
+        {
+            for (unsigned int frame : frames)
+                m_quality.frame(frame % 21U, START + frame * 20000U + late);
+        }
+
+        static const uint64_t START = 1000000U;
+
+        CLinkQuality m_quality;
+    };
+
+    TEST_F(LinkQuality_frame, cleanStream)
+    {
+        m_quality.start(START - 20000U);
+        for (unsigned int i = 0U; i < 100U; i++)
+            send({ i });
+        ASSERT_TRUE(m_quality.end());
+
+        const TLinkQuality& stream = m_quality.getStream();
+        EXPECT_EQ(stream.frames, 100U);
+        EXPECT_EQ(stream.lost, 0U);
+        EXPECT_EQ(stream.outOfOrder, 0U);
+        EXPECT_EQ(stream.duplicates, 0U);
+        EXPECT_EQ(stream.jitter, 0U);
+        EXPECT_FALSE(m_quality.end());
+    }
+
+    TEST_F(LinkQuality_frame, lossAcrossTheWrap)
+    {
+        m_quality.start(START - 20000U);
+        send({ 0U, 1U, 2U, 19U, 20U, 23U, 24U });
+
+        EXPECT_EQ(m_quality.getStream().frames, 7U);
+        EXPECT_EQ(m_quality.getStream().lost, 16U + 2U);
+    }
+
+    TEST_F(LinkQuality_frame, lostFirstFrames)
+    {
+        m_quality.start(START - 20000U);
+        send({ 3U, 4U });
+
+        EXPECT_EQ(m_quality.getStream().lost, 3U);
+        EXPECT_EQ(m_quality.getStream().duplicates, 0U);
+    }
+
+    TEST_F(LinkQuality_frame, sequenceOutOfRangeIsIgnored)
+    {
+        m_quality.start(START - 20000U);
+        send({ 0U });
+        m_quality.frame(21U, START + 20000U);
+        m_quality.frame(0x1FU, START + 20000U);
+        send({ 1U, 2U });
+
+        const TLinkQuality& stream = m_quality.getStream();
+        EXPECT_EQ(stream.frames, 3U);
+        EXPECT_EQ(stream.lost, 0U);
+        EXPECT_EQ(stream.outOfOrder, 0U);
+        EXPECT_EQ(stream.duplicates, 0U);
+    }
+
+    TEST_F(LinkQuality_frame, wholeSequencesMissedInASilence)
+    {
+        m_quality.start(START - 20000U);
+        send({ 0U, 1U, 2U, 45U, 46U });
+
+        EXPECT_EQ(m_quality.getStream().frames, 5U);
+        EXPECT_EQ(m_quality.getStream().lost, 42U);
+    }
+
+    TEST_F(LinkQuality_frame, reorderingAndDuplicates)
+    {
+        m_quality.start(START - 20000U);
+        send({ 0U, 1U, 3U });
+        send({ 2U }, 45000U);
+        send({ 3U }, 1000U);
+        send({ 4U, 4U, 5U });
+
+        const TLinkQuality& stream = m_quality.getStream();
+        EXPECT_EQ(stream.frames, 6U);
+        EXPECT_EQ(stream.lost, 0U);
+        EXPECT_EQ(stream.outOfOrder, 1U);
+        EXPECT_EQ(stream.duplicates, 2U);
+    }
+
+    TEST_F(LinkQuality_frame, jitterFollowsTheArrivalSpread)
+    {
+        m_quality.start(START - 20000U);
+        for (unsigned int i = 0U; i < 200U; i++)
+            send({ i }, (i % 2U) * 10000U);
+
+        // Every gap is 10ms off, the estimate converges on that
+        EXPECT_NEAR(double(m_quality.getStream().jitter), 10000.0, 500.0);
+    }
+
+    TEST_F(LinkQuality_frame, linkTotalsIncludeTheStreamInProgress)
+    {
+        m_quality.start(START - 20000U);
+        send({ 0U, 2U });
+        m_quality.end();
+
+        // DCS streams start without a header
+        send({ 105U, 106U, 108U });
+        EXPECT_TRUE(m_quality.isActive());
+
+        TLinkQuality link;
+        m_quality.getLink(link);
+        EXPECT_EQ(link.streams, 2U);
+        EXPECT_EQ(link.frames, 5U);
+        EXPECT_EQ(link.lost, 2U);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "MQTTConnection.h"
+
+namespace MQTTConnectionTests
+{
+    // In-process stand in for the broker, every delivery takes as long as a slow broker would
+    class CStubBrokerConnection : public CMQTTConnection
+    {
+    public:
+        CStubBrokerConnection(unsigned int deliveryMs) :
+        CMQTTConnection("127.0.0.1", 1883U, "dstar-gateway", false, "", "", {}, 60U),
+        m_deliveryMs(deliveryMs),
+        m_delivered()
+        {
+            startPublisher();
+        }
+
+        ~CStubBrokerConnection()
+        {
+            stopPublisher();
+        }
+
+        void connect(bool connected)
+        {
+            setConnected(connected);
+        }
+
+        std::vector<std::string> delivered()
+        {
+            std::lock_guard lock(m_mutex);
+            return m_delivered;
+        }
+
+    protected:
+        bool deliver(const std::string& topic, const std::string& payload) override
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_deliveryMs));
+
+            std::lock_guard lock(m_mutex);
+            m_delivered.push_back(topic + ":" + payload);
+            return true;
+        }
+
+    private:
+        unsigned int m_deliveryMs;
+        std::mutex m_mutex;
+        std::vector<std::string> m_delivered;
+    };
+
+    class MQTTConnection_publish : public ::testing::Test {
+    protected:
+        template <typename F>
+        static bool waitFor(F condition)
+        {
+            for (unsigned int i = 0U; i < 500U; i++) {
+                if (condition())
+                    return true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            return false;
+        }
+    };
+
+    TEST_F(MQTTConnection_publish, callerDoesNotBlockOnSlowBroker)
+    {
+        CStubBrokerConnection connection(10U);
+        connection.connect(true);
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0U; i < 50U; i++)
+            connection.publish("log", std::to_string(i));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // Delivering synchronously would have taken half a second
+        EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+
+        EXPECT_TRUE(waitFor([&connection] { return connection.getStats().published == 50ULL; }));
+        auto delivered = connection.delivered();
+        ASSERT_EQ(delivered.size(), 50U);
+        EXPECT_EQ(delivered.front(), "log:0");
+        EXPECT_EQ(delivered.back(), "log:49");
+    }
+
+    TEST_F(MQTTConnection_publish, backlogIsKeptWhileDisconnected)
+    {
+        CStubBrokerConnection connection(0U);
+        connection.setTopicPolicy("json", MQTT_QUEUE_POLICY::DROP_OLDEST, 10U);
+
+        for (unsigned int i = 0U; i < 15U; i++)
+            connection.publish("json", std::to_string(i));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_TRUE(connection.delivered().empty());
+
+        connection.connect(true);
+        EXPECT_TRUE(waitFor([&connection] { return connection.getStats().published == 10ULL; }));
+
+        auto delivered = connection.delivered();
+        ASSERT_EQ(delivered.size(), 10U);
+        EXPECT_EQ(delivered.front(), "json:5");
+
+        TMQTTQueueStats stats = connection.getStats("json");
+        EXPECT_EQ(stats.queued, 15ULL);
+        EXPECT_EQ(stats.dropped, 5ULL);
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "MQTTPublishQueue.h"
+
+namespace MQTTPublishQueueTests
+{
+    class MQTTPublishQueue_pop : public ::testing::Test {};
+
+    TEST_F(MQTTPublishQueue_pop, keepsGlobalOrderAcrossTopics)
+    {
+        CMQTTPublishQueue queue;
+        const std::string topics[] = { "log", "json", "log", "aprs-gateway/aprs", "json" };
+
+        for (unsigned int i = 0U; i < 5U; i++) {
+            std::string text = std::to_string(i);
+            queue.push(topics[i], (const unsigned char*)text.c_str(), text.size());
+        }
+
+        std::vector<CMQTTQueuedMessage> batch;
+        EXPECT_EQ(queue.pop(batch, 100U, 0U), 5U);
+
+        for (unsigned int i = 0U; i < 5U; i++) {
+            EXPECT_EQ(batch[i].m_topic, topics[i]);
+            EXPECT_EQ(batch[i].m_payload, std::to_string(i));
+        }
+    }
+
+    TEST_F(MQTTPublishQueue_pop, batchIsBounded)
+    {
+        CMQTTPublishQueue queue;
+        for (unsigned int i = 0U; i < 50U; i++)
+            queue.push("log", (const unsigned char*)"x", 1U);
+
+        std::vector<CMQTTQueuedMessage> batch;
+        EXPECT_EQ(queue.pop(batch, 20U, 0U), 20U);
+        EXPECT_EQ(queue.size(), 30U);
+    }
+
+    TEST_F(MQTTPublishQueue_pop, waitsForMessages)
+    {
+        CMQTTPublishQueue queue;
+        std::vector<CMQTTQueuedMessage> batch;
+
+        EXPECT_EQ(queue.pop(batch, 20U, 10U), 0U);
+
+        std::thread producer([&queue] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            queue.push("log", (const unsigned char*)"x", 1U);
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_EQ(queue.pop(batch, 20U, 5000U), 1U);
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+
+        producer.join();
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "MQTTPublishQueue.h"
+
+namespace MQTTPublishQueueTests
+{
+    class MQTTPublishQueue_push : public ::testing::Test {
+    protected:
+        static void push(CMQTTPublishQueue& queue, const std::string& topic, const std::string& text)
+        {
+            queue.push(topic, (const unsigned char*)text.c_str(), text.size());
+        }
+
+        static std::vector<std::string> drain(CMQTTPublishQueue& queue)
+        {
+            std::vector<CMQTTQueuedMessage> batch;
+            queue.pop(batch, 1000U, 0U);
+
+            std::vector<std::string> payloads;
+            for (const auto& m : batch)
+                payloads.push_back(m.m_payload);
+
+            return payloads;
+        }
+    };
+
+    TEST_F(MQTTPublishQueue_push, dropOldestKeepsLatest)
+    {
+        CMQTTPublishQueue queue;
+        queue.setPolicy("log", MQTT_QUEUE_POLICY::DROP_OLDEST, 3U);
+
+        for (auto text : { "1", "2", "3", "4", "5" })
+            push(queue, "log", text);
+
+        EXPECT_EQ(drain(queue), std::vector<std::string>({ "3", "4", "5" }));
+
+        TMQTTQueueStats stats = queue.getStats("log");
+        EXPECT_EQ(stats.queued, 5ULL);
+        EXPECT_EQ(stats.dropped, 2ULL);
+    }
+
+    TEST_F(MQTTPublishQueue_push, dropNewestKeepsFirst)
+    {
+        CMQTTPublishQueue queue;
+        queue.setPolicy("aprs-gateway/aprs", MQTT_QUEUE_POLICY::DROP_NEWEST, 3U);
+
+        for (auto text : { "1", "2", "3", "4", "5" })
+            push(queue, "aprs-gateway/aprs", text);
+
+        EXPECT_EQ(drain(queue), std::vector<std::string>({ "1", "2", "3" }));
+
+        TMQTTQueueStats stats = queue.getStats("aprs-gateway/aprs");
+        EXPECT_EQ(stats.queued, 3ULL);
+        EXPECT_EQ(stats.dropped, 2ULL);
+    }
+
+    TEST_F(MQTTPublishQueue_push, coalesceKeepsOnlyLatestPending)
+    {
+        CMQTTPublishQueue queue;
+        queue.setPolicy("status", MQTT_QUEUE_POLICY::COALESCE, 10U);
+
+        push(queue, "log", "log 1");
+        push(queue, "status", "status 1");
+        push(queue, "log", "log 2");
+        push(queue, "status", "status 2");
+        push(queue, "status", "status 3");
+
+        // The refreshed status keeps the turn of the first one
+        EXPECT_EQ(drain(queue), std::vector<std::string>({ "log 1", "status 3", "log 2" }));
+
+        TMQTTQueueStats stats = queue.getStats();
+        EXPECT_EQ(stats.queued, 3ULL);
+        EXPECT_EQ(stats.coalesced, 2ULL);
+        EXPECT_EQ(stats.dropped, 0ULL);
+    }
+
+    TEST_F(MQTTPublishQueue_push, unknownTopicGetsDefaultPolicy)
+    {
+        CMQTTPublishQueue queue(2U, MQTT_QUEUE_POLICY::DROP_OLDEST);
+
+        for (auto text : { "1", "2", "3" })
+            push(queue, "json", text);
+
+        EXPECT_EQ(queue.size(), 2U);
+        EXPECT_EQ(queue.getStats("json").dropped, 1ULL);
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include "NetworkReader.h"
+#include "UDPReaderWriter.h"
+
+#define SERVER_PORT 47021U
+
+namespace NetworkReaderTests
+{
+    class NetworkReader_read : public ::testing::Test {
+    protected:
+        NetworkReader_read() :
+        m_address(CUDPReaderWriter::lookup("127.0.0.1"))
+        {
+        }
+
+        void SetUp() override
+        {
+            ASSERT_TRUE(m_reader.start());
+        }
+
+        void TearDown() override
+        {
+            m_reader.stop();
+        }
+
+        // Read from a queued socket, giving the network thread time to catch up
+        int readWithin(CUDPReaderWriter& socket, unsigned char* buffer, unsigned int length, unsigned int timeoutMs)
+        {
+            in_addr address;
+            unsigned int port;
+
+            return socket.read(buffer, length, address, port, timeoutMs);
+        }
+
+        in_addr        m_address;
+        CNetworkReader m_reader;
+    };
+
+    TEST_F(NetworkReader_read, waitReturnsOnceADatagramIsQueued)
+    {
+        CUDPReaderWriter server("127.0.0.1", SERVER_PORT);
+        CUDPReaderWriter client("127.0.0.1", 0U);
+        ASSERT_TRUE(server.open(&m_reader));
+        ASSERT_TRUE(client.open());
+
+        EXPECT_FALSE(m_reader.wait(10U));
+
+        const unsigned char data[] = { 'D', 'S', 'R', 'P' };
+        ASSERT_TRUE(client.write(data, sizeof(data), m_address, SERVER_PORT));
+
+        EXPECT_TRUE(m_reader.wait(1000U));
+
+        unsigned char buffer[16U];
+        in_addr address;
+        unsigned int port = 0U;
+        EXPECT_EQ(server.read(buffer, sizeof(buffer), address, port), int(sizeof(data)));
+        EXPECT_EQ(::memcmp(buffer, data, sizeof(data)), 0);
+        EXPECT_EQ(address.s_addr, m_address.s_addr);
+        EXPECT_NE(port, 0U);
+
+        EXPECT_EQ(server.read(buffer, sizeof(buffer), address, port), 0);
+
+        client.close();
+        server.close();
+    }
+
+    TEST_F(NetworkReader_read, moreThanAQueueOfDatagramsAllArriveInOrder)
+    {
+        CUDPReaderWriter server("127.0.0.1", SERVER_PORT);
+        CUDPReaderWriter client("127.0.0.1", 0U);
+        ASSERT_TRUE(server.open(&m_reader));
+        ASSERT_TRUE(client.open());
+
+        // The rest wait in the socket until the queue has room again
+        const unsigned int COUNT = NETWORK_QUEUE_LENGTH * 3U;
+        for (unsigned int i = 0U; i < COUNT; i++) {
+            unsigned char data[2U] = { (unsigned char)(i >> 8), (unsigned char)i };
+            ASSERT_TRUE(client.write(data, sizeof(data), m_address, SERVER_PORT));
+        }
+
+        for (unsigned int i = 0U; i < COUNT; i++) {
+            unsigned char buffer[16U];
+            ASSERT_EQ(readWithin(server, buffer, sizeof(buffer), 1000U), 2) << "datagram " << i;
+            EXPECT_EQ(buffer[0U] * 256U + buffer[1U], i);
+        }
+
+        client.close();
+        server.close();
+    }
+
+    TEST_F(NetworkReader_read, oversizedDatagramIsDropped)
+    {
+        CUDPReaderWriter server("127.0.0.1", SERVER_PORT);
+        CUDPReaderWriter client("127.0.0.1", 0U);
+        ASSERT_TRUE(server.open(&m_reader));
+        ASSERT_TRUE(client.open());
+
+        // Only the first NETWORK_PACKET_LENGTH bytes would fit, so none of it must be passed on
+        unsigned char large[NETWORK_PACKET_LENGTH + 100U];
+        ::memset(large, 0xAAU, sizeof(large));
+        ASSERT_TRUE(client.write(large, sizeof(large), m_address, SERVER_PORT));
+
+        const unsigned char data[] = { 0x01U, 0x02U, 0x03U };
+        ASSERT_TRUE(client.write(data, sizeof(data), m_address, SERVER_PORT));
+
+        unsigned char buffer[NETWORK_PACKET_LENGTH];
+        ASSERT_EQ(readWithin(server, buffer, sizeof(buffer), 1000U), int(sizeof(data)));
+        EXPECT_EQ(::memcmp(buffer, data, sizeof(data)), 0);
+
+        EXPECT_EQ(readWithin(server, buffer, sizeof(buffer), 20U), 0);
+
+        client.close();
+        server.close();
+    }
+
+    TEST_F(NetworkReader_read, closedSocketIsNoLongerReceived)
+    {
+        CUDPReaderWriter server("127.0.0.1", SERVER_PORT);
+        CUDPReaderWriter client("127.0.0.1", 0U);
+        ASSERT_TRUE(server.open(&m_reader));
+        ASSERT_TRUE(client.open());
+
+        const unsigned char data[] = { 0x01U };
+        ASSERT_TRUE(client.write(data, sizeof(data), m_address, SERVER_PORT));
+        ASSERT_TRUE(m_reader.wait(1000U));
+
+        // Whatever was queued goes with the socket
+        server.close();
+        ASSERT_TRUE(server.open(&m_reader));
+
+        unsigned char buffer[16U];
+        EXPECT_EQ(readWithin(server, buffer, sizeof(buffer), 20U), 0);
+
+        ASSERT_TRUE(client.write(data, sizeof(data), m_address, SERVER_PORT));
+        EXPECT_EQ(readWithin(server, buffer, sizeof(buffer), 1000U), 1);
+
+        client.close();
+        server.close();
+    }
+
+    TEST_F(NetworkReader_read, socketOpenedWithoutTheReaderIsLeftAlone)
+    {
+        CUDPReaderWriter server("127.0.0.1", SERVER_PORT);
+        CUDPReaderWriter client("127.0.0.1", 0U);
+        ASSERT_TRUE(server.open());
+        ASSERT_TRUE(client.open());
+
+        const unsigned char data[] = { 0x01U };
+        ASSERT_TRUE(client.write(data, sizeof(data), m_address, SERVER_PORT));
+
+        EXPECT_FALSE(m_reader.wait(50U));
+
+        unsigned char buffer[16U];
+        EXPECT_EQ(readWithin(server, buffer, sizeof(buffer), 1000U), 1);
+
+        client.close();
+        server.close();
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "PacingEngine.h"
+
+namespace PacingEngineTests
+{
+    class PacingEngine_run : public ::testing::Test {
+    };
+
+    TEST_F(PacingEngine_run, streamPacerDeadlines)
+    {
+        CStreamPacer pacer(20U);
+        TPacingTime start = std::chrono::steady_clock::now();
+        pacer.start(start);
+
+        EXPECT_EQ(pacer.getDue(start), 0U);
+        EXPECT_EQ(pacer.getDue(start + std::chrono::microseconds(19999)), 0U);
+        EXPECT_EQ(pacer.getDue(start + std::chrono::milliseconds(20)), 1U);
+        EXPECT_EQ(pacer.getDue(start + std::chrono::milliseconds(1000)), 50U);
+        EXPECT_EQ(pacer.getDeadline(0U), start + std::chrono::milliseconds(20));
+        EXPECT_EQ(pacer.getDeadline(49U), start + std::chrono::milliseconds(1000));
+    }
+
+    TEST_F(PacingEngine_run, histogramPercentiles)
+    {
+        CJitterHistogram histogram(100U, 10U);
+        for (unsigned int i = 0U; i < 98U; i++)
+            histogram.add(std::chrono::microseconds(50));
+        histogram.add(std::chrono::microseconds(450));
+        histogram.add(std::chrono::microseconds(5000));
+
+        EXPECT_EQ(histogram.getTotal(), 100UL);
+        EXPECT_EQ(histogram.getCount(0U), 98UL);
+        EXPECT_EQ(histogram.getCount(4U), 1UL);
+        EXPECT_EQ(histogram.getCount(10U), 1UL) << "Anything past the last bucket goes in the overflow";
+        EXPECT_EQ(histogram.getPercentile(0.5), 100ULL);
+        EXPECT_EQ(histogram.getPercentile(0.99), 500ULL);
+        EXPECT_EQ(histogram.getMax(), 5000ULL);
+    }
+
+    TEST_F(PacingEngine_run, streamsEndWhenTheCallbackSaysSo)
+    {
+        CPacingEngine engine(1U);
+        std::vector<unsigned int> frames;
+
+        engine.add([&](unsigned int frame) { frames.push_back(frame); return frame < 4U; });
+        engine.run();
+
+        EXPECT_EQ(frames, std::vector<unsigned int>({ 0U, 1U, 2U, 3U, 4U }));
+        EXPECT_FALSE(engine.hasStreams());
+    }
+
+    TEST_F(PacingEngine_run, concurrentStreamsJitter)
+    {
+        const unsigned int STREAMS = 8U;
+        const unsigned int FRAMES  = 50U;
+
+        CPacingEngine engine(20U);
+        std::vector<std::vector<TPacingTime>> sent(STREAMS);
+
+        TPacingTime start = std::chrono::steady_clock::now();
+        for (unsigned int s = 0U; s < STREAMS; s++) {
+            // Stagger the streams so that their deadlines interleave
+            engine.add([&, s](unsigned int frame) {
+                sent[s].push_back(std::chrono::steady_clock::now());
+                return frame + 1U < FRAMES;
+            }, start + std::chrono::microseconds(s * 2500U));
+        }
+
+        engine.run();
+
+        const CJitterHistogram& jitter = engine.getJitter();
+        ASSERT_EQ(jitter.getTotal(), STREAMS * FRAMES);
+
+        for (unsigned int s = 0U; s < STREAMS; s++) {
+            ASSERT_EQ(sent[s].size(), FRAMES);
+
+            // Never early, and the last frame lands where the schedule says whatever happened before
+            TPacingTime last = start + std::chrono::microseconds(s * 2500U) + std::chrono::milliseconds(20U * FRAMES);
+            EXPECT_GE(sent[s].back(), last);
+        }
+
+        std::cout << "Lateness over " << jitter.getTotal() << " frames in " << STREAMS << " streams:" << std::endl;
+        for (unsigned int i = 0U; i < jitter.getBucketCount(); i++) {
+            if (jitter.getCount(i) > 0UL)
+                std::cout << "  " << (i + 1U == jitter.getBucketCount() ? ">= " : "< ") << (i + (i + 1U == jitter.getBucketCount() ? 0U : 1U)) * jitter.getBucketWidth() << " us: " << jitter.getCount(i) << std::endl;
+        }
+        std::cout << "  p50 " << jitter.getPercentile(0.5) << " us, p99 " << jitter.getPercentile(0.99) << " us, max " << jitter.getMax() << " us" << std::endl;
+
+        // Generous, the test machine may be busy, but a spinning or drifting loop would be way off
+        EXPECT_LE(jitter.getPercentile(0.5), 2000ULL);
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "RemoteProtocolHandler.h"
+#include "UDPReaderWriter.h"
+
+namespace RemoteProtocolHandlerTests
+{
+    const unsigned int SUBSCRIBE_PORT = 47501U;
+
+    class RemoteProtocolHandler_readType : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(m_server.open());
+            ASSERT_TRUE(m_first.open());
+            ASSERT_TRUE(m_second.open());
+            m_address = CUDPReaderWriter::lookup("127.0.0.1");
+        }
+
+        void TearDown() override
+        {
+            m_server.close();
+            m_first.close();
+            m_second.close();
+        }
+
+        RPH_TYPE send(CUDPReaderWriter& client, const char* type)
+        {
+            client.write((const unsigned char*)type, 3U, m_address, SUBSCRIBE_PORT);
+
+            for (unsigned int i = 0U; i < 100U; i++) {
+                RPH_TYPE read = m_server.readType();
+                if (read != RPHT_NONE)
+                    return read;
+                ::usleep(1000U);
+            }
+            return RPHT_NONE;
+        }
+
+        void login(CUDPReaderWriter& client)
+        {
+            ASSERT_EQ(send(client, "LIN"), RPHT_LOGIN);
+            m_server.setLoggedIn(true);
+        }
+
+        std::string receive(CUDPReaderWriter& client)
+        {
+            unsigned char buffer[100U];
+            in_addr address;
+            unsigned int port;
+            int length = client.read(buffer, sizeof(buffer) - 1U, address, port, 500U);
+            if (length <= 0)
+                return "";
+            buffer[length] = 0x00U;
+            return std::string((const char*)buffer);
+        }
+
+        CRemoteProtocolHandler m_server{ SUBSCRIBE_PORT, "127.0.0.1" };
+        CUDPReaderWriter       m_first{ "127.0.0.1", 0U };
+        CUDPReaderWriter       m_second{ "127.0.0.1", 0U };
+        in_addr                m_address;
+    };
+
+    TEST_F(RemoteProtocolHandler_readType, secondSubscriberIsRefused)
+    {
+        login(m_first);
+        ASSERT_EQ(send(m_first, "SUB"), RPHT_SUBSCRIBE);
+        m_server.setSubscribed(true);
+        m_server.setLoggedIn(false);
+
+        login(m_second);
+        EXPECT_EQ(send(m_second, "SUB"), RPHT_NONE);
+        EXPECT_EQ(receive(m_second), "NAKSomeone else is already subscribed");
+
+        // Nor can it end someone else's subscription
+        EXPECT_EQ(send(m_second, "UNS"), RPHT_NONE);
+        EXPECT_EQ(receive(m_second), "NAKYou are not subscribed");
+
+        // The subscriber still renews and ends its own
+        EXPECT_EQ(send(m_first, "SUB"), RPHT_SUBSCRIBE);
+        EXPECT_TRUE(m_server.isSubscribed());
+        EXPECT_EQ(send(m_first, "UNS"), RPHT_UNSUBSCRIBE);
+        m_server.setSubscribed(false);
+
+        EXPECT_EQ(send(m_second, "SUB"), RPHT_SUBSCRIBE);
+    }
+}
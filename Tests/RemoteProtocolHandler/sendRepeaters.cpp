@@ -0,0 +1,219 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "RemoteProtocolHandler.h"
+#include "RemoteRepeaterData.h"
+#include "UDPReaderWriter.h"
+#include "Utils.h"
+
+namespace RemoteProtocolHandlerTests
+{
+    const unsigned int SERVER_PORT = 47500U;
+
+    class RemoteProtocolHandler_sendRepeaters : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(m_server.open());
+            ASSERT_TRUE(m_client.open());
+            m_address = CUDPReaderWriter::lookup("127.0.0.1");
+
+            // The server answers whoever sent LIN
+            send("LIN");
+            ASSERT_EQ(m_server.readType(), RPHT_LOGIN);
+            m_server.setLoggedIn(true);
+        }
+
+        void TearDown() override
+        {
+            m_server.close();
+            m_client.close();
+        }
+
+        void send(const char* type)
+        {
+            m_client.write((const unsigned char*)type, 3U, m_address, SERVER_PORT);
+        }
+
+        RPH_TYPE readType()
+        {
+            for (unsigned int i = 0U; i < 100U; i++) {
+                RPH_TYPE type = m_server.readType();
+                if (type != RPHT_NONE)
+                    return type;
+                ::usleep(1000U);
+            }
+            return RPHT_NONE;
+        }
+
+        int receive(unsigned char* buffer)
+        {
+            in_addr address;
+            unsigned int port;
+            return m_client.read(buffer, 2000U, address, port, 500U);
+        }
+
+        static std::vector<CRemoteRepeaterData*> repeaters(unsigned int count, unsigned int links)
+        {
+            std::vector<CRemoteRepeaterData*> data;
+            for (unsigned int i = 0U; i < count; i++) {
+                CRemoteRepeaterData* rpt = new CRemoteRepeaterData("F4FXL  " + std::string(1U, 'A' + i), RECONNECT_NEVER, "DCS208 C");
+                for (unsigned int n = 0U; n < links; n++)
+                    rpt->addLink("XRF999 " + std::string(1U, 'A' + n), PROTO_DEXTRA, true, DIR_OUTGOING, false);
+                data.push_back(rpt);
+            }
+            return data;
+        }
+
+        // The repeaters in one ALL datagram, each entry is its link count followed by the RPT body
+        static unsigned int countRepeaters(const unsigned char* buffer, int length)
+        {
+            unsigned int count = 0U;
+            int pos = 3U;
+            while (pos + int(sizeof(int32_t)) <= length) {
+                int32_t links;
+                ::memcpy(&links, buffer + pos, sizeof(int32_t));
+                pos += sizeof(int32_t) + 20 + CUtils::swap_endian_be(links) * 24;
+                count++;
+            }
+            EXPECT_EQ(pos, length);
+            return count;
+        }
+
+        CRemoteProtocolHandler m_server{ SERVER_PORT, "127.0.0.1" };
+        CUDPReaderWriter       m_client{ "127.0.0.1", 0U };
+        in_addr                m_address;
+    };
+
+    TEST_F(RemoteProtocolHandler_sendRepeaters, oneAnswerForTheWholeGateway)
+    {
+        send("GAR");
+        ASSERT_EQ(readType(), RPHT_REPEATERS);
+
+        std::vector<CRemoteRepeaterData*> data = repeaters(4U, 2U);
+        EXPECT_TRUE(m_server.sendRepeaters(data));
+
+        unsigned char buffer[2000U];
+        int length = receive(buffer);
+        ASSERT_GT(length, 3);
+        EXPECT_EQ(::memcmp(buffer, "ALL", 3U), 0);
+        EXPECT_EQ(countRepeaters(buffer, length), 4U);
+
+        // Polling needed GCS and then a GRP per repeater
+        EXPECT_EQ(receive(buffer), 0);
+
+        for (CRemoteRepeaterData* rpt : data)
+            delete rpt;
+    }
+
+    TEST_F(RemoteProtocolHandler_sendRepeaters, largeGatewaysSpanDatagrams)
+    {
+        send("GAR");
+        ASSERT_EQ(readType(), RPHT_REPEATERS);
+
+        std::vector<CRemoteRepeaterData*> data = repeaters(20U, 10U);
+        EXPECT_TRUE(m_server.sendRepeaters(data));
+
+        unsigned int total = 0U;
+        unsigned int datagrams = 0U;
+        unsigned char buffer[2000U];
+        int length;
+        while ((length = receive(buffer)) > 0) {
+            EXPECT_EQ(::memcmp(buffer, "ALL", 3U), 0);
+            total += countRepeaters(buffer, length);
+            datagrams++;
+        }
+
+        EXPECT_EQ(total, 20U);
+        EXPECT_EQ(datagrams, 3U);
+
+        for (CRemoteRepeaterData* rpt : data)
+            delete rpt;
+    }
+
+    TEST_F(RemoteProtocolHandler_sendRepeaters, subscriptionOutlivesOtherSessions)
+    {
+        send("SUB");
+        ASSERT_EQ(readType(), RPHT_SUBSCRIBE);
+        m_server.setSubscribed(true);
+
+        // Another client logs in to send a command
+        CUDPReaderWriter other("127.0.0.1", 0U);
+        ASSERT_TRUE(other.open());
+        other.write((const unsigned char*)"LIN", 3U, m_address, SERVER_PORT);
+        ASSERT_EQ(readType(), RPHT_LOGIN);
+        m_server.setLoggedIn(true);
+        EXPECT_TRUE(m_server.isSubscribed());
+
+        std::vector<unsigned char> repeater;
+        std::vector<CRemoteRepeaterData*> data = repeaters(1U, 1U);
+        CRemoteProtocolHandler::encodeRepeater(*data[0U], repeater);
+        EXPECT_EQ(repeater.size(), 44U);
+        EXPECT_TRUE(m_server.sendRepeaterEvent(repeater));
+        EXPECT_TRUE(m_server.sendHeardEvent("F4FXL  B", "KC3FRA"));
+
+        unsigned char buffer[2000U];
+        EXPECT_EQ(receive(buffer), 3 + 44);
+        EXPECT_EQ(::memcmp(buffer, "EVR", 3U), 0);
+        EXPECT_EQ(receive(buffer), 3 + 16);
+        EXPECT_EQ(::memcmp(buffer, "EVH", 3U), 0);
+        EXPECT_EQ(std::string((char*)buffer + 11U, 8U), "KC3FRA  ");
+
+        // The subscriber still renews, and its ACK comes back to it rather than to the session
+        send("SUB");
+        ASSERT_EQ(readType(), RPHT_SUBSCRIBE);
+        EXPECT_TRUE(m_server.isFromSubscriber());
+        EXPECT_TRUE(m_server.sendACK());
+        EXPECT_EQ(receive(buffer), 3);
+        EXPECT_EQ(::memcmp(buffer, "ACK", 3U), 0);
+
+        other.close();
+        delete data[0U];
+    }
+
+    TEST_F(RemoteProtocolHandler_sendRepeaters, voiceStatsAreOneRecordPerProtocol)
+    {
+        send("GVS");
+        ASSERT_EQ(readType(), RPHT_VOICESTATS);
+
+        TVoiceSnapshot snapshot = {};
+        snapshot.framesIn = 1234U;
+        std::vector<unsigned char> stats;
+        for (unsigned int i = VP_HB; i < VOICE_PROTOCOLS; i++)
+            CRemoteProtocolHandler::encodeVoiceStats(VOICE_PROTOCOL(i), snapshot, stats);
+        ASSERT_EQ(stats.size(), 6U * 140U);
+        EXPECT_TRUE(m_server.sendVoiceStats(stats));
+
+        unsigned char buffer[2000U];
+        ASSERT_EQ(receive(buffer), 3 + 6 * 140);
+        EXPECT_EQ(::memcmp(buffer, "VST", 3U), 0);
+
+        int32_t protocol;
+        ::memcpy(&protocol, buffer + 3U + 140U, sizeof(int32_t));
+        EXPECT_EQ(CUtils::swap_endian_be(protocol), int32_t(VP_ICOM));
+
+        uint64_t framesIn;
+        ::memcpy(&framesIn, buffer + 3U + sizeof(int32_t), sizeof(uint64_t));
+        EXPECT_EQ(CUtils::swap_endian_be(framesIn), 1234U);
+    }
+}
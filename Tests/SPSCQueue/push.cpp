@@ -0,0 +1,115 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "SPSCQueue.h"
+
+namespace SPSCQueueTests
+{
+    class SPSCQueue_push : public ::testing::Test {};
+
+    TEST_F(SPSCQueue_push, fullQueueRefusesNewEntries)
+    {
+        CSPSCQueue<unsigned int> queue(4U);
+
+        for (unsigned int i = 0U; i < 4U; i++)
+            EXPECT_TRUE(queue.push(i));
+
+        EXPECT_FALSE(queue.push(4U));
+        EXPECT_EQ(queue.size(), 4U);
+        EXPECT_EQ(queue.writable(), 0U);
+
+        for (unsigned int i = 0U; i < 4U; i++) {
+            unsigned int* value = queue.front();
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, i);
+            queue.pop();
+        }
+
+        EXPECT_TRUE(queue.isEmpty());
+        EXPECT_EQ(queue.front(), nullptr);
+    }
+
+    TEST_F(SPSCQueue_push, capacityIsRoundedUpToAPowerOfTwo)
+    {
+        CSPSCQueue<unsigned int> queue(5U);
+
+        EXPECT_EQ(queue.capacity(), 8U);
+        EXPECT_EQ(queue.writable(), 8U);
+    }
+
+    TEST_F(SPSCQueue_push, slotsOnlyShowOnceCommitted)
+    {
+        CSPSCQueue<unsigned int> queue(4U);
+
+        // Wrap the indices round once first
+        for (unsigned int i = 0U; i < 3U; i++) {
+            queue.push(i);
+            queue.pop();
+        }
+
+        for (unsigned int i = 0U; i < 3U; i++)
+            *queue.writeSlot(i) = 10U + i;
+
+        EXPECT_TRUE(queue.isEmpty());
+
+        queue.commit(2U);
+        EXPECT_EQ(queue.size(), 2U);
+
+        EXPECT_EQ(*queue.front(), 10U);
+        queue.pop();
+        EXPECT_EQ(*queue.front(), 11U);
+        queue.pop();
+        EXPECT_TRUE(queue.isEmpty());
+    }
+
+    TEST_F(SPSCQueue_push, everyEntryArrivesInOrderAcrossThreads)
+    {
+        const unsigned int COUNT = 200000U;
+        CSPSCQueue<unsigned int> queue(64U);
+
+        std::thread producer([&queue, COUNT]() {
+            for (unsigned int i = 0U; i < COUNT; i++) {
+                while (!queue.push(i))
+                    std::this_thread::yield();
+            }
+        });
+
+        unsigned int expected = 0U;
+        while (expected < COUNT) {
+            unsigned int* value = queue.front();
+            if (value == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (*value != expected)
+                break;
+
+            queue.pop();
+            expected++;
+        }
+
+        producer.join();
+
+        EXPECT_EQ(expected, COUNT);
+        EXPECT_TRUE(queue.isEmpty());
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "APRSCollector.h"
+#include "SlowDataEncoder.h"
+#include "SlowDataCollectorThrottle.h"
+#include "NMEASentenceCollector.h"
+#include "GPSACollector.h"
+#include "RSMS1AMessageCollector.h"
+#include "DStarDefines.h"
+
+namespace SlowDataDemuxTests
+{
+    // Many stations all beaconing several NMEA sentences at once
+    class SlowDataDemux_benchmark : public ::testing::Test {
+    protected:
+        static const unsigned int STREAMS = 64U;
+        static const unsigned int FRAMES  = 21U * 50U;		// 21 seconds per stream
+        static const unsigned int ROUNDS  = 3U;
+
+        void SetUp() override
+        {
+            CSlowDataEncoder encoder;
+            encoder.setGPSData("$GPGGA,092750.000,5321.6802,N,00630.3371,W,1,8,1.03,61.7,M,55.2,M,,*76\x0A"
+                               "$GPRMC,092751.000,A,5321.6802,N,00630.3371,W,0.06,31.66,280511,,,A*45\x0A"
+                               "$GPVTG,31.66,T,,M,0.06,N,0.1,K,A*30\x0A");
+
+            m_data.resize(FRAMES * DATA_FRAME_LENGTH_BYTES);
+            // Sync frames are skipped by the receivers, whatever they hold
+            for (unsigned int i = 0U; i < FRAMES; i++) {
+                if ((i % 21U) != 0U)
+                    encoder.getInterleavedData(m_data.data() + i * DATA_FRAME_LENGTH_BYTES);
+            }
+        }
+
+        // Feeds every stream in turn, frame by frame, the way the gateway interleaves them.
+        // Best of a few rounds, to keep whatever else runs on the machine out of the figures.
+        template<typename F> double framesPerSecond(F writeData)
+        {
+            double best = 0.0;
+            for (unsigned int round = 0U; round < ROUNDS; round++) {
+                auto start = std::chrono::steady_clock::now();
+                for (unsigned int i = 0U; i < FRAMES; i++) {
+                    for (unsigned int s = 0U; s < STREAMS; s++)
+                        writeData(s, i, m_data.data() + i * DATA_FRAME_LENGTH_BYTES);
+                }
+                auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                best = std::max(best, (STREAMS * FRAMES) / elapsed);
+            }
+
+            return best;
+        }
+
+        std::vector<unsigned char> m_data;
+    };
+
+    TEST_F(SlowDataDemux_benchmark, DISABLED_gpsHeavyStreams)
+    {
+        // The way CAPRSCollector used to work, every collector descrambling the same bytes on its own
+        std::vector<std::vector<std::unique_ptr<ISlowDataCollector>>> legacy(STREAMS);
+        for (auto& collectors : legacy) {
+            collectors.emplace_back(new CRSMS1AMessageCollector());
+            collectors.emplace_back(new CSlowDataCollectorThrottle(new CGPSACollector(), 10U));
+            for (auto sentence : { "$GPGGA", "$GPGLL", "$GPVTG", "$GPRMC", "$GPGSA", "$GPGSV" })
+                collectors.emplace_back(new CSlowDataCollectorThrottle(new CNMEASentenceCollector(sentence), 10U));
+        }
+
+        unsigned long legacyComplete = 0UL;
+        double legacyRate = framesPerSecond([&](unsigned int s, unsigned int frame, const unsigned char* data) {
+            for (auto& collector : legacy[s]) {
+                if ((frame % 21U) == 0U)
+                    collector->sync();
+                else if (collector->writeData(data))
+                    legacyComplete++;
+            }
+        });
+
+        std::vector<std::unique_ptr<CAPRSCollector>> demuxed(STREAMS);
+        for (auto& collector : demuxed)
+            collector.reset(new CAPRSCollector());
+
+        unsigned long demuxComplete = 0UL;
+        double demuxRate = framesPerSecond([&](unsigned int s, unsigned int frame, const unsigned char* data) {
+            if ((frame % 21U) == 0U)
+                demuxed[s]->sync();
+            else if (demuxed[s]->writeData(data))
+                demuxComplete++;
+        });
+
+        std::cout << STREAMS << " GPS streams, per collector descrambling : " << (unsigned long)legacyRate << " frames/s" << std::endl;
+        std::cout << STREAMS << " GPS streams, single pass demux          : " << (unsigned long)demuxRate << " frames/s" << std::endl;
+
+        EXPECT_GT(demuxComplete, 0UL);
+        EXPECT_EQ(demuxComplete, legacyComplete) << "Both ways shall see the same sentences";
+    }
+}
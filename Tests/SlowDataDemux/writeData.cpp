@@ -0,0 +1,132 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "SlowDataDemux.h"
+#include "SlowDataEncoder.h"
+#include "TextCollector.h"
+#include "APRSCollector.h"
+#include "DStarDefines.h"
+
+namespace SlowDataDemuxTests
+{
+    class SlowDataDemux_writeData : public ::testing::Test {
+    protected:
+        // Runs the frames through the demux, syncing where the sync frames would be. The encoder
+        // carries on across the sync frames the way a radio does.
+        static bool transmit(CSlowDataEncoder& encoder, CSlowDataDemux& demux, unsigned int frames)
+        {
+            bool complete = false;
+            unsigned char data[DATA_FRAME_LENGTH_BYTES];
+
+            for (unsigned int i = 0U; i < frames; i++) {
+                if ((i % 21U) == 0U) {
+                    demux.sync();
+                    continue;
+                }
+
+                encoder.getInterleavedData(data);
+                if (demux.writeData(data))
+                    complete = true;
+            }
+
+            return complete;
+        }
+    };
+
+    TEST_F(SlowDataDemux_writeData, blocksOnlyGoToTheirType)
+    {
+        CSlowDataEncoder encoder;
+        encoder.setTextData("Hello world");
+        encoder.setGPSData("$GPRMC,092751.000,A,5321.6802,N,00630.3371,W,0.06,31.66,280511,,,A*45\x0A");
+
+        std::vector<unsigned char> textTypes, gpsTypes;
+
+        CSlowDataDemux demux;
+        demux.addConsumer(SLOW_DATA_TYPE_TEXT, [&](const unsigned char* block) { textTypes.push_back(block[0U]); return false; });
+        demux.addConsumer(SLOW_DATA_TYPE_GPS | 0x05U, [&](const unsigned char* block) { gpsTypes.push_back(block[0U]); return false; });
+        EXPECT_EQ(demux.getConsumerCount(), 2U);
+
+        transmit(encoder, demux, 21U * 4U);
+
+        ASSERT_FALSE(textTypes.empty());
+        ASSERT_FALSE(gpsTypes.empty());
+        for (auto type : textTypes)
+            EXPECT_EQ(type & SLOW_DATA_TYPE_MASK, SLOW_DATA_TYPE_TEXT);
+        for (auto type : gpsTypes)
+            EXPECT_EQ(type & SLOW_DATA_TYPE_MASK, SLOW_DATA_TYPE_GPS);
+    }
+
+    TEST_F(SlowDataDemux_writeData, textAndPositionFromOneStream)
+    {
+        CSlowDataEncoder encoder;
+        encoder.setTextData("Hello world");
+        encoder.setGPSData("$GPRMC,092751.000,A,5321.6802,N,00630.3371,W,0.06,31.66,280511,,,A*45\x0A");
+
+        CHeaderData header;
+        header.setMyCall1("N0CALL  ");
+        header.setMyCall2("5100");
+
+        CTextCollector text;
+        CAPRSCollector aprs;
+        aprs.writeHeader(header);
+
+        // The APRS collector has to be read as soon as it has something, like CAPRSHandler does
+        std::vector<std::string> frames;
+
+        CSlowDataDemux demux;
+        demux.addConsumer(SLOW_DATA_TYPE_TEXT, [&](const unsigned char* block) { return text.writeBlock(block); });
+        demux.addConsumer(SLOW_DATA_TYPE_GPS,  [&](const unsigned char* block) {
+            bool complete = aprs.writeBlock(block);
+            if (complete)
+                aprs.getData([&](const std::string& frame, const std::string&) { frames.push_back(frame); });
+            return complete;
+        });
+
+        EXPECT_TRUE(transmit(encoder, demux, 21U * 6U));
+
+        ASSERT_TRUE(text.hasData());
+        EXPECT_EQ(text.getData(), "Hello world         ");
+
+        ASSERT_GE(frames.size(), 1U);
+        EXPECT_EQ(frames[0U], "N0CALL-5>GPS30,DSTAR*:$GPRMC,092751.000,A,5321.6802,N,00630.3371,W,0.06,31.66,280511,,,A*45");
+    }
+
+    TEST_F(SlowDataDemux_writeData, syncRestartsTheFraming)
+    {
+        unsigned int blocks = 0U;
+
+        CSlowDataDemux demux;
+        demux.addConsumer(SLOW_DATA_TYPE_TEXT, [&](const unsigned char*) { blocks++; return false; });
+
+        unsigned char first[DATA_FRAME_LENGTH_BYTES]  = { SLOW_DATA_TYPE_TEXT ^ SCRAMBLER_BYTE1, 'A' ^ SCRAMBLER_BYTE2, 'B' ^ SCRAMBLER_BYTE3 };
+        unsigned char second[DATA_FRAME_LENGTH_BYTES] = { 'C' ^ SCRAMBLER_BYTE1, 'D' ^ SCRAMBLER_BYTE2, 'E' ^ SCRAMBLER_BYTE3 };
+
+        demux.writeData(first);
+        demux.sync();
+        demux.writeData(first);
+        EXPECT_EQ(blocks, 0U) << "A block cut by a sync frame shall be dropped";
+
+        demux.writeData(second);
+        EXPECT_EQ(blocks, 1U);
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "StatusSegment.h"
+
+namespace StatusSegmentTests
+{
+    class StatusSegment_read : public ::testing::Test {
+    protected:
+        StatusSegment_read() :
+        m_name("/dgw_status_tests_" + std::to_string(::getpid()))
+        {
+        }
+
+        // Every byte after the time stamp carries the low byte of the time stamp, so a torn copy shows up as a mismatch
+        static void fill(SStatusData& data, uint64_t n)
+        {
+            ::memset(&data, int(n & 0xFFU), sizeof(SStatusData));
+            data.updated = n;
+        }
+
+        static bool isConsistent(const SStatusData& data)
+        {
+            const unsigned char* p = (const unsigned char*)&data;
+            unsigned char expected = (unsigned char)(data.updated & 0xFFU);
+
+            for (std::size_t i = sizeof(data.updated); i < sizeof(SStatusData); i++) {
+                if (p[i] != expected)
+                    return false;
+            }
+
+            return true;
+        }
+
+        std::string m_name;
+    };
+
+    TEST_F(StatusSegment_read, missingSegmentCannotBeOpened)
+    {
+        CStatusSegment reader(m_name);
+
+        EXPECT_FALSE(reader.open());
+        EXPECT_FALSE(reader.isOpen());
+        EXPECT_FALSE(reader.isRunning());
+    }
+
+    TEST_F(StatusSegment_read, readerSeesWhatWasWritten)
+    {
+        CStatusSegment writer(m_name);
+        ASSERT_TRUE(writer.create());
+
+        SStatusData data;
+        ::memset(&data, 0x00, sizeof(SStatusData));
+        data.updated = 1234ULL;
+        CStatusSegment::setString(data.gateway, STATUS_CALLSIGN_LENGTH, "F4FXL  G");
+        data.repeaterCount = 1U;
+        CStatusSegment::setString(data.repeaters[0].callsign, STATUS_CALLSIGN_LENGTH, "F4FXL  B");
+        CStatusSegment::setString(data.repeaters[0].lastHeard, STATUS_CALLSIGN_LENGTH, "A CALLSIGN THAT IS TOO LONG");
+        data.traffic.repeaterFrames = 42ULL;
+        writer.write(data);
+
+        CStatusSegment reader(m_name);
+        ASSERT_TRUE(reader.open());
+        EXPECT_TRUE(reader.isRunning());
+
+        SStatusData read;
+        ASSERT_TRUE(reader.read(read));
+        EXPECT_EQ(read.updated, 1234ULL);
+        EXPECT_STREQ(read.gateway, "F4FXL  G");
+        EXPECT_EQ(read.repeaterCount, 1U);
+        EXPECT_STREQ(read.repeaters[0].callsign, "F4FXL  B");
+        EXPECT_STREQ(read.repeaters[0].lastHeard, "A CALLSI");
+        EXPECT_EQ(read.traffic.repeaterFrames, 42ULL);
+
+        writer.close();
+        EXPECT_FALSE(reader.isRunning());
+    }
+
+    TEST_F(StatusSegment_read, copiesAreConsistentUnderConcurrentUpdates)
+    {
+        CStatusSegment writer(m_name);
+        ASSERT_TRUE(writer.create());
+
+        SStatusData data;
+        fill(data, 1ULL);
+        writer.write(data);
+
+        std::atomic<bool> stop(false);
+        std::thread writerThread([&]() {
+            SStatusData update;
+            for (uint64_t n = 2ULL; !stop.load(); n++) {
+                fill(update, n);
+                writer.write(update);
+            }
+        });
+
+        // Each reader maps the segment on its own, as separate processes would
+        const unsigned int READERS = 3U;
+        const unsigned int READS   = 20000U;
+        std::vector<unsigned int> torn(READERS, 0U);
+        std::vector<unsigned int> backwards(READERS, 0U);
+        std::vector<unsigned int> failed(READERS, 0U);
+        std::vector<std::thread> readers;
+
+        for (unsigned int r = 0U; r < READERS; r++) {
+            readers.emplace_back([&, r]() {
+                CStatusSegment reader(m_name);
+                if (!reader.open()) {
+                    failed[r] = READS;
+                    return;
+                }
+
+                uint64_t last = 0ULL;
+                SStatusData copy;
+                for (unsigned int i = 0U; i < READS; i++) {
+                    if (!reader.read(copy)) {
+                        failed[r]++;
+                        continue;
+                    }
+
+                    if (!isConsistent(copy))
+                        torn[r]++;
+                    if (copy.updated < last)
+                        backwards[r]++;
+
+                    last = copy.updated;
+                }
+            });
+        }
+
+        for (std::thread& reader : readers)
+            reader.join();
+
+        stop.store(true);
+        writerThread.join();
+
+        for (unsigned int r = 0U; r < READERS; r++) {
+            EXPECT_EQ(torn[r], 0U) << "reader " << r;
+            EXPECT_EQ(backwards[r], 0U) << "reader " << r;
+            EXPECT_LT(failed[r], READS / 100U) << "reader " << r;
+        }
+    }
+}
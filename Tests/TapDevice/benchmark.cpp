@@ -0,0 +1,142 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "EthernetRouteTable.h"
+#include "TapDevice.h"
+
+namespace TapDeviceTests
+{
+    const unsigned int ROUTES = 256U;
+    const unsigned int CHUNK  = TAP_BATCH_FRAMES;
+    const unsigned int FRAMES = CHUNK * 2000U;
+    const unsigned int ROUNDS = 5U;
+
+    class TapDevice_benchmark : public ::testing::Test {
+    protected:
+        static void address(unsigned char* addr, unsigned int n)
+        {
+            addr[0U] = 0x02U;
+            addr[1U] = 0x00U;
+            addr[2U] = 0x00U;
+            addr[3U] = 0x00U;
+            addr[4U] = (n >> 8) & 0xFFU;
+            addr[5U] = n & 0xFFU;
+        }
+
+        // Queue a chunk of frames addressed to stations spread over the whole table
+        static void send(int fd, unsigned int first)
+        {
+            unsigned char frame[60U];
+            ::memset(frame, 0x00U, sizeof(frame));
+
+            for (unsigned int i = 0U; i < CHUNK; i++) {
+                address(frame, (first + i) % ROUTES);
+                ASSERT_EQ(::write(fd, frame, sizeof(frame)), ssize_t(sizeof(frame)));
+            }
+        }
+    };
+
+    TEST_F(TapDevice_benchmark, DISABLED_ddFramesPerSecond)
+    {
+        // The previous handler: select() before every read() and a scan of the route list for every frame
+        unsigned char list[ROUTES][ETHERNET_ADDRESS_LENGTH];
+        CEthernetRouteTable table(ROUTES, 3600U);
+        for (unsigned int i = 0U; i < ROUTES; i++) {
+            address(list[i], i);
+            table.learn(list[i], "F4FXL   ");
+        }
+
+        std::chrono::nanoseconds oldBest = std::chrono::nanoseconds::max();
+        std::chrono::nanoseconds newBest = std::chrono::nanoseconds::max();
+
+        for (unsigned int round = 0U; round < ROUNDS; round++) {
+            int fds[2];
+            ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+
+            unsigned int found = 0U;
+            unsigned char buffer[TAP_FRAME_LENGTH];
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned int n = 0U; n < FRAMES; n += CHUNK) {
+                send(fds[1], n);
+
+                for (;;) {
+                    fd_set readFds;
+                    FD_ZERO(&readFds);
+                    FD_SET(fds[0], &readFds);
+                    timeval tv = { 0L, 0L };
+                    if (::select(fds[0] + 1, &readFds, NULL, NULL, &tv) <= 0)
+                        break;
+
+                    if (::read(fds[0], buffer, sizeof(buffer)) <= 0)
+                        break;
+
+                    for (unsigned int i = 0U; i < ROUTES; i++) {
+                        if (::memcmp(list[i], buffer, ETHERNET_ADDRESS_LENGTH) == 0) {
+                            found++;
+                            break;
+                        }
+                    }
+                }
+            }
+            oldBest = std::min(oldBest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+            EXPECT_EQ(found, FRAMES);
+
+            ::close(fds[0]);
+            ::close(fds[1]);
+
+            ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+            CTapDevice tap;
+            ASSERT_TRUE(tap.open(fds[0]));
+
+            found = 0U;
+            std::string callsign;
+            start = std::chrono::steady_clock::now();
+            for (unsigned int n = 0U; n < FRAMES; n += CHUNK) {
+                send(fds[1], n);
+
+                unsigned int length = 0U;
+                const unsigned char* frame;
+                while ((frame = tap.read(length)) != nullptr) {
+                    if (table.find(frame, callsign))
+                        found++;
+                }
+            }
+            newBest = std::min(newBest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+            EXPECT_EQ(found, FRAMES);
+
+            tap.close();
+            ::close(fds[1]);
+        }
+
+        auto oldRate = (unsigned long long)(FRAMES * 1.0E9 / oldBest.count());
+        auto newRate = (unsigned long long)(FRAMES * 1.0E9 / newBest.count());
+        std::cout << "select() and route scan : " << oldRate << " frames/s" << std::endl;
+        std::cout << "Batched and hashed      : " << newRate << " frames/s" << std::endl;
+
+        EXPECT_GT(newRate, oldRate);
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <cstring>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "TapDevice.h"
+
+namespace TapDeviceTests
+{
+    // A seqpacket socket pair keeps frame boundaries like a tap device does, without needing the privileges to create one
+    class TapDevice_read : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, m_fds), 0);
+            ASSERT_TRUE(m_tap.open(m_fds[0]));
+        }
+
+        void TearDown() override
+        {
+            m_tap.close();
+            ::close(m_fds[1]);
+        }
+
+        int        m_fds[2];
+        CTapDevice m_tap;
+    };
+
+    TEST_F(TapDevice_read, nothingWaiting)
+    {
+        unsigned int length = 0U;
+        EXPECT_EQ(m_tap.read(length), nullptr);
+    }
+
+    TEST_F(TapDevice_read, waitingFramesAreReadInOneBatch)
+    {
+        unsigned char frame[100U];
+        for (unsigned int i = 0U; i < 10U; i++) {
+            ::memset(frame, i, sizeof(frame));
+            ASSERT_EQ(::write(m_fds[1], frame, 60U + i), ssize_t(60U + i));
+        }
+
+        for (unsigned int i = 0U; i < 10U; i++) {
+            unsigned int length = 0U;
+            const unsigned char* data = m_tap.read(length);
+            ASSERT_NE(data, nullptr);
+            EXPECT_EQ(length, 60U + i);
+            EXPECT_EQ(data[0U], i);
+            EXPECT_EQ(data[length - 1U], i);
+        }
+
+        unsigned int length = 0U;
+        EXPECT_EQ(m_tap.read(length), nullptr);
+        EXPECT_EQ(m_tap.getFramesRead(), 10ULL);
+        EXPECT_EQ(m_tap.getBatches(), 1ULL);
+    }
+
+    TEST_F(TapDevice_read, writesGoOutOnFlush)
+    {
+        unsigned char frame[60U];
+        ::memset(frame, 0x55U, sizeof(frame));
+
+        for (unsigned int i = 0U; i < 3U; i++)
+            ASSERT_TRUE(m_tap.write(frame, sizeof(frame)));
+
+        unsigned char buffer[TAP_FRAME_LENGTH];
+        EXPECT_LT(::recv(m_fds[1], buffer, sizeof(buffer), MSG_DONTWAIT), 0);
+
+        ASSERT_TRUE(m_tap.flush());
+        for (unsigned int i = 0U; i < 3U; i++)
+            EXPECT_EQ(::recv(m_fds[1], buffer, sizeof(buffer), MSG_DONTWAIT), ssize_t(sizeof(frame)));
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <gtest/gtest.h>
+
+#include "Thread.h"
+
+namespace ThreadTests
+{
+    class Thread_configure : public ::testing::Test {
+    protected:
+        void TearDown() override
+        {
+            // The settings are process wide, keep them out of later tests
+            CThread::clearSettings();
+        }
+    };
+
+    class CNamedThread : public CThread {
+    public:
+        CNamedThread(const std::string& name) :
+        CThread(name),
+        m_name(),
+        m_pinned(false)
+        {
+        }
+
+        char m_name[16U];
+        bool m_pinned;
+
+    protected:
+        virtual void* Entry()
+        {
+            ::pthread_getname_np(::pthread_self(), m_name, sizeof(m_name));
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            ::pthread_getaffinity_np(::pthread_self(), sizeof(cpu_set_t), &set);
+            m_pinned = CPU_COUNT(&set) == 1 && CPU_ISSET(0, &set);
+
+            return NULL;
+        }
+    };
+
+    TEST_F(Thread_configure, threadCarriesItsNameCutToTheKernelLength)
+    {
+        CNamedThread thread("A very long thread name");
+        thread.Run();
+        thread.Wait();
+
+        EXPECT_STREQ(thread.m_name, "A very long thr");
+    }
+
+    TEST_F(Thread_configure, threadIsPinnedToTheCPUsOfItsRole)
+    {
+        TThreadSettings settings;
+        settings.policy   = TP_OTHER;
+        settings.priority = 1U;
+        settings.cpus     = { 0U };
+        CThread::setSettings("Pinned", settings);
+
+        CNamedThread thread("Pinned");
+        thread.Run();
+        thread.Wait();
+
+        EXPECT_STREQ(thread.m_name, "Pinned");
+        EXPECT_TRUE(thread.m_pinned);
+    }
+
+    TEST_F(Thread_configure, clearedSettingsNoLongerApply)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        ::pthread_getaffinity_np(::pthread_self(), sizeof(cpu_set_t), &set);
+        if (CPU_COUNT(&set) < 2)
+            GTEST_SKIP() << "Pinning to CPU 0 cannot be told apart from running on CPU 0 alone";
+
+        TThreadSettings settings;
+        settings.policy   = TP_OTHER;
+        settings.priority = 1U;
+        settings.cpus     = { 0U };
+        CThread::setSettings("Cleared", settings);
+        CThread::clearSettings();
+
+        CNamedThread thread("Cleared");
+        thread.Run();
+        thread.Wait();
+
+        EXPECT_STREQ(thread.m_name, "Cleared");
+        EXPECT_FALSE(thread.m_pinned);
+    }
+}
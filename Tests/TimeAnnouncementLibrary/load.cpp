@@ -0,0 +1,135 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "TimeAnnouncementLibrary.h"
+#include "DStarDefines.h"
+
+namespace TimeAnnouncementLibraryTests
+{
+    class TimeAnnouncementLibrary_load : public ::testing::Test {
+    protected:
+        std::filesystem::path m_dir;
+
+        void SetUp() override
+        {
+            m_dir = std::filesystem::temp_directory_path() / ("TimeAnnouncementLibrary_load_" + std::to_string(::getpid()));
+            std::filesystem::create_directories(m_dir);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_dir);
+        }
+
+        std::string cacheFile() const { return (m_dir / "dgwtimeserver.cache").string(); }
+
+        static std::vector<unsigned char> frames(unsigned int count, unsigned char fill)
+        {
+            return std::vector<unsigned char>(count * DV_FRAME_LENGTH_BYTES, fill);
+        }
+    };
+
+    TEST_F(TimeAnnouncementLibrary_load, findReturnsWhatWasInserted)
+    {
+        CTimeAnnouncementLibrary library("F4FXL|0|0");
+
+        EXPECT_EQ(library.find(12U, 30U), nullptr);
+
+        library.insert(12U, 30U, frames(100U, 0x12U));
+        library.insert(23U, 59U, frames(50U, 0x23U));
+        library.insert(12U, 30U, frames(101U, 0x13U));
+
+        EXPECT_EQ(library.size(), 2U);
+        ASSERT_NE(library.find(12U, 30U), nullptr);
+        EXPECT_EQ(*library.find(12U, 30U), frames(101U, 0x13U));
+        EXPECT_EQ(*library.find(23U, 59U), frames(50U, 0x23U));
+        EXPECT_EQ(library.find(0U, 0U), nullptr);
+
+        library.clear();
+        EXPECT_EQ(library.size(), 0U);
+        EXPECT_EQ(library.find(12U, 30U), nullptr);
+    }
+
+    TEST_F(TimeAnnouncementLibrary_load, savedAnnouncementsAreReloaded)
+    {
+        CTimeAnnouncementLibrary saved("F4FXL|0|0");
+        for (unsigned int hour = 0U; hour < 24U; hour++) {
+            for (unsigned int min = 0U; min < 60U; min += 15U)
+                saved.insert(hour, min, frames(100U + hour, (unsigned char)(hour + min)));
+        }
+        ASSERT_TRUE(saved.save(cacheFile()));
+        EXPECT_FALSE(std::filesystem::exists(cacheFile() + ".tmp"));
+
+        CTimeAnnouncementLibrary loaded("F4FXL|0|0");
+        ASSERT_TRUE(loaded.load(cacheFile()));
+        EXPECT_EQ(loaded.size(), 96U);
+        for (unsigned int hour = 0U; hour < 24U; hour++) {
+            for (unsigned int min = 0U; min < 60U; min++) {
+                if ((min % 15U) == 0U) {
+                    ASSERT_NE(loaded.find(hour, min), nullptr);
+                    EXPECT_EQ(*loaded.find(hour, min), *saved.find(hour, min));
+                } else {
+                    EXPECT_EQ(loaded.find(hour, min), nullptr);
+                }
+            }
+        }
+    }
+
+    TEST_F(TimeAnnouncementLibrary_load, otherSettingsAreIgnored)
+    {
+        CTimeAnnouncementLibrary saved("F4FXL|0|0");
+        saved.insert(8U, 0U, frames(100U, 0x08U));
+        ASSERT_TRUE(saved.save(cacheFile()));
+
+        CTimeAnnouncementLibrary loaded("F4FXL|6|0");
+        loaded.insert(9U, 0U, frames(100U, 0x09U));
+
+        EXPECT_FALSE(loaded.load(cacheFile())) << "Announcements rendered in another language shall not be replayed";
+        EXPECT_EQ(loaded.size(), 1U);
+        EXPECT_EQ(loaded.find(8U, 0U), nullptr);
+        EXPECT_NE(loaded.find(9U, 0U), nullptr);
+    }
+
+    TEST_F(TimeAnnouncementLibrary_load, damagedFileIsIgnored)
+    {
+        CTimeAnnouncementLibrary saved("F4FXL|0|0");
+        saved.insert(8U, 0U, frames(100U, 0x08U));
+        saved.insert(9U, 0U, frames(100U, 0x09U));
+        ASSERT_TRUE(saved.save(cacheFile()));
+
+        std::filesystem::resize_file(cacheFile(), std::filesystem::file_size(cacheFile()) - 10U);
+
+        CTimeAnnouncementLibrary loaded("F4FXL|0|0");
+        EXPECT_FALSE(loaded.load(cacheFile()));
+        EXPECT_EQ(loaded.size(), 0U);
+        EXPECT_EQ(loaded.find(8U, 0U), nullptr);
+    }
+
+    TEST_F(TimeAnnouncementLibrary_load, missingFile)
+    {
+        CTimeAnnouncementLibrary loaded("F4FXL|0|0");
+        EXPECT_FALSE(loaded.load(cacheFile()));
+    }
+}
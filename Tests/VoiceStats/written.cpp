@@ -0,0 +1,123 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include <gtest/gtest.h>
+
+#include "VoiceStats.h"
+
+namespace VoiceStatsTests
+{
+    class VoiceStats_written : public ::testing::Test {
+    protected:
+        void SetUp() override
+        {
+            CVoiceStats::setEnabled(true);
+            CVoiceStats::snapshot(VP_DCS, m_before);
+        }
+
+        void TearDown() override
+        {
+            CVoiceStats::setEnabled(false);
+        }
+
+        // The counters are shared by the whole process, so only look at what the test added
+        TVoiceSnapshot delta() const
+        {
+            TVoiceSnapshot after;
+            CVoiceStats::snapshot(VP_DCS, after);
+            CVoiceStats::subtract(after, m_before);
+            return after;
+        }
+
+        TVoiceSnapshot m_before;
+    };
+
+    TEST_F(VoiceStats_written, disabledCountsNothing)
+    {
+        CVoiceStats::setEnabled(false);
+
+        TVoiceTiming timing;
+        CVoiceStats::reset(timing);
+        CVoiceStats::decoded(timing, VP_DCS, CVoiceStats::stamp());
+        CVoiceStats::routed(timing);
+        CVoiceStats::written(timing, VP_DCS);
+        CVoiceStats::dropped(VP_DCS);
+        CVoiceStats::headerRepeat(VP_DCS);
+
+        EXPECT_EQ(timing.received, 0U);
+
+        TVoiceSnapshot stats = delta();
+        EXPECT_EQ(stats.framesIn, 0U);
+        EXPECT_EQ(stats.framesOut, 0U);
+        EXPECT_EQ(stats.drops, 0U);
+        EXPECT_EQ(stats.headerRepeats, 0U);
+        EXPECT_EQ(stats.total.getCount(), 0U);
+    }
+
+    TEST_F(VoiceStats_written, everyStageIsTimed)
+    {
+        TVoiceTiming timing;
+        CVoiceStats::reset(timing);
+        CVoiceStats::decoded(timing, VP_DCS, CVoiceStats::stamp());
+        CVoiceStats::routed(timing);
+        CVoiceStats::routed(timing);
+        CVoiceStats::written(timing, VP_DCS);
+        CVoiceStats::written(timing, VP_DCS);
+
+        EXPECT_EQ(timing.source, VP_DCS);
+
+        TVoiceSnapshot stats = delta();
+        EXPECT_EQ(stats.framesIn, 1U);
+        EXPECT_EQ(stats.framesOut, 2U);
+        EXPECT_EQ(stats.decode.getCount(), 1U);
+        // Routing to a second repeater keeps the first time
+        EXPECT_EQ(stats.route.getCount(), 1U);
+        EXPECT_EQ(stats.write.getCount(), 2U);
+        EXPECT_EQ(stats.total.getCount(), 2U);
+        EXPECT_EQ(stats.late, 0U);
+    }
+
+    TEST_F(VoiceStats_written, lateFramesAreCounted)
+    {
+        TVoiceTiming timing;
+        CVoiceStats::reset(timing);
+        CVoiceStats::decoded(timing, VP_DCS, CVoiceStats::stamp() - 50000U);
+        CVoiceStats::written(timing, VP_DCS);
+
+        TVoiceSnapshot stats = delta();
+        EXPECT_EQ(stats.late, 1U);
+        EXPECT_GE(stats.total.getMax(), 50000U);
+        // Never routed, so there is no write stage
+        EXPECT_EQ(stats.write.getCount(), 0U);
+    }
+
+    TEST_F(VoiceStats_written, generatedFramesOnlyCountOut)
+    {
+        TVoiceTiming timing;
+        CVoiceStats::reset(timing);
+        CVoiceStats::routed(timing);
+        CVoiceStats::written(timing, VP_DCS);
+        CVoiceStats::dropped(VP_DCS);
+
+        TVoiceSnapshot stats = delta();
+        EXPECT_EQ(stats.framesOut, 1U);
+        EXPECT_EQ(stats.drops, 1U);
+        EXPECT_EQ(stats.route.getCount(), 0U);
+        EXPECT_EQ(stats.total.getCount(), 0U);
+    }
+}